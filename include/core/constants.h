@@ -534,6 +534,8 @@
 #define FRAME_ATTACK_PROPS_OFFSET         170     // word: high/low/any bits (0xAA)
 #define FRAME_HIT_PROPS_OFFSET            176     // word: blockable bit at 0x10 (0xB0)
 #define FRAME_GUARD_PROPS_OFFSET          178     // word: extra guard metadata (0xB2)
+#define FRAME_DAMAGE_OFFSET               168     // word: damage (0xA8)
+#define FRAME_HITSTOP_OFFSET              194     // word: hitstop (0xC2)
 
 // Raw input values
 #define RAW_INPUT_UP    255
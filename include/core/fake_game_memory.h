@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include "game_memory.h"
+
+// Portable in-process stand-in for efz.exe memory.
+// Lays out a fake module image with the P1/P2/game-state pointer slots at EFZ_BASE_OFFSET_*, and
+// backs each slot with a zeroed player/game-state struct so fields can be poked at the offsets in
+// constants.h. Addresses are 32-bit "game" addresses translated to owned buffers, so ResolvePointer /
+// GetPlayerBase behave exactly as against the real process. Accesses outside a mapped region fail
+// like an unreadable page would.
+//
+// Not thread-safe: intended for single-threaded replays, host-side checks and benchmarks.
+class FakeGameMemory : public IGameMemory {
+public:
+    static constexpr uintptr_t kModuleBase      = 0x00400000;
+    // Whole module image is mapped (zeroed) so reads of other efz.exe globals succeed
+    static constexpr size_t    kModuleBytes     = 0x00400000;
+    static constexpr uintptr_t kPlayer1Base     = 0x10000000;
+    static constexpr uintptr_t kPlayer2Base     = 0x10010000;
+    static constexpr uintptr_t kGameStateBase   = 0x10020000;
+    // Player struct span: covers the common block and the character-specific 0x31xx slots
+    static constexpr size_t    kPlayerBytes     = 0x3400;
+    // Game state span: covers practice/CPU flags (4930..4936) and GAME_MODE_OFFSET
+    static constexpr size_t    kGameStateBytes  = 0x1400;
+
+    // Starts "in battle": both players mapped, screen state 3 and both HP fields at MAX_HP.
+    FakeGameMemory();
+
+    bool Read(uintptr_t address, void* buffer, size_t size) override;
+    bool Write(uintptr_t address, const void* data, size_t size) override;
+    uintptr_t ModuleBase() override { return kModuleBase; }
+    const char* Name() const override { return "fake"; }
+
+    // Map an extra zeroed region (anim tables, frame blocks, practice controller, ...).
+    // Fails if it overlaps an existing region.
+    bool MapRegion(uintptr_t address, size_t size);
+    // Simulate character select: clear a player's pointer slot (1/2) or restore it.
+    void SetPlayerPresent(int playerNum, bool present);
+    void SetScreenState(uint8_t state);
+
+    uintptr_t PlayerBase(int playerNum) const { return playerNum == 2 ? kPlayer2Base : kPlayer1Base; }
+    uintptr_t GameStateBase() const { return kGameStateBase; }
+
+    template <typename T>
+    void SetPlayerField(int playerNum, uintptr_t offset, const T& value) { Write(PlayerBase(playerNum) + offset, &value, sizeof(T)); }
+    template <typename T>
+    T GetPlayerField(int playerNum, uintptr_t offset) const {
+        T v{};
+        const_cast<FakeGameMemory*>(this)->Read(PlayerBase(playerNum) + offset, &v, sizeof(T));
+        return v;
+    }
+    template <typename T>
+    void SetGameStateField(uintptr_t offset, const T& value) { Write(kGameStateBase + offset, &value, sizeof(T)); }
+    void SetCharacterName(int playerNum, const char* name);
+
+    // Access counters (reset with ResetCounters) for cost comparisons between implementations
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t faults = 0;   // accesses that hit no mapped region
+    void ResetCounters() { reads = writes = faults = 0; }
+
+private:
+    struct Region {
+        uintptr_t address;
+        std::vector<uint8_t> bytes;
+    };
+    std::vector<Region> m_regions;
+
+    uint8_t* Translate(uintptr_t address, size_t size);
+    void WritePointerSlot(uintptr_t moduleOffset, uint32_t value);
+};
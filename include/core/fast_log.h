@@ -0,0 +1,225 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Structured, allocation-free logging for hot paths (192 Hz frame monitor, input hooks).
+//
+//   EFZ_LOG(LogCat::FrameMonitor, detailedLogging.load(), "[FRAME_MONITOR][TIMING] avg=%d max=%d", avg, max);
+//
+// The enabled check (category mask + detailedLogging / debug-file flags) runs BEFORE any argument is
+// evaluated, so dropped messages cost a couple of atomic loads. Enabled messages are pushed as a
+// fixed-size binary record (format pointer + raw argument bits + copied string bytes) into a lock-free
+// single-producer ring owned by the calling thread; a background drain thread formats them lazily and
+// hands the text to the LogOut console / debug-file sinks. If a thread's ring is full the record is
+// dropped and counted, the producer never blocks.
+//
+// Format strings must be string literals (the pointer is kept until the drain thread formats it).
+// Supported arguments: integers, enums, bool, floating point, const char*, std::string and
+// std::string_view (strings are copied, up to kLogTextBytes per record in total).
+//
+// Categories are compile-time IDs. LogOut() maps its bracket tag onto the same table, so both paths
+// share the filtering rules: DETAILED categories only reach the console while detailedLogging is on,
+// DEBUGFILE categories are also written to efz_training_debug.log.
+
+extern std::atomic<bool> detailedLogging;
+namespace DebugLog { extern bool g_EnableDebugLog; }
+
+#define LOGCAT_DETAILED  0x1u
+#define LOGCAT_DEBUGFILE 0x2u
+
+//          id               tag               flags
+#define EFZ_LOG_CATEGORIES(X) \
+    X(Other,           "OTHER",          0) \
+    X(Window,          "WINDOW",         LOGCAT_DETAILED) \
+    X(Overlay,         "OVERLAY",        LOGCAT_DETAILED) \
+    X(Imgui,           "IMGUI",          LOGCAT_DETAILED) \
+    X(ImguiMonitor,    "IMGUI_MONITOR",  LOGCAT_DETAILED) \
+    X(Config,          "CONFIG",         LOGCAT_DETAILED) \
+    X(Keybinds,        "KEYBINDS",       LOGCAT_DETAILED) \
+    X(InputBuffer,     "INPUT_BUFFER",   LOGCAT_DETAILED) \
+    X(BufferFreeze,    "BUFFER_FREEZE",  LOGCAT_DETAILED) \
+    X(BufferDebug,     "BUFFER_DEBUG",   LOGCAT_DETAILED) \
+    X(BufferCombo,     "BUFFER_COMBO",   LOGCAT_DETAILED) \
+    X(BufferDump,      "BUFFER_DUMP",    LOGCAT_DETAILED) \
+    X(AutoAction,      "AUTO-ACTION",    LOGCAT_DETAILED) \
+    X(TriggerDiag,     "TRIGGER_DIAG",   LOGCAT_DETAILED) \
+    X(Delay,           "DELAY",          LOGCAT_DETAILED) \
+    X(Cooldown,        "COOLDOWN",       LOGCAT_DETAILED) \
+    X(Dash,            "DASH",           LOGCAT_DETAILED) \
+    X(DashDebug,       "DASH_DEBUG",     LOGCAT_DETAILED) \
+    X(AutoGuard,       "AUTO_GUARD",     LOGCAT_DETAILED) \
+    X(Crg,             "CRG",            LOGCAT_DETAILED) \
+    X(Rg,              "RG",             LOGCAT_DETAILED) \
+    X(Switch,          "SWITCH",         LOGCAT_DEBUGFILE) \
+    X(Freeze,          "FREEZE",         LOGCAT_DEBUGFILE) \
+    X(AI,              "AI",             LOGCAT_DEBUGFILE) \
+    X(Engine,          "ENGINE",         LOGCAT_DEBUGFILE) \
+    X(FrameMonitor,    "FRAME_MONITOR",  0) \
+    X(FrameMonitorAlt, "FRAME MONITOR",  0) \
+    X(RgDebug,         "RG_DEBUG",       0) \
+    X(CleanHit,        "CLEANHIT",       0) \
+    X(ActionableDbg,   "ACTIONABLE_DBG", 0) \
+    X(Trace,           "TRACE",          0) \
+    X(CollisionHook,   "COLLISION_HOOK", 0) \
+    X(Motion,          "MOTION",         LOGCAT_DETAILED) \
+    X(InputMotion,     "INPUT_MOTION",   LOGCAT_DETAILED) \
+    X(InputQueue,      "INPUT_QUEUE",    LOGCAT_DETAILED)
+
+enum class LogCat : uint8_t {
+#define EFZ_LOGCAT_ENUM(id, tag, flags) id,
+    EFZ_LOG_CATEGORIES(EFZ_LOGCAT_ENUM)
+#undef EFZ_LOGCAT_ENUM
+    Count
+};
+static_assert((size_t)LogCat::Count <= 64, "log category mask is 64 bits");
+
+namespace FastLog {
+    constexpr std::string_view kCategoryTags[] = {
+#define EFZ_LOGCAT_TAG(id, tag, flags) tag,
+        EFZ_LOG_CATEGORIES(EFZ_LOGCAT_TAG)
+#undef EFZ_LOGCAT_TAG
+    };
+    constexpr uint8_t kCategoryFlags[] = {
+#define EFZ_LOGCAT_FLAGS(id, tag, flags) (uint8_t)(flags),
+        EFZ_LOG_CATEGORIES(EFZ_LOGCAT_FLAGS)
+#undef EFZ_LOGCAT_FLAGS
+    };
+
+    constexpr uint64_t BuildMask(uint8_t flag) {
+        uint64_t m = 0;
+        for (size_t i = 0; i < (size_t)LogCat::Count; ++i) if (kCategoryFlags[i] & flag) m |= (1ull << i);
+        return m;
+    }
+    constexpr uint64_t kDetailedMask = BuildMask(LOGCAT_DETAILED);
+    constexpr uint64_t kDebugFileMask = BuildMask(LOGCAT_DEBUGFILE);
+
+    // Categories muted at runtime (console and file). All enabled by default.
+    extern std::atomic<uint64_t> g_mutedMask;
+
+    constexpr LogCat CategoryFromTag(std::string_view tag) {
+        for (size_t i = 0; i < (size_t)LogCat::Count; ++i) if (kCategoryTags[i] == tag) return (LogCat)i;
+        return LogCat::Other;
+    }
+    // Category of a "[TAG] ..." / "[TAG][SUB] ..." message: the first bracketed tag, else Other
+    LogCat CategoryFromMessage(std::string_view msg);
+    inline const char* CategoryName(LogCat c) {
+        return (size_t)c < (size_t)LogCat::Count ? kCategoryTags[(size_t)c].data() : "OTHER";
+    }
+
+    inline bool RoutesToConsole(LogCat c, bool consoleOutput) {
+        if (!consoleOutput) return false;
+        return !(kDetailedMask & (1ull << (unsigned)c)) || detailedLogging.load(std::memory_order_relaxed);
+    }
+    inline bool RoutesToDebugFile(LogCat c) {
+        return (kDebugFileMask & (1ull << (unsigned)c)) && DebugLog::g_EnableDebugLog;
+    }
+    // Cheap pre-check: would a message of this category go anywhere?
+    inline bool Enabled(LogCat c, bool consoleOutput) {
+        if (g_mutedMask.load(std::memory_order_relaxed) & (1ull << (unsigned)c)) return false;
+        return RoutesToConsole(c, consoleOutput) || RoutesToDebugFile(c);
+    }
+
+    // ---- Binary records ----
+    constexpr size_t kLogMaxArgs = 8;
+    constexpr size_t kLogTextBytes = 128;
+    constexpr uint32_t kLogRingSlots = 256;   // per producing thread
+
+    enum ArgType : uint8_t { ArgNone = 0, ArgInt, ArgUInt, ArgDouble, ArgStr, ArgPtr };
+
+    struct Record {
+        uint64_t    tsNs;                    // steady clock, for cross-thread ordering
+        const char* fmt;                     // string literal
+        uint8_t     cat;
+        uint8_t     console;
+        uint8_t     argc;
+        uint8_t     textUsed;
+        uint8_t     types[kLogMaxArgs];
+        uint64_t    args[kLogMaxArgs];       // raw bits; ArgStr = (offset << 8) | length into text
+        char        text[kLogTextBytes];
+    };
+
+    // Encoder (producer side; no allocation)
+    class RecordBuilder {
+    public:
+        explicit RecordBuilder(Record& r) : m_r(r) {}
+        template <typename T>
+        void Add(const T& v) {
+            if (m_r.argc >= kLogMaxArgs) return;
+            using D = std::decay_t<T>;
+            uint8_t i = m_r.argc++;
+            if constexpr (std::is_same_v<D, bool>) {
+                m_r.types[i] = ArgInt; m_r.args[i] = v ? 1 : 0;
+            } else if constexpr (std::is_enum_v<D>) {
+                m_r.types[i] = ArgInt; m_r.args[i] = (uint64_t)(int64_t)v;
+            } else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>) {
+                m_r.types[i] = ArgInt; m_r.args[i] = (uint64_t)(int64_t)v;
+            } else if constexpr (std::is_integral_v<D>) {
+                m_r.types[i] = ArgUInt; m_r.args[i] = (uint64_t)v;
+            } else if constexpr (std::is_floating_point_v<D>) {
+                double d = (double)v; m_r.types[i] = ArgDouble; memcpy(&m_r.args[i], &d, sizeof(d));
+            } else if constexpr (std::is_array_v<T>) {
+                AddString(i, std::string_view(v));   // string literal / char buffer
+            } else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>) {
+                AddString(i, v ? std::string_view(v) : std::string_view("(null)"));
+            } else if constexpr (std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>) {
+                AddString(i, std::string_view(v));
+            } else if constexpr (std::is_pointer_v<D>) {
+                m_r.types[i] = ArgPtr; m_r.args[i] = (uint64_t)(uintptr_t)v;
+            } else {
+                static_assert(sizeof(D) == 0, "unsupported EFZ_LOG argument type");
+            }
+        }
+    private:
+        void AddString(uint8_t i, std::string_view s) {
+            size_t room = kLogTextBytes - m_r.textUsed;
+            size_t n = s.size() < room ? s.size() : room;
+            if (n > 255) n = 255;
+            memcpy(m_r.text + m_r.textUsed, s.data(), n);
+            m_r.types[i] = ArgStr;
+            m_r.args[i] = ((uint64_t)m_r.textUsed << 8) | n;
+            m_r.textUsed = (uint8_t)(m_r.textUsed + n);
+        }
+        Record& m_r;
+    };
+
+    // Claim the calling thread's next ring slot (nullptr when the ring is full; the drop is counted)
+    Record* BeginRecord(LogCat cat, bool consoleOutput, const char* fmt);
+    void CommitRecord();
+
+    template <typename... Args>
+    void Push(LogCat cat, bool consoleOutput, const char* fmt, const Args&... args) {
+        Record* r = BeginRecord(cat, consoleOutput, fmt);
+        if (!r) return;
+        RecordBuilder b(*r);
+        (b.Add(args), ...);
+        CommitRecord();
+    }
+
+    // Render a record to text (drain side). Returns the length written (always NUL-terminated).
+    size_t Format(const Record& r, char* out, size_t cap);
+
+    // Where drained lines go. Installed by logger.cpp (console + debug file).
+    using SinkFn = void(*)(LogCat cat, bool console, const char* line, size_t len);
+    void SetSink(SinkFn sink);
+
+    // Drain thread control. Start is idempotent; Push starts it on first use.
+    void Start();
+    // Ask the drain thread to flush what it has and exit (does not join; safe from DllMain)
+    void Stop();
+    // Format and emit everything queued so far on the calling thread
+    void DrainNow();
+
+    uint64_t DroppedRecords();
+    uint64_t DrainedRecords();
+}
+
+#define EFZ_LOG(cat, consoleOutput, fmt, ...) \
+    do { \
+        const bool efzLogConsole_ = (consoleOutput); \
+        if (FastLog::Enabled((cat), efzLogConsole_)) FastLog::Push((cat), efzLogConsole_, fmt, ##__VA_ARGS__); \
+    } while (0)
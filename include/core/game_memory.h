@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// One write of a batch (see IGameMemory::WriteBatch)
+struct MemoryWriteSpan {
+    uintptr_t   address;
+    const void* data;
+    size_t      size;
+};
+
+// Game memory backend.
+// Every guarded access to EFZ memory (SafeReadMemory/SafeWriteMemory, ResolvePointer, GetPlayerBase,
+// GetEFZBase) goes through the active backend. The default is the live Win32 process; a portable
+// FakeGameMemory (fake_game_memory.h) can be installed to drive the same code paths from a flat buffer.
+// Header is intentionally free of <windows.h> so portable code can include it.
+class IGameMemory {
+public:
+    virtual ~IGameMemory() = default;
+
+    // Guarded copy out of / into game memory. Return false when the range isn't accessible.
+    virtual bool Read(uintptr_t address, void* buffer, size_t size) = 0;
+    virtual bool Write(uintptr_t address, const void* data, size_t size) = 0;
+    // Address of the efz.exe module image (EFZ_BASE_OFFSET_* are relative to this)
+    virtual uintptr_t ModuleBase() = 0;
+    // Short identifier for logs ("win32", "fake")
+    virtual const char* Name() const = 0;
+    // Apply several writes at once; spans are sorted by address and don't overlap. Backends may use
+    // this to change page protection once per page instead of once per write. Returns failed count.
+    virtual size_t WriteBatch(const MemoryWriteSpan* spans, size_t count) {
+        size_t failed = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (!Write(spans[i].address, spans[i].data, spans[i].size)) ++failed;
+        }
+        return failed;
+    }
+    // Forget cached page validity (engine may have freed/re-allocated structures). Default: no cache.
+    virtual void InvalidateRegions() {}
+};
+
+// Active backend (never null; defaults to the Win32 process backend)
+IGameMemory& GetGameMemory();
+// Install a backend; nullptr restores the Win32 default. The caller keeps ownership and must keep it
+// alive until replaced. Invalidates the module/game-state/player base caches.
+void SetGameMemory(IGameMemory* backend);
+
+// EFZ is a 32-bit process: pointer slots in game memory are always 4 bytes wide, regardless of the
+// host's uintptr_t. Use this instead of reading sizeof(uintptr_t) when following engine pointers.
+inline bool ReadGamePointer(uintptr_t address, uintptr_t& out) {
+    uint32_t raw = 0;
+    if (!GetGameMemory().Read(address, &raw, sizeof(raw))) return false;
+    out = static_cast<uintptr_t>(raw);
+    return true;
+}
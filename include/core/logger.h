@@ -1,6 +1,7 @@
 #pragma once
 #include <windows.h>
 #include <string>
+#include <cstdint>
 #include <fstream>
 #include <mutex>
     #include <atomic>
@@ -19,7 +20,8 @@ namespace Logger {
 
 void LogOut(const std::string& msg, bool consoleOutput = false);
 void InitializeLogging();
-void UpdateConsoleTitle();
+// One console title refresh; returns microseconds until the next (TaskScheduler::kDone to stop)
+uint32_t UpdateConsoleTitle();
 short GetCurrentMoveID(int player);
 // Flush any pending console logs buffered before the console was created
 void FlushPendingConsoleLogs();
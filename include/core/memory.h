@@ -1,6 +1,7 @@
 #pragma once
 #include <windows.h>
 #include <cstdint>
+#include "game_memory.h" // IGameMemory backend, ReadGamePointer
 
 // Function to read player inputs
 uint8_t GetPlayerInputs(int playerNum);
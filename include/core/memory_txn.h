@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Features whose game-memory writes are journaled for undo. Positions, RF and character resources
+// are batched under None: the engine rewrites them every frame, so there is nothing to restore.
+enum class WriteOwner : uint8_t {
+    None = 0,          // not journaled
+    PracticePatch,     // practice_patch.cpp control/auto-block/block-mode flags
+    Count
+};
+
+// Per-tick write transaction.
+// Writes are collected instead of applied immediately. Commit() sorts them, merges adjacent and
+// overlapping ranges (later writes win), records the original bytes in the owner's undo journal and
+// hands the result to the active backend as one batch, so page protection changes once per page
+// rather than once per field.
+//
+// While a transaction is alive it is the thread's current transaction: SafeWriteMemory on that
+// thread is routed into it, and SafeReadMemory overlays its pending bytes so read-after-write inside
+// the scope still sees the new values. Nested transactions forward into the enclosing one on Commit.
+// The destructor commits anything still pending.
+//
+// Pending writes live in fixed inline storage (kMaxSpans writes, kMaxBytes bytes) and Commit() merges
+// on the stack, so a transaction never allocates; the RF freeze keeper opens one every tick. A write
+// that does not fit flushes what is pending first; one larger than kMaxBytes bypasses the batch.
+class MemoryWriteTxn {
+public:
+    explicit MemoryWriteTxn(WriteOwner owner = WriteOwner::None);
+    ~MemoryWriteTxn();
+    MemoryWriteTxn(const MemoryWriteTxn&) = delete;
+    MemoryWriteTxn& operator=(const MemoryWriteTxn&) = delete;
+
+    static constexpr size_t kMaxSpans = 64;
+    static constexpr size_t kMaxBytes = 1024;
+
+    bool Add(uintptr_t address, const void* data, size_t size);
+    template <typename T>
+    bool Add(uintptr_t address, const T& value) { return Add(address, &value, sizeof(T)); }
+
+    // Apply pending bytes that intersect [address, address+size) onto buffer
+    void Overlay(uintptr_t address, void* buffer, size_t size) const;
+
+    // Apply and clear pending writes. Returns false if any merged range failed to write.
+    bool Commit();
+    // Drop pending writes without applying them
+    void Discard();
+
+    size_t PendingWrites() const { return m_spanCount; }
+    // Ranges the last Commit() produced after merging, and how many of them failed
+    size_t LastRunCount() const { return m_lastRuns; }
+    size_t LastFailedCount() const { return m_lastFailed; }
+
+    static MemoryWriteTxn* Current();
+
+private:
+    struct Span {
+        uintptr_t address;
+        uint32_t  size;
+        uint32_t  offset;   // into m_bytes
+    };
+    WriteOwner m_owner;
+    MemoryWriteTxn* m_parent;
+    Span m_spans[kMaxSpans];
+    size_t m_spanCount = 0;
+    uint8_t m_bytes[kMaxBytes];
+    size_t m_used = 0;
+    size_t m_lastRuns = 0;
+    size_t m_lastFailed = 0;
+};
+
+// Single journaled write for isolated flag writes: joins the current transaction if there is one,
+// otherwise goes straight to the backend
+bool JournaledWrite(WriteOwner owner, uintptr_t address, const void* data, size_t size);
+template <typename T>
+inline bool JournaledWrite(WriteOwner owner, uintptr_t address, const T& value) {
+    return JournaledWrite(owner, address, &value, sizeof(T));
+}
+
+// Undo journals: each owner remembers the bytes that were in memory before its FIRST write to them,
+// in a fixed-size per-owner table (no allocation; a full journal logs once and stops recording).
+// RevertWrites restores those bytes in one batch and clears the journal. Returns false on write
+// failure or when the journal had overflowed. Only journal fields the engine doesn't rewrite on its
+// own: restoring a transient value (timers, per-frame flags) would put back a stale one.
+// RevertAllWrites runs when features are disabled (leaving Practice) and before netplay.
+bool RevertWrites(WriteOwner owner);
+bool RevertAllWrites();
+void DiscardWriteJournal(WriteOwner owner);
+size_t GetWriteJournalBytes(WriteOwner owner);
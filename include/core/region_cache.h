@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Page-granular memory validity cache.
+// Answers "can I read/write [address, address+size) without faulting?" from a small direct-mapped
+// table of recently validated pages, and only asks the OS (via the injected query function) on a miss.
+// Only positive answers are cached; a page that fails the query is re-queried next time.
+// Invalidate() bumps a generation counter so every cached page is treated as unknown again; call it
+// whenever the engine may have freed or re-allocated structures (character reload, match exit).
+// Forget() drops just the pages of one range, e.g. after a copy faulted on a page the cache vouched for.
+//
+// Portable: no OS calls here. The Win32 backend supplies a VirtualQuery-based query function; tests
+// and benchmarks can supply their own. All methods are safe to call from multiple threads.
+class RegionValidityCache {
+public:
+    enum : uint32_t {
+        kReadable = 1u << 0,
+        kWritable = 1u << 1,   // writable as-is (no protection change needed)
+    };
+    static constexpr uintptr_t kPageSize  = 0x1000;
+    static constexpr size_t    kSlotCount = 256;  // power of two
+
+    // Describe the region containing `address`: fill base/size of the allocation range sharing the
+    // same protection and its access flags. Return false if the address is not mapped at all.
+    using QueryFn = bool (*)(uintptr_t address, uintptr_t& regionBase, size_t& regionSize, uint32_t& flags, void* ctx);
+
+    RegionValidityCache(QueryFn query, void* ctx);
+
+    bool CanRead(uintptr_t address, size_t size)  { return Check(address, size, kReadable); }
+    bool CanWrite(uintptr_t address, size_t size) { return Check(address, size, kWritable); }
+
+    void Invalidate();
+    void Forget(uintptr_t address, size_t size);
+    uint32_t Generation() const { return m_generation.load(std::memory_order_acquire); }
+
+    // Counters for diagnostics/benchmarks (relaxed; approximate under contention)
+    uint64_t Hits() const    { return m_hits.load(std::memory_order_relaxed); }
+    uint64_t Queries() const { return m_queries.load(std::memory_order_relaxed); }
+
+private:
+    bool Check(uintptr_t address, size_t size, uint32_t need);
+    bool CheckPage(uintptr_t page, uint32_t need, uint32_t gen);
+
+    // Slot layout: [flags:2][generation:16][page number:46]; 0 means empty. Only the low 16 bits
+    // of the generation fit, so Invalidate() empties every slot when they wrap to 0.
+    static uint64_t Pack(uintptr_t page, uint32_t gen, uint32_t flags) {
+        return (static_cast<uint64_t>(page) << 18) | (static_cast<uint64_t>(gen & 0xFFFFu) << 2) | (flags & 0x3u);
+    }
+
+    QueryFn m_query;
+    void* m_ctx;
+    std::atomic<uint32_t> m_generation{1};
+    std::atomic<uint64_t> m_slots[kSlotCount];
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_queries{0};
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+// Shared deadline-driven executor for the timed background work that used to own a sleep loop each
+// (ImmediateInput's 64 Hz writer, the console title updater, the human-control and RF freeze keepers).
+//
+// One worker thread owns a hashed timer wheel (256 slots x 1 ms; entries further out wait for a later lap).
+// Any thread submits through a fixed pool of task slots and a lock-free push-only list; the worker
+// drains that list each wakeup, so submission never blocks on the worker. The worker sleeps on an
+// event until the earliest deadline in the wheel (or a submission), runs every due task, and records
+// how late each run started against its deadline, which is the wakeup jitter shown in the Debug tab.
+//
+// A task returns the delay until its next run, measured from the deadline it was scheduled for, so a
+// constant return value is a drift-free fixed rate and a varying one gives adaptive backoff. A task
+// that fell more than one delay behind resyncs to now + delay instead of bursting to catch up.
+// Tasks run serially on the worker; keep them short and never block in one.
+
+namespace TaskScheduler {
+    using TaskId = uint32_t;
+    constexpr TaskId kInvalidTask = 0;
+    constexpr int kMaxTasks = 64;
+    constexpr uint32_t kDone = 0;   // TaskFn return value: do not run again
+
+    // Returns microseconds until the next run, or kDone
+    using TaskFn = std::function<uint32_t()>;
+
+    // Idempotent. Tasks submitted before Start() run once the worker is up.
+    void Start();
+    // Worker exits after its current task; remaining tasks are dropped (process shutdown)
+    void Stop();
+    bool IsRunning();
+
+    // First run after `delayUs`. `name` is copied (truncated to 31 chars) for the stats table.
+    // Returns kInvalidTask when all kMaxTasks slots are in use.
+    TaskId Schedule(const char* name, uint32_t delayUs, TaskFn fn);
+    // Fixed-rate helper: fn runs every periodUs until cancelled
+    TaskId SchedulePeriodic(const char* name, uint32_t periodUs, std::function<void()> fn);
+    TaskId ScheduleOnce(const char* name, uint32_t delayUs, std::function<void()> fn);
+
+    // The task does not start again; a run already in progress completes. Stale ids are ignored.
+    void Cancel(TaskId id);
+    bool IsScheduled(TaskId id);
+
+    struct TaskStats {
+        char     name[32];
+        uint64_t runs = 0;
+        double   meanLateUs = 0.0;   // wakeup jitter: start time minus deadline
+        double   maxLateUs = 0.0;
+        uint64_t lateOver2ms = 0;    // runs that started more than 2 ms late
+        double   meanRunUs = 0.0;
+        double   maxRunUs = 0.0;
+    };
+    // Live tasks in slot order; returns how many were written
+    int GetStats(TaskStats* out, int max);
+    void ResetStats();
+}
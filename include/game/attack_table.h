@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+// Per-character attack data, built once per loaded character instead of probed per lookup.
+//
+// A character's animation table (player + ANIM_TABLE_OFFSET) holds one entry per moveID whose frames
+// pointer leads to an array of FRAME_BLOCK_STRIDE-byte frame blocks; damage, guard/blockstun, hitstop
+// and the HIGH/LOW attack bits live in those blocks (the words AttackReader used to find through
+// TryFindNestedAttackPtr). The frame monitor hands every tick's sample to Update; when a player's
+// animation table pointer changes (new character, new match) a TaskScheduler task walks the table in
+// small chunks and folds the frames of each attack moveID into one MoveData. The finished table is
+// published by index swap, so Lookup is an array access from any thread.
+//
+// Frame counts are not stored in the table entry; a move's frames end at the next move's frames in
+// memory (capped at kMaxFramesPerMove) or at the first implausible block, whichever comes first.
+
+struct PerFrameSample;
+
+namespace AttackTable {
+    constexpr int kMaxMoveId = 512;          // same range as the MoveProps table
+    constexpr int kMaxFramesPerMove = 96;
+    constexpr int kMovesPerRun = 24;         // frame arrays read per scheduler run
+
+    enum MoveFlags : uint8_t {
+        HasData   = 1u << 0,   // frames were read for this moveID
+        Guardable = 1u << 1,   // some frame carries a guard (blockstun) value
+        High      = 1u << 2,   // some active frame must be blocked standing
+        Low       = 1u << 3,   // some active frame must be blocked crouching
+    };
+
+    struct MoveData {
+        uint16_t damage;        // max over frames
+        uint16_t blockstun;     // max guard value over frames
+        uint16_t hitstop;       // max over frames
+        uint8_t  frames;        // frame blocks in the move
+        uint8_t  firstActive;   // first frame block with damage or a guard value
+        uint8_t  activeFrames;  // frame blocks with damage or a guard value (not always contiguous)
+        uint8_t  flags;         // MoveFlags
+        uint32_t activeMask[(kMaxFramesPerMove + 31) / 32];  // bit b: frame block b is active
+    };
+
+    // Multi-hit moves can have inactive blocks between hits; test the block itself
+    inline bool IsActiveBlock(const MoveData& m, int block) {
+        return block >= 0 && block < kMaxFramesPerMove && ((m.activeMask[block >> 5] >> (block & 31)) & 1u);
+    }
+
+    // Frame monitor thread: schedule a rebuild when a player's animation table changed
+    void Update(const PerFrameSample& sample);
+
+    // Any thread. nullptr while the player's table is being built or when the moveID has no attack frames.
+    const MoveData* Lookup(int player, short moveID);
+    bool IsReady(int player);
+    int  MoveCount(int player);     // moveIDs with attack frames in the published table
+
+    // "HIGH" / "LOW" / "ANY" (guardable without a height bit) / "UNBLOCKABLE"
+    const char* HeightName(const MoveData& m);
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "frame_advantage_engine.h"
+
+// Session record of every exchange the frame advantage engine resolves.
+//
+// frame_advantage.cpp forwards each engine event: a Connect opens a pending exchange for the attacker
+// (taking the Gap reported on the same tick and a recoil guard edge of the defender), and the
+// attacker's FrameAdvantage closes it. A new connect by the same attacker (strings, combos) or a
+// stale reset closes it without an advantage; a teleport/reset discards it. The frame monitor's RG
+// analysis adds FA1/FA2 for recoil guarded exchanges.
+//
+// Closed exchanges go into a fixed ring of kCapacity rows stored column by column, so memory is
+// bounded however long the session runs. Aggregates are updated on insertion and cover the whole
+// session since the last Reset, including rows the ring has already overwritten:
+//  - gap histogram in visual frames,
+//  - advantage-on-block histogram in visual frames (the punish distribution),
+//  - per attacker move: count, blocks, hits and advantage min / sum / max.
+// Bins truncate toward zero, so "punishable at N frames" (gap >= N, block advantage <= -N) is an
+// exact sum over bins for any N. Events are rare (a few per second at most) and are recorded under
+// one mutex; readers copy what they show.
+//
+// Advantage, gap and RG values are internal frames (3 per visual frame); kNone marks a missing value.
+
+namespace ExchangeStats {
+    constexpr int kCapacity = 8192;             // rows kept for the table and CSV export
+    constexpr int kMaxMoveId = 512;             // per-move aggregates cover the shared moveID range
+    constexpr int kGapBins = 21;                // 0..20F (engine gaps stop at 60 internal frames)
+    constexpr int kAdvantageRange = 30;         // advantage bins cover -30F..+30F, clamped
+    constexpr int kAdvantageBins = 2 * kAdvantageRange + 1;
+    constexpr int16_t kNone = INT16_MIN;
+
+    enum class Outcome : uint8_t { Block, Hit, Thrown, Lockout, RecoilGuard, Count };
+
+    struct Position { int16_t x; int16_t y; };
+
+    struct Row {
+        uint32_t id;            // exchanges recorded before this one (session-wide)
+        int      frame;         // internal frame of the connect
+        uint8_t  attacker;      // 1 or 2
+        Outcome  outcome;
+        short    attackerMove;
+        short    defenderMove;  // defender state right after the connect
+        int16_t  advantage;
+        int16_t  gap;
+        int16_t  rgFa1;
+        int16_t  rgFa2;
+        Position attackerPos;
+        Position defenderPos;
+    };
+
+    struct Summary {
+        uint32_t total;
+        uint32_t stored;                                    // rows still in the ring
+        uint32_t byOutcome[(int)Outcome::Count];
+        uint32_t withAdvantage;
+        uint32_t gaps;
+        uint32_t gapBins[kGapBins];                         // [i] = gaps of i.00..i.66 F
+        uint32_t advantageBins[kAdvantageBins];             // [i] = block advantage (i - kAdvantageRange) F
+    };
+
+    struct MoveStats {
+        uint8_t  player;
+        short    moveID;
+        uint32_t count;
+        uint32_t blocks;
+        uint32_t hits;
+        uint32_t withAdvantage;
+        int      advantageMin;
+        int      advantageMax;
+        int64_t  advantageSum;
+    };
+
+    // Frame monitor thread
+    void OnEngineEvent(const FrameAdvantageEngine::Event& e, const FrameAdvantageEngine::Input& in,
+                       const Position pos[2]);
+    void OnRecoilGuardResult(int defender, int fa1, int fa2);
+
+    // Any thread
+    void DiscardPending();
+    void Reset();
+    Summary GetSummary();
+    // Sums over the histograms for a threshold in visual frames
+    uint32_t PunishableGaps(const Summary& s, int frames);
+    uint32_t PunishableBlocks(const Summary& s, int frames);
+    // Moves with at least one exchange, by player then moveID; returns how many were written
+    int CopyMoveStats(MoveStats* out, int max);
+    // Newest first; returns how many were written
+    int CopyRecent(Row* out, int max);
+
+    const char* OutcomeName(Outcome o);
+    // One row per stored exchange plus the per-move summary.
+    // Empty path writes efz_exchanges.csv next to the config file.
+    bool ExportCsv(const std::string& path, std::string* writtenPath = nullptr);
+}
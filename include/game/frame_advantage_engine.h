@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+
+// Side-effect-free core of MonitorFrameAdvantage.
+//
+// One Step per 192 Hz engine tick: the caller fills an Input from the tick's PerFrameSample (plus the
+// pause-aware internal frame and the global game-speed freeze flag) and gets back what happened on that
+// tick as events (new action, recoil guard, connect, gap, frame advantage, stale reset). All exchange
+// tracking that used to live in the global FrameAdvantageState and in function statics is held in a
+// State the caller owns, so the same trace always yields the same events. Overlay messages, display
+// timers and logging stay with the caller (frame_advantage.cpp); this file has no Win32 dependency and
+// also builds into tools/fa_replay.
+//
+// Frames are internal frames (3 per visual frame). Players are 1 and 2; Side arrays are indexed player - 1.
+
+namespace FrameAdvantageEngine {
+    constexpr int kConnectCooldown = 3;       // internal frames between connects of one attacker
+    constexpr int kAttackConnectWindow = 60;  // attack edge -> defender lockout still counts as a connect
+    constexpr int kMaxGapFrames = 60;         // gaps above this are a reset to neutral, not reported
+    constexpr int kStaleFrames = 1152;        // ~6 s of tracking with nothing left to wait for
+    constexpr int kMaxEvents = 12;            // upper bound of events one Step can produce
+
+    struct Input {
+        int   frame;               // pause-aware internal frame (GetCurrentInternalFrame)
+        short moveID[2];
+        short prevMoveID[2];
+        bool  actionable[2];       // IsActionable(moveID)
+        bool  prevActionable[2];   // IsActionable(prevMoveID)
+        bool  gameSpeedFrozen;     // superflash / global freeze (PauseIntegration::IsGameSpeedFrozen)
+    };
+
+    enum class EventKind : uint8_t {
+        NewAction,       // attack start edge, or any tick in a dash start / jump (the FA readout should clear)
+        RecoilGuard,     // player entered a recoil guard state
+        Connect,         // player's attack locked the opponent (connect says how)
+        Gap,             // player's connect ended a gap in a string: value = gap, raw = before freeze removal
+        FrameAdvantage,  // exchange resolved: value = defender free - attacker actionable - freeze after recovery
+        StaleReset,      // tracking made no progress for kStaleFrames; exchange state was dropped
+    };
+
+    enum class ConnectKind : uint8_t { Block, Hit, Thrown, Lockout };
+
+    struct Event {
+        EventKind   kind;
+        uint8_t     player;       // acting player (the attacker for Connect / Gap / FrameAdvantage), 0 for StaleReset
+        ConnectKind connect;      // Connect only
+        int         frame;        // Input::frame of the tick that produced it
+        int         value;
+        int         raw;
+    };
+
+    // Per-player tracking. Attacker fields describe this player's current attack, defender fields the
+    // opponent's attack on this player.
+    struct Side {
+        bool  attacking;
+        bool  defending;
+        bool  inBlockstun;
+        bool  inHitstun;
+        int   attackStartFrame;
+        int   blockstunStartFrame;
+        int   hitstunStartFrame;
+        short initialBlockstunMoveID;
+        int   actionableFrame;        // attacker recovered
+        int   defenderFreeFrame;      // defender left the lockout
+        int   frameAdvantage;         // last result as attacker
+        bool  advantageCalculated;
+
+        int   lastFreeFrame;          // as defender: became actionable (gap start), -1 while locked
+        int   freezeSinceFree;        // as defender: freeze ticks since lastFreeFrame
+        int   freezeAfterActionable;  // as attacker: freeze ticks between recovery and defender free
+        int   connectCooldown;
+        int   lastAttackEdgeFrame;
+    };
+
+    struct State {
+        Side side[2];
+        int  staleFrames;
+    };
+
+    // Everything cleared (match start)
+    void Reset(State& s);
+    // Exchange tracking cleared; gap and freeze bookkeeping kept (ResetFrameAdvantageState)
+    void ResetTracking(State& s);
+    // Exchange, gap and freeze bookkeeping cleared; block/hit flags kept (teleport / position reset)
+    void Cancel(State& s);
+
+    // Advance one tick. Writes up to `max` events to `out` in the order they happened; returns the count.
+    int Step(State& s, const Input& in, Event* out, int max);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+// Frame meter: what each player was doing on every visual frame of the current exchange.
+//
+// The frame monitor publishes one cell per player per 192 Hz tick from the PerFrameSample (moveID,
+// actionable flag and the frame index inside the move); attack moves are split into startup /
+// active / recovery through AttackTable's per-block active bits (gaps between hits are recovery).
+// Readers get visual-frame columns: three ticks fold into one column, keeping the most significant
+// cell (active beats stun beats startup ...), so a 1-tick active frame is never lost.
+//
+// A meter segment starts when either player leaves actionable and stops kIdleTicks after both
+// are actionable again; the last segment stays readable until the next one starts. Storage and
+// publication follow InputHistory: one writer, a sequence counter, relaxed atomic payload, no
+// allocation and no game memory reads on the reader side.
+
+struct PerFrameSample;
+
+namespace FrameMeter {
+    constexpr int kColumns = 80;                    // visual frames shown
+    constexpr int kTicksPerColumn = 3;              // 192 Hz ticks per visual frame
+    constexpr int kRingTicks = 256;                 // >= kColumns * kTicksPerColumn
+    constexpr int kIdleTicks = 20 * kTicksPerColumn;
+
+    // Ordered by significance when ticks fold into a column
+    enum Cell : uint8_t {
+        Empty = 0,
+        Actionable,
+        Busy,           // not actionable outside attacks and stun (dash, jump, landing, tech)
+        Recovery,
+        Startup,
+        Blockstun,
+        Hitstun,        // includes launched, thrown and special stun
+        Active,
+        kCellCount
+    };
+
+    // Frame monitor thread
+    void Publish(const PerFrameSample& sample);
+    void Reset();
+
+    // Any thread. Changes whenever the meter content does (publish or reset).
+    uint32_t Version();
+    // Columns of the current segment for player 1 or 2, oldest first, at most `max` of the newest
+    int CopyColumns(int player, uint8_t* out, int max);
+}
@@ -0,0 +1,296 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Columnar storage for macro slot recordings.
+//
+// Every per-tick column of a macro slot (macro mask, raw buffer writes, per-tick counts/indices,
+// diagnostics) is a RunColumn: a sequence of arithmetic runs (first value, step, length). Held
+// inputs collapse to step-0 runs (RLE) and the engine's buffer index, which advances by a constant
+// amount per tick, collapses to step-N runs (delta). Runs live in fixed-size chunks that are never
+// reallocated, so appending on the 64 Hz recorder path is a store into a preallocated slot and,
+// at most every kChunkRuns runs, one small allocation — no vector doubling and copying.
+//
+// A RunColumn can also be bound to external read-only storage (BindView), e.g. a macro library entry
+// in a memory-mapped file. Reads go straight to the array; the first write copies it into runs.
+//
+// Full input-buffer snapshots use SnapshotColumn: a keyframe every kKeyInterval ticks and
+// (position, value) diffs against the previous snapshot in between.
+//
+// All chunk memory is accounted in MacroColumns::LiveBytes() so the recorder can enforce budgets.
+
+namespace MacroColumns {
+    inline std::atomic<size_t>& LiveBytes() {
+        static std::atomic<size_t> bytes{0};
+        return bytes;
+    }
+}
+
+template <typename T>
+class RunColumn {
+    static_assert(std::is_integral_v<T> && sizeof(T) <= 2, "RunColumn stores 8/16-bit integral values");
+    using U = std::make_unsigned_t<T>;
+
+    struct Run {
+        uint32_t start;     // element index of the first value
+        uint16_t count;     // run length (>= 1)
+        U        first;
+        U        step;      // value(i) = first + step * (i - start), modulo 2^bits
+    };
+
+public:
+    static constexpr size_t kChunkRuns = 512;
+
+    RunColumn() = default;
+    ~RunColumn() { Release(); }
+    RunColumn(const RunColumn&) = delete;
+    RunColumn& operator=(const RunColumn&) = delete;
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t RunCount() const { return m_runs; }
+    size_t Bytes() const { return m_chunks.size() * kChunkRuns * sizeof(Run); }
+    bool IsView() const { return m_view != nullptr; }
+
+    // Read `n` values from caller-owned memory that outlives the binding (no copy)
+    void BindView(const T* values, size_t n) {
+        clear();
+        m_view = n ? values : nullptr;
+        m_size = m_view ? n : 0;
+    }
+
+    void clear() {
+        m_view = nullptr;
+        // Keep the first chunk so the next recording starts without allocating
+        if (m_chunks.size() > 1) {
+            MacroColumns::LiveBytes().fetch_sub((m_chunks.size() - 1) * kChunkRuns * sizeof(Run), std::memory_order_relaxed);
+            m_chunks.resize(1);
+        }
+        m_runs = 0; m_size = 0; m_cursor.store(0, std::memory_order_relaxed);
+    }
+
+    // Preallocate chunks for at least `runs` runs
+    void ReserveRuns(size_t runs) {
+        while (m_chunks.size() * kChunkRuns < runs) AddChunk();
+    }
+
+    void push_back(T value) {
+        if (m_view) Materialize();
+        const U v = (U)value;
+        if (m_runs) {
+            Run& r = RunAt(m_runs - 1);
+            if (r.count < 0xFFFF) {
+                if (r.count == 1) { r.step = (U)(v - r.first); r.count = 2; ++m_size; return; }
+                if (ValueIn(r, r.count) == v) { ++r.count; ++m_size; return; }
+            }
+        }
+        if (m_runs == m_chunks.size() * kChunkRuns) AddChunk();
+        Run& n = RunAt(m_runs++);
+        n.start = (uint32_t)m_size; n.count = 1; n.first = v; n.step = 0;
+        ++m_size;
+    }
+
+    T back() const {
+        if (m_view) return m_view[m_size - 1];
+        return (T)ValueIn(RunAt(m_runs - 1), RunAt(m_runs - 1).count - 1);
+    }
+
+    // Replace the last value (recorder folds late buffer writes into the current tick)
+    void SetBack(T value) {
+        if (!m_size) return;
+        if (m_view) Materialize();
+        Run& r = RunAt(m_runs - 1);
+        if (r.count == 1) { r.first = (U)value; return; }
+        if (r.count == 2) { r.step = (U)((U)value - r.first); return; }
+        --r.count; --m_size;
+        push_back(value);
+    }
+
+    T operator[](size_t i) const {
+        if (m_view) return m_view[i];
+        // Sequential readers (playback, dumps) hit the cursor run or the next one
+        size_t ri = m_cursor.load(std::memory_order_relaxed);
+        if (ri >= m_runs) ri = 0;
+        const Run* r = &RunAt(ri);
+        if (i < r->start || i >= (size_t)r->start + r->count) {
+            if (ri + 1 < m_runs && i >= RunAt(ri + 1).start && i < (size_t)RunAt(ri + 1).start + RunAt(ri + 1).count) {
+                ++ri;
+            } else {
+                size_t lo = 0, hi = m_runs;   // last run with start <= i
+                while (hi - lo > 1) {
+                    size_t mid = (lo + hi) / 2;
+                    if (RunAt(mid).start <= i) lo = mid; else hi = mid;
+                }
+                ri = lo;
+            }
+            m_cursor.store(ri, std::memory_order_relaxed);
+            r = &RunAt(ri);
+        }
+        return (T)ValueIn(*r, (uint32_t)(i - r->start));
+    }
+
+    void Assign(const std::vector<T>& values) {
+        clear();
+        for (T v : values) push_back(v);
+    }
+
+    std::vector<T> ToVector() const {
+        if (m_view) return std::vector<T>(m_view, m_view + m_size);
+        std::vector<T> out;
+        out.reserve(m_size);
+        for (size_t r = 0; r < m_runs; ++r) {
+            const Run& run = RunAt(r);
+            for (uint32_t k = 0; k < run.count; ++k) out.push_back((T)ValueIn(run, k));
+        }
+        return out;
+    }
+
+private:
+    static U ValueIn(const Run& r, uint32_t k) { return (U)(r.first + (U)(r.step * k)); }
+    Run& RunAt(size_t i) { return m_chunks[i / kChunkRuns][i % kChunkRuns]; }
+    const Run& RunAt(size_t i) const { return m_chunks[i / kChunkRuns][i % kChunkRuns]; }
+
+    void Materialize() {
+        const T* src = m_view;
+        const size_t n = m_size;
+        clear();
+        for (size_t i = 0; i < n; ++i) push_back(src[i]);
+    }
+
+    void AddChunk() {
+        m_chunks.emplace_back(new Run[kChunkRuns]);
+        MacroColumns::LiveBytes().fetch_add(kChunkRuns * sizeof(Run), std::memory_order_relaxed);
+    }
+    void Release() {
+        MacroColumns::LiveBytes().fetch_sub(Bytes(), std::memory_order_relaxed);
+        m_chunks.clear();
+        m_view = nullptr;
+        m_runs = 0; m_size = 0; m_cursor.store(0, std::memory_order_relaxed);
+    }
+
+    std::vector<std::unique_ptr<Run[]>> m_chunks;
+    size_t m_runs = 0;
+    size_t m_size = 0;
+    const T* m_view = nullptr;                 // bound external values (BindView); m_size is their count
+    mutable std::atomic<size_t> m_cursor{0};   // read hint only; GUI and frame monitor may both read
+};
+
+// Per-tick copies of a fixed-size byte ring (the engine input buffer), stored as keyframes plus
+// sparse diffs. A tick usually changes a handful of ring bytes, so a diff is a few bytes instead of
+// a full copy.
+class SnapshotColumn {
+public:
+    static constexpr size_t kKeyInterval = 64;
+    static constexpr size_t kChunkBytes = 16 * 1024;
+
+    SnapshotColumn() = default;
+    ~SnapshotColumn() { Release(); }
+    SnapshotColumn(const SnapshotColumn&) = delete;
+    SnapshotColumn& operator=(const SnapshotColumn&) = delete;
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+    size_t Bytes() const { return m_chunks.size() * kChunkBytes; }
+
+    void clear() {
+        if (m_chunks.size() > 1) {
+            MacroColumns::LiveBytes().fetch_sub((m_chunks.size() - 1) * kChunkBytes, std::memory_order_relaxed);
+            m_chunks.resize(1);
+        }
+        m_entries.clear();
+        m_used = 0;
+        m_prev.clear();
+        m_decodedIdx = (size_t)-1;
+    }
+
+    void reserve(size_t ticks) { m_entries.reserve(ticks); }
+
+    void push_back(const std::vector<uint8_t>& snap) {
+        Entry e{};
+        e.size = (uint16_t)snap.size();
+        const bool key = (m_entries.size() % kKeyInterval) == 0 || snap.size() != m_prev.size();
+        if (key) {
+            e.key = 1;
+            e.loc = Append(snap.data(), snap.size());
+            e.len = (uint16_t)snap.size();
+        } else {
+            // (u16 position, u8 value) triples for bytes that changed since the previous tick
+            m_scratch.clear();
+            for (size_t i = 0; i < snap.size(); ++i) {
+                if (snap[i] == m_prev[i]) continue;
+                m_scratch.push_back((uint8_t)(i & 0xFF));
+                m_scratch.push_back((uint8_t)(i >> 8));
+                m_scratch.push_back(snap[i]);
+            }
+            e.loc = Append(m_scratch.data(), m_scratch.size());
+            e.len = (uint16_t)m_scratch.size();
+        }
+        m_entries.push_back(e);
+        m_prev = snap;
+    }
+
+    // Rebuild snapshot i into `out`. Sequential access replays one diff.
+    bool Decode(size_t i, std::vector<uint8_t>& out) const {
+        if (i >= m_entries.size()) return false;
+        size_t from;
+        if (m_decodedIdx != (size_t)-1 && m_decodedIdx <= i && (i - m_decodedIdx) <= kKeyInterval) {
+            from = m_decodedIdx + 1;            // keyframes inside the range reset the state below
+        } else {
+            from = i;
+            while (!m_entries[from].key) --from;
+        }
+        for (size_t t = from; t <= i; ++t) {
+            const Entry& e = m_entries[t];
+            if (e.key) { m_decoded.assign(Data(e.loc), Data(e.loc) + e.len); continue; }
+            const uint8_t* d = Data(e.loc);
+            for (size_t b = 0; b + 3 <= e.len; b += 3) {
+                size_t pos = (size_t)d[b] | ((size_t)d[b + 1] << 8);
+                if (pos < m_decoded.size()) m_decoded[pos] = d[b + 2];
+            }
+        }
+        m_decodedIdx = i;
+        out = m_decoded;
+        return true;
+    }
+
+private:
+    struct Entry {
+        uint32_t loc;       // chunk * kChunkBytes + offset
+        uint16_t len;
+        uint16_t size;      // snapshot size in bytes
+        uint8_t  key;
+    };
+
+    const uint8_t* Data(uint32_t loc) const { return m_chunks[loc / kChunkBytes].get() + (loc % kChunkBytes); }
+
+    uint32_t Append(const uint8_t* p, size_t n) {
+        if (n > kChunkBytes) n = kChunkBytes;   // snapshots are a few hundred bytes; never hit in practice
+        // A full chunk gets a successor even for an empty payload: loc must point inside a chunk
+        if (m_chunks.empty() || m_used + n > kChunkBytes || m_used == kChunkBytes) {
+            m_chunks.emplace_back(new uint8_t[kChunkBytes]);
+            MacroColumns::LiveBytes().fetch_add(kChunkBytes, std::memory_order_relaxed);
+            m_used = 0;
+        }
+        uint32_t loc = (uint32_t)((m_chunks.size() - 1) * kChunkBytes + m_used);
+        if (n) memcpy(m_chunks.back().get() + m_used, p, n);
+        m_used += n;
+        return loc;
+    }
+    void Release() {
+        MacroColumns::LiveBytes().fetch_sub(m_chunks.size() * kChunkBytes, std::memory_order_relaxed);
+        m_chunks.clear();
+    }
+
+    std::vector<std::unique_ptr<uint8_t[]>> m_chunks;
+    size_t m_used = 0;
+    std::vector<Entry> m_entries;
+    std::vector<uint8_t> m_prev;
+    std::vector<uint8_t> m_scratch;
+    mutable std::vector<uint8_t> m_decoded;
+    mutable size_t m_decodedIdx = (size_t)-1;
+};
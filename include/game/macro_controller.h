@@ -84,4 +84,10 @@ std::string SerializeSlot(int slot, bool includeBuffers);
 // On failure returns false and puts a message into errorOut; slot contents are left unchanged.
 bool DeserializeSlot(int slot, const std::string& text, std::string& errorOut);
 
+// Macro library (see macro_library.h)
+// Bind a library entry to a slot: the slot reads the memory-mapped streams directly (no parsing/copy).
+bool BindLibraryEntry(int slot, size_t entryIndex);
+// Store a slot's streams (normalized to P1-facing) as a new library entry; returns the entry index or -1.
+int SaveSlotToLibrary(int slot, const std::string& name, const std::string& situation, int charId);
+
 } // namespace MacroController
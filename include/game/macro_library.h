@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// On-disk macro library (efz_macros.efzlib next to the config file).
+//
+// A versioned binary container of named macros, each tagged with a character ID and a free-form
+// situation label ("wakeup", "blockstring", ...). The file is memory-mapped read-only at startup and
+// macro streams are stored raw, so binding an entry to a slot hands the slot pointers into the view
+// (see MacroController::BindLibraryEntry) — no parsing, and the cost does not depend on library size.
+//
+// File layout: MacroLibFileHeader, then entry blobs (name, situation, per-tick macro masks, per-tick
+// buffer write counts, raw buffer writes; each section 4-byte aligned), then the index: entryCount
+// MacroLibEntry records at header.indexOffset. Appending writes the new blob and a fresh index past
+// the end of the file and only then rewrites the header, so existing data is never moved (live
+// mappings stay valid) and an interrupted append leaves the previous index in effect. The file is
+// then mapped again; the previous mapping is released once no bound slot pins it, so address space
+// stays at one mapping plus whatever slots still play from.
+// Only fixed-width little-endian fields; this header is intentionally free of <windows.h>.
+
+#define MACROLIB_MAGIC   0x4C5A4645u   // "EFZL"
+#define MACROLIB_VERSION 1u
+
+struct MacroLibFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;       // sizeof(MacroLibFileHeader)
+    uint32_t entrySize;        // sizeof(MacroLibEntry)
+    uint32_t entryCount;
+    uint32_t indexOffset;      // file offset of the index (entryCount records)
+    uint32_t reserved[2];
+};
+static_assert(sizeof(MacroLibFileHeader) == 32, "macro library header layout");
+
+struct MacroLibEntry {
+    uint32_t nameOffset;
+    uint16_t nameLength;
+    uint16_t situationLength;
+    uint32_t situationOffset;
+    int16_t  charId;           // -1 = any character
+    uint16_t flags;            // reserved (0)
+    uint32_t ticks;            // 64 Hz logic ticks
+    uint32_t macroOffset;      // ticks x uint8_t immediate mask (P1-facing)
+    uint32_t countsOffset;     // ticks x uint16_t raw buffer writes per tick
+    uint32_t bufOffset;        // bufLength x uint8_t raw buffer values (P1-facing)
+    uint32_t bufLength;
+};
+static_assert(sizeof(MacroLibEntry) == 36, "macro library entry layout");
+
+namespace MacroLibrary {
+    struct EntryInfo {
+        std::string name;
+        std::string situation;
+        int charId = -1;
+        uint32_t ticks = 0;
+        uint32_t bufLength = 0;
+    };
+
+    // Pointers into the mapped file. GetView pins the mapping they live in and ReleaseView unpins
+    // it; a mapping replaced by an Append stays mapped only while something still pins it.
+    struct EntryView {
+        const uint8_t*  macro = nullptr;
+        const uint16_t* counts = nullptr;
+        const uint8_t*  buf = nullptr;
+        uint32_t ticks = 0;
+        uint32_t bufLength = 0;
+        uint32_t mapping = 0;  // pinned mapping (0 = none)
+    };
+
+    // Map the library (once, at startup). Empty path uses the default location. A missing file is an
+    // empty library. Reopening unmaps every view, so it must not happen while slots are bound.
+    bool Open(const std::string& path = "");
+    void Close();
+    bool IsOpen();
+    std::string CurrentPath();
+
+    size_t Count();
+    bool GetInfo(size_t index, EntryInfo& out);
+    bool GetView(size_t index, EntryView& out);
+    // Unpin and reset a view from GetView (no-op for an empty view)
+    void ReleaseView(EntryView& view);
+    // First entry with this name whose character matches (charId -1 on either side matches any)
+    int Find(const std::string& name, int charId);
+
+    // Add an entry and remap. Streams are per-tick macro masks, per-tick buffer write counts and the
+    // concatenated buffer writes, all P1-facing. Returns the new entry's index, or -1 on failure.
+    int Append(const std::string& name, const std::string& situation, int charId,
+               const std::vector<uint8_t>& macro, const std::vector<uint16_t>& counts,
+               const std::vector<uint8_t>& buf);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Stream replay step shared by MacroController's playback and the offline fidelity verifier.
+//
+// A macro tick (64 Hz) carries an immediate mask and the raw buffer writes the engine produced while
+// it was recorded (macroStream / bufCountsPerTick / bufStream). BeginTick() loads one tick; Subframe()
+// then yields the poll mask for one internal frame (192 Hz), issuing ceil(remaining / subframes left)
+// of the tick's writes so they are all out by the end of the tick. An issued write's button bits
+// replace the baseline buttons for that subframe; directions always come from the immediate mask.
+//
+// VerifyStream() runs the same steps against InputBufferModel: every subframe that issues a write is
+// committed by the engine as one history entry holding that subframe's poll mask, the new entries are
+// captured the way the recorder captures them (ring[prev .. index)), and the result is diffed against
+// the recorded bufStream. Portable (no <windows.h>); tools/macro_verify drives it in batch.
+
+namespace MacroReplay {
+    constexpr int kSubframesPerTick = 3;
+
+    class TickStepper {
+    public:
+        void Reset();
+        // `writeCount` is the recorded count; the values follow through QueueWrite (the stream may hold fewer)
+        void BeginTick(uint8_t baselineMask, uint16_t writeCount);
+        void QueueWrite(uint8_t raw);
+        // Poll mask for this internal frame (frameDiv 0..2 within the 64 Hz tick)
+        uint8_t Subframe(int frameDiv, int* writesIssued = nullptr);
+
+        bool Drained() const { return m_head >= m_queue.size() && m_writesLeft == 0; }
+        uint8_t Baseline() const { return m_baseline; }
+        void SetBaseline(uint8_t mask) { m_baseline = mask; }
+
+    private:
+        std::vector<uint8_t> m_queue;
+        size_t   m_head = 0;
+        uint16_t m_writesLeft = 0;
+        uint8_t  m_baseline = 0;
+    };
+
+    struct FidelityReport {
+        uint32_t ticks = 0;
+        uint32_t expectedEntries = 0;   // recorded bufStream length
+        uint32_t producedEntries = 0;   // entries the model engine wrote during replay
+        uint32_t mismatches = 0;        // compared positions that differ
+        uint32_t directionMismatches = 0;
+        uint32_t buttonMismatches = 0;
+        int64_t  firstMismatch = -1;    // entry index, or -1
+        uint8_t  firstExpected = 0;
+        uint8_t  firstProduced = 0;
+        bool Matches() const { return mismatches == 0 && expectedEntries == producedEntries; }
+    };
+
+    // Replay `ticks` ticks (macro masks, per-tick write counts, concatenated writes; same facing as
+    // recorded) and diff the history it produces. `advancePhase` (0..2) shifts every tick that many
+    // subframes after the recorder's 64 Hz capture boundary (playback advances when the engine's index
+    // moves, which need not be on that boundary); each tick still steps its own subframes 0..2, so a
+    // shifted tick's entries are split across two capture windows.
+    FidelityReport VerifyStream(const uint8_t* macro, const uint16_t* counts, uint32_t ticks,
+                                const uint8_t* buf, uint32_t bufLength, int advancePhase = 0);
+}
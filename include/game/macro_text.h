@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// EFZMACRO 1 text codec (see SerializeSlot/DeserializeSlot in macro_controller.h for the grammar).
+//
+// Parse() is a single forward pass over a string_view: no token strings or per-tick temporaries are
+// built; each tick pack (base token, optional {k: ...} buffer group, optional xN repeat) is handed to
+// a TickSink as soon as it is complete, so callers write straight into their own storage. Errors
+// report the byte offset of the offending token.
+//
+// Writer emits the canonical form with run-length compression of identical consecutive ticks
+// (runs longer than kMaxRepeat are split), appending into one caller-owned string.
+//
+// Portable (no <windows.h>) so tools/macro_text_bench can build it on any host.
+
+namespace MacroText {
+    // Unified input mask bits (== GAME_INPUT_* in input_core.h; checked in macro_controller.cpp)
+    constexpr uint8_t kRight = 0x01;
+    constexpr uint8_t kLeft  = 0x02;
+    constexpr uint8_t kDown  = 0x04;
+    constexpr uint8_t kUp    = 0x08;
+    constexpr uint8_t kA     = 0x10;
+    constexpr uint8_t kB     = 0x20;
+    constexpr uint8_t kC     = 0x40;
+    constexpr uint8_t kD     = 0x80;
+
+    // Upper bound for one xN suffix (~4.5 hours of 64 Hz ticks); larger values are rejected
+    constexpr uint32_t kMaxRepeat = 1u << 20;
+
+    class TickSink {
+    public:
+        virtual ~TickSink() = default;
+        // `repeat` identical ticks with immediate mask `mask` and `writeCount` raw buffer writes each
+        virtual void OnTicks(uint8_t mask, const uint8_t* writes, uint16_t writeCount, uint32_t repeat) = 0;
+    };
+
+    struct ParseError {
+        size_t offset = 0;      // byte offset into the parsed text
+        std::string message;
+    };
+
+    // Parse EFZMACRO text (header optional). Returns false and fills `err` on the first error; ticks
+    // before the error have already been delivered to `sink`.
+    bool Parse(std::string_view text, TickSink& sink, ParseError& err);
+
+    // Token <-> mask helpers ("5", "2AB", "N"; numpad directions, buttons in any order/case)
+    bool TokenToMask(std::string_view tok, uint8_t& outMask);
+    void AppendMaskToken(std::string& out, uint8_t mask);
+
+    class Writer {
+    public:
+        // Appends "EFZMACRO 1" and the ticks to `out`
+        Writer(std::string& out, bool includeBuffers);
+        // Buffer writes are copied; the caller may reuse `writes` after the call
+        void Tick(uint8_t mask, const uint8_t* writes, uint16_t writeCount);
+        void Finish();
+
+    private:
+        void FlushPending();
+
+        std::string& m_out;
+        bool m_includeBuffers;
+        bool m_havePending = false;
+        uint8_t m_mask = 0;
+        uint16_t m_writeCount = 0;
+        uint32_t m_run = 0;
+        std::vector<uint8_t> m_writes;
+    };
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../core/constants.h"
+
+// Compile-time moveID property table.
+// Every moveID classification used by the 192 Hz loop (IsActionable, IsBlockstun, IsHitstun, ...)
+// is folded into one 16-bit flag word per moveID, built at compile time from Classify() below.
+// All engine-defined moveIDs that carry a property are < kTableSize; any other value (negative,
+// character-specific >= 512) has no flags, which matches the previous comparison chains.
+namespace MoveProps {
+    enum Flag : uint16_t {
+        Actionable      = 1u << 0,   // IsActionable: neutral/walk/crouch/fall/landing whitelist
+        RecoveryNeutral = 1u << 1,   // Continuous Recovery / RF freeze neutral whitelist
+        Blockstun       = 1u << 2,   // IsBlockstun (guard IDs + 140..165 minus dashes)
+        BlockstunState  = 1u << 3,   // IsBlockstunState (leveled block IDs + air guard)
+        RecoilGuard     = 1u << 4,
+        Dash            = 1u << 5,   // IsDashState (start/recovery, not the sentinel)
+        Hitstun         = 1u << 6,
+        Launched        = 1u << 7,
+        Airtech         = 1u << 8,
+        Groundtech      = 1u << 9,
+        Frozen          = 1u << 10,
+        SpecialStun     = 1u << 11,  // fire / electric / frozen
+        Thrown          = 1u << 12,
+        Attack          = 1u << 13,  // IsAttackMove: 200..350, 400..500
+        AirtechableMove = 1u << 14,  // launched or fire/electric (IsPlayerAirtechable minus untech)
+        Prohibited      = 1u << 15,  // explicitly inactionable group (vs. merely unknown)
+    };
+
+    constexpr size_t kTableSize = 512;
+
+    constexpr bool InRange(int id, int lo, int hi) { return id >= lo && id <= hi; }
+
+    // Reference classification. Single source of truth for the table; keep in sync with constants.h.
+    constexpr uint16_t Classify(int id) {
+        uint16_t f = 0;
+
+        const bool actionable = id == IDLE_MOVE_ID || id == WALK_FWD_ID || id == WALK_BACK_ID ||
+                                id == CROUCH_ID || id == CROUCH_TO_STAND_ID || id == FALLING_ID ||
+                                id == LANDING_ID || id == LANDING_1_ID || id == LANDING_2_ID || id == LANDING_3_ID;
+        if (actionable) f |= Actionable;
+        if (id == 0 || id == 1 || id == 2 || id == 3 || id == 4 || id == 7 || id == 8 || id == 9 || id == 13)
+            f |= RecoveryNeutral;
+
+        const bool dashAny = id == FORWARD_DASH_START_ID || id == FORWARD_DASH_RECOVERY_ID ||
+                             id == BACKWARD_DASH_START_ID || id == BACKWARD_DASH_RECOVERY_ID ||
+                             id == FORWARD_DASH_RECOVERY_SENTINEL_ID;
+        if (id == FORWARD_DASH_START_ID || id == FORWARD_DASH_RECOVERY_ID ||
+            id == BACKWARD_DASH_START_ID || id == BACKWARD_DASH_RECOVERY_ID)
+            f |= Dash;
+
+        if (id == STAND_GUARD_ID || id == CROUCH_GUARD_ID || id == CROUCH_GUARD_STUN1 ||
+            id == CROUCH_GUARD_STUN2 || id == AIR_GUARD_ID ||
+            ((id == 150 || id == 152 || InRange(id, 140, 149) || InRange(id, 153, 165)) && !dashAny))
+            f |= Blockstun;
+        if (id == STANDING_BLOCK_LVL1 || id == STANDING_BLOCK_LVL2 || id == STANDING_BLOCK_LVL3 ||
+            id == CROUCHING_BLOCK_LVL1 || id == CROUCHING_BLOCK_LVL2_A || id == CROUCHING_BLOCK_LVL2_B ||
+            id == AIR_GUARD_ID)
+            f |= BlockstunState;
+        if (id == RG_STAND_ID || id == RG_CROUCH_ID || id == RG_AIR_ID) f |= RecoilGuard;
+
+        if (InRange(id, STAND_HITSTUN_START, STAND_HITSTUN_END) || InRange(id, CROUCH_HITSTUN_START, CROUCH_HITSTUN_END) ||
+            id == SWEEP_HITSTUN || id == 69 /* Ikumi 623 hit state */)
+            f |= Hitstun;
+        if (InRange(id, LAUNCHED_HITSTUN_START, LAUNCHED_HITSTUN_END)) f |= Launched;
+        if (id == FORWARD_AIRTECH || id == BACKWARD_AIRTECH) f |= Airtech;
+        if (id == GROUNDTECH_PRE || id == GROUNDTECH_START || id == GROUNDTECH_END || id == GROUNDTECH_RECOVERY)
+            f |= Groundtech;
+        if (InRange(id, FROZEN_STATE_START, FROZEN_STATE_END)) f |= Frozen;
+        if (id == FIRE_STATE || id == ELECTRIC_STATE || InRange(id, FROZEN_STATE_START, FROZEN_STATE_END))
+            f |= SpecialStun;
+        if (InRange(id, THROWN_STATE_START, THROWN_STATE_END) || InRange(id, THROWN2_STATE_START, THROWN2_STATE_END) ||
+            InRange(id, THROWN3_STATE_START, THROWN3_STATE_END) || InRange(id, THROWN4_STATE_START, THROWN4_STATE_END) ||
+            InRange(id, THROWN5_STATE_START, THROWN5_STATE_END))
+            f |= Thrown;
+        if (InRange(id, 200, 350) || InRange(id, 400, 500)) f |= Attack;
+        if (InRange(id, LAUNCHED_HITSTUN_START, LAUNCHED_HITSTUN_END) || id == FIRE_STATE || id == ELECTRIC_STATE)
+            f |= AirtechableMove;
+
+        // IsActionable's explicit inactionable groups (only meaningful when not already actionable)
+        const bool prohibited = (f & (Attack | BlockstunState | Hitstun | Launched | Thrown | Airtech |
+                                      Groundtech | Frozen | RecoilGuard)) != 0 ||
+                                dashAny || id == GROUND_IC_ID || id == AIR_IC_ID ||
+                                id == STAND_GUARD_ID || id == CROUCH_GUARD_ID || id == AIR_GUARD_ID;
+        if (prohibited && !actionable) f |= Prohibited;
+        return f;
+    }
+
+    struct Table { uint16_t flags[kTableSize]; };
+
+    constexpr Table BuildTable() {
+        Table t{};
+        for (size_t i = 0; i < kTableSize; ++i) t.flags[i] = Classify(static_cast<int>(i));
+        return t;
+    }
+
+    inline constexpr Table kTable = BuildTable();
+
+    // All flags for a moveID in one lookup
+    constexpr uint16_t Get(short moveID) {
+        return (moveID >= 0 && static_cast<size_t>(moveID) < kTableSize) ? kTable.flags[moveID] : 0;
+    }
+    constexpr bool Has(short moveID, uint16_t mask) { return (Get(moveID) & mask) != 0; }
+
+    // Spot checks against the old comparison chains
+    static_assert(Has(IDLE_MOVE_ID, Actionable) && Has(LANDING_3_ID, Actionable) && !Has(4, Actionable), "actionable");
+    static_assert(Has(4, RecoveryNeutral) && !Has(10, RecoveryNeutral), "recovery neutral");
+    static_assert(Has(140, Blockstun) && Has(162, Blockstun) && !Has(FORWARD_DASH_START_ID, Blockstun) &&
+                  !Has(BACKWARD_DASH_RECOVERY_ID, Blockstun) && !Has(166, Blockstun) && Has(AIR_GUARD_ID, Blockstun), "blockstun");
+    static_assert(Has(FORWARD_DASH_START_ID, Dash) && !Has(FORWARD_DASH_RECOVERY_SENTINEL_ID, Dash), "dash");
+    static_assert(Has(SWEEP_HITSTUN, Hitstun | Launched) && Has(69, Hitstun) && !Has(59, Hitstun), "hitstun");
+    static_assert(Has(200, Attack) && !Has(351, Attack) && Has(500, Attack) && !Has(501, Attack), "attack");
+    static_assert(Has(GROUND_IC_ID, Prohibited) && Has(FORWARD_DASH_RECOVERY_SENTINEL_ID, Prohibited) &&
+                  !Has(IDLE_MOVE_ID, Prohibited) && !Has(501, Prohibited), "prohibited");
+    static_assert(Get(-1) == 0 && Get(511) == 0, "out of range");
+}
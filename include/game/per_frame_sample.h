@@ -1,13 +1,68 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
 #include <windows.h>
 #include "../utils/config.h" // for settings snapshot if needed later
 #include "game_state.h" // GamePhase / GameMode enums
 
+// Bulk per-tick copies of engine memory.
+// FrameDataMonitor copies each player struct prefix and the game-state control block with ONE
+// guarded read per region at the top of the tick; consumers then decode typed fields from the copy
+// instead of issuing their own SafeReadMemory per field. Only fields inside these windows may be
+// read through the snapshot; anything beyond (character-specific 0x31xx slots, anim tables, ...)
+// still needs a direct read.
+//
+// Player window [0x000, 0x270) covers: move/frame ids (0x08/0x0A), position/velocity (0x20..0x3F),
+// facing (0x50), name (0x94), AI flag (0xA4), HP/RF/IC/untech (0x108..0x127), meter/blockstun
+// (0x148/0x14A), anim table ptr (0x164), raw inputs (0x188..0x18D), command latches (0x1A8..0x1AA),
+// the circular input buffer (0x1AB..0x25E), its index (0x260) and the motion token (0x262).
+#define PLAYER_SNAPSHOT_BYTES 0x270
+// Game-state window [4928, 4968): active player (4930), CPU flags (4931/4932), practice block mode
+// (4934), practice auto-block dword (4936) and the game mode byte (GAME_MODE_OFFSET = 0x1364).
+#define GAMESTATE_SNAPSHOT_BEGIN 4928
+#define GAMESTATE_SNAPSHOT_BYTES 40
+
+struct PlayerSnapshot {
+    bool      valid;                        // true when the bulk read succeeded this tick
+    uintptr_t base;                         // player struct address the copy was taken from
+    uint8_t   raw[PLAYER_SNAPSHOT_BYTES];
+
+    // Typed field access by player-struct offset (same offsets as constants.h).
+    // Returns a zero value when the snapshot is invalid or the field lies outside the window.
+    template <typename T>
+    T Get(size_t offset) const {
+        T v{};
+        if (valid && offset + sizeof(T) <= sizeof(raw)) memcpy(&v, raw + offset, sizeof(T));
+        return v;
+    }
+    template <typename T>
+    bool TryGet(size_t offset, T& out) const {
+        if (!valid || offset + sizeof(T) > sizeof(raw)) return false;
+        memcpy(&out, raw + offset, sizeof(T));
+        return true;
+    }
+};
+
+struct GameStateSnapshot {
+    bool      valid;
+    uintptr_t base;                         // game state struct address
+    uint8_t   raw[GAMESTATE_SNAPSHOT_BYTES];
+
+    // Offsets are absolute game-state offsets (e.g. GAMESTATE_OFF_ACTIVE_PLAYER), not window-relative.
+    template <typename T>
+    bool TryGet(size_t gsOffset, T& out) const {
+        if (!valid || gsOffset < GAMESTATE_SNAPSHOT_BEGIN) return false;
+        size_t rel = gsOffset - GAMESTATE_SNAPSHOT_BEGIN;
+        if (rel + sizeof(T) > sizeof(raw)) return false;
+        memcpy(&out, raw + rel, sizeof(T));
+        return true;
+    }
+};
+
 // Unified 192Hz sampling context populated once per FrameDataMonitor loop.
-// Initial version is read-only and non-invasive: subsystems keep existing APIs.
-// Later we can pass this by const reference to avoid duplicated memory reads.
+// Subsystems read typed fields from the bulk copies below instead of touching game memory.
 struct PerFrameSample {
     uint32_t        frame;            // Global internal frame counter (192Hz)
     unsigned long long tickMs;        // GetTickCount64 at sample time
@@ -29,7 +84,26 @@ struct PerFrameSample {
     uintptr_t       p1Ptr;
     uintptr_t       p2Ptr;
     bool            online;           // Netplay/spectating/tournament active
+    // Bulk copies taken at the top of the tick (see PLAYER_SNAPSHOT_BYTES)
+    PlayerSnapshot    p1;
+    PlayerSnapshot    p2;
+    GameStateSnapshot gs;
+    // Memory cost of the snapshot stage this tick (constant while both players exist)
+    uint16_t        snapshotReads;    // guarded bulk reads issued
+    uint16_t        snapshotBytes;    // bytes copied
+
+    const PlayerSnapshot& Player(int playerNum) const { return (playerNum == 2) ? p2 : p1; }
 };
 
 // Accessor for current sample (lifetime owned by frame_monitor.cpp)
 const PerFrameSample& GetCurrentPerFrameSample();
+
+// Read a player-struct field from this tick's snapshot. Served from the copy only on the frame
+// monitor thread, when playerBase matches a captured side and the field lies inside the window;
+// otherwise falls back to a guarded SafeReadMemory. Writes made later in the same tick are NOT
+// visible through the snapshot, so read-modify-write sequences should read memory directly.
+bool ReadSampledPlayerField(uintptr_t playerBase, uintptr_t offset, void* out, size_t size);
+template <typename T>
+inline bool ReadSampledPlayerField(uintptr_t playerBase, uintptr_t offset, T& out) {
+    return ReadSampledPlayerField(playerBase, offset, &out, sizeof(T));
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Always-on per-subsystem cost histograms for the 192 Hz frame monitor loop.
+//
+// Each subsystem call in FrameDataMonitor is wrapped in a TickProfiler::Scope. Durations go into a
+// log-linear histogram per section (8 sub-buckets per power of two, ~12% resolution from 8 ns up to
+// ~130 ms), so p50/p99/max are available without storing samples. Only the frame monitor thread
+// records; the GUI reads the counters live and a reset is applied at the next tick boundary.
+
+enum class TickSection : uint8_t {
+    Snapshot,           // RefreshPointerCache + CaptureSnapshotRegions
+    Framestep,          // Framestep::Update + overlay status
+    MacroTick,          // MacroController::Tick
+    MotionRecognizer,   // MotionRecognizer::Update
+    FrameAdvantage,     // MonitorFrameAdvantage
+    DummyAutoBlock,     // MonitorDummyAutoBlock
+    AutoActions,        // ProcessTriggerDelays + MonitorAutoActions
+    AutoAirtech,        // MonitorAutoAirtech
+    CharEnforcement,    // CharacterSettings::TickCharacterEnforcements
+    RFFreeze,           // UpdateRFFreezeTick
+    Tick,               // whole tick body (frame start until the pacing sleep)
+    Count
+};
+
+namespace TickProfiler {
+    constexpr int kSubBucketBits = 3;
+    constexpr int kSubBuckets = 1 << kSubBucketBits;
+    constexpr int kBuckets = 26 * kSubBuckets;      // top bucket covers up to ~2^27 ns
+    constexpr double kBudgetUs = 1000000.0 / 192.0; // one internal frame (~5.2 ms)
+
+    struct SectionStats {
+        uint64_t count = 0;
+        double   meanUs = 0.0;
+        double   p50Us = 0.0;
+        double   p99Us = 0.0;
+        double   maxUs = 0.0;
+        uint64_t overBudget = 0;    // samples longer than one internal frame
+    };
+
+    const char* SectionName(TickSection s);
+
+    // Frame monitor thread only
+    void Record(TickSection s, uint64_t ns);
+    // Called once per tick by the frame monitor; applies pending resets
+    void EndTick();
+
+    // Any thread
+    SectionStats GetStats(TickSection s);
+    void RequestReset();
+    // Write one row per section (name,count,mean,p50,p99,max,over_budget) plus the raw buckets.
+    // Empty path writes efz_tick_profile.csv next to the config file.
+    bool ExportCsv(const std::string& path, std::string* writtenPath = nullptr);
+
+    class Scope {
+    public:
+        explicit Scope(TickSection s) : m_section(s), m_start(std::chrono::steady_clock::now()) {}
+        ~Scope() {
+            Record(m_section, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_start).count());
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        TickSection m_section;
+        std::chrono::steady_clock::time_point m_start;
+    };
+}
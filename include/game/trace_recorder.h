@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Binary per-tick trace.
+// While enabled (Debug tab), FrameDataMonitor appends one fixed-size TraceRecord per 192 Hz tick:
+// the PerFrameSample essentials and its bulk player/game-state windows, the published FrameSnapshot,
+// the injected input masks of both sides and the overlay messages raised that tick. Records go into
+// a ring inside a memory-mapped file, so a session costs no allocations and no per-tick syscalls;
+// once the ring is full the oldest ticks are overwritten.
+//
+// File layout: TraceFileHeader, then `capacity` TraceRecord slots. Record N lives in slot
+// N % capacity; header.written is the number of records ever written (valid records are the last
+// min(written, capacity)). Only fixed-width fields, so the format reads the same on any host.
+// This header is intentionally free of <windows.h> (trace tools include it).
+
+#define TRACE_MAGIC            0x545A4645u   // "EFZT"
+#define TRACE_VERSION          1u
+#define TRACE_PLAYER_BYTES     0x270         // == PLAYER_SNAPSHOT_BYTES
+#define TRACE_GAMESTATE_BYTES  40            // == GAMESTATE_SNAPSHOT_BYTES
+#define TRACE_OVERLAY_EVENTS   2             // overlay messages stored per tick (count keeps the total)
+#define TRACE_OVERLAY_TEXT     46
+
+enum TraceRecordFlags : uint16_t {
+    TRACE_F_CHARS_INIT      = 1u << 0,
+    TRACE_F_ONLINE          = 1u << 1,
+    TRACE_F_P1_VALID        = 1u << 2,   // p1Raw holds this tick's bulk copy
+    TRACE_F_P2_VALID        = 1u << 3,
+    TRACE_F_GS_VALID        = 1u << 4,
+    TRACE_F_ACTIONABLE1     = 1u << 5,
+    TRACE_F_ACTIONABLE2     = 1u << 6,
+    TRACE_F_NEUTRAL1        = 1u << 7,
+    TRACE_F_NEUTRAL2        = 1u << 8,
+    TRACE_F_P2_BLOCK_EDGE   = 1u << 9,
+    TRACE_F_P2_HITSTUN_EDGE = 1u << 10,
+};
+
+struct TraceFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;       // sizeof(TraceFileHeader)
+    uint32_t recordSize;       // sizeof(TraceRecord)
+    uint32_t capacity;         // record slots in the ring
+    uint32_t tickHz;           // 192
+    uint64_t written;          // records written so far
+    uint64_t startTickMs;      // GetTickCount64 when recording started
+    uint8_t  reserved[24];
+};
+static_assert(sizeof(TraceFileHeader) == 64, "trace header layout");
+
+// Injection state of one side at the end of the tick
+struct TraceInputState {
+    uint8_t manualOverride;    // g_manualInputOverride
+    uint8_t manualMask;        // g_manualInputMask
+    uint8_t pollOverride;      // g_pollOverrideActive (input hook poll override)
+    uint8_t pollMask;          // g_pollOverrideMask
+    uint8_t immediateMask;     // ImmediateInput desired mask
+    uint8_t immediateOnly;     // g_injectImmediateOnly
+    uint8_t reserved[2];
+};
+
+struct TraceOverlayEvent {
+    uint16_t categoryHash;     // FNV-1a of the category, folded to 16 bits (0 = none)
+    char     text[TRACE_OVERLAY_TEXT]; // truncated, NUL-terminated
+};
+
+struct TraceRecord {
+    uint64_t seq;              // record number (slot = seq % capacity)
+    uint64_t tickMs;
+    uint32_t frame;            // internal 192 Hz frame counter
+    uint16_t flags;            // TraceRecordFlags
+    uint8_t  phase;            // GamePhase
+    uint8_t  mode;             // GameMode
+    int16_t  moveID1, moveID2;
+    int16_t  prevMoveID1, prevMoveID2;
+    // FrameSnapshot
+    double   p1X, p2X, p1Y, p2Y;
+    double   p1RF, p2RF;
+    int32_t  p1Hp, p2Hp;
+    int32_t  p1Meter, p2Meter;
+    int32_t  p1CharId, p2CharId;
+    TraceInputState input[2]; // [0]=P1, [1]=P2
+    uint8_t  overlayCount;     // overlay messages raised this tick (may exceed TRACE_OVERLAY_EVENTS)
+    uint8_t  reserved[7];
+    TraceOverlayEvent overlay[TRACE_OVERLAY_EVENTS];
+    // PerFrameSample bulk windows (see per_frame_sample.h)
+    uint8_t  p1Raw[TRACE_PLAYER_BYTES];
+    uint8_t  p2Raw[TRACE_PLAYER_BYTES];
+    uint8_t  gsRaw[TRACE_GAMESTATE_BYTES];
+};
+static_assert(sizeof(TraceRecord) == 1512, "trace record layout");
+
+struct PerFrameSample;
+struct FrameSnapshot;
+
+namespace TraceRecorder {
+    // ~85 s at 192 Hz, ~25 MB
+    constexpr uint32_t kDefaultCapacity = 192 * 85;
+
+    // Create/overwrite the trace file and map it. Empty path = efz_trace.bin next to the config file.
+    bool Start(const std::string& path = std::string(), uint32_t capacity = kDefaultCapacity);
+    // Flush and unmap. Safe to call when not recording.
+    void Stop();
+    bool IsRecording();
+    uint64_t RecordedTicks();
+    std::string CurrentPath();
+
+    // Append the current tick (frame monitor thread, after the snapshot is published)
+    void RecordTick(const PerFrameSample& sample, const FrameSnapshot& snap);
+    // Overlay message hook (any thread). No-op unless recording.
+    void NoteOverlayEvent(const std::string& text, const std::string& category);
+}
@@ -19,11 +19,11 @@ namespace ImGuiGui {
         int currentTab;
         int requestedTab; 
         // Sub-tab indices for tab bars within top-level tabs
-        int mainMenuSubTab;   // 0=Opponent, 1=Values, 2=Options
+        int mainMenuSubTab;   // 0=Opponent, 1=Values, 2=Options, 3=Stats
         int autoActionSubTab; // 0=Triggers, 1=Macros
         int helpSubTab;       // 0..N-1 across Help tabs
         // One-shot programmatic selection requests for sub-tabs
-        int requestedMainMenuSubTab;   // -1 or 0..2
+        int requestedMainMenuSubTab;   // -1 or 0..3
         int requestedAutoActionSubTab; // -1 or 0..1
         int requestedHelpSubTab;       // -1 or 0..5
         DisplayData localData;
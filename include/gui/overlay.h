@@ -20,18 +20,6 @@ typedef HRESULT(WINAPI* FlipFunc)(IDirectDrawSurface7*, IDirectDrawSurface7*, DW
 #define DDRAW_BLIT_OFFSET 4
 #define DDRAW_FLIP_OFFSET 11
 
-// Structure to represent a text message in the overlay
-struct OverlayMessage {
-    std::string text;
-    COLORREF color;
-    std::chrono::steady_clock::time_point expireTime;
-    int xPos;
-    int yPos;
-    bool isPermanent;  // If true, stays until explicitly removed
-    int id;            // Unique ID for permanent messages
-    std::string category; // NEW: Category for grouping messages
-};
-
 class DirectDrawHook {
 private:
     // Original DirectDraw functions
@@ -44,10 +32,7 @@ private:
     // Hook state
     static IDirectDrawSurface7* primarySurface;
     static HWND gameWindow;
-    static std::mutex messagesMutex;
-    static std::deque<OverlayMessage> messages;
-    static std::vector<OverlayMessage> permanentMessages;
-    static int nextMessageId;
+    // Message text, positions and categories live in OverlayMessages (fixed slots, lock-free reads)
     
     // Hook functions
     static HRESULT WINAPI HookedDirectDrawCreate(GUID* lpGUID, LPVOID* lplpDD, IUnknown* pUnkOuter);
@@ -133,4 +118,8 @@ extern int g_FramestepStatusId;
 // Debug overlay borders toggle (controlled from ImGui)
 extern std::atomic<bool> g_ShowOverlayDebugBorders;
 // Gate RG debug toasts via ImGui Debug tab
-extern std::atomic<bool> g_ShowRGDebugToasts;
\ No newline at end of file
+extern std::atomic<bool> g_ShowRGDebugToasts;
+// Run-length input history of both players drawn over the game (InputHistory, Debug tab toggle)
+extern std::atomic<bool> g_ShowInputHistoryOverlay;
+// Per-visual-frame state bar of both players drawn over the game (FrameMeter, Options tab toggle)
+extern std::atomic<bool> g_ShowFrameMeterOverlay;
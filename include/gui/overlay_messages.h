@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity store behind DirectDrawHook's overlay messages.
+//
+// Every message lives in one of kSlots preallocated slots (temporary and permanent slots are separate
+// pools) with its text copied into an inline buffer, so adding or updating a message never allocates.
+// Categories are interned once into small ids; replacing or removing "all messages of a category" is
+// an integer compare per slot.
+//
+// Writers (frame monitor, GUI, input threads) are serialised among themselves by a mutex that only
+// writers take. Each slot is published through its own sequence counter (odd while written) and the
+// payload sits in relaxed atomics, so a render thread copies slots without ever waiting on a writer:
+// a slot caught mid-write is retried a few times and otherwise left out of that frame's snapshot
+// (the snapshot reports itself incomplete so the caller does not cache it).
+//
+// Times are steady-clock milliseconds (NowMs).
+
+namespace OverlayMessages {
+    constexpr int kTempSlots = 32;
+    constexpr int kPermanentSlots = 32;
+    constexpr int kSlots = kTempSlots + kPermanentSlots;
+    constexpr int kTextBytes = 192;             // including the terminator; longer text is truncated
+    constexpr int kMaxCategories = 32;
+    constexpr uint16_t kNoCategory = 0;
+
+    struct Message {
+        int      id;            // permanent message id, -1 for temporary messages
+        uint16_t category;
+        bool     permanent;
+        uint32_t color;         // COLORREF
+        int      x;
+        int      y;
+        uint64_t expireMs;      // temporary messages only
+        uint32_t order;         // insertion order (updates keep it)
+        char     text[kTextBytes];
+    };
+
+    uint64_t NowMs();
+
+    // Writers, any thread
+    // Interned id of a category name; kNoCategory for "" or when the table is full
+    uint16_t Category(const char* name, size_t len);
+    // Replaces the temporary message of the same category (none for kNoCategory); evicts the message
+    // closest to expiry when all temporary slots are live
+    void AddTemporary(const char* text, size_t len, uint16_t category, uint32_t color, uint64_t expireMs, int x, int y);
+    // Returns -1 when every permanent slot is taken
+    int  AddPermanent(const char* text, size_t len, uint32_t color, int x, int y);
+    // False (and no write) when the id is unknown or text and color are unchanged
+    bool UpdatePermanent(int id, const char* text, size_t len, uint32_t color);
+    void RemovePermanent(int id);
+    void RemoveCategory(uint16_t category);
+    void Clear();
+
+    // Readers, any thread
+    // Changes with every write; a cached snapshot stays valid while it is unchanged (and nothing expired)
+    uint32_t Version();
+    // Messages live at nowMs: permanent first, then temporary, each in insertion order
+    int Snapshot(Message* out, int max, uint64_t nowMs, bool* complete = nullptr);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+
+// Compiled hotkey bindings, evaluated once per rendered frame (PollHotkeysOncePerFrame in
+// input_handler.cpp, called from HookedEndScene after the XInputShim snapshot refresh).
+//
+// A Snapshot is the down state of every watched virtual key as a 256-bit set plus one button word
+// per XInput pad (wButtons, with the triggers folded in as the config's LT/RT pseudo bits). Edges are
+// cur & ~prev over those words; the first binding in table order whose key or pad bit went down
+// wins, so at most one action fires per frame. Nothing here touches Win32: a test or tool can fill
+// Snapshots from any key source and drive Evaluate directly.
+
+namespace HotkeyDispatch {
+    enum class Action : uint8_t {
+        None = 0,
+        ToggleMenu,
+        ToggleImGui,
+        Teleport,           // load saved positions; held direction/D picks a preset or swap
+        SavePosition,
+        SwapPositions,
+        SwitchPlayers,
+        MacroRecord,
+        MacroPlay,
+        MacroSlot,
+        ToggleStats,
+        ResetFrameCounter,
+        FramestepPause,
+        FramestepStep,
+        Help,
+        AutoJump,
+        Count
+    };
+
+    constexpr int kMaxPads = 4;
+    constexpr int kMaxBindings = 48;
+    // Trigger pseudo-masks used by the config parser for gamepad bindings
+    constexpr uint32_t kPadLeftTrigger = 0x10000;
+    constexpr uint32_t kPadRightTrigger = 0x20000;
+    constexpr uint8_t kTriggerThreshold = 50;
+
+    struct KeySet {
+        uint64_t bits[4] = {};
+        void Set(int vk) { if (vk > 0 && vk < 256) bits[vk >> 6] |= (1ull << (vk & 63)); }
+        bool Test(int vk) const { return vk > 0 && vk < 256 && (bits[vk >> 6] >> (vk & 63)) & 1ull; }
+        bool Any() const { return (bits[0] | bits[1] | bits[2] | bits[3]) != 0; }
+    };
+
+    struct Snapshot {
+        KeySet keys;                    // watched keys currently down
+        uint32_t pads[kMaxPads] = {};   // PadBits() per connected pad, 0 otherwise
+    };
+
+    // wButtons plus kPadLeftTrigger / kPadRightTrigger when a trigger is past kTriggerThreshold
+    inline uint32_t PadBits(uint16_t buttons, uint8_t leftTrigger, uint8_t rightTrigger) {
+        return buttons | (leftTrigger >= kTriggerThreshold ? kPadLeftTrigger : 0u)
+                       | (rightTrigger >= kTriggerThreshold ? kPadRightTrigger : 0u);
+    }
+
+    struct Hit {
+        Action action = Action::None;
+        int pad = -1;                   // pad index for a gamepad binding, -1 for the keyboard
+    };
+
+    class Table {
+    public:
+        void Clear();
+        // Bindings are evaluated in the order they were added. vk <= 0 / padMask <= 0 leave that
+        // half unbound; a binding with neither is dropped.
+        bool Bind(Action action, int vk, int padMask);
+        // Track a key that no binding uses (chord modifiers read from the current Snapshot)
+        void Watch(int vk) { m_watched.Set(vk); }
+
+        // Keys a key source has to sample for this table
+        const KeySet& WatchedKeys() const { return m_watched; }
+        int Size() const { return m_count; }
+
+        // First binding with a key or pad edge between prev and cur; pads outside padFilter
+        // (bit i = pad i) are ignored
+        Hit Evaluate(const Snapshot& prev, const Snapshot& cur, unsigned padFilter) const;
+
+    private:
+        struct Binding {
+            Action action;
+            uint8_t vk;
+            uint32_t padMask;
+        };
+        Binding m_bindings[kMaxBindings] = {};
+        int m_count = 0;
+        KeySet m_watched;
+    };
+
+    const char* ActionName(Action action);
+}
@@ -4,7 +4,7 @@
 #include <cstdint>
 
 // Centralized immediate-register input writer.
-// Runs at visual framerate (64 fps), writing only the immediate registers
+// Runs at visual framerate (64 fps) as a TaskScheduler task, writing only the immediate registers
 // (no buffer writes). Provides clean edges by inserting a neutral frame when
 // changing or re-asserting a non-zero mask.
 
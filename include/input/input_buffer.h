@@ -13,7 +13,6 @@ extern const uintptr_t INPUT_BUFFER_INDEX_OFFSET;
 // Buffer freezing globals
 extern std::atomic<bool> g_bufferFreezingActive;
 extern std::atomic<bool> g_indexFreezingActive;
-extern std::thread g_bufferFreezeThread;
 extern std::vector<uint8_t> g_frozenBufferValues;
 extern uint16_t g_frozenBufferStartIndex;
 extern uint16_t g_frozenBufferLength;
@@ -23,7 +22,10 @@ extern std::atomic<int> g_activeFreezePlayer;
 
 // Buffer freezing functions
 //bool FreezeBufferForMotion(int playerNum, int motionType, int buttonMask, int optimalIndex);
-void FreezeBufferValuesThread(int playerNum);
+// Start applying the g_frozen* image (and index lock, if enabled) for playerNum; callers fill those first
+void ArmBufferFreeze(int playerNum);
+// Called by HookedProcessCharacterInput for the freeze owner right before the engine reads its ring
+void ApplyBufferFreezeTick(int playerNum, uintptr_t characterPtr);
 bool CaptureAndFreezeBuffer(int playerNum, uint16_t startIndex, uint16_t length, int motionType = -1, int buttonMask = 0);
 bool FreezeBufferIndex(int playerNum, uint16_t indexValue);
 void StopBufferFreezing();
\ No newline at end of file
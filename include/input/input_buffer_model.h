@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Portable model of a character's engine input history: the 180-entry circular buffer at
+// INPUT_BUFFER_OFFSET and the 16-bit write index at INPUT_BUFFER_INDEX_OFFSET.
+//
+// The engine stores an entry at ring[index] and then advances index modulo the ring size, so
+// ring[index - 1] is the newest entry and the entries written since an earlier index `prev` are
+// ring[prev .. index) with wraparound; MacroController's recorder captures bufStream in that order.
+// input_buffer.cpp defines INPUT_BUFFER_* from the constants below. No <windows.h>, so the model
+// also builds on any host (tools/macro_verify).
+
+namespace InputBufferModel {
+    constexpr uint16_t  kRingSize    = 180;    // 0xB4 entries
+    constexpr uintptr_t kRingOffset  = 0x1AB;  // ring start in the player struct
+    constexpr uintptr_t kIndexOffset = 0x260;  // uint16_t write index in the player struct
+
+    class Ring {
+    public:
+        Ring() { Reset(0); }
+        // Neutral ring with the write index at `index`
+        void Reset(uint16_t index);
+        // Copy a live snapshot (kRingSize bytes) and its index
+        void Load(const uint8_t* ring, uint16_t index);
+
+        // One engine history write: ring[index] = mask, index advances
+        void Push(uint8_t mask);
+        uint8_t Latest() const;
+        uint8_t At(uint16_t pos) const { return m_ring[pos % kRingSize]; }
+        uint16_t Index() const { return m_index; }
+        const uint8_t* Data() const { return m_ring; }
+
+        // Append the entries written since `prevIndex`, oldest first; returns how many
+        size_t CollectSince(uint16_t prevIndex, std::vector<uint8_t>& out) const;
+
+    private:
+        uint8_t  m_ring[kRingSize];
+        uint16_t m_index = 0;
+    };
+}
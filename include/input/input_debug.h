@@ -7,7 +7,6 @@
 // Debug functions
 void DiagnoseInputSystem(int playerNum);
 void DumpInputBuffer(int playerNum);
-std::string GetInputBufferVisualization(int playerNum, int window); // Removed default parameter
 void LogNextBufferValue(int playerNum);
 void LogButtonPress(const char* buttonName, uintptr_t address, uint8_t value, const char* result);
 
@@ -20,7 +20,6 @@
 // Global buffer freezing variables
 extern std::atomic<bool> g_bufferFreezingActive;
 extern std::atomic<bool> g_indexFreezingActive;
-extern std::thread g_bufferFreezeThread;
 extern std::vector<uint8_t> g_frozenBufferValues;
 extern uint16_t g_frozenBufferStartIndex;
 extern uint16_t g_frozenBufferLength;
@@ -37,7 +36,7 @@ inline uint8_t u8(int value) {
 }
 
 // Core buffer freezing functions
-void FreezeBufferValuesThread(int playerNum);
+void ArmBufferFreeze(int playerNum);
 //bool CaptureAndFreezeBuffer(int playerNum, uint16_t startIndex, uint16_t length); // Moved to input_buffer.h
 bool FreezeBufferIndex(int playerNum, uint16_t indexValue);
 void StopBufferFreezing();
@@ -68,9 +67,6 @@ bool FreezeBufferWithPattern(int playerNum, const std::vector<uint8_t>& pattern)
 // last non-neutral input; extraNeutralFrames worth of neutral (0) bytes are implicitly assumed.)
 bool FreezeBufferWithPattern(int playerNum, const std::vector<uint8_t>& pattern, int extraNeutralFrames);
 
-// Buffer visualization function
-std::string GetInputBufferVisualization(int playerNum, int window);
-
 // Session lifecycle helpers
 void BeginBufferFreezeSession(int playerNum, std::string_view label);
 void EndBufferFreezeSession(int playerNum, const char* reason, bool clearGlobals = true);
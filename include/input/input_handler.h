@@ -31,8 +31,9 @@ extern bool g_directInputReadOnly;
 static std::atomic<bool> globalF1ThreadRunning{true};
 
 // Function declarations
-void MonitorKeys();
 void RestartKeyMonitoring();
+// Render thread, once per frame after XInputShim::RefreshSnapshotOncePerFrame()
+void PollHotkeysOncePerFrame();
 bool InitDirectInput(HINSTANCE hInstance);
 void CleanupDirectInput();
 bool ReadDirectInputKeyboardState(BYTE* keyboardState);
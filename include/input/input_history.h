@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+// Per-tick input history of both players, published by the frame monitor and read by the GUI.
+//
+// Each 192 Hz tick FrameDataMonitor publishes the newest entry of each player's engine input buffer
+// (from the PerFrameSample bulk copy, so no extra memory reads), normalised to the player's facing
+// (6 = forward). The history keeps the last kHistoryTicks masks plus an incrementally maintained
+// run-length view ("6A x3, 5 x12"): a tick either extends the newest run or opens a new one.
+//
+// The frame monitor is the only writer. Everything sits behind one sequence counter (odd while a
+// tick is being written); readers copy what they need and retry if the counter moved, so the
+// render thread never blocks the monitor, never reads game memory and never allocates.
+
+struct PerFrameSample;
+
+namespace InputHistory {
+    constexpr int kHistoryTicks = 1024;     // ~5.3 s at 192 Hz
+    constexpr int kMaxRuns = 64;
+    constexpr uint32_t kMaxRunTicks = 0xFFFFFF;
+
+    struct Run {
+        uint8_t mask;       // facing-relative GAME_INPUT_* mask
+        uint32_t ticks;     // 192 Hz ticks held (saturates at kMaxRunTicks)
+    };
+
+    // Frame monitor thread
+    void Publish(const PerFrameSample& sample);
+    void Reset();
+
+    // Any thread. Copies are consistent snapshots of one published tick.
+    uint32_t PublishedTicks();
+    // Last `max` masks of a player (1 or 2), oldest first; returns how many were written
+    int CopyRecent(int player, uint8_t* out, int max);
+    // Newest run first; returns how many were written
+    int CopyRuns(int player, Run* out, int max);
+
+    // "6A", "2", "5" (numpad + buttons). Writes at most size-1 chars; returns the length.
+    int FormatMask(uint8_t mask, char* buf, int size);
+    // "6A x3, 5 x12" from runs as returned by CopyRuns (newest first); stops when buf is full
+    int FormatRuns(const Run* runs, int count, char* buf, int size);
+}
@@ -38,11 +38,11 @@ void SetAIControlFlag(int playerNum, bool human);
 bool IsAIControlFlagHuman(int playerNum);
 void RestoreAIControlIfNeeded(int playerNum);
 void DumpInputBuffer(int playerNum);
-std::string GetInputBufferVisualization(int playerNum, int window = 16);
 bool WriteSequentialInputs(int playerNum, const std::vector<InputFrame>& frames);
 bool InjectMotionToBuffer(int playerNum, const std::vector<uint8_t>& motionSequence, int offset = 0);
 void ForceHumanControl(int playerNum);
-void ForceHumanControlThread(int playerNum);
+// One keeper pass for ForceHumanControl; returns microseconds until the next (TaskScheduler::kDone to stop)
+uint32_t ForceHumanControlTick(int playerNum, int& stableIters);
 void LogNextBufferValue(int playerNum);
 
 // Input manipulation functions
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Incremental motion recognition over the engine's circular input buffer.
+//
+// Every special/super motion family (236, 623, 41236, ..., dashes) is listed once in a table; the
+// table also backs GetMotionTypeName / DetermineButtonFromMotionType. At first use each family's
+// direction string is compiled into a KMP transition table over numpad symbols, so one buffer entry
+// advances every family by a single table lookup: O(1) per new entry, independent of history length.
+//
+// Entries are fed P1-facing (mirrored by the player's facing). Held directions collapse (only changes
+// advance the automata) and neutral is ignored by families whose pattern has no 5 in it. A family
+// completes when its last direction is followed by a newly pressed button within kButtonWindow
+// entries (dashes complete on the last direction). When several families complete on the same entry
+// (236 inside 41236) only the longest is reported. Leniency is reported per hit.
+//
+// FrameDataMonitor feeds both players each tick from the PerFrameSample bulk copy (the ring and its
+// index lie inside the player window), so recognition costs no extra memory reads.
+
+struct PerFrameSample;
+
+namespace MotionRecognizer {
+    // Gaps are in buffer entries (one per 64 Hz engine frame)
+    constexpr uint16_t kStepGap = 12;       // max entries between consecutive directions
+    constexpr uint16_t kButtonWindow = 8;   // max entries from the last direction to the button press
+    constexpr int kMaxPatternLength = 10;
+    constexpr int kMaxFamilies = 24;
+
+    struct MotionFamily {
+        const char* name;       // "236", "41236", ... ("Forward Dash" for buttonless families)
+        const char* dirs;       // numpad sequence, P1-facing ("252" for 22, "656" for a dash)
+        int ids[4];             // MOTION_* for A, B, C, D (buttonless: ids[0] only)
+        bool buttonless;
+    };
+
+    // Table lookup: family of a MOTION_* id and the button slot (0..3 = A..D) it uses
+    const MotionFamily* FindFamily(int motionId, int* buttonIndex = nullptr);
+    size_t FamilyCount();
+    const MotionFamily& Family(size_t index);
+
+    struct MotionHit {
+        int      motionId;      // MOTION_* constant
+        uint8_t  button;        // GAME_INPUT_A..D (0 for buttonless)
+        uint8_t  player;        // 1 or 2
+        uint16_t frames;        // entries from the first direction to completion
+        uint16_t buttonLag;     // entries between the last direction and the button
+        uint32_t entry;         // running entry count of the player's buffer at completion
+    };
+
+    // Per-player automaton state; usable standalone (tools, verification of injected sequences)
+    class Matcher {
+    public:
+        Matcher();
+        void Reset();
+        // Feed one buffer entry. Writes the completed motion (if any, and max > 0) to `out`; returns 0 or 1.
+        int Feed(uint8_t mask, bool facingRight, MotionHit* out, int max);
+        uint32_t Entries() const { return m_entry; }
+
+    private:
+        struct FamilyState {
+            uint8_t  state;                          // matched directions
+            uint32_t stepAt[kMaxPatternLength + 1];  // entry at which each matched direction landed
+        };
+        FamilyState m_states[kMaxFamilies];
+        uint32_t m_entry = 0;
+        uint8_t  m_prevSymbol = 5;
+        uint8_t  m_prevButtons = 0;
+    };
+
+    constexpr int kMaxHitsPerTick = 8;
+    constexpr int kRecentHits = 16;
+
+    // Frame monitor thread: consume the new buffer entries of both players from this tick's sample
+    void Update(const PerFrameSample& sample);
+    // Drop automaton state and resync to the current buffer index on the next Update
+    void Reset();
+
+    // Motions completed during the last Update (frame monitor thread)
+    int GetTickHits(int player, MotionHit* out, int max);
+    // Most recent motions, newest first (any thread)
+    int GetRecentHits(int player, MotionHit* out, int max);
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <cstdint>
 #include "input_core.h"
+#include "motion_templates.h"
 
 // Input frame structure
 struct InputFrame {
@@ -20,9 +21,20 @@ std::string GetMotionTypeName(int motionType);
 void ProcessInputQueues();
 int ConvertActionToMotion(int actionType, int triggerType);
 inline uint8_t u8(int value);
+// Per-player motion queue (index 1 = P1, 2 = P2). `frames` points into the compile-time template
+// table (motion_templates.h), or into `scratch` when the caller overrides the template's button,
+// so queuing never allocates. One mask per internal frame; p1/p2QueueIndex is the cursor.
+struct MotionQueue {
+    const uint8_t* frames = nullptr;
+    int length = 0;
+    uint8_t scratch[MotionTemplates::kMaxFrames] = {};
+};
+extern MotionQueue g_motionQueue[3];
+
+// Mask at the player's queue cursor (0 when inactive or exhausted)
+uint8_t GetQueuedMotionMask(int playerNum);
+
 // Motion input globals
-extern std::vector<InputFrame> p1InputQueue;
-extern std::vector<InputFrame> p2InputQueue;
 extern int p1QueueIndex;
 extern int p2QueueIndex;
 extern int p1FrameCounter;
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+
+// Input sequences for every queueable MOTION_* id, built at compile time (motion_templates.cpp) for
+// both facings. A sequence holds one input mask per internal frame, so QueueMotionInput only points
+// the player's MotionQueue at it: no per-queue construction and no allocation on the wakeup path.
+//
+// Timing: each direction is held kDirFrames, a neutral separator (22, dashes) kNeutralFrames, and
+// the final direction carries the button for kButtonFrames (dashes end on a plain direction).
+
+namespace MotionTemplates {
+    constexpr int kDirFrames = 3;
+    constexpr int kButtonFrames = 6;
+    constexpr int kNeutralFrames = 2;
+    constexpr int kMaxFrames = 36;      // longest: 10 directions (4123641236 / 6321463214) + button
+
+    struct Sequence {
+        uint8_t frames[kMaxFrames];
+        uint8_t length;
+        uint8_t button;                 // GAME_INPUT_A..D carried by the final step (0 for dashes)
+    };
+
+    // nullptr when the motion has no template (MOTION_NONE, custom ids)
+    const Sequence* Find(int motionId, bool facingRight);
+}
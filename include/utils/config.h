@@ -104,6 +104,10 @@ namespace Config {
         // Practice: Dummy Auto-Block behavior
         // Continuous neutral timeout used by event-driven modes (ms). Defaults to 10000 (10s).
         int autoBlockNeutralTimeoutMs;
+
+        // Macro recorder memory budget (KB). Recording stops when a slot or all slots together exceed it.
+        int macroSlotBudgetKB;           // Per slot (default: 4096)
+        int macroTotalBudgetKB;          // All slots (default: 16384)
     };
     
     // Initialize configuration system
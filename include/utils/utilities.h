@@ -494,6 +494,8 @@ extern std::atomic<bool> g_efzWindowActive;
 extern std::atomic<bool> g_guiActive;
 // Set when an online match is detected; used to terminate/pause mod threads
 extern std::atomic<bool> g_onlineModeActive;
+// Suppress the auto-action full-clear log lines (one-shot persistent clears, replay resets)
+extern std::atomic<bool> g_suppressAutoActionClearLogging;
 
 // Enter online-safe mode: cooperatively stop mod threads, disable hooks/features
 void EnterOnlineMode();
@@ -0,0 +1,74 @@
+#include "../include/core/fake_game_memory.h"
+#include "../include/core/constants.h"
+
+FakeGameMemory::FakeGameMemory() {
+    MapRegion(kModuleBase, kModuleBytes);
+    MapRegion(kPlayer1Base, kPlayerBytes);
+    MapRegion(kPlayer2Base, kPlayerBytes);
+    MapRegion(kGameStateBase, kGameStateBytes);
+    WritePointerSlot(EFZ_BASE_OFFSET_P1, (uint32_t)kPlayer1Base);
+    WritePointerSlot(EFZ_BASE_OFFSET_P2, (uint32_t)kPlayer2Base);
+    WritePointerSlot(EFZ_BASE_OFFSET_GAME_STATE, (uint32_t)kGameStateBase);
+    SetScreenState(3);
+    for (int p = 1; p <= 2; ++p) {
+        int hp = MAX_HP;
+        SetPlayerField(p, HP_OFFSET, hp);
+        SetPlayerField(p, HP_BAR_OFFSET, hp);
+    }
+    ResetCounters();
+}
+
+uint8_t* FakeGameMemory::Translate(uintptr_t address, size_t size) {
+    for (Region& r : m_regions) {
+        if (address >= r.address && address - r.address + size <= r.bytes.size()) {
+            return r.bytes.data() + (address - r.address);
+        }
+    }
+    return nullptr;
+}
+
+bool FakeGameMemory::Read(uintptr_t address, void* buffer, size_t size) {
+    if (!address || !buffer || size == 0) return false;
+    ++reads;
+    const uint8_t* src = Translate(address, size);
+    if (!src) { ++faults; return false; }
+    memcpy(buffer, src, size);
+    return true;
+}
+
+bool FakeGameMemory::Write(uintptr_t address, const void* data, size_t size) {
+    if (!address || !data || size == 0) return false;
+    ++writes;
+    uint8_t* dst = Translate(address, size);
+    if (!dst) { ++faults; return false; }
+    memcpy(dst, data, size);
+    return true;
+}
+
+bool FakeGameMemory::MapRegion(uintptr_t address, size_t size) {
+    if (!address || size == 0) return false;
+    for (const Region& r : m_regions) {
+        if (address < r.address + r.bytes.size() && r.address < address + size) return false;
+    }
+    m_regions.push_back(Region{address, std::vector<uint8_t>(size, 0)});
+    return true;
+}
+
+void FakeGameMemory::SetPlayerPresent(int playerNum, bool present) {
+    uint32_t ptr = present ? (uint32_t)PlayerBase(playerNum) : 0;
+    WritePointerSlot(playerNum == 2 ? EFZ_BASE_OFFSET_P2 : EFZ_BASE_OFFSET_P1, ptr);
+}
+
+void FakeGameMemory::SetScreenState(uint8_t state) {
+    Write(kModuleBase + EFZ_BASE_OFFSET_SCREEN_STATE, &state, sizeof(state));
+}
+
+void FakeGameMemory::SetCharacterName(int playerNum, const char* name) {
+    char buf[16] = {0};
+    if (name) strncpy(buf, name, sizeof(buf) - 1);
+    Write(PlayerBase(playerNum) + CHARACTER_NAME_OFFSET, buf, sizeof(buf));
+}
+
+void FakeGameMemory::WritePointerSlot(uintptr_t moduleOffset, uint32_t value) {
+    Write(kModuleBase + moduleOffset, &value, sizeof(value));
+}
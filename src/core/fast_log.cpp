@@ -0,0 +1,245 @@
+#include "../include/core/fast_log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FastLog {
+
+std::atomic<uint64_t> g_mutedMask{0};
+
+namespace {
+    // Per-thread SPSC ring: the owning thread is the only producer, the drain side the only consumer
+    struct Ring {
+        alignas(64) std::atomic<uint32_t> head{0};   // next slot the producer fills
+        alignas(64) std::atomic<uint32_t> tail{0};   // next slot the consumer reads
+        std::atomic<bool> orphaned{false};           // producer thread exited
+        Record slots[kLogRingSlots];
+    };
+
+    // Ring registry; locked only when a thread logs for the first time and by the drain pass
+    std::mutex s_ringsMutex;
+    std::vector<Ring*> s_rings;
+
+    struct RingOwner {
+        Ring* ring = nullptr;
+        ~RingOwner() { if (ring) ring->orphaned.store(true, std::memory_order_release); }
+    };
+    thread_local RingOwner t_owner;
+
+    std::atomic<SinkFn> s_sink{nullptr};
+    std::atomic<bool> s_started{false};
+    std::atomic<bool> s_stop{false};
+    std::atomic<uint64_t> s_dropped{0};
+    std::atomic<uint64_t> s_drained{0};
+
+    std::mutex s_drainMutex;                          // one drain pass at a time
+    std::vector<Record> s_batch;                      // drain-side scratch, reused
+    std::vector<Ring*> s_ringsScratch;
+
+    uint64_t NowNs() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    Ring* ThreadRing() {
+        if (t_owner.ring) return t_owner.ring;
+        Ring* r = new Ring();
+        {
+            std::lock_guard<std::mutex> lock(s_ringsMutex);
+            s_rings.push_back(r);
+        }
+        t_owner.ring = r;
+        return r;
+    }
+
+    void DrainPass() {
+        std::lock_guard<std::mutex> drainLock(s_drainMutex);
+        s_batch.clear();
+        {
+            std::lock_guard<std::mutex> lock(s_ringsMutex);
+            s_ringsScratch = s_rings;
+        }
+        bool anyOrphanEmpty = false;
+        for (Ring* r : s_ringsScratch) {
+            uint32_t tail = r->tail.load(std::memory_order_relaxed);
+            uint32_t head = r->head.load(std::memory_order_acquire);
+            while (tail != head) {
+                s_batch.push_back(r->slots[tail % kLogRingSlots]);
+                ++tail;
+            }
+            r->tail.store(tail, std::memory_order_release);
+            if (r->orphaned.load(std::memory_order_acquire) && r->head.load(std::memory_order_acquire) == tail)
+                anyOrphanEmpty = true;
+        }
+        if (anyOrphanEmpty) {
+            std::lock_guard<std::mutex> lock(s_ringsMutex);
+            s_rings.erase(std::remove_if(s_rings.begin(), s_rings.end(), [](Ring* r) {
+                bool dead = r->orphaned.load(std::memory_order_acquire) &&
+                            r->head.load(std::memory_order_acquire) == r->tail.load(std::memory_order_relaxed);
+                if (dead) delete r;
+                return dead;
+            }), s_rings.end());
+        }
+        if (s_batch.empty()) return;
+
+        // Interleave threads in the order the messages were produced
+        std::stable_sort(s_batch.begin(), s_batch.end(), [](const Record& a, const Record& b) { return a.tsNs < b.tsNs; });
+        SinkFn sink = s_sink.load(std::memory_order_acquire);
+        char line[512];
+        for (const Record& rec : s_batch) {
+            size_t len = Format(rec, line, sizeof(line));
+            if (sink) sink((LogCat)rec.cat, rec.console != 0, line, len);
+        }
+        s_drained.fetch_add(s_batch.size(), std::memory_order_relaxed);
+    }
+
+    void DrainThread() {
+        while (!s_stop.load(std::memory_order_acquire)) {
+            DrainPass();
+            std::this_thread::sleep_for(std::chrono::milliseconds(4));
+        }
+        DrainPass();
+        s_started.store(false, std::memory_order_release);
+    }
+
+    // Append helpers for Format
+    struct Out {
+        char* buf; size_t cap; size_t n;
+        void Put(char c) { if (n + 1 < cap) buf[n++] = c; }
+        void Put(const char* s, int len) { for (int i = 0; i < len && s[i]; ++i) Put(s[i]); }
+    };
+
+    bool IsFlagChar(char c) { return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0'; }
+    bool IsLengthChar(char c) { return c == 'h' || c == 'l' || c == 'j' || c == 'z' || c == 't' || c == 'L'; }
+}
+
+LogCat CategoryFromMessage(std::string_view msg) {
+    size_t open = msg.find('[');
+    if (open == std::string_view::npos) return LogCat::Other;
+    size_t close = msg.find(']', open);
+    if (close == std::string_view::npos) return LogCat::Other;
+    return CategoryFromTag(msg.substr(open + 1, close - open - 1));
+}
+
+Record* BeginRecord(LogCat cat, bool consoleOutput, const char* fmt) {
+    if (!s_started.load(std::memory_order_relaxed)) Start();
+    Ring* r = ThreadRing();
+    uint32_t head = r->head.load(std::memory_order_relaxed);
+    if (head - r->tail.load(std::memory_order_acquire) >= kLogRingSlots) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Record& rec = r->slots[head % kLogRingSlots];
+    rec.tsNs = NowNs();
+    rec.fmt = fmt;
+    rec.cat = (uint8_t)cat;
+    rec.console = consoleOutput ? 1 : 0;
+    rec.argc = 0;
+    rec.textUsed = 0;
+    return &rec;
+}
+
+void CommitRecord() {
+    Ring* r = t_owner.ring;
+    r->head.store(r->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+size_t Format(const Record& r, char* buf, size_t cap) {
+    if (!buf || cap == 0) return 0;
+    Out out{buf, cap, 0};
+    const char* p = r.fmt ? r.fmt : "";
+    uint8_t ai = 0;
+    while (*p) {
+        if (*p != '%') { out.Put(*p++); continue; }
+        if (p[1] == '%') { out.Put('%'); p += 2; continue; }
+
+        // Rebuild the conversion with our own length modifier (arguments are stored widened)
+        char spec[32]; size_t sl = 0;
+        spec[sl++] = *p++;
+        while (*p && IsFlagChar(*p) && sl < 12) spec[sl++] = *p++;
+        while (*p && ((*p >= '0' && *p <= '9') || *p == '.') && sl < 24) spec[sl++] = *p++;
+        while (*p && IsLengthChar(*p)) ++p;
+        char conv = *p;
+        if (!conv) break;
+        ++p;
+        if (ai >= r.argc) { out.Put("<?>", 3); continue; }
+        const uint8_t type = r.types[ai];
+        const uint64_t raw = r.args[ai];
+        ++ai;
+
+        double d = 0.0;
+        if (type == ArgDouble) memcpy(&d, &raw, sizeof(d));
+        char strBuf[256];
+        if (type == ArgStr) {
+            size_t off = (size_t)(raw >> 8), len = (size_t)(raw & 0xFF);
+            if (off + len > kLogTextBytes) len = 0;
+            memcpy(strBuf, r.text + off, len);
+            strBuf[len] = '\0';
+        }
+
+        char tmp[320];
+        int w = 0;
+        switch (conv) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c': {
+                if (type == ArgStr) { spec[sl++] = 's'; spec[sl] = '\0'; w = snprintf(tmp, sizeof(tmp), spec, strBuf); break; }
+                if (conv == 'c') { spec[sl++] = 'c'; spec[sl] = '\0'; w = snprintf(tmp, sizeof(tmp), spec, (int)(int64_t)raw); break; }
+                spec[sl++] = 'l'; spec[sl++] = 'l'; spec[sl++] = conv; spec[sl] = '\0';
+                if (type == ArgDouble) w = snprintf(tmp, sizeof(tmp), spec, (long long)d);
+                else if (conv == 'd' || conv == 'i') w = snprintf(tmp, sizeof(tmp), spec, (long long)(int64_t)raw);
+                else w = snprintf(tmp, sizeof(tmp), spec, (unsigned long long)raw);
+                break;
+            }
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                spec[sl++] = conv; spec[sl] = '\0';
+                double v = (type == ArgDouble) ? d : (type == ArgInt ? (double)(int64_t)raw : (double)raw);
+                if (type == ArgStr) { spec[sl - 1] = 's'; w = snprintf(tmp, sizeof(tmp), spec, strBuf); }
+                else w = snprintf(tmp, sizeof(tmp), spec, v);
+                break;
+            }
+            case 's': {
+                spec[sl++] = 's'; spec[sl] = '\0';
+                if (type == ArgStr) { w = snprintf(tmp, sizeof(tmp), spec, strBuf); break; }
+                if (type == ArgDouble) w = snprintf(tmp, sizeof(tmp), "%g", d);
+                else if (type == ArgInt) w = snprintf(tmp, sizeof(tmp), "%lld", (long long)(int64_t)raw);
+                else w = snprintf(tmp, sizeof(tmp), "%llu", (unsigned long long)raw);
+                break;
+            }
+            case 'p':
+                w = snprintf(tmp, sizeof(tmp), "0x%08llX", (unsigned long long)raw);
+                break;
+            default:
+                tmp[0] = '%'; tmp[1] = conv; w = 2;
+                break;
+        }
+        if (w > 0) out.Put(tmp, w < (int)sizeof(tmp) ? w : (int)sizeof(tmp) - 1);
+    }
+    buf[out.n] = '\0';
+    return out.n;
+}
+
+void SetSink(SinkFn sink) {
+    s_sink.store(sink, std::memory_order_release);
+}
+
+void Start() {
+    s_stop.store(false, std::memory_order_release);
+    bool expected = false;
+    if (!s_started.compare_exchange_strong(expected, true)) return;
+    std::thread(DrainThread).detach();
+}
+
+void Stop() {
+    s_stop.store(true, std::memory_order_release);
+}
+
+void DrainNow() {
+    DrainPass();
+}
+
+uint64_t DroppedRecords() { return s_dropped.load(std::memory_order_relaxed); }
+uint64_t DrainedRecords() { return s_drained.load(std::memory_order_relaxed); }
+
+} // namespace FastLog
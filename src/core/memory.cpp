@@ -2,7 +2,11 @@
 #include <iomanip>
 #include <chrono>
 #include "../include/core/memory.h"
+#include "../include/core/region_cache.h"
+#include "../include/core/memory_txn.h"
+#include "../include/core/task_scheduler.h"
 #include "../include/core/constants.h"
+#include "../include/game/move_props.h"
 #include "../include/utils/utilities.h"
 #include "../include/utils/config.h"
 
@@ -13,6 +17,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 // For global shutdown flag
 #include "../include/core/globals.h"
 
@@ -20,37 +25,171 @@
 static double saved_x1 = 240.0, saved_y1 = 0.0;
 static double saved_x2 = 400.0, saved_y2 = 0.0;
 
-// Helper function for safe memory reading
-bool SafeWriteMemory(uintptr_t address, const void* data, size_t size) {
-    if (!address || !data || size == 0) return false;
-
-    DWORD oldProtect;
-    if (!VirtualProtect((LPVOID)address, size, PAGE_EXECUTE_READWRITE, &oldProtect)) {
-        return false;
+// Live-process backend: guarded access to efz.exe memory in our own address space.
+// Page validity/protection comes from a RegionValidityCache filled via VirtualQuery, so steady-state
+// reads of player/game-state pages are a plain memcpy and writes to already-writable pages skip the
+// VirtualProtect round trip. The copy itself stays under SEH in case a page vanished or changed
+// protection between invalidations; a write that faults on a page the cache called writable forgets
+// those pages and retries once through the VirtualProtect path.
+namespace {
+    bool QueryWin32Region(uintptr_t address, uintptr_t& regionBase, size_t& regionSize, uint32_t& flags, void*) {
+        MEMORY_BASIC_INFORMATION mbi;
+        if (VirtualQuery((LPCVOID)address, &mbi, sizeof(mbi)) != sizeof(mbi)) return false;
+        if (mbi.State != MEM_COMMIT) return false;
+        regionBase = (uintptr_t)mbi.BaseAddress;
+        regionSize = mbi.RegionSize;
+        flags = 0;
+        DWORD prot = mbi.Protect;
+        if (prot & (PAGE_GUARD | PAGE_NOACCESS)) return true;
+        DWORD base = prot & 0xFF;
+        if (base & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
+                    PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) {
+            flags |= RegionValidityCache::kReadable;
+        }
+        if (base & (PAGE_READWRITE | PAGE_EXECUTE_READWRITE)) {
+            flags |= RegionValidityCache::kWritable;
+        }
+        return true;
     }
 
-    bool success = false;
-    if (!IsBadWritePtr((LPVOID)address, size)) {
-        memcpy((void*)address, data, size);
-        success = true;
+    // No C++ objects with destructors here: required for __try
+    bool GuardedCopy(void* dst, const void* src, size_t size) {
+#if defined(_MSC_VER)
+        __try {
+            memcpy(dst, src, size);
+            return true;
+        } __except (EXCEPTION_EXECUTE_HANDLER) {
+            return false;
+        }
+#else
+        // Host builds (tools/trace_replay): the region cache never reports live pages, so this
+        // backend never copies there
+        memcpy(dst, src, size);
+        return true;
+#endif
     }
 
-    VirtualProtect((LPVOID)address, size, oldProtect, &oldProtect);
-    return success;
+    class Win32GameMemory : public IGameMemory {
+    public:
+        Win32GameMemory() : m_regions(&QueryWin32Region, nullptr) {}
+
+        bool Read(uintptr_t address, void* buffer, size_t size) override {
+            if (!m_regions.CanRead(address, size)) return false;
+            if (GuardedCopy(buffer, (const void*)address, size)) return true;
+            m_regions.Invalidate();
+            return false;
+        }
+        bool Write(uintptr_t address, const void* data, size_t size) override {
+            if (m_regions.CanWrite(address, size)) {
+                if (GuardedCopy((void*)address, data, size)) return true;
+                // Stale entry: the protection changed since the page was cached. Requery below.
+                m_regions.Forget(address, size);
+            }
+            // Read-only/code pages: temporarily lift protection
+            if (!m_regions.CanRead(address, size)) return false;
+            DWORD oldProtect;
+            if (!VirtualProtect((LPVOID)address, size, PAGE_EXECUTE_READWRITE, &oldProtect)) {
+                return false;
+            }
+            bool success = GuardedCopy((void*)address, data, size);
+            VirtualProtect((LPVOID)address, size, oldProtect, &oldProtect);
+            return success;
+        }
+        uintptr_t ModuleBase() override {
+            return reinterpret_cast<uintptr_t>(GetModuleHandleA(NULL)); // NULL = current process module
+        }
+        const char* Name() const override { return "win32"; }
+        void InvalidateRegions() override { m_regions.Invalidate(); }
+
+        // Writable pages are copied directly; spans on protected pages are grouped so each page is
+        // unprotected/restored once for the whole batch. Protection is lifted and put back page by
+        // page: neighbouring pages of a group can carry different protections.
+        size_t WriteBatch(const MemoryWriteSpan* spans, size_t count) override {
+            const uintptr_t page = RegionValidityCache::kPageSize;
+            size_t failed = 0;
+            size_t i = 0;
+            while (i < count) {
+                const MemoryWriteSpan& s = spans[i];
+                if (m_regions.CanWrite(s.address, s.size)) {
+                    if (GuardedCopy((void*)s.address, s.data, s.size)) { ++i; continue; }
+                    // Stale entry: requery and take the protected path below once
+                    m_regions.Forget(s.address, s.size);
+                }
+                if (!m_regions.CanRead(s.address, s.size)) { ++failed; ++i; continue; }
+                uintptr_t lo = s.address & ~(page - 1);
+                uintptr_t hi = (s.address + s.size + page - 1) & ~(page - 1);
+                size_t j = i + 1;
+                while (j < count && spans[j].address < hi &&
+                       !m_regions.CanWrite(spans[j].address, spans[j].size) &&
+                       m_regions.CanRead(spans[j].address, spans[j].size)) {
+                    hi = (std::max)(hi, (spans[j].address + spans[j].size + page - 1) & ~(page - 1));
+                    ++j;
+                }
+                // Spans are sorted and disjoint, so a failed span is only ever seen again on the
+                // following pages: counting indices above the last counted one avoids doubles.
+                size_t lastFailed = i;
+                bool anyFailed = false;
+                auto markFailed = [&](size_t k) {
+                    if (!anyFailed || k > lastFailed) { ++failed; lastFailed = k; anyFailed = true; }
+                };
+                size_t first = i;        // first span that may still touch the current page
+                for (uintptr_t p = lo; p < hi; p += page) {
+                    while (first < j && spans[first].address + spans[first].size <= p) ++first;
+                    DWORD oldProtect;
+                    const bool unprotected = VirtualProtect((LPVOID)p, page, PAGE_EXECUTE_READWRITE, &oldProtect) != 0;
+                    for (size_t k = first; k < j && spans[k].address < p + page; ++k) {
+                        const uintptr_t a = (std::max)(spans[k].address, p);
+                        const uintptr_t b = (std::min)(spans[k].address + spans[k].size, p + page);
+                        if (!unprotected ||
+                            !GuardedCopy((void*)a, (const uint8_t*)spans[k].data + (a - spans[k].address), b - a)) {
+                            markFailed(k);
+                        }
+                    }
+                    if (unprotected) VirtualProtect((LPVOID)p, page, oldProtect, &oldProtect);
+                }
+                i = j;
+            }
+            return failed;
+        }
+
+    private:
+        RegionValidityCache m_regions;
+    };
+
+    Win32GameMemory s_win32Memory;
+    std::atomic<IGameMemory*> s_activeMemory{&s_win32Memory};
+}
+
+IGameMemory& GetGameMemory() {
+    return *s_activeMemory.load(std::memory_order_acquire);
+}
+
+void SetGameMemory(IGameMemory* backend) {
+    IGameMemory* next = backend ? backend : &s_win32Memory;
+    s_activeMemory.store(next, std::memory_order_release);
+    // Cached pointers belong to the previous backend's address space
+    InvalidateEFZBaseCache();
+    InvalidateGameStatePtrCache();
+    InvalidatePlayerBaseCache();
+    LogOut(std::string("[MEMORY] Game memory backend: ") + next->Name(), detailedLogging.load());
+}
+
+// Helper function for safe memory writing
+bool SafeWriteMemory(uintptr_t address, const void* data, size_t size) {
+    if (!address || !data || size == 0) return false;
+    // Inside a write transaction: defer to its batched commit
+    if (MemoryWriteTxn* txn = MemoryWriteTxn::Current()) return txn->Add(address, data, size);
+    return GetGameMemory().Write(address, data, size);
 }
 
 bool SafeReadMemory(uintptr_t address, void* buffer, size_t size) {
     if (!address || !buffer || size == 0) {
         return false;
     }
-    
-    // Use IsBadReadPtr to check if we can read from the address safely
-    if (!IsBadReadPtr((LPVOID)address, size)) {
-        memcpy(buffer, (void*)address, size);
-        return true;
-    }
-    
-    return false;
+    if (!GetGameMemory().Read(address, buffer, size)) return false;
+    // Read-your-writes for values still pending in this thread's transaction
+    if (MemoryWriteTxn* txn = MemoryWriteTxn::Current()) txn->Overlay(address, buffer, size);
+    return true;
 }
 
 uintptr_t ResolvePointer(uintptr_t base, uintptr_t baseOffset, uintptr_t offset) {
@@ -74,7 +213,7 @@ uintptr_t ResolvePointer(uintptr_t base, uintptr_t baseOffset, uintptr_t offset)
     if (ptrAddr < 0x1000 || ptrAddr > 0xFFFFFFFF) return 0;
 
     uintptr_t ptrValue = 0;
-    if (!SafeReadMemory(ptrAddr, &ptrValue, sizeof(uintptr_t))) return 0;
+    if (!ReadGamePointer(ptrAddr, ptrValue)) return 0;
 
     if (ptrValue == 0 || ptrValue > 0xFFFFFFFF) return 0;
 
@@ -153,6 +292,10 @@ void SetPlayerPosition(uintptr_t base, uintptr_t playerOffset, double x, double
         LogOut("[MEMORY] Failed to resolve position pointers", true);
         return;
     }
+
+    // All writes below land in one transaction: frame/moveID and position/velocity each merge into
+    // a single range
+    MemoryWriteTxn txn;
     
     // Read current Y position to determine if transitioning from air to ground
     double currentY = 0.0;
@@ -224,6 +367,10 @@ void SetPlayerPosition(uintptr_t base, uintptr_t playerOffset, double x, double
         }
     }
     
+    if (!txn.Commit()) {
+        LogOut("[MEMORY] Set position: " + std::to_string(txn.LastFailedCount()) + " of " +
+               std::to_string(txn.LastRunCount()) + " write ranges failed", true);
+    }
     LogOut("[MEMORY] Set position - X: " + std::to_string(x) + ", Y: " + std::to_string(y), detailedLogging.load());
 }
 
@@ -233,72 +380,38 @@ bool SetRFValuesDirect(double p1RF, double p2RF) {
     uintptr_t base = GetEFZBase();
     if (!base) return false;
     
-    // Use direct pointer access
-    uintptr_t* p1Ptr = (uintptr_t*)(base + EFZ_BASE_OFFSET_P1);
-    uintptr_t* p2Ptr = (uintptr_t*)(base + EFZ_BASE_OFFSET_P2);
-    
-    // Validate pointers are readable
-    if (IsBadReadPtr(p1Ptr, sizeof(uintptr_t)) || IsBadReadPtr(p2Ptr, sizeof(uintptr_t))) {
+    uintptr_t p1Base = 0, p2Base = 0;
+    if (!ReadGamePointer(base + EFZ_BASE_OFFSET_P1, p1Base) || !ReadGamePointer(base + EFZ_BASE_OFFSET_P2, p2Base)) {
         LogOut("[RF] Invalid player base pointers", detailedLogging);
         return false;
     }
     
-    // Follow the pointers to get player structures
-    uintptr_t p1Base = *p1Ptr;
-    uintptr_t p2Base = *p2Ptr;
-    
     if (!p1Base || !p2Base) {
         LogOut("[RF] Player structures not initialized", detailedLogging);
         return false;
     }
     
-    // Calculate RF addresses
-    double* p1RFAddr = (double*)(p1Base + RF_OFFSET);
-    double* p2RFAddr = (double*)(p2Base + RF_OFFSET);
-    
-    // Validate these addresses
-    if (IsBadWritePtr(p1RFAddr, sizeof(double)) || IsBadWritePtr(p2RFAddr, sizeof(double))) {
-        LogOut("[RF] Invalid RF addresses", detailedLogging);
+    // Both sides in one batch
+    MemoryWriteTxn txn;
+    txn.Add(p1Base + RF_OFFSET, p1RF);
+    txn.Add(p2Base + RF_OFFSET, p2RF);
+    if (!txn.Commit()) {
+        LogOut("[RF] RF write failed for " + std::to_string(txn.LastFailedCount()) + " side(s)", true);
         return false;
     }
     
-    // Write values with memory protection handling
-    DWORD oldProtect1, oldProtect2;
+    // Verify the writes
     bool success = true;
-    
-    // P1 RF write
-    if (VirtualProtect(p1RFAddr, sizeof(double), PAGE_EXECUTE_READWRITE, &oldProtect1)) {
-        *p1RFAddr = p1RF; // Direct write - no memcpy
-        VirtualProtect(p1RFAddr, sizeof(double), oldProtect1, &oldProtect1);
-        
-        // Verify the write
-        double verification = 0.0;
-        memcpy(&verification, p1RFAddr, sizeof(double));
-        if (verification != p1RF) {
-            LogOut("[RF] P1 RF verification failed: wrote " + std::to_string(p1RF) + 
-                   " but read back " + std::to_string(verification), true);
-            success = false;
-        }
-    } else {
-        LogOut("[RF] P1 VirtualProtect failed", true);
+    double verification = 0.0;
+    if (!SafeReadMemory(p1Base + RF_OFFSET, &verification, sizeof(double)) || verification != p1RF) {
+        LogOut("[RF] P1 RF verification failed: wrote " + std::to_string(p1RF) + 
+               " but read back " + std::to_string(verification), true);
         success = false;
     }
-    
-    // P2 RF write
-    if (VirtualProtect(p2RFAddr, sizeof(double), PAGE_EXECUTE_READWRITE, &oldProtect2)) {
-        *p2RFAddr = p2RF; // Direct write - no memcpy
-        VirtualProtect(p2RFAddr, sizeof(double), oldProtect2, &oldProtect2);
-        
-        // Verify the write
-        double verification = 0.0;
-        memcpy(&verification, p2RFAddr, sizeof(double));
-        if (verification != p2RF) {
-            LogOut("[RF] P2 RF verification failed: wrote " + std::to_string(p2RF) + 
-                   " but read back " + std::to_string(verification), true);
-            success = false;
-        }
-    } else {
-        LogOut("[RF] P2 VirtualProtect failed", true);
+    verification = 0.0;
+    if (!SafeReadMemory(p2Base + RF_OFFSET, &verification, sizeof(double)) || verification != p2RF) {
+        LogOut("[RF] P2 RF verification failed: wrote " + std::to_string(p2RF) + 
+               " but read back " + std::to_string(verification), true);
         success = false;
     }
     
@@ -834,7 +947,7 @@ std::atomic<double> rfFreezeValueP2(0.0);
 // Track provenance of RF freeze per-player
 static std::atomic<int> rfFreezeOriginP1{ (int)RFFreezeOrigin::None };
 static std::atomic<int> rfFreezeOriginP2{ (int)RFFreezeOrigin::None };
-std::thread rfFreezeThread;
+static TaskScheduler::TaskId rfFreezeTask = TaskScheduler::kInvalidTask;
 bool rfThreadRunning = false;
 // Desired RF-freeze IC color lock settings (optional)
 static bool rfFreezeColorP1Enabled = false;
@@ -842,96 +955,61 @@ static bool rfFreezeColorP1Blue = false;
 static bool rfFreezeColorP2Enabled = false;
 static bool rfFreezeColorP2Blue = false;
 
-// Improved RF freeze thread function with better error handling
-void RFFreezeThreadFunc() {
-    rfThreadRunning = true;
-    int sleepMs = 10;                // default ~100 Hz when active
+// RF freeze keeper, run on the shared scheduler; returns microseconds until the next pass
+static uint32_t RFFreezeTaskTick() {
+    static int sleepMs = 10;         // default ~100 Hz when active
     const int minSleepMs = 5;        // lower bound when values are drifting
     const int maxSleepMs = 40;       // back off to ~25 Hz when stable
-    int stableIters = 0;
+    static int stableIters = 0;
     auto nearlyEqual = [](double a, double b) {
         return fabs(a - b) < 1e-6;   // tiny tolerance for float write verification
     };
     
-    while (rfThreadRunning && !g_isShuttingDown.load()) {
-        if (rfFreezing.load()) {
-            uintptr_t base = GetEFZBase();
-            if (base) {
-                // Use direct pointer access
-                uintptr_t* p1Ptr = (uintptr_t*)(base + EFZ_BASE_OFFSET_P1);
-                uintptr_t* p2Ptr = (uintptr_t*)(base + EFZ_BASE_OFFSET_P2);
-                
-                // Validate pointers are readable using IsBadReadPtr
-                if (!IsBadReadPtr(p1Ptr, sizeof(uintptr_t)) && !IsBadReadPtr(p2Ptr, sizeof(uintptr_t))) {
-                    // Follow the pointers to get player structures
-                    uintptr_t p1Base = *p1Ptr;
-                    uintptr_t p2Base = *p2Ptr;
-                    
-                    if (p1Base && p2Base) {
-                        // Calculate RF addresses
-                        double* p1RFAddr = (double*)(p1Base + RF_OFFSET);
-                        double* p2RFAddr = (double*)(p2Base + RF_OFFSET);
-                        
-                        // Validate these addresses using IsBadWritePtr
-                        if (!IsBadWritePtr(p1RFAddr, sizeof(double)) && !IsBadWritePtr(p2RFAddr, sizeof(double))) {
-                            // Only write if value changed to avoid constant page flips
-                            double targetP1 = rfFreezeValueP1.load();
-                            double targetP2 = rfFreezeValueP2.load();
-                            double curP1 = *p1RFAddr;
-                            double curP2 = *p2RFAddr;
-                            bool wrote = false;
-
-                            if (rfFreezeP1Active.load() && !nearlyEqual(curP1, targetP1)) {
-                                DWORD oldProtect1;
-                                if (VirtualProtect(p1RFAddr, sizeof(double), PAGE_EXECUTE_READWRITE, &oldProtect1)) {
-                                    *p1RFAddr = targetP1;
-                                    VirtualProtect(p1RFAddr, sizeof(double), oldProtect1, &oldProtect1);
-                                    wrote = true;
-                                }
-                            }
-                            if (rfFreezeP2Active.load() && !nearlyEqual(curP2, targetP2)) {
-                                DWORD oldProtect2;
-                                if (VirtualProtect(p2RFAddr, sizeof(double), PAGE_EXECUTE_READWRITE, &oldProtect2)) {
-                                    *p2RFAddr = targetP2;
-                                    VirtualProtect(p2RFAddr, sizeof(double), oldProtect2, &oldProtect2);
-                                    wrote = true;
-                                }
-                            }
-
-                            // Adjust backoff
-                if (wrote) {
-                                sleepMs = minSleepMs;
-                                stableIters = 0;
-                            } else {
-                                stableIters++;
-                                if (stableIters > 3) {
+    if (!rfThreadRunning || g_isShuttingDown.load()) return TaskScheduler::kDone;
+    if (rfFreezing.load()) {
+        uintptr_t base = GetEFZBase();
+        uintptr_t p1Base = 0, p2Base = 0;
+        double curP1 = 0.0, curP2 = 0.0;
+        if (base && ReadGamePointer(base + EFZ_BASE_OFFSET_P1, p1Base) && ReadGamePointer(base + EFZ_BASE_OFFSET_P2, p2Base) &&
+            p1Base && p2Base &&
+            SafeReadMemory(p1Base + RF_OFFSET, &curP1, sizeof(curP1)) &&
+            SafeReadMemory(p2Base + RF_OFFSET, &curP2, sizeof(curP2))) {
+            // Only write if value changed; both sides go out as one batch
+            double targetP1 = rfFreezeValueP1.load();
+            double targetP2 = rfFreezeValueP2.load();
+            MemoryWriteTxn txn;
+            if (rfFreezeP1Active.load() && !nearlyEqual(curP1, targetP1)) txn.Add(p1Base + RF_OFFSET, targetP1);
+            if (rfFreezeP2Active.load() && !nearlyEqual(curP2, targetP2)) txn.Add(p2Base + RF_OFFSET, targetP2);
+            bool wrote = txn.PendingWrites() > 0 && txn.Commit();
+
+            // Adjust backoff
+            if (wrote) {
+                sleepMs = minSleepMs;
+                stableIters = 0;
+            } else {
+                stableIters++;
+                if (stableIters > 3) {
                     sleepMs = (std::min)(sleepMs * 2, maxSleepMs);
-                                }
-                            }
-                        }
-                    }
                 }
             }
         }
-        else {
-            // When not freezing, back off considerably and avoid memory touching
-            sleepMs = maxSleepMs;
-        }
-        
-        Sleep(sleepMs);
     }
+    else {
+        // When not freezing, back off considerably and avoid memory touching
+        sleepMs = maxSleepMs;
+    }
+    return (uint32_t)sleepMs * 1000;
 }
 
-// Initialize the RF freeze thread
+// Initialize the RF freeze keeper
 void InitRFFreezeThread() {
     if (rfThreadRunning) return;
     
     rfThreadRunning = true;
-    rfFreezeThread = std::thread(RFFreezeThreadFunc);
-    rfFreezeThread.detach();
+    rfFreezeTask = TaskScheduler::Schedule("RFFreeze", 0, []() { return RFFreezeTaskTick(); });
     
     // Only show in detailed mode
-    LogOut("[RF] RF freeze thread initialized", detailedLogging.load());
+    LogOut("[RF] RF freeze task scheduled", detailedLogging.load());
 }
 
 // Start freezing RF values
@@ -1003,7 +1081,9 @@ void StopRFFreezePlayer(int player) {
 void StopRFFreezeThread() {
     if (rfThreadRunning) {
         rfThreadRunning = false;
-        LogOut("[RF] RF freeze thread signaled to stop", detailedLogging.load());
+        TaskScheduler::Cancel(rfFreezeTask);
+        rfFreezeTask = TaskScheduler::kInvalidTask;
+        LogOut("[RF] RF freeze task cancelled", detailedLogging.load());
     }
 }
 
@@ -1021,8 +1101,8 @@ void UpdateRFFreezeTick() {
     uintptr_t base = GetEFZBase();
     if (!base) return;
     uintptr_t p1Base = 0, p2Base = 0;
-    if (!SafeReadMemory(base + EFZ_BASE_OFFSET_P1, &p1Base, sizeof(p1Base))) return;
-    if (!SafeReadMemory(base + EFZ_BASE_OFFSET_P2, &p2Base, sizeof(p2Base))) return;
+    if (!ReadGamePointer(base + EFZ_BASE_OFFSET_P1, p1Base)) return;
+    if (!ReadGamePointer(base + EFZ_BASE_OFFSET_P2, p2Base)) return;
     if (!p1Base || !p2Base) return;
     double* p1RFAddr = (double*)(p1Base + RF_OFFSET);
     double* p2RFAddr = (double*)(p2Base + RF_OFFSET);
@@ -1031,7 +1111,7 @@ void UpdateRFFreezeTick() {
     bool neutralOnly = cfg.freezeRFOnlyWhenNeutral;
     bool requireBothNeutral = cfg.crRequireBothNeutral; // when enabled, require BOTH sides neutral for RF freeze writes
     int bothNeutralDelayMs = (cfg.crBothNeutralDelayMs < 0 ? 0 : cfg.crBothNeutralDelayMs);
-    auto isAllowedNeutral = [](short m){ return (m==0 || m==1 || m==2 || m==3 || m==4 || m==7 || m==8 || m==9 || m==13); };
+    auto isAllowedNeutral = [](short m){ return MoveProps::Has(m, MoveProps::RecoveryNeutral); };
     short m1=0, m2=0;
     // Always read move IDs so we can log why freeze applies or skips
     {
@@ -1077,7 +1157,8 @@ void UpdateRFFreezeTick() {
     // Otherwise, it honors only the target side's neutrality.
     bool canP1 = p1Active && (!neutralOnly || (requireBothNeutral ? bothAllowedWithDelay : p1Allowed));
     bool canP2 = p2Active && (!neutralOnly || (requireBothNeutral ? bothAllowedWithDelay : p2Allowed));
-    // Only write when value differs
+    // Only write when value differs; both sides are committed as one batch
+    MemoryWriteTxn rfTxn;
     if (canP1 && p1RFAddr) {
         double cur1 = 0.0;
         if (SafeReadMemory((uintptr_t)p1RFAddr, &cur1, sizeof(cur1)) && cur1 != t1) {
@@ -1094,6 +1175,7 @@ void UpdateRFFreezeTick() {
             }
         }
     }
+    if (!rfTxn.Commit()) { didWriteP1 = didWriteP2 = false; }
     bool p1SkipDelay = false, p2SkipDelay = false;
     if (p1Active && !canP1 && neutralOnly) {
         if (requireBothNeutral && bothAllowed && (bothElapsedMs < (unsigned long long)bothNeutralDelayMs)) {
@@ -0,0 +1,251 @@
+#include "../include/core/memory_txn.h"
+#include "../include/core/game_memory.h"
+#include "../include/core/logger.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+namespace {
+    thread_local MemoryWriteTxn* t_currentTxn = nullptr;
+
+    // Original bytes per owner: the value from before the owner's FIRST write to each byte, so
+    // repeated writes (per-tick flags) don't overwrite it. Fixed-size and flat: a list of
+    // non-overlapping ranges whose bytes sit in one pool, so recording never allocates. Once full,
+    // further new ranges are dropped and the owner's revert is reported as incomplete.
+    constexpr size_t kJournalRanges = 256;
+    constexpr size_t kJournalBytes = 4096;
+
+    struct Journal {
+        struct Range {
+            uintptr_t address;
+            uint16_t  size;
+            uint16_t  offset;   // into bytes
+        };
+        std::mutex lock;
+        Range    ranges[kJournalRanges];
+        size_t   rangeCount = 0;
+        uint8_t  bytes[kJournalBytes];
+        size_t   used = 0;
+        bool     overflowed = false;
+
+        void Clear() { rangeCount = 0; used = 0; overflowed = false; }
+    };
+    Journal s_journals[(size_t)WriteOwner::Count];
+
+    const char* OwnerName(WriteOwner owner) {
+        switch (owner) {
+            case WriteOwner::PracticePatch:   return "PracticePatch";
+            default:                          return "None";
+        }
+    }
+
+    // Record [address, address+size) bytes not already journaled. Caller holds j.lock.
+    void RecordUncovered(Journal& j, WriteOwner owner, uintptr_t address, size_t size) {
+        const uintptr_t end = address + size;
+        uintptr_t cur = address;
+        while (cur < end) {
+            // Skip over a range that already covers cur, else find where the next one starts
+            uintptr_t next = end;
+            bool covered = false;
+            for (size_t i = 0; i < j.rangeCount; ++i) {
+                const Journal::Range& r = j.ranges[i];
+                if (r.address <= cur && cur < r.address + r.size) { cur = r.address + r.size; covered = true; break; }
+                if (r.address > cur && r.address < next) next = r.address;
+            }
+            if (covered) continue;
+            const size_t len = next - cur;
+            if (j.rangeCount == kJournalRanges || j.used + len > kJournalBytes || len > 0xFFFF) {
+                if (!j.overflowed) {
+                    j.overflowed = true;
+                    LogOut(std::string("[MEMORY] write journal for ") + OwnerName(owner) +
+                           " is full; later writes cannot be reverted", true);
+                }
+                return;
+            }
+            // Real memory, not the current transaction's overlay
+            if (GetGameMemory().Read(cur, j.bytes + j.used, len)) {
+                j.ranges[j.rangeCount++] = {cur, (uint16_t)len, (uint16_t)j.used};
+                j.used += len;
+            }
+            cur = next;
+        }
+    }
+
+    void JournalOriginal(WriteOwner owner, uintptr_t address, size_t size) {
+        if (owner == WriteOwner::None || owner >= WriteOwner::Count) return;
+        Journal& j = s_journals[(size_t)owner];
+        std::lock_guard<std::mutex> lock(j.lock);
+        RecordUncovered(j, owner, address, size);
+    }
+}
+
+MemoryWriteTxn::MemoryWriteTxn(WriteOwner owner)
+    : m_owner(owner), m_parent(t_currentTxn) {
+    t_currentTxn = this;
+}
+
+MemoryWriteTxn::~MemoryWriteTxn() {
+    if (m_spanCount) Commit();
+    t_currentTxn = m_parent;
+}
+
+MemoryWriteTxn* MemoryWriteTxn::Current() {
+    return t_currentTxn;
+}
+
+bool MemoryWriteTxn::Add(uintptr_t address, const void* data, size_t size) {
+    if (!address || !data || size == 0) return false;
+    if (size > kMaxBytes) {
+        // Too big to batch: apply what is pending so ordering holds, then write it directly
+        if (!Commit()) return false;
+        if (m_parent) return m_parent->Add(address, data, size);
+        JournalOriginal(m_owner, address, size);
+        return GetGameMemory().Write(address, data, size);
+    }
+    if (m_spanCount == kMaxSpans || m_used + size > kMaxBytes) {
+        if (!Commit()) return false;
+    }
+    m_spans[m_spanCount++] = {address, (uint32_t)size, (uint32_t)m_used};
+    memcpy(m_bytes + m_used, data, size);
+    m_used += size;
+    return true;
+}
+
+void MemoryWriteTxn::Overlay(uintptr_t address, void* buffer, size_t size) const {
+    if (m_parent) m_parent->Overlay(address, buffer, size);
+    uintptr_t end = address + size;
+    for (size_t i = 0; i < m_spanCount; ++i) { // insertion order: later writes win
+        const Span& s = m_spans[i];
+        uintptr_t lo = (std::max)(address, s.address);
+        uintptr_t hi = (std::min)(end, s.address + s.size);
+        if (lo >= hi) continue;
+        memcpy((uint8_t*)buffer + (lo - address), m_bytes + s.offset + (lo - s.address), hi - lo);
+    }
+}
+
+void MemoryWriteTxn::Discard() {
+    m_spanCount = 0;
+    m_used = 0;
+}
+
+bool MemoryWriteTxn::Commit() {
+    m_lastRuns = 0;
+    m_lastFailed = 0;
+    if (m_spanCount == 0) return true;
+
+    // Nested: hand everything to the enclosing transaction, keeping our own journal entries
+    if (m_parent) {
+        for (size_t i = 0; i < m_spanCount; ++i) {
+            const Span& s = m_spans[i];
+            JournalOriginal(m_owner, s.address, s.size);
+            m_parent->Add(s.address, m_bytes + s.offset, s.size);
+        }
+        Discard();
+        return true;
+    }
+
+    // Order by address, keeping insertion order for equal starts (insertion sort: a handful of spans,
+    // and stable without a scratch buffer), then merge touching ranges
+    uint8_t order[kMaxSpans];
+    for (size_t i = 0; i < m_spanCount; ++i) {
+        size_t j = i;
+        while (j > 0 && m_spans[order[j - 1]].address > m_spans[i].address) {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = (uint8_t)i;
+    }
+
+    struct Run { uintptr_t address; size_t size; size_t offset; };
+    Run runs[kMaxSpans];
+    size_t runCount = 0;
+    uint8_t runOf[kMaxSpans];
+    for (size_t k = 0; k < m_spanCount; ++k) {
+        const uint8_t idx = order[k];
+        const Span& s = m_spans[idx];
+        uintptr_t end = s.address + s.size;
+        if (runCount && s.address <= runs[runCount - 1].address + runs[runCount - 1].size) {
+            Run& r = runs[runCount - 1];
+            if (end > r.address + r.size) r.size = end - r.address;
+        } else {
+            runs[runCount++] = {s.address, (size_t)s.size, 0};
+        }
+        runOf[idx] = (uint8_t)(runCount - 1);
+    }
+    // Merged runs never hold more bytes than the spans they came from
+    uint8_t merged[kMaxBytes];
+    size_t off = 0;
+    for (size_t k = 0; k < runCount; ++k) { runs[k].offset = off; off += runs[k].size; }
+    // Apply in insertion order so the last write to a byte wins
+    for (size_t i = 0; i < m_spanCount; ++i) {
+        const Span& s = m_spans[i];
+        const Run& r = runs[runOf[i]];
+        memcpy(merged + r.offset + (s.address - r.address), m_bytes + s.offset, s.size);
+    }
+
+    MemoryWriteSpan batch[kMaxSpans];
+    for (size_t k = 0; k < runCount; ++k) {
+        JournalOriginal(m_owner, runs[k].address, runs[k].size);
+        batch[k] = {runs[k].address, merged + runs[k].offset, runs[k].size};
+    }
+    m_lastRuns = runCount;
+    m_lastFailed = GetGameMemory().WriteBatch(batch, runCount);
+    Discard();
+    return m_lastFailed == 0;
+}
+
+bool JournaledWrite(WriteOwner owner, uintptr_t address, const void* data, size_t size) {
+    if (!address || !data || size == 0) return false;
+    JournalOriginal(owner, address, size);
+    // Inside a transaction the write joins its batch; otherwise it's a single span, nothing to merge
+    if (MemoryWriteTxn* txn = t_currentTxn) return txn->Add(address, data, size);
+    return GetGameMemory().Write(address, data, size);
+}
+
+bool RevertWrites(WriteOwner owner) {
+    if (owner == WriteOwner::None || owner >= WriteOwner::Count) return true;
+    Journal& j = s_journals[(size_t)owner];
+    std::lock_guard<std::mutex> lock(j.lock);
+    if (j.rangeCount == 0) { j.Clear(); return true; }
+
+    // Ranges never overlap; WriteBatch wants them in address order
+    uint16_t order[kJournalRanges];
+    for (size_t i = 0; i < j.rangeCount; ++i) order[i] = (uint16_t)i;
+    std::sort(order, order + j.rangeCount, [&j](uint16_t a, uint16_t b) {
+        return j.ranges[a].address < j.ranges[b].address;
+    });
+    MemoryWriteSpan spans[kJournalRanges];
+    for (size_t i = 0; i < j.rangeCount; ++i) {
+        const Journal::Range& r = j.ranges[order[i]];
+        spans[i] = {r.address, j.bytes + r.offset, r.size};
+    }
+    const bool ok = GetGameMemory().WriteBatch(spans, j.rangeCount) == 0;
+    const bool complete = !j.overflowed;
+    if (!complete) {
+        LogOut(std::string("[MEMORY] reverted ") + OwnerName(owner) +
+               " writes only partially: its journal overflowed", true);
+    }
+    j.Clear();
+    return ok && complete;
+}
+
+bool RevertAllWrites() {
+    bool ok = true;
+    for (size_t i = 1; i < (size_t)WriteOwner::Count; ++i) ok = RevertWrites((WriteOwner)i) && ok;
+    return ok;
+}
+
+void DiscardWriteJournal(WriteOwner owner) {
+    if (owner >= WriteOwner::Count) return;
+    Journal& j = s_journals[(size_t)owner];
+    std::lock_guard<std::mutex> lock(j.lock);
+    j.Clear();
+}
+
+size_t GetWriteJournalBytes(WriteOwner owner) {
+    if (owner >= WriteOwner::Count) return 0;
+    Journal& j = s_journals[(size_t)owner];
+    std::lock_guard<std::mutex> lock(j.lock);
+    return j.used;
+}
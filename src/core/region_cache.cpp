@@ -0,0 +1,65 @@
+#include "../include/core/region_cache.h"
+
+RegionValidityCache::RegionValidityCache(QueryFn query, void* ctx)
+    : m_query(query), m_ctx(ctx) {
+    for (auto& s : m_slots) s.store(0, std::memory_order_relaxed);
+}
+
+void RegionValidityCache::Invalidate() {
+    const uint32_t gen = m_generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+    // A slot written 65536 generations ago would match again
+    if ((gen & 0xFFFFu) == 0) {
+        for (auto& s : m_slots) s.store(0, std::memory_order_release);
+    }
+}
+
+void RegionValidityCache::Forget(uintptr_t address, size_t size) {
+    if (!address || size == 0) return;
+    const uintptr_t last = address + (size - 1);
+    if (last < address) return;
+    for (uintptr_t page = address / kPageSize; page <= last / kPageSize; ++page) {
+        std::atomic<uint64_t>& slot = m_slots[page & (kSlotCount - 1)];
+        uint64_t v = slot.load(std::memory_order_acquire);
+        if (v && (v >> 18) == static_cast<uint64_t>(page)) slot.compare_exchange_strong(v, 0, std::memory_order_acq_rel);
+    }
+}
+
+bool RegionValidityCache::Check(uintptr_t address, size_t size, uint32_t need) {
+    if (!address || size == 0) return false;
+    uintptr_t last = address + (size - 1);
+    if (last < address) return false; // wraps
+    uint32_t gen = m_generation.load(std::memory_order_acquire);
+    for (uintptr_t page = address / kPageSize; page <= last / kPageSize; ++page) {
+        if (!CheckPage(page, need, gen)) return false;
+    }
+    return true;
+}
+
+bool RegionValidityCache::CheckPage(uintptr_t page, uint32_t need, uint32_t gen) {
+    std::atomic<uint64_t>& slot = m_slots[page & (kSlotCount - 1)];
+    uint64_t v = slot.load(std::memory_order_acquire);
+    if (v && (v >> 18) == static_cast<uint64_t>(page) && ((v >> 2) & 0xFFFFu) == (gen & 0xFFFFu)) {
+        uint32_t flags = static_cast<uint32_t>(v & 0x3u);
+        if ((flags & need) == need) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        // Cached but lacking the requested access (e.g. read-only page asked for write): ask again,
+        // protection may have changed since.
+    }
+
+    m_queries.fetch_add(1, std::memory_order_relaxed);
+    uintptr_t regionBase = 0; size_t regionSize = 0; uint32_t flags = 0;
+    if (!m_query || !m_query(page * kPageSize, regionBase, regionSize, flags, m_ctx)) return false;
+    flags &= (kReadable | kWritable);
+    if (flags) {
+        uint64_t packed = Pack(page, gen, flags);
+        slot.store(packed, std::memory_order_release);
+        // Invalidated (possibly wrapped and cleared) while we queried: don't leave an old-generation
+        // entry behind
+        if (m_generation.load(std::memory_order_acquire) != gen) {
+            slot.compare_exchange_strong(packed, 0, std::memory_order_acq_rel);
+        }
+    }
+    return (flags & need) == need;
+}
@@ -0,0 +1,345 @@
+#include "../include/core/task_scheduler.h"
+#include "../include/core/logger.h"
+#include "../include/core/globals.h"
+#include "../include/utils/utilities.h"
+#include <windows.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+    using namespace TaskScheduler;
+
+    constexpr int      kWheelBits = 8;
+    constexpr int      kWheelSlots = 1 << kWheelBits;
+    constexpr uint64_t kSlotNs = 1000000ull;    // 1 ms per slot
+    constexpr int      kIndexBits = 6;          // TaskId = generation << kIndexBits | slot index
+    static_assert((1 << kIndexBits) == kMaxTasks, "TaskId layout assumes kMaxTasks == 64");
+
+    enum SlotState : uint32_t { kFree = 0, kClaimed = 1, kLive = 2 };
+
+    struct Task {
+        std::atomic<uint32_t> state{ kFree };
+        std::atomic<uint32_t> generation{ 1 };
+        std::atomic<uint32_t> cancelGen{ 0 };   // == generation once cancelled
+        char   name[32] = {};
+        TaskFn fn;
+        int    nextSubmit = -1;                 // submission list link
+
+        // Worker-owned wheel bookkeeping
+        uint64_t deadlineNs = 0;                // absolute; entries more than a lap out just stay put
+        int      nextInSlot = -1;
+
+        // Written by the worker, read by the GUI
+        std::atomic<uint64_t> runs{ 0 };
+        std::atomic<uint64_t> lateSumNs{ 0 };
+        std::atomic<uint64_t> lateMaxNs{ 0 };
+        std::atomic<uint64_t> lateOver{ 0 };
+        std::atomic<uint64_t> runSumNs{ 0 };
+        std::atomic<uint64_t> runMaxNs{ 0 };
+    };
+
+    Task s_tasks[kMaxTasks];
+    std::atomic<int> s_submitHead{ -1 };       // push-only list; the worker takes it whole
+
+    // Worker state
+    int      s_wheel[kWheelSlots];
+    int      s_cursor = 0;
+    uint64_t s_wheelTimeNs = 0;                 // start of the slot under the cursor
+
+    std::atomic<bool> s_running{ false };
+    std::atomic<bool> s_stop{ false };
+    std::atomic<bool> s_resetStats{ false };
+    std::atomic<bool> s_cancelPending{ false };
+    HANDLE s_wakeEvent = nullptr;
+
+    uint64_t NowNs() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    inline uint32_t IndexOf(TaskId id) { return id & (kMaxTasks - 1); }
+    inline uint32_t GenerationOf(TaskId id) { return id >> kIndexBits; }
+
+    bool IsCancelled(const Task& t) {
+        return t.cancelGen.load(std::memory_order_acquire) == t.generation.load(std::memory_order_relaxed);
+    }
+
+    void Wake() {
+        if (s_wakeEvent) SetEvent(s_wakeEvent);
+    }
+
+    void Release(int idx) {
+        Task& t = s_tasks[idx];
+        t.fn = nullptr;
+        t.generation.fetch_add(1, std::memory_order_relaxed);
+        t.state.store(kFree, std::memory_order_release);
+    }
+
+    void Insert(int idx) {
+        Task& t = s_tasks[idx];
+        const uint64_t ahead = t.deadlineNs > s_wheelTimeNs ? (t.deadlineNs - s_wheelTimeNs) / kSlotNs : 0;
+        const int slot = (int)((s_cursor + ahead) & (kWheelSlots - 1));
+        t.nextInSlot = s_wheel[slot];
+        s_wheel[slot] = idx;
+    }
+
+    void DrainSubmissions(uint64_t now) {
+        int head = s_submitHead.exchange(-1, std::memory_order_acquire);
+        // Reverse to submission order so same-deadline tasks run FIFO
+        int ordered = -1;
+        while (head >= 0) {
+            const int next = s_tasks[head].nextSubmit;
+            s_tasks[head].nextSubmit = ordered;
+            ordered = head;
+            head = next;
+        }
+        while (ordered >= 0) {
+            const int next = s_tasks[ordered].nextSubmit;
+            Task& t = s_tasks[ordered];
+            t.deadlineNs += now;    // submitters store the relative delay
+            Insert(ordered);
+            ordered = next;
+        }
+    }
+
+    void UpdateMax(std::atomic<uint64_t>& slot, uint64_t v) {
+        if (v > slot.load(std::memory_order_relaxed)) slot.store(v, std::memory_order_relaxed);
+    }
+
+    void RunTask(int idx) {
+        Task& t = s_tasks[idx];
+        const uint64_t start = NowNs();
+        const uint64_t late = start > t.deadlineNs ? start - t.deadlineNs : 0;
+        uint32_t nextUs = kDone;
+        try {
+            nextUs = t.fn ? t.fn() : kDone;
+        } catch (...) {
+            LogOut(std::string("[SCHED] Task '") + t.name + "' threw; dropped", true);
+            nextUs = kDone;
+        }
+        const uint64_t end = NowNs();
+
+        t.runs.fetch_add(1, std::memory_order_relaxed);
+        t.lateSumNs.fetch_add(late, std::memory_order_relaxed);
+        UpdateMax(t.lateMaxNs, late);
+        if (late > 2 * kSlotNs) t.lateOver.fetch_add(1, std::memory_order_relaxed);
+        t.runSumNs.fetch_add(end - start, std::memory_order_relaxed);
+        UpdateMax(t.runMaxNs, end - start);
+
+        if (nextUs == kDone || IsCancelled(t)) {
+            Release(idx);
+            return;
+        }
+        const uint64_t delayNs = (uint64_t)nextUs * 1000ull;
+        t.deadlineNs += delayNs;
+        // Fell more than one delay behind: resync instead of running back-to-back
+        if (t.deadlineNs + delayNs < end) t.deadlineNs = end + delayNs;
+        Insert(idx);
+    }
+
+    // Advance the cursor up to `now` and run every due task
+    void RunDue(uint64_t now) {
+        int due[kMaxTasks];
+        for (;;) {
+            int count = 0;
+            const bool slotElapsed = s_wheelTimeNs + kSlotNs <= now;
+            int* link = &s_wheel[s_cursor];
+            while (*link >= 0) {
+                const int idx = *link;
+                Task& t = s_tasks[idx];
+                if (IsCancelled(t)) {
+                    *link = t.nextInSlot;
+                    Release(idx);
+                } else if (t.deadlineNs <= now) {
+                    *link = t.nextInSlot;
+                    due[count++] = idx;
+                } else {
+                    link = &t.nextInSlot;
+                }
+            }
+            // Run after unlinking so a task that reschedules into this slot is not seen twice
+            for (int i = 0; i < count; ++i) RunTask(due[i]);
+            if (!slotElapsed) break;
+            s_cursor = (s_cursor + 1) & (kWheelSlots - 1);
+            s_wheelTimeNs += kSlotNs;
+        }
+    }
+
+    // Earliest deadline on the current lap; slots are scanned in time order so the first hit wins
+    uint64_t NextDeadline() {
+        for (int k = 0; k < kWheelSlots; ++k) {
+            const uint64_t slotEnd = s_wheelTimeNs + (uint64_t)(k + 1) * kSlotNs;
+            uint64_t best = UINT64_MAX;
+            for (int idx = s_wheel[(s_cursor + k) & (kWheelSlots - 1)]; idx >= 0; idx = s_tasks[idx].nextInSlot) {
+                const Task& t = s_tasks[idx];
+                if (t.deadlineNs < slotEnd && t.deadlineNs < best) best = t.deadlineNs;
+            }
+            if (best != UINT64_MAX) return best;
+        }
+        // Only entries on later laps (or none): wake at the lap boundary
+        return s_wheelTimeNs + (uint64_t)kWheelSlots * kSlotNs;
+    }
+
+    // Free cancelled entries wherever they sit so their slots can be reused right away
+    void SweepCancelled() {
+        for (int& head : s_wheel) {
+            int* link = &head;
+            while (*link >= 0) {
+                const int idx = *link;
+                if (IsCancelled(s_tasks[idx])) {
+                    *link = s_tasks[idx].nextInSlot;
+                    Release(idx);
+                } else {
+                    link = &s_tasks[idx].nextInSlot;
+                }
+            }
+        }
+    }
+
+    void ApplyStatsReset() {
+        for (Task& t : s_tasks) {
+            t.runs.store(0, std::memory_order_relaxed);
+            t.lateSumNs.store(0, std::memory_order_relaxed);
+            t.lateMaxNs.store(0, std::memory_order_relaxed);
+            t.lateOver.store(0, std::memory_order_relaxed);
+            t.runSumNs.store(0, std::memory_order_relaxed);
+            t.runMaxNs.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Worker() {
+        for (int& head : s_wheel) head = -1;
+        s_cursor = 0;
+        s_wheelTimeNs = NowNs();
+
+        while (!s_stop.load(std::memory_order_acquire) && !g_isShuttingDown.load()) {
+            if (s_resetStats.exchange(false, std::memory_order_acq_rel)) ApplyStatsReset();
+            uint64_t now = NowNs();
+            DrainSubmissions(now);
+            if (s_cancelPending.exchange(false, std::memory_order_acq_rel)) SweepCancelled();
+            RunDue(now);
+
+            now = NowNs();
+            const uint64_t next = NextDeadline();
+            if (next > now) {
+                // Round up: waking a little late is cheaper than spinning on a sub-ms remainder
+                const uint64_t waitMs = (next - now + kSlotNs - 1) / kSlotNs;
+                WaitForSingleObject(s_wakeEvent, (DWORD)(waitMs > 1000 ? 1000 : waitMs));
+            }
+        }
+        s_running.store(false);
+        LogOut("[SCHED] Worker stopped", detailedLogging.load());
+    }
+
+    TaskId Submit(const char* name, uint32_t delayUs, TaskFn fn) {
+        for (int idx = 0; idx < kMaxTasks; ++idx) {
+            Task& t = s_tasks[idx];
+            uint32_t expected = kFree;
+            if (!t.state.compare_exchange_strong(expected, kClaimed, std::memory_order_acquire)) continue;
+
+            strncpy(t.name, name ? name : "task", sizeof(t.name) - 1);
+            t.name[sizeof(t.name) - 1] = '\0';
+            t.fn = std::move(fn);
+            t.deadlineNs = (uint64_t)delayUs * 1000ull;  // made absolute by the worker on drain
+            t.runs.store(0, std::memory_order_relaxed);
+            t.lateSumNs.store(0, std::memory_order_relaxed);
+            t.lateMaxNs.store(0, std::memory_order_relaxed);
+            t.lateOver.store(0, std::memory_order_relaxed);
+            t.runSumNs.store(0, std::memory_order_relaxed);
+            t.runMaxNs.store(0, std::memory_order_relaxed);
+            const uint32_t gen = t.generation.load(std::memory_order_relaxed);
+            t.state.store(kLive, std::memory_order_relaxed);
+
+            int head = s_submitHead.load(std::memory_order_relaxed);
+            do {
+                t.nextSubmit = head;
+            } while (!s_submitHead.compare_exchange_weak(head, idx, std::memory_order_release, std::memory_order_relaxed));
+            Wake();
+            return (TaskId)((gen << kIndexBits) | (uint32_t)idx);
+        }
+        LogOut(std::string("[SCHED] No free task slot for '") + (name ? name : "task") + "'", true);
+        return kInvalidTask;
+    }
+}
+
+namespace TaskScheduler {
+
+void Start() {
+    bool expected = false;
+    if (!s_running.compare_exchange_strong(expected, true)) return;
+    s_stop.store(false);
+    if (!s_wakeEvent) s_wakeEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    std::thread(Worker).detach();
+    LogOut("[SCHED] Worker started", detailedLogging.load());
+}
+
+void Stop() {
+    s_stop.store(true, std::memory_order_release);
+    Wake();
+}
+
+bool IsRunning() { return s_running.load(); }
+
+TaskId Schedule(const char* name, uint32_t delayUs, TaskFn fn) {
+    return Submit(name, delayUs, std::move(fn));
+}
+
+TaskId SchedulePeriodic(const char* name, uint32_t periodUs, std::function<void()> fn) {
+    if (periodUs == 0) return kInvalidTask;
+    return Submit(name, periodUs, [periodUs, fn = std::move(fn)]() { fn(); return periodUs; });
+}
+
+TaskId ScheduleOnce(const char* name, uint32_t delayUs, std::function<void()> fn) {
+    return Submit(name, delayUs, [fn = std::move(fn)]() { fn(); return kDone; });
+}
+
+void Cancel(TaskId id) {
+    if (id == kInvalidTask) return;
+    Task& t = s_tasks[IndexOf(id)];
+    const uint32_t gen = GenerationOf(id);
+    if (t.generation.load(std::memory_order_relaxed) != gen) return;
+    t.cancelGen.store(gen, std::memory_order_release);
+    s_cancelPending.store(true, std::memory_order_release);
+    Wake();
+}
+
+bool IsScheduled(TaskId id) {
+    if (id == kInvalidTask) return false;
+    const Task& t = s_tasks[IndexOf(id)];
+    const uint32_t gen = GenerationOf(id);
+    return t.state.load(std::memory_order_acquire) == kLive &&
+           t.generation.load(std::memory_order_relaxed) == gen &&
+           t.cancelGen.load(std::memory_order_relaxed) != gen;
+}
+
+int GetStats(TaskStats* out, int max) {
+    int n = 0;
+    for (int idx = 0; idx < kMaxTasks && n < max; ++idx) {
+        const Task& t = s_tasks[idx];
+        if (t.state.load(std::memory_order_acquire) != kLive) continue;
+        const uint32_t gen = t.generation.load(std::memory_order_relaxed);
+        TaskStats& s = out[n];
+        memcpy(s.name, t.name, sizeof(s.name));
+        s.name[sizeof(s.name) - 1] = '\0';
+        s.runs = t.runs.load(std::memory_order_relaxed);
+        const double runs = s.runs ? (double)s.runs : 1.0;
+        s.meanLateUs = t.lateSumNs.load(std::memory_order_relaxed) / runs / 1000.0;
+        s.maxLateUs = t.lateMaxNs.load(std::memory_order_relaxed) / 1000.0;
+        s.lateOver2ms = t.lateOver.load(std::memory_order_relaxed);
+        s.meanRunUs = t.runSumNs.load(std::memory_order_relaxed) / runs / 1000.0;
+        s.maxRunUs = t.runMaxNs.load(std::memory_order_relaxed) / 1000.0;
+        // Slot recycled while copying: skip the torn row
+        if (t.generation.load(std::memory_order_acquire) != gen) continue;
+        ++n;
+    }
+    return n;
+}
+
+void ResetStats() {
+    s_resetStats.store(true, std::memory_order_release);
+    Wake();
+}
+
+} // namespace TaskScheduler
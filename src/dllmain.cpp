@@ -31,14 +31,16 @@
 #include "../include/utils/debug_log.h"
 #include "../include/game/efzrevival_addrs.h"
 #include "../include/input/framestep.h"
+#include "../include/game/trace_recorder.h"
+#include "../include/core/fast_log.h"
+#include "../include/core/task_scheduler.h"
+#include "../include/game/macro_library.h"
 // forward declaration for overlay gate
 namespace PracticeOverlayGate { void EnsureInstalled(); void SetMenuVisible(bool); }
 #pragma comment(lib, "winmm.lib")
 
 // Forward declarations for functions in other files
-void MonitorKeys();
 void FrameDataMonitor();
-void UpdateConsoleTitle();
 void WriteStartupLog(const std::string& message);
 extern std::atomic<bool> inStartupPhase;
 
@@ -57,7 +59,10 @@ void DelayedInitialization(HMODULE hModule) {
 
         WriteStartupLog("Starting delayed initialization");
 
-        // Initialize logging system (starts title updater thread)
+        // Shared timer executor for periodic background work (title updater, immediate input, ...)
+        TaskScheduler::Start();
+
+        // Initialize logging system (schedules the title updater)
         WriteStartupLog("Initializing logging system...");
         InitializeLogging();
         WriteStartupLog("Logging system initialized");
@@ -125,6 +130,9 @@ void DelayedInitialization(HMODULE hModule) {
         // Initialize framestep system (vanilla only)
         Framestep::Initialize();
 
+        // Map the on-disk macro library (missing file = empty library)
+        MacroLibrary::Open();
+
         // Attempt to install Practice hotkey gate (will succeed only after EfzRevival.dll present)
         try {
             if (PracticeHotkeyGate::Install()) {
@@ -163,7 +171,7 @@ void DelayedInitialization(HMODULE hModule) {
 
     // Start essential threads.
     LogOut("[SYSTEM] Starting background threads...", true);
-    // Note: UpdateConsoleTitle thread is already started by InitializeLogging(); don't start a duplicate here.
+    // Note: the console title task is already scheduled by InitializeLogging(); don't add a duplicate here.
     std::thread(FrameDataMonitor).detach();
         LogOut("[SYSTEM] Essential background threads started.", true);
 
@@ -252,8 +260,16 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         g_isShuttingDown = true;
         g_featuresEnabled = false;
         
+        // Stop the structured-log drain thread (records queued after this are dropped with the process)
+        FastLog::Stop();
         // Shutdown debug log
         DebugLog::Shutdown();
+        // Flush and unmap the tick trace, if one is running
+        TraceRecorder::Stop();
+        // Unmap the macro library (slots bound to it are not used past this point)
+        MacroLibrary::Close();
+        // Stop the shared scheduler worker (pending timed tasks are dropped)
+        TaskScheduler::Stop();
         
         // CRITICAL: Stop buffer freezing FIRST
         StopBufferFreezing();
@@ -29,6 +29,7 @@ namespace AlwaysRG {
 
 		// Write 0x3C to the RG arm byte (+334). Keep it byte-sized to match the engine's usage.
 		uint8_t arm = 0x3C;
+		// Not journaled: the engine counts the timer down itself, so there is nothing to restore
 		SafeWriteMemory(p2 + 334, &arm, sizeof(arm));
 		// Optional: extremely low-frequency debug spam gate is omitted here to keep it quiet.
 	}
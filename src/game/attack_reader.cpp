@@ -1,4 +1,5 @@
 #include "../include/game/attack_reader.h"
+#include "../include/game/attack_table.h"
 #include "../include/game/collision_hook.h"
 #include "../include/core/memory.h"
 #include "../include/core/logger.h"
@@ -64,99 +65,50 @@ void AttackReader::LogMoveData(int playerNum, short moveID) {
     if (moveID <= 0) {
         return; // Not an attack move
     }
-    
-    uintptr_t base = GetEFZBase();
-    if (!base) return;
-    
-    uintptr_t playerOffset = (playerNum == 1) ? EFZ_BASE_OFFSET_P1 : EFZ_BASE_OFFSET_P2;
-    uintptr_t playerPtr = 0;
-    
-    if (!SafeReadMemory(base + playerOffset, &playerPtr, sizeof(uintptr_t)) || !playerPtr) {
-        return;
-    }
-    
-    // Get attack data pointer
-    uintptr_t attackDataPtr = GetAttackDataPtr(playerPtr, moveID);
-    if (!attackDataPtr) {
-        LogOut("[ATTACK_READER] P" + std::to_string(playerNum) + " move " + 
-               std::to_string(moveID) + " - Failed to get attack data", true);
-        return;
-    }
-    
-    // Read attack properties
-    uint8_t attackTypeFlags = 0;
-    uint16_t activeRemain = 0;
-    uint16_t damage = 0;
-    uint16_t blockstun = 0;
-    uint16_t hitstop = 0;
-    
-    // Only log if we can read the attack type
-    if (!SafeReadMemory(attackDataPtr + ATTACK_FLAGS_OFFSET, &attackTypeFlags, sizeof(uint8_t))) {
+
+    // Per-character table built in the background (attack_table.h); no memory probing here
+    const AttackTable::MoveData* m = AttackTable::Lookup(playerNum, moveID);
+    if (!m) {
+        if (AttackTable::IsReady(playerNum)) {
+            LogOut("[ATTACK_READER] P" + std::to_string(playerNum) + " move " +
+                   std::to_string(moveID) + " - No attack frames", detailedLogging.load());
+        }
         return;
     }
-    
-    // Try to read other properties
-    SafeReadMemory(attackDataPtr + ATTACK_ACTIVE_REMAINING, &activeRemain, sizeof(uint16_t));
-    SafeReadMemory(attackDataPtr + ATTACK_DAMAGE_OFFSET, &damage, sizeof(uint16_t));
-    SafeReadMemory(attackDataPtr + ATTACK_BLOCKSTUN_OFFSET, &blockstun, sizeof(uint16_t));
-    SafeReadMemory(attackDataPtr + ATTACK_HITSTOP_OFFSET, &hitstop, sizeof(uint16_t));
-    
-    // Determine attack height
-    std::string heightStr = "Unknown";
-    if (attackTypeFlags & 0x40 || attackTypeFlags & 0x80)
-        heightStr = "THROW (Unblockable)";
-    else if (attackTypeFlags & 0x01)
-        heightStr = "LOW";
-    else if (attackTypeFlags & 0x04)
-        heightStr = "HIGH";
-    else if (attackTypeFlags & 0x02)
-        heightStr = "MID";
-    
-    // Log the complete attack data
+
     std::stringstream ss;
-    ss << "[ATTACK_DATA] P" << playerNum << " Move ID: " << moveID 
-       << " | Type: 0x" << std::hex << (int)attackTypeFlags << std::dec
-       << " (" << heightStr << ")"
-    << " | ActiveRemain: " << activeRemain
-       << " | Damage: " << damage
-       << " | Blockstun: " << blockstun
-       << " | Hitstop: " << hitstop;
-    
-    LogOut(ss.str(), true);
+    ss << "[ATTACK_DATA] P" << playerNum << " Move ID: " << moveID
+       << " | Height: " << AttackTable::HeightName(*m)
+       << " | Active: " << (int)m->firstActive << "+" << (int)m->activeFrames << "/" << (int)m->frames
+       << " | Damage: " << m->damage
+       << " | Blockstun: " << m->blockstun
+       << " | Hitstop: " << m->hitstop;
+
+    LogOut(ss.str(), detailedLogging.load());
 }
 
 AttackHeight AttackReader::GetAttackHeight(int playerPtr, short moveID) {
     if (moveID <= 0) {
         return ATTACK_HEIGHT_UNKNOWN;
     }
-    
-    // Need to find the move data pointer from playerPtr + moveID table
-    uintptr_t attackDataPtr = GetAttackDataPtr(playerPtr, moveID);
-    if (!attackDataPtr) {
-        return ATTACK_HEIGHT_UNKNOWN;
-    }
-    
-    // Attack type is at offset 170 in the attack data
-    int attackType = 0;
-    if (!SafeReadMemory(attackDataPtr + ATTACK_FLAGS_OFFSET, &attackType, sizeof(uint8_t))) {
+
+    uintptr_t ptr = static_cast<uintptr_t>(static_cast<uint32_t>(playerPtr));
+    int playerNum = (ptr == GetPlayerPointer(1)) ? 1 : ((ptr == GetPlayerPointer(2)) ? 2 : 0);
+    const AttackTable::MoveData* m = AttackTable::Lookup(playerNum, moveID);
+    if (!m) {
         return ATTACK_HEIGHT_UNKNOWN;
     }
-    
-    // Log the attack properties we found
-    LogOut(std::string("[ATTACK_READER] Attack height flags: 0x") + 
-           std::to_string(attackType) + " for moveID " + std::to_string(moveID), true);
-    
-    // Check flags in order of priority
-    if (attackType & 0x40 || attackType & 0x80)
+
+    // Same decode as the per-frame guard requirement (HIGH bit 0x1, LOW bit 0x2)
+    if (!(m->flags & AttackTable::Guardable))
         return ATTACK_HEIGHT_THROW; // Unblockable
-    else if (attackType & 0x01)
-        return ATTACK_HEIGHT_LOW;   // Low attack
-    else if (attackType & 0x04)
-        return ATTACK_HEIGHT_HIGH;  // High attack
-    else if (attackType & 0x02)
-        return ATTACK_HEIGHT_MID;   // Mid attack
-    
-    return ATTACK_HEIGHT_MID; // Default to mid if unknown
+    const bool high = (m->flags & AttackTable::High) != 0;
+    const bool low = (m->flags & AttackTable::Low) != 0;
+    if (high && !low)
+        return ATTACK_HEIGHT_HIGH;
+    if (low && !high)
+        return ATTACK_HEIGHT_LOW;
+    return ATTACK_HEIGHT_MID;   // guardable either way (or mixed heights across frames)
 }
 
 bool AttackReader::IsMoveActive(int playerPtr, short moveID) {
@@ -0,0 +1,206 @@
+#include "../include/game/attack_table.h"
+#include "../include/game/per_frame_sample.h"
+#include "../include/game/move_props.h"
+#include "../include/core/constants.h"
+#include "../include/core/memory.h"
+#include "../include/core/logger.h"
+#include "../include/core/task_scheduler.h"
+#include "../include/utils/utilities.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+
+namespace AttackTable {
+
+namespace {
+    constexpr uint32_t kChunkDelayUs = 1000;     // between scheduler runs of one build
+    constexpr int kPointerChunk = 64;            // anim table entries per read
+    static_assert(ANIM_ENTRY_STRIDE == 8 && ANIM_ENTRY_FRAMES_PTR_OFFSET == 4, "anim entry is two 32-bit words");
+
+    struct Table {
+        MoveData moves[kMaxMoveId];
+        int count;
+    };
+
+    // Published state: readers index s_tables[player][s_published[player]]
+    Table s_tables[2][2];
+    std::atomic<int> s_published[2] = { {-1}, {-1} };
+
+    // Frame monitor thread
+    uintptr_t s_wantAnimTab[2] = { 0, 0 };
+    std::atomic<uint32_t> s_generation[2] = { {0}, {0} };
+    TaskScheduler::TaskId s_task[2] = { TaskScheduler::kInvalidTask, TaskScheduler::kInvalidTask };
+
+    // Scheduler worker only (builds run serially there)
+    struct Build {
+        uint32_t  generation;
+        uintptr_t animTab;
+        int       buffer;
+        int       nextMove;
+        bool      pointersRead;
+        uint32_t  framesPtr[kMaxMoveId];
+        uint32_t  sorted[kMaxMoveId];    // distinct non-null frame pointers, ascending
+        int       sortedCount;
+    };
+    Build s_build[2];
+    int s_lastBuffer[2] = { 1, 1 };
+    uint8_t s_frameBuf[kMaxFramesPerMove * FRAME_BLOCK_STRIDE];
+
+    void ReadPointers(Build& b) {
+        memset(b.framesPtr, 0, sizeof(b.framesPtr));
+        uint32_t entries[kPointerChunk * 2];
+        for (int first = 0; first < kMaxMoveId; first += kPointerChunk) {
+            // A short table ends inside unreadable memory; keep what was read so far
+            if (!SafeReadMemory(b.animTab + static_cast<uintptr_t>(first) * ANIM_ENTRY_STRIDE, entries, sizeof(entries)))
+                break;
+            for (int i = 0; i < kPointerChunk; ++i)
+                b.framesPtr[first + i] = entries[i * 2 + ANIM_ENTRY_FRAMES_PTR_OFFSET / 4];
+        }
+        b.sortedCount = 0;
+        for (int id = 0; id < kMaxMoveId; ++id)
+            if (b.framesPtr[id]) b.sorted[b.sortedCount++] = b.framesPtr[id];
+        std::sort(b.sorted, b.sorted + b.sortedCount);
+        b.sortedCount = static_cast<int>(std::unique(b.sorted, b.sorted + b.sortedCount) - b.sorted);
+    }
+
+    int FrameLimit(const Build& b, uint32_t ptr) {
+        const uint32_t* next = std::upper_bound(b.sorted, b.sorted + b.sortedCount, ptr);
+        if (next == b.sorted + b.sortedCount) return kMaxFramesPerMove;
+        const uint32_t blocks = (*next - ptr) / FRAME_BLOCK_STRIDE;
+        return blocks == 0 ? 1 : static_cast<int>((std::min)(blocks, static_cast<uint32_t>(kMaxFramesPerMove)));
+    }
+
+    uint16_t Word(const uint8_t* block, int offset) {
+        uint16_t v;
+        memcpy(&v, block + offset, sizeof(v));
+        return v;
+    }
+
+    void ReadMove(const Build& b, short id, MoveData& out) {
+        out = MoveData{};
+        const uint32_t ptr = b.framesPtr[id];
+        int frames = FrameLimit(b, ptr);
+        if (!SafeReadMemory(ptr, s_frameBuf, static_cast<size_t>(frames) * FRAME_BLOCK_STRIDE)) {
+            // The array runs into unreadable memory: take the blocks that can be read one by one
+            int readable = 0;
+            while (readable < frames &&
+                   SafeReadMemory(ptr + static_cast<uint32_t>(readable) * FRAME_BLOCK_STRIDE,
+                                  s_frameBuf + readable * FRAME_BLOCK_STRIDE, FRAME_BLOCK_STRIDE))
+                ++readable;
+            frames = readable;
+        }
+
+        out.firstActive = 0xFF;
+        int f = 0;
+        for (; f < frames; ++f) {
+            const uint8_t* block = s_frameBuf + f * FRAME_BLOCK_STRIDE;
+            const uint16_t damage = Word(block, FRAME_DAMAGE_OFFSET);
+            const uint16_t guard = Word(block, FRAME_GUARD_PROPS_OFFSET);
+            const uint16_t hitstop = Word(block, FRAME_HITSTOP_OFFSET);
+            // Same bounds AttackReader used to reject random pointers: past them we left the move
+            if (damage > 5000 || guard > 1000 || hitstop > 1000) break;
+            if (!damage && !guard) continue;
+
+            const uint16_t attack = Word(block, FRAME_ATTACK_PROPS_OFFSET);
+            if (out.firstActive == 0xFF) out.firstActive = static_cast<uint8_t>(f);
+            out.activeFrames++;
+            out.activeMask[f >> 5] |= 1u << (f & 31);
+            out.damage = (std::max)(out.damage, damage);
+            out.blockstun = (std::max)(out.blockstun, guard);
+            out.hitstop = (std::max)(out.hitstop, hitstop);
+            if (guard) out.flags |= Guardable;
+            if (attack & 0x1) out.flags |= High;
+            if (attack & 0x2) out.flags |= Low;
+        }
+        out.frames = static_cast<uint8_t>(f);
+        if (f > 0) out.flags |= HasData;
+    }
+
+    uint32_t RunBuild(int p, uint32_t generation, uintptr_t animTab) {
+        if (generation != s_generation[p].load()) return TaskScheduler::kDone;   // superseded
+
+        Build& b = s_build[p];
+        if (b.generation != generation || b.animTab != animTab) {
+            b.generation = generation;
+            b.animTab = animTab;
+            b.buffer = s_lastBuffer[p] ^ 1;
+            b.nextMove = 0;
+            b.pointersRead = false;
+        }
+        Table& t = s_tables[p][b.buffer];
+        if (!b.pointersRead) {
+            ReadPointers(b);
+            memset(&t, 0, sizeof(t));
+            b.pointersRead = true;
+            return kChunkDelayUs;
+        }
+
+        int read = 0;
+        while (b.nextMove < kMaxMoveId && read < kMovesPerRun) {
+            const short id = static_cast<short>(b.nextMove++);
+            if (!b.framesPtr[id] || !MoveProps::Has(id, MoveProps::Attack)) continue;
+            ReadMove(b, id, t.moves[id]);
+            if (t.moves[id].activeFrames) t.count++;
+            ++read;
+        }
+        if (b.nextMove < kMaxMoveId) return kChunkDelayUs;
+
+        if (generation == s_generation[p].load()) {
+            s_lastBuffer[p] = b.buffer;
+            s_published[p].store(b.buffer);
+            std::ostringstream oss;
+            oss << "[ATTACK_TABLE] P" << (p + 1) << " ready: " << t.count << " attack moves (anim table 0x"
+                << std::hex << animTab << ")";
+            LogOut(oss.str(), detailedLogging.load());
+        }
+        return TaskScheduler::kDone;
+    }
+}
+
+void Update(const PerFrameSample& sample) {
+    for (int p = 0; p < 2; ++p) {
+        const PlayerSnapshot& ps = sample.Player(p + 1);
+        if (!ps.valid) continue;
+        const uintptr_t animTab = ps.Get<uint32_t>(ANIM_TABLE_OFFSET);
+        if (animTab == s_wantAnimTab[p]) continue;
+
+        // New character data: drop the old table now, rebuild in the background
+        s_wantAnimTab[p] = animTab;
+        s_published[p].store(-1);
+        const uint32_t generation = s_generation[p].fetch_add(1) + 1;
+        TaskScheduler::Cancel(s_task[p]);
+        s_task[p] = TaskScheduler::kInvalidTask;
+        if (!animTab) continue;
+        s_task[p] = TaskScheduler::Schedule(p == 0 ? "AttackTableP1" : "AttackTableP2", 0,
+            [p, generation, animTab]() { return RunBuild(p, generation, animTab); });
+    }
+}
+
+const MoveData* Lookup(int player, short moveID) {
+    if ((player != 1 && player != 2) || moveID < 0 || moveID >= kMaxMoveId) return nullptr;
+    const int buffer = s_published[player - 1].load();
+    if (buffer < 0) return nullptr;
+    const MoveData& m = s_tables[player - 1][buffer].moves[moveID];
+    return m.activeFrames ? &m : nullptr;
+}
+
+bool IsReady(int player) {
+    return (player == 1 || player == 2) && s_published[player - 1].load() >= 0;
+}
+
+int MoveCount(int player) {
+    if (player != 1 && player != 2) return 0;
+    const int buffer = s_published[player - 1].load();
+    return buffer < 0 ? 0 : s_tables[player - 1][buffer].count;
+}
+
+const char* HeightName(const MoveData& m) {
+    if (!(m.flags & Guardable)) return "UNBLOCKABLE";
+    if ((m.flags & High) && (m.flags & Low)) return "HIGH/LOW";
+    if (m.flags & High) return "HIGH";
+    if (m.flags & Low) return "LOW";
+    return "ANY";
+}
+
+} // namespace AttackTable
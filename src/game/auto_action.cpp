@@ -671,18 +671,13 @@ static inline bool AutoActionWorkPending() {
 
 
 bool IsCharacterGrounded(int playerNum) {
-    uintptr_t base = GetEFZBase();
-    if (!base) return true; // Default to true if can't check
-    
-    uintptr_t playerOffset = (playerNum == 1) ? EFZ_BASE_OFFSET_P1 : EFZ_BASE_OFFSET_P2;
-    uintptr_t yAddr = ResolvePointer(base, playerOffset, YPOS_OFFSET);
-    uintptr_t yVelAddr = ResolvePointer(base, playerOffset, YVEL_OFFSET);
-    
-    if (!yAddr || !yVelAddr) return true; // Default to true if can't check
+    uintptr_t pBase = GetPlayerBase(playerNum);
+    if (!pBase) return true; // Default to true if can't check
     
+    // Served from the tick snapshot when called on the frame monitor thread
     double yPos = 0.0, yVel = 0.0;
-    SafeReadMemory(yAddr, &yPos, sizeof(double));
-    SafeReadMemory(yVelAddr, &yVel, sizeof(double));
+    ReadSampledPlayerField(pBase, YPOS_OFFSET, yPos);
+    ReadSampledPlayerField(pBase, YVEL_OFFSET, yVel);
     
     // Character is considered grounded when very close to y=0 and not moving vertically
     return (yPos <= 0.1 && fabs(yVel) < 0.1);
@@ -1097,6 +1092,15 @@ static void MonitorAutoActionsImpl(short moveID1, short moveID2, short prevMoveI
         }
         return false;
     };
+    // Randomize gate for the wake pre-arm paths (a condition rather than a goto: the pre-arm bodies
+    // declare initialized locals, and jumping past them is ill-formed outside MSVC)
+    auto wakePrearmSkippedByRandomGate = [&](const char* who) -> bool {
+        if (!triggerRandomizeEnabled.load() || (rand() & 1) != 0) return false;
+        if (detailedLogging.load() && canLogTrigDiag()) {
+            LogOut(std::string("[AUTO-ACTION] ") + who + " Wake prearm skipped by random gate", true);
+        }
+        return true;
+    };
     
     // P1 triggers
     if ((targetPlayer == 1 || targetPlayer == 3) && !p1DelayState.isDelaying && !p1ActionApplied) {
@@ -1261,8 +1265,7 @@ static void MonitorAutoActionsImpl(short moveID1, short moveID2, short prevMoveI
         // reversals. In that case we skip pre-arm entirely and let StartTriggerDelay
         // handle immediate macro playback on the first actionable wake frame.
     if (triggerOnWakeupEnabled.load() && !s_p1WakePrearmed) {
-            if (moveID1 == GROUNDTECH_RECOVERY) {
-                if (triggerRandomizeEnabled.load()) { if ((rand() & 1) == 0) { if (detailedLogging.load() && canLogTrigDiag()) LogOut("[AUTO-ACTION] P1 Wake prearm skipped by random gate", true); goto p1_wake_prearm_done; } }
+            if (moveID1 == GROUNDTECH_RECOVERY && !wakePrearmSkippedByRandomGate("P1")) {
                 int actionType = triggerOnWakeupAction.load();
                 int motionType = ConvertTriggerActionToMotion(actionType, TRIGGER_ON_WAKEUP);
                 int userDelayF = triggerOnWakeupDelay.load();
@@ -1302,7 +1305,6 @@ static void MonitorAutoActionsImpl(short moveID1, short moveID2, short prevMoveI
                 } else if (detailedLogging.load()) {
                     LogOut("[AUTO-ACTION] P1 wake pre-arm skipped (delay>0 or unsupported action)", true);
                 }
-            p1_wake_prearm_done: ;
             }
         }
 
@@ -1876,16 +1878,7 @@ static void MonitorAutoActionsImpl(short moveID1, short moveID2, short prevMoveI
 
     // Standard wake pre-arm path for specials/holds (non-macro).
     if (triggerOnWakeupEnabled.load() && !s_p2WakePrearmed) {
-            if (moveID2 == GROUNDTECH_RECOVERY) {
-                if (triggerRandomizeEnabled.load()) {
-                    if ((rand() & 1) == 0) {
-                        if (detailedLogging.load() && canLogTrigDiag()) {
-                            LogOut("[AUTO-ACTION] P2 Wake prearm skipped by random gate", true);
-                        }
-                        goto p2_wake_prearm_done;
-                    }
-                }
-
+            if (moveID2 == GROUNDTECH_RECOVERY && !wakePrearmSkippedByRandomGate("P2")) {
                 // Determine the selected action row (if any) for wake pre-arm.
                 int userDelayF = s_p2WakeOptionPicked ? s_p2WakePrePickedOption.delay : triggerOnWakeupDelay.load();
                 if (s_p2WakeOptionPicked) {
@@ -1946,7 +1939,6 @@ static void MonitorAutoActionsImpl(short moveID1, short moveID2, short prevMoveI
                     }
                     LogOut("[AUTO-ACTION] P2 wake pre-arm skipped (" + reason + ")", true);
                 }
-            p2_wake_prearm_done: ;
             }
         }
 
@@ -3307,8 +3299,8 @@ void ProcessAutoControlRestore() {
         // No timeout-based fallback: rely on dash age and state only
     if (g_recentDashQueued.load() && moveID2 == 0 && !sawNonZeroMoveID) {
             int age = frameCounter.load() - g_recentDashQueuedFrame.load();
-            extern int p2CurrentMotionType; extern bool p2QueueActive; extern int p2QueueIndex; extern int p2FrameCounter; extern std::vector<InputFrame> p2InputQueue;
-            int qSize = (int)p2InputQueue.size();
+            extern int p2CurrentMotionType; extern bool p2QueueActive; extern int p2QueueIndex; extern int p2FrameCounter;
+            int qSize = g_motionQueue[2].length;
             // Throttle noisy trace logs behind detailedLogging to reduce idle overhead
             if (detailedLogging.load()) {
                 static int s_nextDashTraceLogFrame = 0; // ~8 logs/sec at 192Hz
@@ -3321,7 +3313,7 @@ void ProcessAutoControlRestore() {
                            " frameInStep=" + std::to_string(p2FrameCounter) +
                            " motionType=" + std::to_string(p2CurrentMotionType), true);
                     if (p2QueueActive && p2QueueIndex < qSize) {
-                        uint8_t mask = p2InputQueue[p2QueueIndex].inputMask;
+                        uint8_t mask = GetQueuedMotionMask(2);
                         LogOut(std::string("[AUTO-ACTION][DASH][TRACE] current mask=") + std::to_string((int)mask), true);
                     }
                 }
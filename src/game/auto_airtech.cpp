@@ -1,5 +1,6 @@
 #include "../include/game/auto_airtech.h"
 #include "../include/core/constants.h"
+#include "../include/game/move_props.h"
 #include "../include/utils/utilities.h"
 #include "../include/utils/network.h"
 #include "../include/game/game_state.h"
@@ -79,8 +80,7 @@ bool IsPlayerAirtechable(short moveID, int playerNum) {
     
     // Check moveID for airtechable states: launched hitstun or special stun only
     // Do NOT include AIR_GUARD to avoid spurious triggers while air-blocking
-    bool airtechableMoveID = (moveID >= LAUNCHED_HITSTUN_START && moveID <= LAUNCHED_HITSTUN_END) ||
-                             (moveID == FIRE_STATE || moveID == ELECTRIC_STATE);
+    bool airtechableMoveID = MoveProps::Has(moveID, MoveProps::AirtechableMove);
     
     // Untech value == 0 means player can tech
     // AND moveID should be in an airtechable state
@@ -89,7 +89,7 @@ bool IsPlayerAirtechable(short moveID, int playerNum) {
 
 // Check if player is in airtech animation
 bool IsAirtechAnimation(short moveID) {
-    return moveID == FORWARD_AIRTECH || moveID == BACKWARD_AIRTECH;
+    return MoveProps::Has(moveID, MoveProps::Airtech);
 }
 
 void MonitorAutoAirtech(short moveID1, short moveID2) {
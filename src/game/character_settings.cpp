@@ -1,9 +1,11 @@
 #include "../include/game/character_settings.h"
 #include "../include/core/constants.h"
 #include "../include/core/memory.h"
+#include "../include/core/memory_txn.h"
 #include "../include/core/logger.h"
 #include "../include/game/game_state.h"
 #include "../include/game/frame_monitor.h"
+#include "../include/game/per_frame_sample.h"
 #include "../include/utils/utilities.h"
 #include "../include/core/globals.h"
 #include <atomic>
@@ -11,10 +13,10 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <unordered_map>
 #include <thread>
 #include <atomic>
-#include "../include/gui/imgui_impl.h"
 #include <chrono>
 #include <sstream>
 
@@ -781,6 +783,8 @@ namespace CharacterSettings {
     }
     
     void ApplyCharacterValues(uintptr_t base, const DisplayData& data) {
+        // Collect every character write into one batch (committed on return)
+        MemoryWriteTxn txn;
         // Ensure pointer caches have correct base for this session
         if (base) {
             if (s_pointersP1.base == 0 || s_pointersP1.base != base + EFZ_BASE_OFFSET_P1) {
@@ -1030,6 +1034,8 @@ namespace CharacterSettings {
                 // Call the engine function toggleCharacterMode(char* this, int unusedEDX, char targetMode) using __fastcall
                 using ToggleModeFn = int(__fastcall*)(uintptr_t /*this*/, int /*edx_unused*/, char /*targetMode*/);
                 ToggleModeFn ToggleCharacterMode = reinterpret_cast<ToggleModeFn>(gameBase + TOGGLE_CHARACTER_MODE_RVA);
+                // The engine reads memory directly: flush anything still pending first
+                txn.Commit();
                 ToggleCharacterMode(playerThis, 0, (char)desiredMode);
                 usedEngine = true;
             }
@@ -1371,6 +1377,13 @@ namespace CharacterSettings {
 
         bool didWriteThisTick = false;
 
+        // The move ID is the only field read here that lies inside the per-frame player snapshot
+        // (ReadSampledPlayerField). Resource timers/counters at 0x31xx-0x34xx and the puppet slot
+        // array past 0x4D0 are outside the window and are still read directly.
+        auto sampledMoveId = [&](int pi, short& mv) {
+            return ReadSampledPlayerField(GetPlayerBase(pi), MOVE_ID_OFFSET, mv);
+        };
+
         // Ikumi genocide timer keeper
         if (localData.infiniteBloodMode) {
             if (localData.p1CharID == CHAR_ID_IKUMI) {
@@ -1428,8 +1441,7 @@ namespace CharacterSettings {
 
                 // Detect supers that consume a feather and replenish by +1 (up to max)
                 short mv = 0;
-                if (auto mvAddr = ResolvePointer(base, off, MOVE_ID_OFFSET)) {
-                    SafeReadMemory(mvAddr, &mv, sizeof(short));
+                if (sampledMoveId(pi, mv)) {
                     if (mv == 313 || mv == 314 || mv == 315) {
                         if (auto addr = ResolvePointer(base, off, MISUZU_FEATHER_OFFSET)) {
                             int cur = 0; SafeReadMemory(addr, &cur, sizeof(int));
@@ -1478,7 +1490,7 @@ namespace CharacterSettings {
             if (!(modeAddr && gateAddr)) return;
             uint8_t curMode=0, curGate=0; SafeReadMemory(modeAddr,&curMode,sizeof(uint8_t)); SafeReadMemory(gateAddr,&curGate,sizeof(uint8_t));
             if (curGate != 0) { uint8_t z=0; SafeWriteMemory(gateAddr,&z,sizeof(uint8_t)); didWriteThisTick = true; }
-            short mv=0; if (auto mvAddr = ResolvePointer(base, off, MOVE_ID_OFFSET)) SafeReadMemory(mvAddr,&mv,sizeof(short));
+            short mv=0; sampledMoveId(pi, mv);
             bool inTossSuper = (mv == RUMI_SUPER_TOSS_A || mv == RUMI_SUPER_TOSS_B || mv == RUMI_SUPER_TOSS_C);
             int &delayRef = (pi==1)?p1RestoreDelay:p2RestoreDelay;
             if (inTossSuper) { delayRef = 60; return; }
@@ -1487,7 +1499,7 @@ namespace CharacterSettings {
                 using ToggleModeFn = int(__fastcall*)(uintptr_t, int, char);
                 uintptr_t gameBase = GetEFZBase();
                 ToggleModeFn ToggleCharacterMode = reinterpret_cast<ToggleModeFn>(gameBase + TOGGLE_CHARACTER_MODE_RVA);
-                uintptr_t playerThis = 0; SafeReadMemory(gameBase + ((pi==1)?EFZ_BASE_OFFSET_P1:EFZ_BASE_OFFSET_P2), &playerThis, sizeof(uintptr_t));
+                uintptr_t playerThis = GetPlayerBase(pi);
                 if (!playerThis) return; ToggleCharacterMode(playerThis, 0, 0); uint8_t z2=0; SafeWriteMemory(gateAddr,&z2,sizeof(uint8_t)); didWriteThisTick = true;
             }
         }; if (AreCharactersInitialized()) { enforceRumi(1); enforceRumi(2); }
@@ -1580,10 +1592,8 @@ namespace CharacterSettings {
             if ((pi==1 && localData.p1CharID != CHAR_ID_NAYUKI) || (pi==2 && localData.p2CharID != CHAR_ID_NAYUKI)) return;
             const int off = (pi==1)?EFZ_BASE_OFFSET_P1:EFZ_BASE_OFFSET_P2;
             // Check if player is in groundtech recovery state (moveID 96)
-            auto mvAddr = ResolvePointer(base, off, MOVE_ID_OFFSET);
-            if (!mvAddr) return;
-            short moveId = 0; SafeReadMemory(mvAddr, &moveId, sizeof(moveId));
-            if (moveId != GROUNDTECH_RECOVERY) return;
+            short moveId = 0;
+            if (!sampledMoveId(pi, moveId) || moveId != GROUNDTECH_RECOVERY) return;
             // Restore jam count to locked value
             auto addr = ResolvePointer(base, off, NEYUKI_JAM_COUNT_OFFSET); if (!addr) return;
             int want = (pi==1)?localData.p1NeyukiJamCount:localData.p2NeyukiJamCount;
@@ -1677,8 +1687,7 @@ namespace CharacterSettings {
             bool isMinagi = (pi==1)?(localData.p1CharID==CHAR_ID_MINAGI):(localData.p2CharID==CHAR_ID_MINAGI);
             bool wantReadied = (pi==1)?localData.p1MinagiAlwaysReadied:localData.p2MinagiAlwaysReadied;
             if (!(isMinagi && wantReadied)) return;
-            const int off = (pi==1)?EFZ_BASE_OFFSET_P1:EFZ_BASE_OFFSET_P2;
-            uintptr_t playerBase = 0; SafeReadMemory(base + off, &playerBase, sizeof(playerBase)); if (!playerBase) return;
+            const uintptr_t playerBase = GetPlayerBase(pi); if (!playerBase) return;
             for (int i=0;i<MINAGI_PUPPET_SLOT_MAX_SCAN;i++) {
                 uintptr_t slot = playerBase + MINAGI_PUPPET_SLOTS_BASE + (uintptr_t)i*MINAGI_PUPPET_SLOT_STRIDE;
                 uint16_t id=0; if (!SafeReadMemory(slot + MINAGI_PUPPET_SLOT_ID_OFFSET, &id, sizeof(id))) continue;
@@ -1705,9 +1714,8 @@ namespace CharacterSettings {
             auto convertSlots = [&](int pi){
                 bool isMinagi = (pi==1)?(localData.p1CharID==CHAR_ID_MINAGI):(localData.p2CharID==CHAR_ID_MINAGI);
                 if (!isMinagi) return;
-                const int off = (pi==1)?EFZ_BASE_OFFSET_P1:EFZ_BASE_OFFSET_P2;
-                uintptr_t playerBase = 0; SafeReadMemory(base + off, &playerBase, sizeof(playerBase)); if (!playerBase) return;
-                short moveId=0; if (auto mv = ResolvePointer(base, off, MOVE_ID_OFFSET)) SafeReadMemory(mv,&moveId,sizeof(moveId));
+                const uintptr_t playerBase = GetPlayerBase(pi); if (!playerBase) return;
+                short moveId=0; ReadSampledPlayerField(playerBase, MOVE_ID_OFFSET, moveId);
                 // Only act during the specified animations to avoid touching character core states
                 auto isConversionMove = [](short mv)->bool {
                     return (mv >= 429 && mv <= 432) ||
@@ -1738,8 +1746,7 @@ namespace CharacterSettings {
             bool applyNow = (pi==1)?localData.p1MinagiApplyPos:localData.p2MinagiApplyPos;
             if (!applyNow) return;
             if (std::isnan(setX) || std::isnan(setY)) return;
-            const int off = (pi==1)?EFZ_BASE_OFFSET_P1:EFZ_BASE_OFFSET_P2;
-            uintptr_t playerBase = 0; SafeReadMemory(base + off, &playerBase, sizeof(playerBase)); if (!playerBase) return;
+            const uintptr_t playerBase = GetPlayerBase(pi); if (!playerBase) return;
             for (int i=0;i<MINAGI_PUPPET_SLOT_MAX_SCAN;i++) {
                 uintptr_t slot = playerBase + MINAGI_PUPPET_SLOTS_BASE + (uintptr_t)i*MINAGI_PUPPET_SLOT_STRIDE;
                 uint16_t id=0; if (!SafeReadMemory(slot + MINAGI_PUPPET_SLOT_ID_OFFSET, &id, sizeof(id))) continue;
@@ -1,5 +1,6 @@
 #include "../include/game/collision_hook.h"
 #include "../include/core/logger.h"
+#include "../include/core/fast_log.h"
 #include "../include/core/memory.h"
 #include "../include/utils/utilities.h"
 #include "../include/input/input_core.h"
@@ -12,6 +13,8 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <emmintrin.h>
+#include <intrin.h>
 #include "../include/core/constants.h"
 #include "../include/gui/overlay.h"
 
@@ -28,26 +31,72 @@ static std::atomic<uintptr_t> g_lastAttackDataP2{0};
 static std::atomic<int> g_attackDataOffsetP1{-1};
 static std::atomic<int> g_attackDataOffsetP2{-1};
 
-// Identify which player owns this frame-data by scanning both player bases for a matching field.
+// Size of the player struct window searched for the frame-data pointer field
+static constexpr int FRAME_DATA_SCAN_BYTES = 0x1200;
+
+// Last frame-data pointer that matched neither player (projectiles/helpers); skips repeat rescans
+static uintptr_t g_lastUnownedFrameData = 0;
+static uintptr_t g_lastUnownedP1 = 0, g_lastUnownedP2 = 0;
+
+// O(1) check of a previously learned offset: one guarded read of the field
+static bool MatchesLearnedOffset(uintptr_t playerBase, int off, uintptr_t frameDataPtr) {
+    if (!playerBase || off < 0) return false;
+    uint32_t candidate = 0;
+    return SafeReadMemory(playerBase + off, &candidate, sizeof(candidate)) && candidate == (uint32_t)frameDataPtr;
+}
+
+// Full scan: one bulk copy of the struct window, then a 16-byte SSE2 compare over aligned dwords
+static int ScanPlayerForFrameData(uintptr_t playerBase, uintptr_t frameDataPtr) {
+    if (!playerBase) return -1;
+    alignas(16) uint32_t words[FRAME_DATA_SCAN_BYTES / 4];
+    if (!SafeReadMemory(playerBase, words, sizeof(words))) {
+        // Window straddles an unreadable page: fall back to per-field reads
+        for (int off = 0; off <= FRAME_DATA_SCAN_BYTES - 4; off += 4) {
+            uint32_t candidate = 0;
+            if (!SafeReadMemory(playerBase + off, &candidate, sizeof(candidate))) continue;
+            if (candidate == (uint32_t)frameDataPtr) return off;
+        }
+        return -1;
+    }
+    const __m128i needle = _mm_set1_epi32((int)(uint32_t)frameDataPtr);
+    for (int i = 0; i < FRAME_DATA_SCAN_BYTES / 4; i += 4) {
+        __m128i chunk = _mm_load_si128(reinterpret_cast<const __m128i*>(&words[i]));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(chunk, needle)));
+        if (mask) {
+            unsigned long lane = 0;
+            _BitScanForward(&lane, (unsigned long)mask);
+            return (i + (int)lane) * 4;
+        }
+    }
+    return -1;
+}
+
+// Identify which player owns this frame-data. Learned offsets are validated first (one read per player);
+// the struct scan only runs until the offset is discovered or when a pointer matches neither player.
 static void IdentifyPlayerByFrameData(uintptr_t frameDataPtr, int& outPlayerNum, int& outOffset) {
     outPlayerNum = 0; outOffset = -1;
     if (!frameDataPtr) return;
     uintptr_t p1 = GetPlayerPointer(1);
     uintptr_t p2 = GetPlayerPointer(2);
-    // scan first 0x600 bytes at 4-byte alignment
-    auto scan = [&](uintptr_t playerBase) -> int {
-        if (!playerBase) return -1;
-    for (int off = 0; off <= 0x1200 - 4; off += 4) {
-            uintptr_t candidate = 0;
-            if (!SafeReadMemory(playerBase + off, &candidate, sizeof(candidate))) continue;
-            if (candidate == frameDataPtr) return off;
-        }
-        return -1;
-    };
-    int off1 = scan(p1);
+
+    const int known1 = g_attackDataOffsetP1.load(std::memory_order_relaxed);
+    const int known2 = g_attackDataOffsetP2.load(std::memory_order_relaxed);
+    if (MatchesLearnedOffset(p1, known1, frameDataPtr)) { outPlayerNum = 1; outOffset = known1; return; }
+    if (MatchesLearnedOffset(p2, known2, frameDataPtr)) { outPlayerNum = 2; outOffset = known2; return; }
+
+    // Both offsets known and neither matched: not a player-owned pointer; don't rescan the same one
+    if (known1 >= 0 && known2 >= 0 && frameDataPtr == g_lastUnownedFrameData &&
+        p1 == g_lastUnownedP1 && p2 == g_lastUnownedP2) {
+        return;
+    }
+
+    int off1 = ScanPlayerForFrameData(p1, frameDataPtr);
     if (off1 >= 0) { outPlayerNum = 1; outOffset = off1; return; }
-    int off2 = scan(p2);
+    int off2 = ScanPlayerForFrameData(p2, frameDataPtr);
     if (off2 >= 0) { outPlayerNum = 2; outOffset = off2; return; }
+    g_lastUnownedFrameData = frameDataPtr;
+    g_lastUnownedP1 = p1;
+    g_lastUnownedP2 = p2;
 }
 
 // We use __fastcall wrapper to intercept __thiscall
@@ -68,18 +117,18 @@ static int __fastcall HookedHandleP2PCollision(void* gameSystem, void* /*edx*/,
             if (playerNum == 1) {
                 uintptr_t prev = g_lastAttackDataP1.exchange(frameData);
                 if (frameData && frameData != prev) {
-                    LogOut(std::string("[COLLISION_HOOK] P1 frameData=") + FormatHexAddress(frameData), true);
+                    EFZ_LOG(LogCat::CollisionHook, true, "[COLLISION_HOOK] P1 frameData=0x%X", frameData);
                 }
-                if (fdOff >= 0 && g_attackDataOffsetP1.load() < 0) {
+                if (fdOff >= 0 && g_attackDataOffsetP1.load() != fdOff) {
                     g_attackDataOffsetP1.store(fdOff);
                     LogOut("[COLLISION_HOOK] Discovered frameData offset P1: " + std::to_string(fdOff), true);
                 }
             } else if (playerNum == 2) {
                 uintptr_t prev = g_lastAttackDataP2.exchange(frameData);
                 if (frameData && frameData != prev) {
-                    LogOut(std::string("[COLLISION_HOOK] P2 frameData=") + FormatHexAddress(frameData), true);
+                    EFZ_LOG(LogCat::CollisionHook, true, "[COLLISION_HOOK] P2 frameData=0x%X", frameData);
                 }
-                if (fdOff >= 0 && g_attackDataOffsetP2.load() < 0) {
+                if (fdOff >= 0 && g_attackDataOffsetP2.load() != fdOff) {
                     g_attackDataOffsetP2.store(fdOff);
                     LogOut("[COLLISION_HOOK] Discovered frameData offset P2: " + std::to_string(fdOff), true);
                 }
@@ -87,13 +136,6 @@ static int __fastcall HookedHandleP2PCollision(void* gameSystem, void* /*edx*/,
         }
     }
 
-    // Read pre-call defender HP to detect damage that happens during the call
-    uintptr_t p1b = GetPlayerPointer(1);
-    uintptr_t p2b = GetPlayerPointer(2);
-    int preHpP1 = 0, preHpP2 = 0;
-    if (p1b) { SafeReadMemory(p1b + HP_OFFSET, &preHpP1, sizeof(preHpP1)); }
-    if (p2b) { SafeReadMemory(p2b + HP_OFFSET, &preHpP2, sizeof(preHpP2)); }
-
     int ret = oHandleP2PCollision(gameSystem, attackerPtr, defenderPtr, attackerFrameData, defenderFrameData);
 
         // Clean Hit rendering handled in frame_monitor via HP-drop detection; no-op here to avoid duplication
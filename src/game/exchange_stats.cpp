@@ -0,0 +1,344 @@
+#include "../include/game/exchange_stats.h"
+#include "../include/utils/config.h"
+#include "../include/core/logger.h"
+#include "../include/utils/utilities.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace ExchangeStats {
+
+namespace {
+    // Columnar ring: row r of the session lives at r % kCapacity in every column
+    struct Columns {
+        int      frame[kCapacity];
+        uint8_t  attacker[kCapacity];
+        uint8_t  outcome[kCapacity];
+        short    attackerMove[kCapacity];
+        short    defenderMove[kCapacity];
+        int16_t  advantage[kCapacity];
+        int16_t  gap[kCapacity];
+        int16_t  rgFa1[kCapacity];
+        int16_t  rgFa2[kCapacity];
+        Position attackerPos[kCapacity];
+        Position defenderPos[kCapacity];
+    };
+
+    struct MoveAggregate {
+        uint32_t count;
+        uint32_t blocks;
+        uint32_t hits;
+        uint32_t withAdvantage;
+        int      advantageMin;
+        int      advantageMax;
+        int64_t  advantageSum;
+    };
+
+    struct Pending {
+        bool open;
+        Row  row;
+    };
+
+    std::mutex s_mutex;
+    Columns s_cols;
+    Summary s_summary;
+    MoveAggregate s_moves[2][kMaxMoveId];
+    Pending s_pending[2];
+    int16_t s_gapAtFrame[2];           // Gap reported for the attacker on s_gapFrame[]
+    int s_gapFrame[2] = { -1, -1 };
+    int s_rgEdgeFrame[2] = { -1, -1 };  // defender's last recoil guard edge
+    int s_lastRow[2] = { -1, -1 };      // newest committed row id per attacker (RG results arrive late)
+
+    constexpr int kRgConnectWindow = 6; // internal frames between the RG edge and the lockout connect
+
+    int16_t Clamp16(int v) {
+        if (v <= INT16_MIN) return INT16_MIN + 1;
+        if (v > INT16_MAX) return INT16_MAX;
+        return static_cast<int16_t>(v);
+    }
+
+    int Bin(int internal, int lo, int hi) {
+        const int f = internal / 3;     // truncates toward zero
+        return f < lo ? lo : (f > hi ? hi : f);
+    }
+
+    Outcome FromConnect(FrameAdvantageEngine::ConnectKind k) {
+        switch (k) {
+        case FrameAdvantageEngine::ConnectKind::Block:  return Outcome::Block;
+        case FrameAdvantageEngine::ConnectKind::Hit:    return Outcome::Hit;
+        case FrameAdvantageEngine::ConnectKind::Thrown: return Outcome::Thrown;
+        default:                                        return Outcome::Lockout;
+        }
+    }
+
+    // s_mutex held
+    void Commit(int a) {
+        Pending& p = s_pending[a];
+        if (!p.open) return;
+        p.open = false;
+        Row& r = p.row;
+        r.id = s_summary.total;
+        const int slot = static_cast<int>(r.id % kCapacity);
+        s_cols.frame[slot] = r.frame;
+        s_cols.attacker[slot] = r.attacker;
+        s_cols.outcome[slot] = static_cast<uint8_t>(r.outcome);
+        s_cols.attackerMove[slot] = r.attackerMove;
+        s_cols.defenderMove[slot] = r.defenderMove;
+        s_cols.advantage[slot] = r.advantage;
+        s_cols.gap[slot] = r.gap;
+        s_cols.rgFa1[slot] = r.rgFa1;
+        s_cols.rgFa2[slot] = r.rgFa2;
+        s_cols.attackerPos[slot] = r.attackerPos;
+        s_cols.defenderPos[slot] = r.defenderPos;
+        s_lastRow[a] = static_cast<int>(r.id);
+
+        Summary& s = s_summary;
+        ++s.total;
+        if (s.stored < (uint32_t)kCapacity) ++s.stored;
+        ++s.byOutcome[(int)r.outcome];
+        if (r.gap != kNone) {
+            ++s.gaps;
+            ++s.gapBins[Bin(r.gap, 0, kGapBins - 1)];
+        }
+        if (r.advantage != kNone) {
+            ++s.withAdvantage;
+            if (r.outcome == Outcome::Block)
+                ++s.advantageBins[Bin(r.advantage, -kAdvantageRange, kAdvantageRange) + kAdvantageRange];
+        }
+
+        if (r.attackerMove < 0 || r.attackerMove >= kMaxMoveId) return;
+        MoveAggregate& m = s_moves[a][r.attackerMove];
+        ++m.count;
+        if (r.outcome == Outcome::Block) ++m.blocks;
+        if (r.outcome == Outcome::Hit) ++m.hits;
+        if (r.advantage != kNone) {
+            if (m.withAdvantage == 0 || r.advantage < m.advantageMin) m.advantageMin = r.advantage;
+            if (m.withAdvantage == 0 || r.advantage > m.advantageMax) m.advantageMax = r.advantage;
+            m.advantageSum += r.advantage;
+            ++m.withAdvantage;
+        }
+    }
+
+    std::string DefaultCsvPath() {
+        std::string cfg = Config::GetConfigFilePath();
+        size_t slash = cfg.find_last_of("\\/");
+        if (slash == std::string::npos) return "efz_exchanges.csv";
+        return cfg.substr(0, slash + 1) + "efz_exchanges.csv";
+    }
+
+    void WriteValue(std::ofstream& f, int16_t v) {
+        if (v != kNone) f << v;
+    }
+}
+
+void OnEngineEvent(const FrameAdvantageEngine::Event& e, const FrameAdvantageEngine::Input& in, const Position pos[2]) {
+    using FrameAdvantageEngine::EventKind;
+    if (e.kind == EventKind::NewAction) return;
+    const int a = e.player - 1;
+    std::lock_guard<std::mutex> lock(s_mutex);
+    switch (e.kind) {
+    case EventKind::RecoilGuard:
+        s_rgEdgeFrame[a] = e.frame;
+        break;
+
+    case EventKind::Gap:
+        // The engine reports the gap just before the connect it ends
+        s_gapAtFrame[a] = Clamp16(e.value);
+        s_gapFrame[a] = e.frame;
+        break;
+
+    case EventKind::Connect: {
+        const int d = 1 - a;
+        Commit(a);      // previous hit of a string or combo
+        Commit(d);      // the defender's own exchange was interrupted
+        Row& r = s_pending[a].row;
+        r = Row{};
+        r.frame = e.frame;
+        r.attacker = e.player;
+        r.outcome = FromConnect(e.connect);
+        if (s_rgEdgeFrame[d] >= 0 && e.frame - s_rgEdgeFrame[d] <= kRgConnectWindow) r.outcome = Outcome::RecoilGuard;
+        r.attackerMove = in.moveID[a];
+        r.defenderMove = in.moveID[d];
+        r.advantage = kNone;
+        r.gap = s_gapFrame[a] == e.frame ? s_gapAtFrame[a] : kNone;
+        r.rgFa1 = kNone;
+        r.rgFa2 = kNone;
+        r.attackerPos = pos[a];
+        r.defenderPos = pos[d];
+        s_pending[a].open = true;
+        break;
+    }
+
+    case EventKind::FrameAdvantage:
+        if (!s_pending[a].open) break;
+        s_pending[a].row.advantage = Clamp16(e.value);
+        Commit(a);
+        break;
+
+    case EventKind::StaleReset:
+        Commit(0);
+        Commit(1);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void OnRecoilGuardResult(int defender, int fa1, int fa2) {
+    if (defender != 1 && defender != 2) return;
+    const int a = 2 - defender;     // attacker index
+    std::lock_guard<std::mutex> lock(s_mutex);
+    Pending& p = s_pending[a];
+    if (p.open && p.row.outcome == Outcome::RecoilGuard) {
+        p.row.rgFa1 = Clamp16(fa1);
+        p.row.rgFa2 = Clamp16(fa2);
+        return;
+    }
+    // Already closed by the engine's advantage on the same tick: patch the stored row if still in the ring
+    const int id = s_lastRow[a];
+    if (id < 0 || s_summary.total - (uint32_t)id > (uint32_t)kCapacity) return;
+    const int slot = id % kCapacity;
+    if (s_cols.outcome[slot] != (uint8_t)Outcome::RecoilGuard || s_cols.rgFa1[slot] != kNone) return;
+    s_cols.rgFa1[slot] = Clamp16(fa1);
+    s_cols.rgFa2[slot] = Clamp16(fa2);
+}
+
+void DiscardPending() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_pending[0].open = false;
+    s_pending[1].open = false;
+}
+
+void Reset() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_summary = Summary{};
+    memset(s_moves, 0, sizeof(s_moves));
+    for (int p = 0; p < 2; ++p) {
+        s_pending[p].open = false;
+        s_gapFrame[p] = -1;
+        s_rgEdgeFrame[p] = -1;
+        s_lastRow[p] = -1;
+    }
+    LogOut("[EXCHANGE] Session statistics reset", detailedLogging.load());
+}
+
+Summary GetSummary() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_summary;
+}
+
+uint32_t PunishableGaps(const Summary& s, int frames) {
+    uint32_t n = 0;
+    for (int i = (std::max)(frames, 0); i < kGapBins; ++i) n += s.gapBins[i];
+    return n;
+}
+
+uint32_t PunishableBlocks(const Summary& s, int frames) {
+    uint32_t n = 0;
+    for (int i = 0; i < kAdvantageBins && i - kAdvantageRange <= -frames; ++i) n += s.advantageBins[i];
+    return n;
+}
+
+int CopyMoveStats(MoveStats* out, int max) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    int n = 0;
+    for (int p = 0; p < 2; ++p) {
+        for (int id = 0; id < kMaxMoveId && n < max; ++id) {
+            const MoveAggregate& m = s_moves[p][id];
+            if (!m.count) continue;
+            out[n++] = MoveStats{ static_cast<uint8_t>(p + 1), static_cast<short>(id), m.count, m.blocks, m.hits,
+                                  m.withAdvantage, m.advantageMin, m.advantageMax, m.advantageSum };
+        }
+    }
+    return n;
+}
+
+int CopyRecent(Row* out, int max) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    int n = 0;
+    for (uint32_t i = 0; i < s_summary.stored && n < max; ++i) {
+        const uint32_t id = s_summary.total - 1 - i;
+        const int slot = static_cast<int>(id % kCapacity);
+        Row& r = out[n++];
+        r.id = id;
+        r.frame = s_cols.frame[slot];
+        r.attacker = s_cols.attacker[slot];
+        r.outcome = static_cast<Outcome>(s_cols.outcome[slot]);
+        r.attackerMove = s_cols.attackerMove[slot];
+        r.defenderMove = s_cols.defenderMove[slot];
+        r.advantage = s_cols.advantage[slot];
+        r.gap = s_cols.gap[slot];
+        r.rgFa1 = s_cols.rgFa1[slot];
+        r.rgFa2 = s_cols.rgFa2[slot];
+        r.attackerPos = s_cols.attackerPos[slot];
+        r.defenderPos = s_cols.defenderPos[slot];
+    }
+    return n;
+}
+
+const char* OutcomeName(Outcome o) {
+    switch (o) {
+    case Outcome::Block:       return "Block";
+    case Outcome::Hit:         return "Hit";
+    case Outcome::Thrown:      return "Thrown";
+    case Outcome::Lockout:     return "Lockout";
+    case Outcome::RecoilGuard: return "RG";
+    default:                   return "?";
+    }
+}
+
+bool ExportCsv(const std::string& path, std::string* writtenPath) {
+    // Copy under the lock, write without it: the frame monitor may record while the file is written
+    std::unique_ptr<Columns> cols(new Columns);
+    Summary summary;
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        *cols = s_cols;
+        summary = s_summary;
+    }
+    std::unique_ptr<MoveStats[]> moves(new MoveStats[2 * kMaxMoveId]);
+    const int moveCount = CopyMoveStats(moves.get(), 2 * kMaxMoveId);
+
+    const std::string target = path.empty() ? DefaultCsvPath() : path;
+    std::ofstream f(target, std::ios::out | std::ios::trunc);
+    if (!f.is_open()) {
+        LogOut("[EXCHANGE] Failed to open " + target + " for writing", true);
+        return false;
+    }
+    f << "id,frame,attacker,outcome,attacker_move,defender_move,advantage,gap,rg_fa1,rg_fa2,"
+         "attacker_x,attacker_y,defender_x,defender_y\n";
+    for (uint32_t i = summary.stored; i > 0; --i) {
+        const uint32_t id = summary.total - i;
+        const int slot = static_cast<int>(id % kCapacity);
+        f << id << ',' << cols->frame[slot] << ',' << (int)cols->attacker[slot] << ','
+          << OutcomeName(static_cast<Outcome>(cols->outcome[slot])) << ','
+          << cols->attackerMove[slot] << ',' << cols->defenderMove[slot] << ',';
+        WriteValue(f, cols->advantage[slot]); f << ',';
+        WriteValue(f, cols->gap[slot]); f << ',';
+        WriteValue(f, cols->rgFa1[slot]); f << ',';
+        WriteValue(f, cols->rgFa2[slot]); f << ',';
+        f << cols->attackerPos[slot].x << ',' << cols->attackerPos[slot].y << ','
+          << cols->defenderPos[slot].x << ',' << cols->defenderPos[slot].y << '\n';
+    }
+    // Session aggregates (cover rows the ring no longer holds)
+    f << "\nplayer,move,count,blocks,hits,with_advantage,advantage_min,advantage_mean,advantage_max\n";
+    for (int i = 0; i < moveCount; ++i) {
+        const MoveStats& m = moves[i];
+        f << (int)m.player << ',' << m.moveID << ',' << m.count << ',' << m.blocks << ',' << m.hits << ','
+          << m.withAdvantage << ',';
+        if (m.withAdvantage)
+            f << m.advantageMin << ',' << (double)m.advantageSum / m.withAdvantage << ',' << m.advantageMax;
+        else
+            f << ",,";
+        f << '\n';
+    }
+    if (!f.good()) return false;
+    if (writtenPath) *writtenPath = target;
+    LogOut("[EXCHANGE] Exported " + std::to_string(summary.stored) + " exchanges to " + target, true);
+    return true;
+}
+
+} // namespace ExchangeStats
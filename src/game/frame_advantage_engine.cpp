@@ -0,0 +1,241 @@
+#include "../include/game/frame_advantage_engine.h"
+#include "../include/core/constants.h"
+#include "../include/game/move_props.h"
+
+namespace FrameAdvantageEngine {
+
+namespace {
+
+bool IsAttack(short id)      { return MoveProps::Has(id, MoveProps::Attack); }
+bool IsBlockState(short id)  { return MoveProps::Has(id, MoveProps::BlockstunState); }
+bool IsHitstunState(short id){ return MoveProps::Has(id, MoveProps::Hitstun); }
+bool IsThrownState(short id) { return MoveProps::Has(id, MoveProps::Thrown); }
+bool IsRecoil(short id)      { return MoveProps::Has(id, MoveProps::RecoilGuard); }
+bool IsFreezeState(short id) { return MoveProps::Has(id, MoveProps::Frozen | MoveProps::SpecialStun); }
+
+bool IsNewActionMove(short id) {
+    return id == FORWARD_DASH_START_ID || id == BACKWARD_DASH_START_ID ||
+           id == STRAIGHT_JUMP_ID || id == FORWARD_JUMP_ID || id == BACKWARD_JUMP_ID;
+}
+
+bool IsLandingMove(short id) {
+    return id == LANDING_ID || id == LANDING_1_ID || id == LANDING_2_ID || id == LANDING_3_ID;
+}
+
+bool IsInfiniteCancel(short id) { return id == GROUND_IC_ID || id == AIR_IC_ID; }
+
+struct Emitter {
+    Event* out;
+    int max;
+    int count;
+    int frame;
+    void Add(EventKind kind, int player, int value = 0, int raw = 0, ConnectKind connect = ConnectKind::Lockout) {
+        if (count >= max) return;
+        out[count++] = Event{ kind, static_cast<uint8_t>(player), connect, frame, value, raw };
+    }
+};
+
+void ClearExchange(Side& d) {
+    d.attacking = false;
+    d.defending = false;
+    d.inBlockstun = false;
+    d.inHitstun = false;
+    d.attackStartFrame = -1;
+    d.blockstunStartFrame = -1;
+    d.hitstunStartFrame = -1;
+    d.initialBlockstunMoveID = 0;
+    d.actionableFrame = -1;
+    d.defenderFreeFrame = -1;
+    d.frameAdvantage = 0;
+    d.advantageCalculated = false;
+}
+
+// A connect starts a fresh exchange for this attacker without touching the defender's earlier results
+void BeginExchange(State& s, int a, int d, int frame) {
+    for (Side& side : s.side) {
+        side.attacking = false;
+        side.attackStartFrame = -1;
+        side.actionableFrame = -1;
+        side.advantageCalculated = false;
+    }
+    Side& atk = s.side[a];
+    Side& def = s.side[d];
+    atk.attacking = true;
+    atk.defending = false;
+    atk.attackStartFrame = frame;
+    atk.freezeAfterActionable = 0;
+    atk.connectCooldown = kConnectCooldown;
+    def.defending = true;
+    def.defenderFreeFrame = -1;
+    def.lastFreeFrame = -1;
+    def.freezeSinceFree = 0;
+}
+
+} // namespace
+
+void Reset(State& s) {
+    for (Side& side : s.side) {
+        ClearExchange(side);
+        side.lastFreeFrame = -1;
+        side.freezeSinceFree = 0;
+        side.freezeAfterActionable = 0;
+        side.connectCooldown = 0;
+        side.lastAttackEdgeFrame = -1;
+    }
+    s.staleFrames = 0;
+}
+
+void ResetTracking(State& s) {
+    for (Side& side : s.side) ClearExchange(side);
+    s.staleFrames = 0;
+}
+
+void Cancel(State& s) {
+    for (Side& side : s.side) {
+        side.attacking = false;
+        side.defending = false;
+        side.actionableFrame = -1;
+        side.defenderFreeFrame = -1;
+        side.frameAdvantage = 0;
+        side.advantageCalculated = false;
+        side.lastFreeFrame = -1;
+        side.freezeSinceFree = 0;
+        side.freezeAfterActionable = 0;
+        side.connectCooldown = 0;
+        side.lastAttackEdgeFrame = -1;
+    }
+    s.staleFrames = 0;
+}
+
+int Step(State& s, const Input& in, Event* out, int max) {
+    Emitter ev{ out, max, 0, in.frame };
+    const int now = in.frame;
+
+    bool attackEdge[2];
+    for (int p = 0; p < 2; ++p) {
+        Side& side = s.side[p];
+        if (side.connectCooldown > 0) side.connectCooldown--;
+        attackEdge[p] = IsAttack(in.moveID[p]) && !IsAttack(in.prevMoveID[p]);
+        if (attackEdge[p]) side.lastAttackEdgeFrame = now;
+        if (attackEdge[p] || IsNewActionMove(in.moveID[p])) ev.Add(EventKind::NewAction, p + 1);
+        if (IsRecoil(in.moveID[p]) && !IsRecoil(in.prevMoveID[p])) ev.Add(EventKind::RecoilGuard, p + 1);
+    }
+
+    // Gap start: the defender regained control (covers knockdown, tech and wakeup)
+    for (int p = 0; p < 2; ++p) {
+        if (!in.prevActionable[p] && in.actionable[p]) {
+            s.side[p].lastFreeFrame = now;
+            s.side[p].freezeSinceFree = 0;
+        }
+    }
+
+    // Freeze ticks are not gap or advantage: count them where they would otherwise inflate a result
+    const bool freeze = in.gameSpeedFrozen || IsFreezeState(in.moveID[0]) || IsFreezeState(in.moveID[1]);
+    if (freeze) {
+        for (int p = 0; p < 2; ++p) {
+            Side& side = s.side[p];
+            if (side.lastFreeFrame != -1) side.freezeSinceFree++;
+            if (side.attacking && side.actionableFrame != -1 && s.side[1 - p].defenderFreeFrame == -1)
+                side.freezeAfterActionable++;
+        }
+    }
+
+    // Connects. IC superflash and global freezes change states without a hit, so nothing connects then.
+    const bool superflash = in.gameSpeedFrozen || IsInfiniteCancel(in.moveID[0]) || IsInfiniteCancel(in.moveID[1]);
+    for (int a = 0; a < 2 && !superflash; ++a) {
+        const int d = 1 - a;
+        const short dm = in.moveID[d], dprev = in.prevMoveID[d];
+        const bool enterBlock = IsBlockState(dm) && !IsBlockState(dprev);
+        const bool enterHit = IsHitstunState(dm) && !IsHitstunState(dprev);
+        const bool enterThrown = IsThrownState(dm) && !IsThrownState(dprev);
+        const bool enterLockout = in.prevActionable[d] && !in.actionable[d];
+        const bool recentAttack = s.side[a].lastAttackEdgeFrame >= 0 &&
+                                  now - s.side[a].lastAttackEdgeFrame <= kAttackConnectWindow;
+        const bool connect = enterBlock || enterHit || enterThrown || (enterLockout && recentAttack) ||
+                             (attackEdge[a] && !in.actionable[d]);
+        if (!connect || s.side[a].connectCooldown != 0) continue;
+
+        Side& def = s.side[d];
+        if (def.lastFreeFrame != -1) {
+            const int raw = now - def.lastFreeFrame;
+            int gap = raw - def.freezeSinceFree;
+            if (gap < 0) gap = 0;
+            if (gap > 0 && gap <= kMaxGapFrames) ev.Add(EventKind::Gap, a + 1, gap, raw);
+        }
+
+        BeginExchange(s, a, d, now);
+        ConnectKind kind = ConnectKind::Lockout;
+        def.inBlockstun = enterBlock;
+        def.inHitstun = !enterBlock && enterHit;
+        if (enterBlock) {
+            kind = ConnectKind::Block;
+            def.blockstunStartFrame = now;
+            def.initialBlockstunMoveID = dm;
+        } else if (enterHit) {
+            kind = ConnectKind::Hit;
+            def.hitstunStartFrame = now;
+        } else if (enterThrown) {
+            kind = ConnectKind::Thrown;
+        }
+        ev.Add(EventKind::Connect, a + 1, 0, 0, kind);
+    }
+
+    // Attacker recovery
+    for (int a = 0; a < 2; ++a) {
+        Side& atk = s.side[a];
+        if (atk.attacking && atk.actionableFrame == -1 && !in.prevActionable[a] && in.actionable[a])
+            atk.actionableFrame = now;
+    }
+
+    // Defender free. Landing out of an air block/hit is still part of the lockout.
+    for (int d = 0; d < 2; ++d) {
+        Side& def = s.side[d];
+        if (def.defending && def.defenderFreeFrame == -1 && !in.prevActionable[d] && in.actionable[d] &&
+            !IsLandingMove(in.moveID[d]))
+            def.defenderFreeFrame = now;
+    }
+
+    // Whiff or cancel where the defender never lost control: the defender is free when the attacker is
+    for (int a = 0; a < 2; ++a) {
+        const Side& atk = s.side[a];
+        Side& def = s.side[1 - a];
+        if (atk.attacking && atk.actionableFrame != -1 && def.defenderFreeFrame == -1 && in.actionable[1 - a])
+            def.defenderFreeFrame = atk.actionableFrame;
+    }
+
+    for (int a = 0; a < 2; ++a) {
+        Side& atk = s.side[a];
+        const Side& def = s.side[1 - a];
+        if (!atk.attacking || atk.advantageCalculated || atk.actionableFrame == -1 || def.defenderFreeFrame == -1)
+            continue;
+        atk.frameAdvantage = def.defenderFreeFrame - atk.actionableFrame - atk.freezeAfterActionable;
+        atk.advantageCalculated = true;
+        ev.Add(EventKind::FrameAdvantage, a + 1, atk.frameAdvantage);
+        atk.attacking = false;
+        atk.attackStartFrame = -1;
+        atk.actionableFrame = -1;
+    }
+
+    // Stale exchange: count only ticks where nothing is left to wait for (long throws and techs are fine)
+    bool tracking = false, waiting = false;
+    for (int p = 0; p < 2; ++p) {
+        const Side& side = s.side[p];
+        tracking |= side.attacking && !side.advantageCalculated;
+        waiting |= !in.actionable[p] && ((side.attacking && side.actionableFrame == -1) ||
+                                         (side.defending && side.defenderFreeFrame == -1));
+    }
+    if (!tracking || waiting) {
+        s.staleFrames = 0;
+    } else if (++s.staleFrames > kStaleFrames) {
+        ResetTracking(s);
+        for (Side& side : s.side) {
+            side.lastFreeFrame = -1;
+            side.freezeAfterActionable = 0;
+        }
+        ev.Add(EventKind::StaleReset, 0);
+    }
+
+    return ev.count;
+}
+
+} // namespace FrameAdvantageEngine
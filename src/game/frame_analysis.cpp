@@ -1,5 +1,6 @@
 #include "../include/game/frame_analysis.h"
 #include "../include/core/constants.h"
+#include "../include/game/move_props.h"
 #include "../include/utils/utilities.h"
 
 #include "../include/core/memory.h"
@@ -8,56 +9,39 @@
 // Global variable for blockstun tracking
 short initialBlockstunMoveID = -1;
 
+// Classifications live in the compile-time MoveProps table (move_props.h)
 bool IsHitstun(short moveID) {
-    return (moveID >= STAND_HITSTUN_START && moveID <= STAND_HITSTUN_END) || 
-           (moveID >= CROUCH_HITSTUN_START && moveID <= CROUCH_HITSTUN_END) ||
-           moveID == SWEEP_HITSTUN ||
-           moveID == 69; // Ikumi 623 hit state
+    return MoveProps::Has(moveID, MoveProps::Hitstun); // includes 69 (Ikumi 623 hit state)
 }
 
 bool IsLaunched(short moveID) {
-    return moveID >= LAUNCHED_HITSTUN_START && moveID <= LAUNCHED_HITSTUN_END;
+    return MoveProps::Has(moveID, MoveProps::Launched);
 }
 
 bool IsAirtech(short moveID) {
-    return moveID == FORWARD_AIRTECH || moveID == BACKWARD_AIRTECH;
+    return MoveProps::Has(moveID, MoveProps::Airtech);
 }
 
 bool IsGroundtech(short moveID) {
-    return moveID == GROUNDTECH_PRE ||
-           moveID == GROUNDTECH_START ||
-           moveID == GROUNDTECH_END || 
-           moveID == GROUNDTECH_RECOVERY; // Recovery state
+    return MoveProps::Has(moveID, MoveProps::Groundtech);
 }
 
 bool IsFrozen(short moveID) {
-    return moveID >= FROZEN_STATE_START && moveID <= FROZEN_STATE_END;
+    return MoveProps::Has(moveID, MoveProps::Frozen);
 }
 
 bool IsSpecialStun(short moveID) {
-    return moveID == FIRE_STATE || moveID == ELECTRIC_STATE || 
-           (moveID >= FROZEN_STATE_START && moveID <= FROZEN_STATE_END);
+    return MoveProps::Has(moveID, MoveProps::SpecialStun);
 }
 
 bool IsThrown(short moveID) {
     // Many characters place defenders into a temporary "thrown" sequence before transitioning to
     // hit/launch states. Known windows include 100..110 (common) and 121..122 (Akiko continuation).
-    if (moveID >= THROWN_STATE_START && moveID <= THROWN_STATE_END) return true;
-    if (moveID >= THROWN2_STATE_START && moveID <= THROWN2_STATE_END) return true;
-    if (moveID >= THROWN3_STATE_START && moveID <= THROWN3_STATE_END) return true;
-    if (moveID >= THROWN4_STATE_START && moveID <= THROWN4_STATE_END) return true;
-    if (moveID >= THROWN5_STATE_START && moveID <= THROWN5_STATE_END) return true;
-    return false;
+    return MoveProps::Has(moveID, MoveProps::Thrown);
 }
 
 bool IsBlockstunState(short moveID) {
-    return moveID == STANDING_BLOCK_LVL1 ||
-           moveID == STANDING_BLOCK_LVL2 ||
-           moveID == STANDING_BLOCK_LVL3 ||
-           moveID == CROUCHING_BLOCK_LVL1 ||
-           moveID == CROUCHING_BLOCK_LVL2_A ||
-           moveID == CROUCHING_BLOCK_LVL2_B ||
-           moveID == AIR_GUARD_ID;
+    return MoveProps::Has(moveID, MoveProps::BlockstunState);
 }
 
 int GetAttackLevel(short blockstunMoveID) {
@@ -0,0 +1,131 @@
+#include "../include/game/frame_meter.h"
+#include "../include/game/per_frame_sample.h"
+#include "../include/game/move_props.h"
+#include "../include/game/attack_table.h"
+#include "../include/core/constants.h"
+#include <atomic>
+
+namespace FrameMeter {
+
+namespace {
+    static_assert(kRingTicks >= kColumns * kTicksPerColumn, "ring must hold a full meter");
+    static_assert(kCellCount <= 16, "cells are packed as nibbles");
+
+    std::atomic<uint32_t> s_seq{0};
+    std::atomic<uint32_t> s_ticks{0};               // ticks in the current segment
+    std::atomic<uint8_t>  s_ring[kRingTicks];       // p1 cell | p2 cell << 4
+
+    // Writer-side state (frame monitor thread only)
+    uint32_t s_wTicks = 0;
+    int      s_wIdle = 0;
+    bool     s_wRecording = false;
+
+    Cell Classify(const PerFrameSample& sample, int player) {
+        const PlayerSnapshot& ps = sample.Player(player);
+        if (!ps.valid) return Empty;
+        if (player == 1 ? sample.actionable1 : sample.actionable2) return Actionable;
+
+        const short move = player == 1 ? sample.moveID1 : sample.moveID2;
+        const uint16_t props = MoveProps::Get(move);
+        if (props & (MoveProps::Hitstun | MoveProps::Launched | MoveProps::Thrown | MoveProps::SpecialStun))
+            return Hitstun;
+        if (props & (MoveProps::Blockstun | MoveProps::BlockstunState | MoveProps::RecoilGuard))
+            return Blockstun;
+        if (!(props & MoveProps::Attack)) return Busy;
+
+        // Without table data (still building, or no hit frames) an attack is just busy
+        const AttackTable::MoveData* m = AttackTable::Lookup(player, move);
+        if (!m) return Busy;
+        const int frame = ps.Get<uint16_t>(CURRENT_FRAME_INDEX_OFFSET);
+        if (frame < m->firstActive) return Startup;
+        // Gaps between hits and everything after the last active block count as recovery
+        return AttackTable::IsActiveBlock(*m, frame) ? Active : Recovery;
+    }
+
+    void BeginWrite() {
+        s_seq.store(s_seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    void EndWrite() {
+        s_seq.store(s_seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    template <typename Fn>
+    void ReadConsistent(Fn&& fn) {
+        for (;;) {
+            const uint32_t before = s_seq.load(std::memory_order_acquire);
+            if (before & 1u) continue;
+            fn();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s_seq.load(std::memory_order_relaxed) == before) return;
+        }
+    }
+}
+
+void Publish(const PerFrameSample& sample) {
+    const Cell p1 = Classify(sample, 1);
+    const Cell p2 = Classify(sample, 2);
+    const bool idle = p1 == Actionable && p2 == Actionable;
+
+    if (!s_wRecording) {
+        if (idle) return;               // keep showing the last segment
+        s_wRecording = true;
+        s_wTicks = 0;
+        s_wIdle = 0;
+    } else if (idle) {
+        if (++s_wIdle > kIdleTicks) {
+            s_wRecording = false;
+            return;
+        }
+    } else {
+        s_wIdle = 0;
+    }
+
+    BeginWrite();
+    s_ring[s_wTicks % kRingTicks].store(static_cast<uint8_t>(p1 | (p2 << 4)), std::memory_order_relaxed);
+    ++s_wTicks;
+    s_ticks.store(s_wTicks, std::memory_order_relaxed);
+    EndWrite();
+}
+
+void Reset() {
+    if (!s_wRecording && s_wTicks == 0) return;     // called every tick outside a match
+    BeginWrite();
+    s_wTicks = 0;
+    s_wIdle = 0;
+    s_wRecording = false;
+    s_ticks.store(0, std::memory_order_relaxed);
+    EndWrite();
+}
+
+uint32_t Version() {
+    return s_seq.load(std::memory_order_acquire);
+}
+
+int CopyColumns(int player, uint8_t* out, int max) {
+    if (player < 1 || player > 2 || max <= 0) return 0;
+    const int shift = (player - 1) * 4;
+    int n = 0;
+    ReadConsistent([&]() {
+        const uint32_t ticks = s_ticks.load(std::memory_order_relaxed);
+        const uint32_t columns = (ticks + kTicksPerColumn - 1) / kTicksPerColumn;
+        // Oldest column whose ticks are all still in the ring
+        const uint32_t oldestTick = ticks > (uint32_t)kRingTicks ? ticks - kRingTicks : 0;
+        uint32_t first = (oldestTick + kTicksPerColumn - 1) / kTicksPerColumn;
+        if (columns - first > (uint32_t)max) first = columns - max;
+        n = static_cast<int>(columns - first);
+        for (int c = 0; c < n; ++c) {
+            const uint32_t begin = (first + c) * kTicksPerColumn;
+            const uint32_t end = begin + kTicksPerColumn < ticks ? begin + kTicksPerColumn : ticks;
+            uint8_t cell = Empty;
+            for (uint32_t t = begin; t < end; ++t) {
+                const uint8_t v = static_cast<uint8_t>((s_ring[t % kRingTicks].load(std::memory_order_relaxed) >> shift) & 0xF);
+                if (v > cell) cell = v;
+            }
+            out[c] = cell;
+        }
+    });
+    return n;
+}
+
+} // namespace FrameMeter
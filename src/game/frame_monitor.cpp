@@ -9,19 +9,28 @@
 #include "../include/utils/utilities.h"
 #include "../include/utils/bgm_control.h"
 #include "../include/core/memory.h"
+#include "../include/core/memory_txn.h"
 #include "../include/core/logger.h"
+#include "../include/core/fast_log.h"
 #include "../include/gui/overlay.h"
 #include "../include/game/game_state.h"
 #include "../include/game/per_frame_sample.h" // unified sampling context
+#include "../include/game/move_props.h"
+#include "../include/game/trace_recorder.h"
+#include "../include/game/tick_profiler.h"
 #include "../include/input/input_buffer.h"
 #include "../include/utils/config.h"
 #include "../include/input/input_motion.h"
+#include "../include/input/motion_recognizer.h"
+#include "../include/input/input_history.h"
 #include "../include/utils/network.h"
 #include "../include/utils/pause_integration.h" // PauseIntegration::EnsurePracticePointerCapture/GetPracticeControllerPtr
 #include "../include/utils/switch_players.h"    // SwitchPlayers::ResetControlMappingForMenusToP1
 #include "../include/input/framestep.h"          // Framestep system for vanilla EFZ
-#define DISABLE_ATTACK_READER 1
 #include "../include/game/attack_reader.h"
+#include "../include/game/attack_table.h"
+#include "../include/game/frame_meter.h"
+#include "../include/game/exchange_stats.h"
 #include "../include/game/practice_patch.h"
 #include "../include/game/character_settings.h"
 #include "../include/game/macro_controller.h"
@@ -222,6 +231,54 @@ namespace {
         s_ptrCache.p2 = ResolvePlayerBaseBestEffort(2, s_ptrCache.base);
         s_ptrCache.gen = s_ptrGen.fetch_add(1, std::memory_order_relaxed) + 1;
     }
+
+    // Thread that owns g_lastSample; sampled reads from any other thread go straight to memory
+    static std::atomic<DWORD> s_monitorThreadId{0};
+
+    static void CapturePlayerSnapshot(PlayerSnapshot &snap, uintptr_t playerBase, uint16_t &reads, uint16_t &bytes) {
+        snap.base = playerBase;
+        snap.valid = false;
+        if (!playerBase) return;
+        ++reads;
+        if (SafeReadMemory(playerBase, snap.raw, sizeof(snap.raw))) {
+            snap.valid = true;
+            bytes += (uint16_t)sizeof(snap.raw);
+        }
+    }
+
+    // Snapshot stage: one bulk read per region (P1, P2, game-state block) per tick.
+    // Must run right after RefreshPointerCache so the copies match the cached pointers.
+    inline void CaptureSnapshotRegions() {
+        uint16_t reads = 0, bytes = 0;
+        CapturePlayerSnapshot(g_lastSample.p1, s_ptrCache.p1, reads, bytes);
+        CapturePlayerSnapshot(g_lastSample.p2, s_ptrCache.p2, reads, bytes);
+        GameStateSnapshot &gs = g_lastSample.gs;
+        gs.base = s_ptrCache.gs;
+        gs.valid = false;
+        if (gs.base) {
+            ++reads;
+            if (SafeReadMemory(gs.base + GAMESTATE_SNAPSHOT_BEGIN, gs.raw, sizeof(gs.raw))) {
+                gs.valid = true;
+                bytes += (uint16_t)sizeof(gs.raw);
+            }
+        }
+        g_lastSample.snapshotReads = reads;
+        g_lastSample.snapshotBytes = bytes;
+    }
+}
+
+bool ReadSampledPlayerField(uintptr_t playerBase, uintptr_t offset, void* out, size_t size) {
+    if (!playerBase || !out || size == 0) return false;
+    if (GetCurrentThreadId() == s_monitorThreadId.load(std::memory_order_relaxed)) {
+        const PlayerSnapshot* snap = nullptr;
+        if (g_lastSample.p1.valid && g_lastSample.p1.base == playerBase) snap = &g_lastSample.p1;
+        else if (g_lastSample.p2.valid && g_lastSample.p2.base == playerBase) snap = &g_lastSample.p2;
+        if (snap && offset + size <= sizeof(snap->raw)) {
+            memcpy(out, snap->raw + offset, size);
+            return true;
+        }
+    }
+    return SafeReadMemory(playerBase + offset, out, size);
 }
 
 FrameStepDebugInfo GetFrameStepDebugInfo() {
@@ -754,6 +811,7 @@ void FrameDataMonitor() {
     
     // Use high (but not time-critical) priority to avoid starving DWM/GPU queues
     SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+    s_monitorThreadId.store(GetCurrentThreadId(), std::memory_order_relaxed);
     
     short prevMoveID1 = -1, prevMoveID2 = -1;
     // Update frame time to match 192fps instead of 60fps
@@ -785,11 +843,6 @@ void FrameDataMonitor() {
     int driftSamples = 0;
     int oversleepCount = 0; // frames that exceeded 2x target
 
-    // New: fine grained section timing (optional on demand)
-    bool sectionTiming = false; // toggle via debugger if needed
-    long long sec_mem = 0, sec_logic = 0, sec_features = 0; // accumulators
-    int sec_samples = 0;
-
     // Improved scheduling target time (accumulative to avoid drift)
     auto startTime = clock::now();
     auto expectedNext = startTime + targetFrameTime; // next frame boundary
@@ -799,6 +852,8 @@ void FrameDataMonitor() {
         if (g_onlineModeActive.load()) {
             StopBufferFreezing();
             ResetActionFlags();
+            // Undo the practice controller flags before netplay
+            RevertAllWrites();
             p1DelayState = {false, 0, TRIGGER_NONE, 0, -1, -1, 0, -1};
             p2DelayState = {false, 0, TRIGGER_NONE, 0, -1, -1, 0, -1};
             break; // exit thread to allow safe self-unload
@@ -809,15 +864,23 @@ void FrameDataMonitor() {
             expectedNext = frameStart + targetFrameTime;
         }
         
-    // Refresh core pointer cache once per loop iteration
-    RefreshPointerCache();
+    // Refresh core pointer cache once per loop iteration, then bulk-copy the player/game-state
+    // regions so every subsystem below decodes fields from the same coherent tick
+    {
+        TickProfiler::Scope prof(TickSection::Snapshot);
+        RefreshPointerCache();
+        CaptureSnapshotRegions();
+    }
     // Check current game phase (single authoritative call per loop)
     GamePhase currentPhase = GetCurrentGamePhase();
     
     // Update framestep system (vanilla only, input monitoring and frame advance)
-    Framestep::Update();
-    // Update framestep overlay status
-    Framestep::UpdateOverlayStatus();
+    {
+        TickProfiler::Scope prof(TickSection::Framestep);
+        Framestep::Update();
+        // Update framestep overlay status
+        Framestep::UpdateOverlayStatus();
+    }
 
     // Lightweight, integrated online detection (replaces separate network thread)
     {
@@ -1316,8 +1379,8 @@ void FrameDataMonitor() {
             // Pointer change logging
                         uintptr_t p1Ptr = s_ptrCache.p1, p2Ptr = s_ptrCache.p2;
             if ((p1Ptr != fm_lastP1Ptr || p2Ptr != fm_lastP2Ptr) && (p1Ptr || p2Ptr)) {
-          LogOut("[FRAME_MONITOR][PTR] P1 " + FM_Hex(p1Ptr) + " (was " + FM_Hex(fm_lastP1Ptr) + ")  P2 " +
-              FM_Hex(p2Ptr) + " (was " + FM_Hex(fm_lastP2Ptr) + ")", detailedLogging.load());
+          EFZ_LOG(LogCat::FrameMonitor, detailedLogging.load(), "[FRAME_MONITOR][PTR] P1 0x%X (was 0x%X)  P2 0x%X (was 0x%X)",
+              p1Ptr, fm_lastP1Ptr, p2Ptr, fm_lastP2Ptr);
                 fm_lastP1Ptr = p1Ptr;
                 fm_lastP2Ptr = p2Ptr;
             }
@@ -1325,10 +1388,8 @@ void FrameDataMonitor() {
             // Initialization transition logging
             if (isInitialized != fm_lastCharsInit) {
                 bool wasInitialized = fm_lastCharsInit;
-          LogOut(std::string("[FRAME MONITOR][INIT] CharactersInitialized: ") +
-              (fm_lastCharsInit ? "true" : "false") + " -> " +
-              (isInitialized ? "true" : "false") +
-              " frame=" + std::to_string(currentFrame), detailedLogging.load());
+          EFZ_LOG(LogCat::FrameMonitorAlt, detailedLogging.load(), "[FRAME MONITOR][INIT] CharactersInitialized: %s -> %s frame=%d",
+              fm_lastCharsInit ? "true" : "false", isInitialized ? "true" : "false", currentFrame);
                 fm_lastCharsInit = isInitialized;
 
                 // Manage character-specific pointer cache lifecycle around init transitions.
@@ -1363,6 +1424,9 @@ void FrameDataMonitor() {
                 lightweightTick();
                 prevMoveID1 = 0;
                 prevMoveID2 = 0;
+                MotionRecognizer::Reset();
+                InputHistory::Reset();
+                FrameMeter::Reset();
                 skipHeavy = true;
             }
             // =========================================================================
@@ -1374,7 +1438,23 @@ void FrameDataMonitor() {
 
             // (EXISTING HEAVY LOGIC BELOW: address refresh, moveID reads, processing)
             // First: tick practice macro controller before processing inputs/motions
-            MacroController::Tick();
+            {
+                TickProfiler::Scope prof(TickSection::MacroTick);
+                MacroController::Tick();
+            }
+            // Advance the motion automata over the new input buffer entries of both players
+            {
+                TickProfiler::Scope prof(TickSection::MotionRecognizer);
+                MotionRecognizer::Update(GetCurrentPerFrameSample());
+                InputHistory::Publish(GetCurrentPerFrameSample());
+            }
+            // Rebuilds the per-character attack table in the background when a character loads
+            AttackTable::Update(GetCurrentPerFrameSample());
+            // Frame meter cells (after the attack table so startup/active/recovery can be split); a
+            // frozen game would only stretch the current cells
+            if (!PauseIntegration::IsGameSpeedFrozen()) {
+                FrameMeter::Publish(GetCurrentPerFrameSample());
+            }
             // Refresh addresses periodically, and also on first use if not yet cached
             if (addressCacheCounter++ >= 192 || !cachedMoveIDAddr1 || !cachedMoveIDAddr2) {
                 cachedMoveIDAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, MOVE_ID_OFFSET);
@@ -1388,30 +1468,29 @@ void FrameDataMonitor() {
                     double actualFPS = framesSinceLastLog / (elapsed.count() / 1000.0);
                     // Only log if enabled in config and either detailed logging is on or fps deviates
                     if (Config::GetSettings().enableFpsDiagnostics && (detailedLogging.load() || fabs(actualFPS - 192.0) > 5.0)) {
-                        LogOut("[FRAME MONITOR] Actual FPS: " + std::to_string(actualFPS) + 
-                               " (target: 192.0)", detailedLogging.load());
+                        EFZ_LOG(LogCat::FrameMonitorAlt, detailedLogging.load(), "[FRAME MONITOR] Actual FPS: %f (target: 192.0)", actualFPS);
                     }
                     lastLogTime = currentTime;
                     framesSinceLastLog = 0;
                 }
             }
             
-            // Read move IDs using cached addresses with error checking
+            // Move IDs come from the tick snapshot; cached addresses are only the fallback when a bulk read failed
             short moveID1 = 0, moveID2 = 0;
-            if (cachedMoveIDAddr1 && !SafeReadMemory(cachedMoveIDAddr1, &moveID1, sizeof(short))) {
+            if (!g_lastSample.p1.TryGet(MOVE_ID_OFFSET, moveID1) &&
+                cachedMoveIDAddr1 && !SafeReadMemory(cachedMoveIDAddr1, &moveID1, sizeof(short))) {
                 // Re-cache on read failure
                 cachedMoveIDAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, MOVE_ID_OFFSET);
             }
-            if (cachedMoveIDAddr2 && !SafeReadMemory(cachedMoveIDAddr2, &moveID2, sizeof(short))) {
+            if (!g_lastSample.p2.TryGet(MOVE_ID_OFFSET, moveID2) &&
+                cachedMoveIDAddr2 && !SafeReadMemory(cachedMoveIDAddr2, &moveID2, sizeof(short))) {
                 cachedMoveIDAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, MOVE_ID_OFFSET);
             }
 
             // Populate unified per-frame sample (read-only use for now)
-            // Neutral whitelist duplicated previously across Continuous Recovery & DummyAutoBlock.
-            auto isNeutralMoveId = [](short m) {
-                return (m == 0 || m == 1 || m == 2 || m == 3 || m == 4 ||
-                        m == 7 || m == 8 || m == 9 || m == 13);
-            };
+            // Neutral whitelist shared with Continuous Recovery & DummyAutoBlock (MoveProps::RecoveryNeutral)
+            const uint16_t props1 = MoveProps::Get(moveID1);
+            const uint16_t props2 = MoveProps::Get(moveID2);
             g_lastSample.frame = (uint32_t)frameCounter.load();
             g_lastSample.tickMs = GetTickCount64();
             g_lastSample.phase = currentPhase;
@@ -1423,8 +1502,8 @@ void FrameDataMonitor() {
             g_lastSample.prevMoveID2 = prevMoveID2;
             g_lastSample.actionable1 = IsActionable(moveID1);
             g_lastSample.actionable2 = IsActionable(moveID2);
-            g_lastSample.neutral1 = isNeutralMoveId(moveID1);
-            g_lastSample.neutral2 = isNeutralMoveId(moveID2);
+            g_lastSample.neutral1 = (props1 & MoveProps::RecoveryNeutral) != 0;
+            g_lastSample.neutral2 = (props2 & MoveProps::RecoveryNeutral) != 0;
             g_lastSample.basePtr = base;
             g_lastSample.gameStatePtr = s_ptrCache.gs;
             g_lastSample.p1Ptr = s_ptrCache.p1;
@@ -1519,9 +1598,7 @@ void FrameDataMonitor() {
                 // Close when attacker becomes actionable or cancels out of their move
                 if (atkActionable || atkMoveNow != rg.attackerMoveAtEvent) {
                     rg.cRGOpen = false;
-                    std::ostringstream os; os.setf(std::ios::fixed); os << std::setprecision(2);
-                    os << "RG: cRG window closed for P" << rg.defender << " (attacker now actionable/cancelled)";
-                    LogOut(std::string("[RG][FM] ") + os.str(), detailedLogging.load());
+                    EFZ_LOG(LogCat::Rg, detailedLogging.load(), "[RG][FM] RG: cRG window closed for P%d (attacker now actionable/cancelled)", rg.defender);
                     // No overlay toast on close to reduce noise
                 }
             };
@@ -1538,13 +1615,9 @@ void FrameDataMonitor() {
                     if (atkActionable) {
                         rg.atkActionableAt = frameCounter.load();
                         // Debug signal for verification
-                        {
-                            std::ostringstream os; os.setf(std::ios::fixed); os << std::setprecision(2);
-                            os << "RG: Attacker actionable (P" << rg.attacker << ")";
-                            LogOut(std::string("[RG][FM] ") + os.str(), true);
-                            if (g_ShowRGDebugToasts.load()) {
-                                DirectDrawHook::AddMessage(os.str(), "RG", RGB(160, 255, 160), 1200, 0, 156);
-                            }
+                        EFZ_LOG(LogCat::Rg, true, "[RG][FM] RG: Attacker actionable (P%d)", rg.attacker);
+                        if (g_ShowRGDebugToasts.load()) {
+                            DirectDrawHook::AddMessage("RG: Attacker actionable (P" + std::to_string(rg.attacker) + ")", "RG", RGB(160, 255, 160), 1200, 0, 156);
                         }
                     }
                 }
@@ -1555,13 +1628,9 @@ void FrameDataMonitor() {
                     if (defActionable) {
                         rg.defActionableAt = frameCounter.load();
                         // Debug signal for verification
-                        {
-                            std::ostringstream os; os.setf(std::ios::fixed); os << std::setprecision(2);
-                            os << "RG: Defender actionable (P" << rg.defender << ")";
-                            LogOut(std::string("[RG][FM] ") + os.str(), true);
-                            if (g_ShowRGDebugToasts.load()) {
-                                DirectDrawHook::AddMessage(os.str(), "RG", RGB(255, 240, 160), 1200, 0, 156);
-                            }
+                        EFZ_LOG(LogCat::Rg, true, "[RG][FM] RG: Defender actionable (P%d)", rg.defender);
+                        if (g_ShowRGDebugToasts.load()) {
+                            DirectDrawHook::AddMessage("RG: Defender actionable (P" + std::to_string(rg.defender) + ")", "RG", RGB(255, 240, 160), 1200, 0, 156);
                         }
                     }
                 }
@@ -1573,12 +1642,10 @@ void FrameDataMonitor() {
                     rg.fa2Ready = true;
                     rg.fa2Announced = true;
 
-                    std::ostringstream os; os.setf(std::ios::fixed); os << std::setprecision(2);
-                          os << "RG: P" << rg.defender
-                              << "  FA1(endFreeze)=" << rg.fa1F << "F"
-                              << "  FA2(meas)=" << rg.fa2F << "F";
-                    LogOut(std::string("[RG][FM] ") + os.str(), true);
+                    EFZ_LOG(LogCat::Rg, true, "[RG][FM] RG: P%d  FA1(endFreeze)=%.2fF  FA2(meas)=%.2fF", rg.defender, rg.fa1F, rg.fa2F);
                     if (g_ShowRGDebugToasts.load()) {
+                        std::ostringstream os; os.setf(std::ios::fixed); os << std::setprecision(2);
+                        os << "RG: P" << rg.defender << "  FA1(endFreeze)=" << rg.fa1F << "F" << "  FA2(meas)=" << rg.fa2F << "F";
                         DirectDrawHook::AddMessage(os.str(), "RG", RGB(120, 200, 255), 1500, 0, 156);
                     }
 
@@ -1588,6 +1655,7 @@ void FrameDataMonitor() {
                     };
                     int fa1Int = toIntFrames(rg.fa1F);
                     int fa2Int = toIntFrames(rg.fa2F);
+                    ExchangeStats::OnRecoilGuardResult(rg.defender, fa1Int, fa2Int);
                     std::string fa1Text = FormatFrameAdvantage(fa1Int);
                     std::string fa2Text = FormatFrameAdvantage(fa2Int);
                     // Show numeric end-of-freeze duration (visual frames) with subframe precision [.00/.33/.66]
@@ -1753,13 +1821,13 @@ void FrameDataMonitor() {
                             if (!pBase) return std::string("P") + std::to_string(pid) + ": <null>";
                             // Read direction/stance (raw inputs)
                             int8_t dir = 0; uint8_t stance = 0;
-                            SafeReadMemory(pBase + BLOCK_DIRECTION_OFFSET, &dir, sizeof(dir));
-                            SafeReadMemory(pBase + BLOCK_STANCE_OFFSET, &stance, sizeof(stance));
+                            ReadSampledPlayerField(pBase, BLOCK_DIRECTION_OFFSET, dir);
+                            ReadSampledPlayerField(pBase, BLOCK_STANCE_OFFSET, stance);
                             // Compute frameBlock pointer
                             uint16_t state = 0, frame = 0; uintptr_t animTab = 0, framesPtr = 0, frameBlock = 0;
-                            SafeReadMemory(pBase + MOVE_ID_OFFSET, &state, sizeof(state)); // move/state at +0x8
-                            SafeReadMemory(pBase + CURRENT_FRAME_INDEX_OFFSET, &frame, sizeof(frame));
-                            SafeReadMemory(pBase + ANIM_TABLE_OFFSET, &animTab, sizeof(animTab));
+                            ReadSampledPlayerField(pBase, MOVE_ID_OFFSET, state); // move/state at +0x8
+                            ReadSampledPlayerField(pBase, CURRENT_FRAME_INDEX_OFFSET, frame);
+                            ReadSampledPlayerField(pBase, ANIM_TABLE_OFFSET, animTab);
                             if (animTab) {
                                 uintptr_t entryAddr = animTab + (static_cast<uintptr_t>(state) * ANIM_ENTRY_STRIDE) + ANIM_ENTRY_FRAMES_PTR_OFFSET;
                                 SafeReadMemory(entryAddr, &framesPtr, sizeof(framesPtr));
@@ -1853,12 +1921,16 @@ void FrameDataMonitor() {
                 bool faNeedsTick = FrameAdvantageTimersActive();
                 if (moveIDsChanged || faNeedsTick) {
                     // Use context overload (currently thin wrapper) to begin migration
+                    TickProfiler::Scope prof(TickSection::FrameAdvantage);
                     MonitorFrameAdvantage(GetCurrentPerFrameSample());
                 }
             }
             
             // Run dummy auto-block using unified sample (still every frame for precision)
-            MonitorDummyAutoBlock(GetCurrentPerFrameSample());
+            {
+                TickProfiler::Scope prof(TickSection::DummyAutoBlock);
+                MonitorDummyAutoBlock(GetCurrentPerFrameSample());
+            }
 
             // Practice-only: Defense helpers
             // Always RG takes effect when enabled; Random RG mimics Revival's per-frame coin flip.
@@ -1872,6 +1944,7 @@ void FrameDataMonitor() {
                 // When tick-integrated mode is active, auto-actions are driven directly from the
                 // engine's per-tick input hook; skip here to avoid double-processing.
                 if (!g_tickIntegratedAutoActions.load()) {
+                    TickProfiler::Scope prof(TickSection::AutoActions);
                     ProcessTriggerDelays();      // Handle pending delays
                     // Pass cached move IDs to avoid extra reads and enable lighter math inside
                     MonitorAutoActions(moveID1, moveID2, prevMoveID1, prevMoveID2);
@@ -1882,7 +1955,10 @@ void FrameDataMonitor() {
                 MonitorAutoJump();
                 
                 // STEP 3: Auto-airtech (every frame for precision, no throttling)
-                MonitorAutoAirtech(moveID1, moveID2);  
+                {
+                    TickProfiler::Scope prof(TickSection::AutoAirtech);
+                    MonitorAutoAirtech(moveID1, moveID2);
+                }
                 ClearDelayStatesIfNonActionable();     
             }
 
@@ -1983,8 +2059,7 @@ void FrameDataMonitor() {
                         bool wroteHpOrMeter = false;
                         bool appliedRf = false;
                         if (tg.hpOn) {
-                            uintptr_t hpA = pBase + HP_OFFSET;
-                            int cur=0; SafeReadMemory(hpA, &cur, sizeof(cur));
+                            int cur=0; ReadSampledPlayerField(pBase, HP_OFFSET, cur);
                             int tgt = CLAMP(tg.hp, 0, MAX_HP);
                             if (cur != tgt) {
                                 SafeWriteMemory(pBase + HP_OFFSET, &tgt, sizeof(tgt));
@@ -1994,7 +2069,7 @@ void FrameDataMonitor() {
                         }
                         if (tg.meterOn) {
                             uintptr_t mA = pBase + METER_OFFSET;
-                            int curFull=0; SafeReadMemory(mA, &curFull, sizeof(curFull));
+                            int curFull=0; ReadSampledPlayerField(pBase, METER_OFFSET, curFull);
                             WORD cur = (WORD)(curFull & 0xFFFF);
                             WORD tgt = (WORD)CLAMP(tg.meter, 0, MAX_METER);
                             if (cur != tgt) { SafeWriteMemory(mA, &tgt, sizeof(tgt)); wroteHpOrMeter = true; }
@@ -2004,8 +2079,8 @@ void FrameDataMonitor() {
                             double p1rf=0.0, p2rf=0.0;
                             uintptr_t p1B = getPlayerBase(1);
                             uintptr_t p2B = getPlayerBase(2);
-                            if (p1B) SafeReadMemory(p1B + RF_OFFSET, &p1rf, sizeof(p1rf));
-                            if (p2B) SafeReadMemory(p2B + RF_OFFSET, &p2rf, sizeof(p2rf));
+                            if (p1B) ReadSampledPlayerField(p1B, RF_OFFSET, p1rf);
+                            if (p2B) ReadSampledPlayerField(p2B, RF_OFFSET, p2rf);
                             if (p==1) p1rf = tg.rf; else p2rf = tg.rf;
                             (void)SetRFValuesDirect(p1rf, p2rf); // best-effort write; freeze handles persistence
                             appliedRf = true;
@@ -2019,8 +2094,8 @@ void FrameDataMonitor() {
                             uintptr_t p1B = getPlayerBase(1);
                             uintptr_t p2B = getPlayerBase(2);
                             int ic1=1, ic2=1;
-                            if (p1B) SafeReadMemory(p1B + IC_COLOR_OFFSET, &ic1, sizeof(ic1));
-                            if (p2B) SafeReadMemory(p2B + IC_COLOR_OFFSET, &ic2, sizeof(ic2));
+                            if (p1B) ReadSampledPlayerField(p1B, IC_COLOR_OFFSET, ic1);
+                            if (p2B) ReadSampledPlayerField(p2B, IC_COLOR_OFFSET, ic2);
                             bool p1Blue = (p==1)? true : (ic1 != 0);
                             bool p2Blue = (p==2)? true : (ic2 != 0);
                             
@@ -2036,8 +2111,8 @@ void FrameDataMonitor() {
                             uintptr_t p1B = getPlayerBase(1);
                             uintptr_t p2B = getPlayerBase(2);
                             int ic1=0, ic2=0;
-                            if (p1B) SafeReadMemory(p1B + IC_COLOR_OFFSET, &ic1, sizeof(ic1));
-                            if (p2B) SafeReadMemory(p2B + IC_COLOR_OFFSET, &ic2, sizeof(ic2));
+                            if (p1B) ReadSampledPlayerField(p1B, IC_COLOR_OFFSET, ic1);
+                            if (p2B) ReadSampledPlayerField(p2B, IC_COLOR_OFFSET, ic2);
                             bool p1Blue = (ic1 != 0);
                             bool p2Blue = (ic2 != 0);
                             if ((p==1 && p1Blue) || (p==2 && p2Blue)) {
@@ -2152,11 +2227,11 @@ void FrameDataMonitor() {
                     uintptr_t p1B = ResolvePlayerBaseBestEffort(1, baseNow);
                     uintptr_t p2B = ResolvePlayerBaseBestEffort(2, baseNow);
                     if (p1B && sample.neutral1) {
-                        int hp = 1; SafeReadMemory(p1B + HP_OFFSET, &hp, sizeof(hp));
+                        int hp = 1; ReadSampledPlayerField(p1B, HP_OFFSET, hp);
                         if (hp <= 0) { int full = MAX_HP; SafeWriteMemory(p1B + HP_OFFSET, &full, sizeof(full)); SafeWriteMemory(p1B + HP_BAR_OFFSET, &full, sizeof(full)); }
                     }
                     if (p2B && sample.neutral2) {
-                        int hp = 1; SafeReadMemory(p2B + HP_OFFSET, &hp, sizeof(hp));
+                        int hp = 1; ReadSampledPlayerField(p2B, HP_OFFSET, hp);
                         if (hp <= 0) { int full = MAX_HP; SafeWriteMemory(p2B + HP_OFFSET, &full, sizeof(full)); SafeWriteMemory(p2B + HP_BAR_OFFSET, &full, sizeof(full)); }
                     }
                 }
@@ -2166,42 +2241,18 @@ void FrameDataMonitor() {
 
             // Publish a snapshot for other consumers at the end of logic section
             {
-                // Resolve and cache addresses periodically to minimize ResolvePointer overhead
-                static uintptr_t s_p1YAddr = 0, s_p2YAddr = 0;
-                static uintptr_t s_p1XAddr = 0, s_p2XAddr = 0;
-                static uintptr_t s_p1HpAddr = 0, s_p2HpAddr = 0;
-                static uintptr_t s_p1MeterAddr = 0, s_p2MeterAddr = 0;
-                static uintptr_t s_p1RfAddr = 0, s_p2RfAddr = 0;
-                static uintptr_t s_p1CharNameAddr = 0, s_p2CharNameAddr = 0; // used to derive IDs if needed
-                static uintptr_t s_p1CharIdAddr = 0, s_p2CharIdAddr = 0; // if ID offset exists in struct (fallback to name->id map)
-                static int s_cacheCounter = 0;
                 // Clean Hit helper state (HP-based, one-shot)
                 static int s_prevHpP1 = -1, s_prevHpP2 = -1;
                 static int s_cleanHitSuppress = 0; // small cooldown in frames to avoid dupes
-                if (++s_cacheCounter >= 192 || !s_p1YAddr || !s_p2YAddr || !s_p1XAddr || !s_p2XAddr ||
-                    !s_p1HpAddr || !s_p2HpAddr || !s_p1MeterAddr || !s_p2MeterAddr || !s_p1RfAddr || !s_p2RfAddr ||
-                    !s_p1CharNameAddr || !s_p2CharNameAddr) {
-                    s_p1YAddr = ResolvePlayerFieldBestEffort(1, YPOS_OFFSET, base);
-                    s_p2YAddr = ResolvePlayerFieldBestEffort(2, YPOS_OFFSET, base);
-                    s_p1XAddr = ResolvePlayerFieldBestEffort(1, XPOS_OFFSET, base);
-                    s_p2XAddr = ResolvePlayerFieldBestEffort(2, XPOS_OFFSET, base);
-                    s_p1HpAddr = ResolvePlayerFieldBestEffort(1, HP_OFFSET, base);
-                    s_p2HpAddr = ResolvePlayerFieldBestEffort(2, HP_OFFSET, base);
-                    s_p1MeterAddr = ResolvePlayerFieldBestEffort(1, METER_OFFSET, base);
-                    s_p2MeterAddr = ResolvePlayerFieldBestEffort(2, METER_OFFSET, base);
-                    s_p1RfAddr = ResolvePlayerFieldBestEffort(1, RF_OFFSET, base);
-                    s_p2RfAddr = ResolvePlayerFieldBestEffort(2, RF_OFFSET, base);
-                    s_p1CharNameAddr = ResolvePlayerFieldBestEffort(1, CHARACTER_NAME_OFFSET, base);
-                    s_p2CharNameAddr = ResolvePlayerFieldBestEffort(2, CHARACTER_NAME_OFFSET, base);
-                    s_cacheCounter = 0;
-                }
 
-                // Read values with best-effort safety
-                double p1Y=0.0, p2Y=0.0; if (s_p1YAddr) SafeReadMemory(s_p1YAddr, &p1Y, sizeof(p1Y)); if (s_p2YAddr) SafeReadMemory(s_p2YAddr, &p2Y, sizeof(p2Y));
-                double p1X=0.0, p2X=0.0; if (s_p1XAddr) SafeReadMemory(s_p1XAddr, &p1X, sizeof(p1X)); if (s_p2XAddr) SafeReadMemory(s_p2XAddr, &p2X, sizeof(p2X));
-                int p1Hp=0, p2Hp=0; if (s_p1HpAddr) SafeReadMemory(s_p1HpAddr, &p1Hp, sizeof(p1Hp)); if (s_p2HpAddr) SafeReadMemory(s_p2HpAddr, &p2Hp, sizeof(p2Hp));
-                int p1Meter=0, p2Meter=0; if (s_p1MeterAddr) { unsigned short w=0; SafeReadMemory(s_p1MeterAddr, &w, sizeof(w)); p1Meter=(int)w; } if (s_p2MeterAddr) { unsigned short w=0; SafeReadMemory(s_p2MeterAddr, &w, sizeof(w)); p2Meter=(int)w; }
-                double p1Rf=0.0, p2Rf=0.0; if (s_p1RfAddr) SafeReadMemory(s_p1RfAddr, &p1Rf, sizeof(p1Rf)); if (s_p2RfAddr) SafeReadMemory(s_p2RfAddr, &p2Rf, sizeof(p2Rf));
+                // Decode from the tick snapshot (zero when a side wasn't captured)
+                const PlayerSnapshot &ps1 = g_lastSample.p1;
+                const PlayerSnapshot &ps2 = g_lastSample.p2;
+                double p1Y = ps1.Get<double>(YPOS_OFFSET), p2Y = ps2.Get<double>(YPOS_OFFSET);
+                double p1X = ps1.Get<double>(XPOS_OFFSET), p2X = ps2.Get<double>(XPOS_OFFSET);
+                int p1Hp = ps1.Get<int>(HP_OFFSET), p2Hp = ps2.Get<int>(HP_OFFSET);
+                int p1Meter = (int)ps1.Get<unsigned short>(METER_OFFSET), p2Meter = (int)ps2.Get<unsigned short>(METER_OFFSET);
+                double p1Rf = ps1.Get<double>(RF_OFFSET), p2Rf = ps2.Get<double>(RF_OFFSET);
 
                 FrameSnapshot snap{};
                 snap.tickMs = GetTickCount64();
@@ -2221,12 +2272,12 @@ void FrameDataMonitor() {
                 snap.p1RF = p1Rf; snap.p2RF = p2Rf;
                 // Character IDs: derive from name if direct ID offset is unavailable
                 int pid1 = -1, pid2 = -1;
-                if (s_p1CharNameAddr) {
-                    char name1[16] = {0}; SafeReadMemory(s_p1CharNameAddr, &name1, sizeof(name1)-1);
+                if (ps1.valid) {
+                    char name1[16] = {0}; memcpy(name1, ps1.raw + CHARACTER_NAME_OFFSET, sizeof(name1)-1);
                     pid1 = CharacterSettings::GetCharacterID(std::string(name1));
                 }
-                if (s_p2CharNameAddr) {
-                    char name2[16] = {0}; SafeReadMemory(s_p2CharNameAddr, &name2, sizeof(name2)-1);
+                if (ps2.valid) {
+                    char name2[16] = {0}; memcpy(name2, ps2.raw + CHARACTER_NAME_OFFSET, sizeof(name2)-1);
                     pid2 = CharacterSettings::GetCharacterID(std::string(name2));
                 }
                 snap.p1CharId = pid1; snap.p2CharId = pid2;
@@ -2286,12 +2337,10 @@ void FrameDataMonitor() {
                                     }
                                 }
 
-                                LogOut(std::string("[CLEANHIT][FM] atk=P") + std::to_string(atkPlayer) +
-                                       " def=P" + std::to_string(defPlayer) +
-                                       " move=" + std::to_string((int)atkMove) +
-                                       " diffY=" + std::to_string(diff) +
-                                       " -> " + ss.str(), true);
-                                DirectDrawHook::AddMessage(ss.str(), "SYSTEM", RGB(255, 255, 0), 1500, 0, 100);
+                                const std::string verdict = ss.str();
+                                EFZ_LOG(LogCat::CleanHit, true, "[CLEANHIT][FM] atk=P%d def=P%d move=%d diffY=%f -> %s",
+                                        atkPlayer, defPlayer, (int)atkMove, diff, verdict);
+                                DirectDrawHook::AddMessage(verdict, "SYSTEM", RGB(255, 255, 0), 1500, 0, 100);
                                 s_cleanHitSuppress = 8; // ~40ms at 192fps
                             }
                         }
@@ -2302,6 +2351,7 @@ void FrameDataMonitor() {
                 }
 
                 PublishSnapshot(snap);
+                TraceRecorder::RecordTick(g_lastSample, snap);
 
                 // Enforce character-specific settings on a modest cadence (~16 Hz)
                 static int charEnfDecim = 0;
@@ -2309,6 +2359,7 @@ void FrameDataMonitor() {
                     // Keep IDs fresh for enforcement decisions
                     if (snap.p1CharId >= 0) displayData.p1CharID = snap.p1CharId;
                     if (snap.p2CharId >= 0) displayData.p2CharID = snap.p2CharId;
+                    TickProfiler::Scope prof(TickSection::CharEnforcement);
                     CharacterSettings::TickCharacterEnforcements(base, displayData);
                 }
 
@@ -2331,8 +2382,8 @@ void FrameDataMonitor() {
             prevMoveID1 = moveID1;
             prevMoveID2 = moveID2;
 
-            // AttackReader disabled to reduce CPU usage
-            if (!DISABLE_ATTACK_READER && moveID1 != lastLoggedMoveID1 && IsAttackMove(moveID1)) {
+            // Attack data is a table lookup now (attack_table.h); log attack starts in detailed mode
+            if (detailedLogging.load() && moveID1 != lastLoggedMoveID1 && IsAttackMove(moveID1)) {
             // Don't log too frequently - enforce a cooldown
             if (moveLogCooldown.load() <= 0) {
                 AttackReader::LogMoveData(1, moveID1);
@@ -2341,8 +2392,7 @@ void FrameDataMonitor() {
             }
         }
         
-    // AttackReader disabled to reduce CPU usage
-    if (!DISABLE_ATTACK_READER && moveID2 != lastLoggedMoveID2 && IsAttackMove(moveID2)) {
+    if (detailedLogging.load() && moveID2 != lastLoggedMoveID2 && IsAttackMove(moveID2)) {
             // Don't log too frequently - enforce a cooldown
             if (moveLogCooldown.load() <= 0) {
                 AttackReader::LogMoveData(2, moveID2);
@@ -2362,6 +2412,8 @@ void FrameDataMonitor() {
 FRAME_MONITOR_FRAME_END:
         // New paced sleep using accumulated schedule (expectedNext)
         auto beforeSleep = clock::now();
+        TickProfiler::Record(TickSection::Tick, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(beforeSleep - frameStart).count());
+        TickProfiler::EndTick();
         while (beforeSleep < expectedNext) {
             auto remaining = expectedNext - beforeSleep;
             if (remaining > std::chrono::microseconds(100)) {
@@ -2391,7 +2443,7 @@ FRAME_MONITOR_FRAME_END:
         // Maintain RF freeze inline only during Match. Outside Match, avoid repeated stop spam.
         if (currentPhase == GamePhase::Match) {
             // ~32 Hz maintenance
-            static int rfDecim = 0; if ((rfDecim++ % 6) == 0) { UpdateRFFreezeTick(); }
+            static int rfDecim = 0; if ((rfDecim++ % 6) == 0) { TickProfiler::Scope prof(TickSection::RFFreeze); UpdateRFFreezeTick(); }
         } else {
             // Outside Match: do not maintain or force-stop; CR will handle start/stop explicitly
         }
@@ -2417,19 +2469,18 @@ FRAME_MONITOR_FRAME_END:
         if (driftSamples >= 960) {
             double avgDriftUs = (double)driftAccum / driftSamples / 1000.0;
             double avgAbsDriftUs = (double)absDriftAccum / driftSamples / 1000.0;
-            if (Config::GetSettings().enableFpsDiagnostics) LogOut("[FRAME_MONITOR][TIMING] samples=" + std::to_string(driftSamples) +
-             " avgDrift(us)=" + std::to_string(avgDriftUs) +
-             " avgAbs(us)=" + std::to_string(avgAbsDriftUs) +
-             " maxLate(ms)=" + std::to_string(maxLate/1e6) +
-             " maxEarly(ms)=" + std::to_string(maxEarly/1e6) +
-             " oversleep>2x=" + std::to_string(oversleepCount), detailedLogging.load());
-            if (Config::GetSettings().enableFpsDiagnostics && sectionTiming && sec_samples > 0) {
-          LogOut("[FRAME MONITOR][SECTIONS] samples=" + std::to_string(sec_samples) +
-              " memAvg(us)=" + std::to_string((sec_mem / 1000.0)/sec_samples) +
-              " logicAvg(us)=" + std::to_string((sec_logic / 1000.0)/sec_samples) +
-              " featAvg(us)=" + std::to_string((sec_features / 1000.0)/sec_samples), detailedLogging.load());
-                sec_mem = sec_logic = sec_features = 0;
-                sec_samples = 0;
+            if (Config::GetSettings().enableFpsDiagnostics) EFZ_LOG(LogCat::FrameMonitor, detailedLogging.load(),
+             "[FRAME_MONITOR][TIMING] samples=%d avgDrift(us)=%f avgAbs(us)=%f maxLate(ms)=%f maxEarly(ms)=%f oversleep>2x=%d snapReads=%u snapBytes=%u",
+             driftSamples, avgDriftUs, avgAbsDriftUs, maxLate / 1e6, maxEarly / 1e6, oversleepCount,
+             g_lastSample.snapshotReads, g_lastSample.snapshotBytes);
+            if (Config::GetSettings().enableFpsDiagnostics) {
+                // Cumulative since the last profiler reset (Debug tab)
+                TickProfiler::SectionStats tick = TickProfiler::GetStats(TickSection::Tick);
+                TickProfiler::SectionStats fa = TickProfiler::GetStats(TickSection::FrameAdvantage);
+                TickProfiler::SectionStats aa = TickProfiler::GetStats(TickSection::AutoActions);
+                EFZ_LOG(LogCat::FrameMonitorAlt, detailedLogging.load(),
+                    "[FRAME MONITOR][SECTIONS] tick p50=%.1fus p99=%.1fus max=%.1fus over=%u | frameAdv p99=%.1fus | autoActions p99=%.1fus",
+                    tick.p50Us, tick.p99Us, tick.maxUs, tick.overBudget, fa.p99Us, aa.p99Us);
             }
             driftAccum = 0;
             absDriftAccum = 0;
@@ -2535,34 +2586,6 @@ void ReinitializeOverlays() {
     LogOut("[FRAME MONITOR] Reinitialized overlay displays", true);
 }
 
-bool AreCharactersInitialized() {
-    uintptr_t base = GetEFZBase();
-    if (!base) {
-        return false;
-    }
-
-    // Check if both P1 and P2 character pointers exist
-    uintptr_t p1StructAddr = 0;
-    uintptr_t p2StructAddr = 0;
-    SafeReadMemory(base + EFZ_BASE_OFFSET_P1, &p1StructAddr, sizeof(uintptr_t));
-    SafeReadMemory(base + EFZ_BASE_OFFSET_P2, &p2StructAddr, sizeof(uintptr_t));
-
-    // Check if both pointers are valid and at least one has a non-zero HP value
-    if (p1StructAddr && p2StructAddr) {
-        int hp1 = 0, hp2 = 0;
-        uintptr_t hp1Addr = p1StructAddr + HP_OFFSET;
-        uintptr_t hp2Addr = p2StructAddr + HP_OFFSET;
-
-        SafeReadMemory(hp1Addr, &hp1, sizeof(int));
-        SafeReadMemory(hp2Addr, &hp2, sizeof(int));
-
-        // Consider initialized if both pointers exist and at least one has HP
-        return (hp1 > 0 || hp2 > 0);
-    }
-    
-    return false;
-}
-
 void UpdateStatsDisplay() {
     // Always require overlay hook; allow Clean Hit helper to run even if stats are disabled
     if (!DirectDrawHook::isHooked) {
@@ -2821,9 +2844,9 @@ void UpdateStatsDisplay() {
             uintptr_t p1BasePtr = ResolvePlayerBaseBestEffort(1, base);
             if (p1BasePtr) {
                 uint16_t st = 0, fr = 0; uintptr_t animTab = 0;
-                if (SafeReadMemory(p1BasePtr + MOVE_ID_OFFSET, &st, sizeof(st)) &&
-                    SafeReadMemory(p1BasePtr + CURRENT_FRAME_INDEX_OFFSET, &fr, sizeof(fr)) &&
-                    SafeReadMemory(p1BasePtr + ANIM_TABLE_OFFSET, &animTab, sizeof(animTab)) && animTab) {
+                if (ReadSampledPlayerField(p1BasePtr, MOVE_ID_OFFSET, st) &&
+                    ReadSampledPlayerField(p1BasePtr, CURRENT_FRAME_INDEX_OFFSET, fr) &&
+                    ReadSampledPlayerField(p1BasePtr, ANIM_TABLE_OFFSET, animTab) && animTab) {
                     uintptr_t framesPtr = 0;
                     uintptr_t entryAddr = animTab + (static_cast<uintptr_t>(st) * ANIM_ENTRY_STRIDE) + ANIM_ENTRY_FRAMES_PTR_OFFSET;
                     if (SafeReadMemory(entryAddr, &framesPtr, sizeof(framesPtr)) && framesPtr) {
@@ -2878,8 +2901,8 @@ void UpdateStatsDisplay() {
             uintptr_t p1 = ResolvePlayerBaseBestEffort(1, baseNow);
             uintptr_t p2 = ResolvePlayerBaseBestEffort(2, baseNow);
             short p1Blk=0, p2Blk=0, p1Hit=0, p2Hit=0;
-            if (p1) { SafeReadMemory(p1 + BLOCKSTUN_OFFSET, &p1Blk, sizeof(p1Blk)); SafeReadMemory(p1 + UNTECH_OFFSET, &p1Hit, sizeof(p1Hit)); }
-            if (p2) { SafeReadMemory(p2 + BLOCKSTUN_OFFSET, &p2Blk, sizeof(p2Blk)); SafeReadMemory(p2 + UNTECH_OFFSET, &p2Hit, sizeof(p2Hit)); }
+            if (p1) { ReadSampledPlayerField(p1, BLOCKSTUN_OFFSET, p1Blk); ReadSampledPlayerField(p1, UNTECH_OFFSET, p1Hit); }
+            if (p2) { ReadSampledPlayerField(p2, BLOCKSTUN_OFFSET, p2Blk); ReadSampledPlayerField(p2, UNTECH_OFFSET, p2Hit); }
             // Return raw counters as integers; clamp negatives to zero for display neatness
             auto clamp0 = [](int v){ return v < 0 ? 0 : v; };
             return std::tuple<int,int,int,int>(clamp0((int)p1Blk), clamp0((int)p1Hit), clamp0((int)p2Blk), clamp0((int)p2Hit));
@@ -2901,8 +2924,8 @@ void UpdateStatsDisplay() {
             uintptr_t p1=ResolvePlayerBaseBestEffort(1, baseNow);
             uintptr_t p2=ResolvePlayerBaseBestEffort(2, baseNow);
             short p1Cand=0, p2Cand=0;
-            if (p1) { SafeReadMemory(p1 + BLOCKSTUN_OFFSET + 2, &p1Cand, sizeof(p1Cand)); }
-            if (p2) { SafeReadMemory(p2 + BLOCKSTUN_OFFSET + 2, &p2Cand, sizeof(p2Cand)); }
+            if (p1) { ReadSampledPlayerField(p1, BLOCKSTUN_OFFSET + 2, p1Cand); }
+            if (p2) { ReadSampledPlayerField(p2, BLOCKSTUN_OFFSET + 2, p2Cand); }
             std::stringstream diag;
             diag << "Blk?(+0x14C): P1 " << (int)(p1Cand < 0 ? 0 : p1Cand) << "  P2 " << (int)(p2Cand < 0 ? 0 : p2Cand);
             upsert(g_statsAIFlagsId, diag.str()); // reuse AI flags line position temporarily below character lines
@@ -3178,10 +3201,10 @@ void UpdateStatsDisplay() {
                 p1BasePtr = ResolvePlayerBaseBestEffort(1, base);
                 p2BasePtr = ResolvePlayerBaseBestEffort(2, base);
                 if (p1BasePtr) {
-                    haveP1 = SafeReadMemory(p1BasePtr + AI_CONTROL_FLAG_OFFSET, &p1AI, sizeof(p1AI));
+                    haveP1 = ReadSampledPlayerField(p1BasePtr, AI_CONTROL_FLAG_OFFSET, p1AI);
                 }
                 if (p2BasePtr) {
-                    haveP2 = SafeReadMemory(p2BasePtr + AI_CONTROL_FLAG_OFFSET, &p2AI, sizeof(p2AI));
+                    haveP2 = ReadSampledPlayerField(p2BasePtr, AI_CONTROL_FLAG_OFFSET, p2AI);
                 }
                 std::stringstream aiLine;
                 aiLine << "AI: P1=" << (haveP1 ? (p1AI?"1":"0") : "-") << " P2=" << (haveP2 ? (p2AI?"1":"0") : "-");
@@ -15,6 +15,11 @@
 #include "../include/game/practice_offsets.h"
 #include "../include/utils/utilities.h"   // GetEFZBase, IsEFZWindowActive, etc.
 #include "../include/game/frame_monitor.h" // AreCharactersInitialized()
+#include "../include/game/macro_columns.h"
+#include "../include/game/macro_library.h"
+#include "../include/game/macro_text.h"
+#include "../include/game/macro_replay.h"
+#include "../include/utils/config.h"
 #include <vector>
 #include <atomic>
 #include <sstream>
@@ -22,6 +27,12 @@
 #include <cctype>
 #include <algorithm>
 
+static_assert(MacroText::kRight == GAME_INPUT_RIGHT && MacroText::kLeft == GAME_INPUT_LEFT &&
+              MacroText::kDown == GAME_INPUT_DOWN && MacroText::kUp == GAME_INPUT_UP &&
+              MacroText::kA == GAME_INPUT_A && MacroText::kB == GAME_INPUT_B &&
+              MacroText::kC == GAME_INPUT_C && MacroText::kD == GAME_INPUT_D,
+              "macro text mask bits out of sync with input_core.h");
+
 // Forward decls in case headers aren't visible due to include order in some TU configs
 extern uintptr_t GetEFZBase();
 bool AreCharactersInitialized();
@@ -38,26 +49,36 @@ namespace {
     struct RLESpan { Mask mask; Mask buf; int ticks; int8_t facing; };
     struct Slot {
         std::vector<RLESpan> spans; // RLE of immediate+buf at 64 Hz
+        // Per-tick columns are run/delta encoded in chunked storage (see macro_columns.h)
         // one byte per 64 Hz logic frame
         // This is the authoritative stream used for playback (StepReplay: Read→inject immediate-only)
-        std::vector<uint8_t> macroStream;
-        std::vector<uint8_t> bufStream; // full circular buffer stream captured during recording
+        RunColumn<uint8_t> macroStream;
+        RunColumn<uint8_t> bufStream; // full circular buffer stream captured during recording
         // Number of buffer entries observed per 64 Hz recorder tick (parallel to spans progression timing, not one-to-one)
         // This preserves how many raw buffer writes the engine produced between each recorder tick.
-        std::vector<uint16_t> bufCountsPerTick;
+        RunColumn<uint16_t> bufCountsPerTick;
         // Snapshot of the engine's buffer index each 64 Hz recorder tick
-        std::vector<uint16_t> bufIndexPerTick;
+        RunColumn<uint16_t> bufIndexPerTick;
         // Optional diagnostics: reason code per tick (U=unfrozen frameDiv, B=frozen buf advance, S=frozen step, X=frozen both)
-        std::vector<char> tickReason;
+        RunColumn<char> tickReason;
         // Raw immediate mask sampled at start of each recorder tick BEFORE any merging / union logic.
-        std::vector<uint8_t> immPerTick;
+        RunColumn<uint8_t> immPerTick;
         // Latest buffer entry value (ring[idx-1]) as observed this tick BEFORE any synthetic write insertion.
-        std::vector<uint8_t> bufLatestPerTick;
-        // Optional: full snapshot of the entire input buffer ring each tick (heavy, gated by constant below).
-        std::vector<std::vector<uint8_t>> fullBufferSnapshots;
+        RunColumn<uint8_t> bufLatestPerTick;
+        // Optional: full snapshot of the entire input buffer ring each tick (keyframe + diffs, gated by constant below).
+        SnapshotColumn fullBufferSnapshots;
         uint16_t bufStartIdx = 0; // buffer index at recording start
         uint16_t bufEndIdx = 0;   // buffer index at recording end
         bool hasData = false;
+        // Library mapping pinned while the columns above are bound to it (BindLibraryEntry)
+        MacroLibrary::EntryView libView;
+
+        // Chunk memory held by this slot's columns
+        size_t Bytes() const {
+            return spans.capacity() * sizeof(RLESpan) + macroStream.Bytes() + bufStream.Bytes() +
+                   bufCountsPerTick.Bytes() + bufIndexPerTick.Bytes() + tickReason.Bytes() +
+                   immPerTick.Bytes() + bufLatestPerTick.Bytes() + fullBufferSnapshots.Bytes();
+        }
     };
 
     constexpr int kMaxSlots = 8; // simple ring of slots
@@ -91,10 +112,9 @@ namespace {
     // Deprecated: replaced by per-tick queue to keep writes within the same 64 Hz tick
     std::vector<uint8_t> s_bufWriteQueue; // legacy, unused after change (kept to preserve state during transitions)
     size_t s_bufQueueHead = 0;
-    // New: per-tick buffer write queue so we can evenly distribute N writes across 3 subframes
-    std::vector<uint8_t> s_tickBufQueue;
-    size_t s_tickBufHead = 0;
-    uint16_t s_writesLeftThisTick = 0; // how many buffer writes remain to issue in the current 64 Hz tick
+    // Per-tick stream step: baseline mask plus this tick's recorded buffer writes spread over 3 subframes
+    // (shared with the offline fidelity verifier, see macro_replay.h)
+    MacroReplay::TickStepper s_replayStep;
     // When finishing playback, we optionally inject one neutral frame (poll override = 0)
     // to guarantee the engine writes a neutral value into the input history immediately.
     bool s_finishing = false;
@@ -106,8 +126,6 @@ namespace {
     bool s_finishGuardActive = false;
     int  s_finishGuardFramesLeft = 0;  // internal frames (192 Hz)
     uint16_t s_finishGuardStartMoveId = 0;
-    // Baseline immediate mask for the current 64 Hz tick
-    uint8_t s_baselineMask = 0;
     // Playback synchronization: track last seen buffer index to detect when engine advances
     uint16_t s_lastSeenBufIdx = 0xFFFF;  // Last buffer index we observed
     bool s_playbackBufIdxSyncInitialized = false;
@@ -128,6 +146,16 @@ namespace {
     // Gating constants for heavy diagnostics
     constexpr bool kEnableFullBufferSnapshots = false; // set false if memory/log size becomes an issue
 
+    // Recorder memory budget (Config: macroSlotBudgetKB / macroTotalBudgetKB)
+    size_t SlotBudgetBytes() {
+        int kb = Config::GetSettings().macroSlotBudgetKB;
+        return (size_t)(kb > 0 ? kb : 4096) * 1024;
+    }
+    size_t TotalBudgetBytes() {
+        int kb = Config::GetSettings().macroTotalBudgetKB;
+        return (size_t)(kb > 0 ? kb : 16384) * 1024;
+    }
+
     // Unified freeze detector for macro timing.
     // Treat as frozen when:
     //  * Not in Match phase (avoid progressing during intros / menus)
@@ -176,75 +204,6 @@ namespace {
         return false;
     }
 
-    // Direction mask <-> numpad helpers
-    static char DirMaskToNumpad(uint8_t m) {
-        bool u = (m & GAME_INPUT_UP) != 0;
-        bool d = (m & GAME_INPUT_DOWN) != 0;
-        bool l = (m & GAME_INPUT_LEFT) != 0;
-        bool r = (m & GAME_INPUT_RIGHT) != 0;
-        // Resolve invalid combos by neutral (5)
-        if ((u && d) || (l && r)) return '5';
-        if (u && r) return '9';
-        if (u && l) return '7';
-        if (d && r) return '3';
-        if (d && l) return '1';
-        if (u) return '8';
-        if (d) return '2';
-        if (r) return '6';
-        if (l) return '4';
-        return '5';
-    }
-
-    static uint8_t NumpadCharToDirMask(char c) {
-        switch (c) {
-            case '1': return (GAME_INPUT_DOWN | GAME_INPUT_LEFT);
-            case '2': return (GAME_INPUT_DOWN);
-            case '3': return (GAME_INPUT_DOWN | GAME_INPUT_RIGHT);
-            case '4': return (GAME_INPUT_LEFT);
-            case '5': return 0;
-            case '6': return (GAME_INPUT_RIGHT);
-            case '7': return (GAME_INPUT_UP | GAME_INPUT_LEFT);
-            case '8': return (GAME_INPUT_UP);
-            case '9': return (GAME_INPUT_UP | GAME_INPUT_RIGHT);
-            case 'N': return 0; // alias
-            default:  return 0xFF; // invalid sentinel
-        }
-    }
-
-    static std::string MaskToToken(uint8_t m) {
-        uint8_t dir = m & (GAME_INPUT_UP | GAME_INPUT_DOWN | GAME_INPUT_LEFT | GAME_INPUT_RIGHT);
-        std::string t;
-        t.push_back(DirMaskToNumpad(dir));
-        // Append buttons in A..D order
-        if (m & GAME_INPUT_A) t.push_back('A');
-        if (m & GAME_INPUT_B) t.push_back('B');
-        if (m & GAME_INPUT_C) t.push_back('C');
-        if (m & GAME_INPUT_D) t.push_back('D');
-        return t;
-    }
-
-    static bool TryTokenToMask(const std::string& tok, uint8_t& outMask) {
-        if (tok.empty()) return false;
-        // Accept 'N' or 'n' as neutral
-        if (tok.size() == 1 && (tok[0] == 'N' || tok[0] == 'n')) { outMask = 0; return true; }
-        char d = tok[0];
-        if (d >= 'a' && d <= 'z') d = (char)std::toupper((unsigned char)d);
-        uint8_t dir = NumpadCharToDirMask(d);
-        if (dir == 0xFF) return false;
-        uint8_t btn = 0;
-        for (size_t i = 1; i < tok.size(); ++i) {
-            char c = tok[i];
-            if (c >= 'a' && c <= 'z') c = (char)std::toupper((unsigned char)c);
-            if (c == 'A') btn |= GAME_INPUT_A;
-            else if (c == 'B') btn |= GAME_INPUT_B;
-            else if (c == 'C') btn |= GAME_INPUT_C;
-            else if (c == 'D') btn |= GAME_INPUT_D;
-            else return false; // unexpected char
-        }
-        outMask = (dir | btn);
-        return true;
-    }
-
     static std::string MaskToButtons(Mask m) {
         // Use unified GAME_INPUT_* flags (input_core.h)
         std::string out;
@@ -262,7 +221,8 @@ namespace {
     }
 
     // --- Diagnostic helpers: stream dumps for analysis ---
-    static void LogVectorHex(const char* label, int slot, const char* phase, const std::vector<uint8_t>& v, size_t perLine = 32) {
+    template <typename Column>
+    static void LogVectorHex(const char* label, int slot, const char* phase, const Column& v, size_t perLine = 32) {
         std::ostringstream line;
         line << "[MACRO][DUMP] slot=" << slot << " " << phase << " " << label << " (" << v.size() << "):";
         LogOut(line.str(), true);
@@ -285,7 +245,8 @@ namespace {
         }
     }
 
-    static void LogVectorU16(const char* label, int slot, const char* phase, const std::vector<uint16_t>& v, size_t perLine = 32) {
+    template <typename Column>
+    static void LogVectorU16(const char* label, int slot, const char* phase, const Column& v, size_t perLine = 32) {
         std::ostringstream line;
         line << "[MACRO][DUMP] slot=" << slot << " " << phase << " " << label << " (" << v.size() << "):";
         LogOut(line.str(), true);
@@ -308,7 +269,7 @@ namespace {
         }
     }
 
-    static void LogTickReasons(const char* phase, int slot, const std::vector<char>& reasons) {
+    static void LogTickReasons(const char* phase, int slot, const RunColumn<char>& reasons) {
         std::ostringstream line;
         line << "[MACRO][DUMP] slot=" << slot << " " << phase << " tickReason (" << reasons.size() << "):";
         LogOut(line.str(), true);
@@ -327,8 +288,8 @@ namespace {
         if (count > 0) LogOut(line.str(), true);
     }
 
-    static void LogPerTickOverview(int slot, const char* phase, const std::vector<uint8_t>& macroStream,
-                                   const std::vector<uint16_t>& bufCountsPerTick, const std::vector<uint16_t>& bufIndexPerTick) {
+    static void LogPerTickOverview(int slot, const char* phase, const RunColumn<uint8_t>& macroStream,
+                                   const RunColumn<uint16_t>& bufCountsPerTick, const RunColumn<uint16_t>& bufIndexPerTick) {
         const size_t ticks = macroStream.size();
         std::ostringstream hdr;
         hdr << "[MACRO][DUMP] slot=" << slot << " " << phase << " per-tick overview (" << ticks << "):";
@@ -422,8 +383,8 @@ namespace {
         s_playIndex = 0; s_playSpanRemaining = 0; s_playStreamIndex = 0; s_playBufStreamIndex = 0; s_frameDiv = 0;
         s_callsSinceDiv0 = 0; s_firstDiv0Seen = false;
         s_streamFacingPerTick.clear();
-        s_bufWriteQueue.clear(); s_bufQueueHead = 0; s_baselineMask = 0;
-        s_tickBufQueue.clear(); s_tickBufHead = 0; s_writesLeftThisTick = 0;
+        s_bufWriteQueue.clear(); s_bufQueueHead = 0;
+        s_replayStep.Reset();
         s_finishing = false; s_finishNeutralFrames = 0; s_finishPendingClearTick = false;
         s_finishGuardActive = false; s_finishGuardFramesLeft = 0; s_finishGuardStartMoveId = 0;
         // Reset playback buffer index synchronization
@@ -478,8 +439,8 @@ namespace {
                 size_t added = s_slots[slotIdx].bufStream.size() - beforeSize;
                 if (added > 0) {
                     if (!s_slots[slotIdx].bufCountsPerTick.empty()) {
-                        s_slots[slotIdx].bufCountsPerTick.back() = static_cast<uint16_t>(
-                            (uint32_t)s_slots[slotIdx].bufCountsPerTick.back() + (uint32_t)added);
+                        s_slots[slotIdx].bufCountsPerTick.SetBack(static_cast<uint16_t>(
+                            (uint32_t)s_slots[slotIdx].bufCountsPerTick.back() + (uint32_t)added));
                     } else {
                         // If there were no ticks recorded (edge case), start with the added amount
                         s_slots[slotIdx].bufCountsPerTick.push_back(static_cast<uint16_t>(added));
@@ -519,7 +480,8 @@ namespace {
             // To avoid massive spam, dump only first and last snapshot (if distinct)
             if (!s_slots[slotIdx].fullBufferSnapshots.empty()) {
                 auto dumpSnap = [&](size_t i, const char* tag){
-                    const auto &snap = s_slots[slotIdx].fullBufferSnapshots[i];
+                    std::vector<uint8_t> snap;
+                    s_slots[slotIdx].fullBufferSnapshots.Decode(i, snap);
                     std::ostringstream hdr; hdr << "[MACRO][DUMP]   snapshot[" << i << "](" << tag << "):"; LogOut(hdr.str(), true);
                     std::ostringstream line; size_t count=0; for (size_t b=0;b<snap.size();++b){ if(count==0){ line<<"[MACRO][DUMP]     "; }
                         line<< std::hex << std::uppercase << std::setfill('0') << std::setw(2) << (int)snap[b]; if (b+1<snap.size()) line<<' ';
@@ -736,7 +698,7 @@ void Tick() {
                         uint8_t v=0; SafeReadMemory(p2PtrSnap + INPUT_BUFFER_OFFSET + (uintptr_t)bi, &v, sizeof(v)); snap[bi]=v;
                     }
                 }
-                s_slots[slotIdx].fullBufferSnapshots.push_back(std::move(snap));
+                s_slots[slotIdx].fullBufferSnapshots.push_back(snap);
             }
         }
         // Ensure we "capture the buffer" every recorder tick: if the engine produced
@@ -746,7 +708,7 @@ void Tick() {
             int slotIdx = ClampSlot(s_curSlot.load()) - 1;
             if (!s_slots[slotIdx].bufCountsPerTick.empty() && s_slots[slotIdx].bufCountsPerTick.back() == 0) {
                 s_slots[slotIdx].bufStream.push_back(mask); // synthetic neutral/held state
-                s_slots[slotIdx].bufCountsPerTick.back() = 1;
+                s_slots[slotIdx].bufCountsPerTick.SetBack(1);
                 buf = mask; // treat buffer value as this synthetic entry for span comparison logic
                 LogOut(std::string("[MACRO][REC] synthetic-buf write (neutral tick) reason=") + reasonCode, true);
             }
@@ -770,6 +732,19 @@ void Tick() {
                    " facing=" + std::to_string(s_recLastFacing) + " reason=" + s_recLastReason, true);
             s_recLastMask = mask; s_recLastBuf = mask; s_recLastFacing = facing; s_recSpanTicks = 1; s_recLastReason = reasonCode;
         }
+        // Enforce the recorder memory budget (per slot and across all slots)
+        {
+            int slotIdx = ClampSlot(s_curSlot.load()) - 1;
+            const size_t slotBytes = s_slots[slotIdx].Bytes();
+            const size_t totalBytes = MacroColumns::LiveBytes().load(std::memory_order_relaxed);
+            if (slotBytes > SlotBudgetBytes() || totalBytes > TotalBudgetBytes()) {
+                LogOut("[MACRO][REC] memory budget reached: slot=" + std::to_string(slotBytes / 1024) + "KB/" +
+                       std::to_string(SlotBudgetBytes() / 1024) + "KB total=" + std::to_string(totalBytes / 1024) + "KB/" +
+                       std::to_string(TotalBudgetBytes() / 1024) + "KB ticks=" + std::to_string((int)s_slots[slotIdx].macroStream.size()), true);
+                DirectDrawHook::AddMessage("Macro: memory budget reached, recording stopped", "MACRO", RGB(255,160,120), 1800, 0, 120);
+                FinishRecording();
+            }
+        }
     } else if (st == State::Replaying) {
         // Finish guard: after neutral clear tick, hold neutral until moveID activation or timeout
         if (s_finishGuardActive) {
@@ -828,10 +803,7 @@ void Tick() {
             s_finishing = true;
             s_finishNeutralFrames = 3; // full tick at 192 Hz pacing
             // Clear any residual queues/baseline
-            s_tickBufQueue.clear();
-            s_tickBufHead = 0;
-            s_writesLeftThisTick = 0;
-            s_baselineMask = 0;
+            s_replayStep.Reset();
         }
         // While waiting for the next boundary, maintain neutral override to avoid tail holds
         if (s_finishPendingClearTick && s_frameDiv != 0) {
@@ -919,16 +891,16 @@ void Tick() {
                 if (curFacing != 0 && recFacing != curFacing) {
                     mask = FlipMaskHoriz(mask);
                 }
-                s_baselineMask = mask;
                 
                 // CRITICAL: Restore the FULL BUFFER SNAPSHOT from recording
                 // This ensures motion recognition works because the D,D,C pattern appears
                 // in the exact same buffer positions relative to the index as during recording.
-                if (kEnableFullBufferSnapshots && 
-                    s_playStreamIndex < s_slots[slotIdx].fullBufferSnapshots.size() &&
-                    !s_slots[slotIdx].fullBufferSnapshots[s_playStreamIndex].empty()) {
+                static std::vector<uint8_t> s_snapshotScratch;
+                if (kEnableFullBufferSnapshots &&
+                    s_slots[slotIdx].fullBufferSnapshots.Decode(s_playStreamIndex, s_snapshotScratch) &&
+                    !s_snapshotScratch.empty()) {
                     
-                    const auto& snapshot = s_slots[slotIdx].fullBufferSnapshots[s_playStreamIndex];
+                    const auto& snapshot = s_snapshotScratch;
                     // Get the recorded buffer index for this tick
                     uint16_t recBufIdx = 0;
                     if (s_playStreamIndex < s_slots[slotIdx].bufIndexPerTick.size()) {
@@ -954,23 +926,21 @@ void Tick() {
                 }
                 
                 // Prepare per-tick queue of recorded raw buffer bytes (for poll override backup)
-                s_tickBufQueue.clear();
-                s_tickBufHead = 0;
-                s_writesLeftThisTick = 0;
+                uint16_t writesThisTick = 0;
                 if (s_playStreamIndex < s_slots[slotIdx].bufCountsPerTick.size()) {
-                    uint16_t writesThisTick = s_slots[slotIdx].bufCountsPerTick[s_playStreamIndex];
-                    s_writesLeftThisTick = writesThisTick;
-                    for (uint16_t i = 0; i < writesThisTick && s_playBufStreamIndex < s_slots[slotIdx].bufStream.size(); ++i) {
-                        uint8_t raw = s_slots[slotIdx].bufStream[s_playBufStreamIndex++];
-                        int8_t recFacingRaw = 0;
-                        if (!s_streamFacingPerTick.empty() && s_playStreamIndex < s_streamFacingPerTick.size()) recFacingRaw = s_streamFacingPerTick[s_playStreamIndex];
-                        if (recFacingRaw == 0) recFacingRaw = +1;
-                        int curFacingRaw = ReadFacingSign(2);
-                        if (curFacingRaw != 0 && recFacingRaw != curFacingRaw) {
-                            raw = FlipMaskHoriz(raw);
-                        }
-                        s_tickBufQueue.push_back(raw);
+                    writesThisTick = s_slots[slotIdx].bufCountsPerTick[s_playStreamIndex];
+                }
+                s_replayStep.BeginTick(mask, writesThisTick);
+                for (uint16_t i = 0; i < writesThisTick && s_playBufStreamIndex < s_slots[slotIdx].bufStream.size(); ++i) {
+                    uint8_t raw = s_slots[slotIdx].bufStream[s_playBufStreamIndex++];
+                    int8_t recFacingRaw = 0;
+                    if (!s_streamFacingPerTick.empty() && s_playStreamIndex < s_streamFacingPerTick.size()) recFacingRaw = s_streamFacingPerTick[s_playStreamIndex];
+                    if (recFacingRaw == 0) recFacingRaw = +1;
+                    int curFacingRaw = ReadFacingSign(2);
+                    if (curFacingRaw != 0 && recFacingRaw != curFacingRaw) {
+                        raw = FlipMaskHoriz(raw);
                     }
+                    s_replayStep.QueueWrite(raw);
                 }
                   // Macro advance logging disabled (uncomment for debugging)
                   // {
@@ -988,26 +958,9 @@ void Tick() {
             }
             // Every frame: write some of this tick's buffer bytes via engine by overriding the poll,
             // and set per-frame poll override to the intended immediate mask for exact engine cadence.
-            const uint8_t DIR_MASK = (GAME_INPUT_UP | GAME_INPUT_DOWN | GAME_INPUT_LEFT | GAME_INPUT_RIGHT);
             const uint8_t BTN_MASK = (GAME_INPUT_A | GAME_INPUT_B | GAME_INPUT_C | GAME_INPUT_D);
-            // Baseline applies fully from the first subframe; buffer button bits for this subframe override as they appear
-            uint8_t frameMask = s_baselineMask;
-            // Determine frames remaining in this tick (including this frame): 3 at s_frameDiv==0, 2 at 1, 1 at 2
-            int framesLeft = 3 - s_frameDiv;
-            // Compute how many writes to issue this subframe to finish by end of tick (ceil division)
-            int writesToDo = 0;
-            if (s_writesLeftThisTick > 0 && framesLeft > 0) {
-                writesToDo = (s_writesLeftThisTick + framesLeft - 1) / framesLeft;
-            }
-            // Issue writesToDo from this tick's queue (clamped)
-            for (int w = 0; w < writesToDo && s_tickBufHead < s_tickBufQueue.size(); ++w) {
-                uint8_t raw = s_tickBufQueue[s_tickBufHead++];
-                // Blend buttons and rely on engine history write from our poll override
-                s_writesLeftThisTick = (s_writesLeftThisTick > 0) ? (uint16_t)(s_writesLeftThisTick - 1) : 0;
-                // Blend button bits if present in any of today writes; later writes can overwrite earlier ones' btns
-                uint8_t btnBits = (raw & BTN_MASK);
-                if (btnBits) frameMask = (uint8_t)((frameMask & DIR_MASK) | btnBits);
-            }
+            // Baseline for the whole tick; this subframe's share of the recorded writes blends in their buttons
+            uint8_t frameMask = s_replayStep.Subframe(s_frameDiv);
 
             // Logic to disable immediate input write for pre-buffer macro playback until the first attack button
             // "Disable immediate inputs(button registers) and only write to the buffer"
@@ -1044,11 +997,11 @@ void Tick() {
             }
             g_injectImmediateOnly[2].store(false);
             // End condition: after last tick and queue drained
-            if (s_playStreamIndex >= s_slots[slotIdx].macroStream.size() && s_tickBufHead >= s_tickBufQueue.size() && s_writesLeftThisTick == 0) {
+            if (s_playStreamIndex >= s_slots[slotIdx].macroStream.size() && s_replayStep.Drained()) {
                 // Defer to the next tick boundary, then inject a full neutral clear tick.
                 // IMPORTANT: Neutralize immediately so we don't keep holding the last mask for leftover subframes.
                 s_finishPendingClearTick = true;
-                s_baselineMask = 0;
+                s_replayStep.SetBaseline(0);
                 g_pollOverrideMask[2].store(0, std::memory_order_relaxed);
                 g_pollOverrideActive[2].store(true, std::memory_order_relaxed);
                 // Early clear of command flags as we enter finish sequence
@@ -1149,6 +1102,16 @@ void ToggleRecord() {
             s_slots[slotIdx].immPerTick.clear();
             s_slots[slotIdx].bufLatestPerTick.clear();
             s_slots[slotIdx].fullBufferSnapshots.clear();
+            MacroLibrary::ReleaseView(s_slots[slotIdx].libView);
+            // Make sure the first chunk of every column exists before the 64 Hz recorder starts appending
+            s_slots[slotIdx].spans.reserve(256);
+            s_slots[slotIdx].macroStream.ReserveRuns(RunColumn<uint8_t>::kChunkRuns);
+            s_slots[slotIdx].bufStream.ReserveRuns(RunColumn<uint8_t>::kChunkRuns);
+            s_slots[slotIdx].bufCountsPerTick.ReserveRuns(RunColumn<uint16_t>::kChunkRuns);
+            s_slots[slotIdx].bufIndexPerTick.ReserveRuns(RunColumn<uint16_t>::kChunkRuns);
+            s_slots[slotIdx].tickReason.ReserveRuns(RunColumn<char>::kChunkRuns);
+            s_slots[slotIdx].immPerTick.ReserveRuns(RunColumn<uint8_t>::kChunkRuns);
+            s_slots[slotIdx].bufLatestPerTick.ReserveRuns(RunColumn<uint8_t>::kChunkRuns);
             s_slots[slotIdx].bufStartIdx = 0;
             s_slots[slotIdx].bufEndIdx = 0;
             s_recLastMask = 0; s_recSpanTicks = 0; s_frameDiv = 0;
@@ -1460,95 +1423,48 @@ namespace MacroController {
 std::string SerializeSlot(int slot, bool includeBuffers) {
     slot = ClampSlot(slot);
     const Slot& s = s_slots[slot - 1];
-    // Build per-tick macro masks
-    std::vector<uint8_t> ticks;
-    std::vector<int8_t> faces; // recorded facing per tick (-1 left, +1 right, 0 unknown)
-    if (!s.macroStream.empty()) {
-        ticks = s.macroStream; // copy
-        // Try to derive per-tick facing from spans if available
-        if (!s.spans.empty()) {
-            faces.reserve(ticks.size());
-            for (const auto& sp : s.spans) {
-                for (int t = 0; t < sp.ticks && faces.size() < ticks.size(); ++t) faces.push_back(sp.facing);
-                if (faces.size() >= ticks.size()) break;
-            }
-            while (faces.size() < ticks.size()) faces.push_back(0);
-        } else {
-            faces.assign(ticks.size(), 0);
-        }
-    } else {
-        // Expand spans
-        for (const auto& sp : s.spans) {
-            for (int t = 0; t < sp.ticks; ++t) {
-                ticks.push_back(sp.mask);
-                faces.push_back(sp.facing);
-            }
-        }
-        if (faces.size() < ticks.size()) faces.resize(ticks.size(), 0);
+    const bool fromStream = !s.macroStream.empty();
+    size_t total = s.macroStream.size();
+    if (!fromStream) {
+        for (const auto& sp : s.spans) total += (size_t)std::max(sp.ticks, 0);
     }
-    std::ostringstream out;
-    out << "EFZMACRO 1";
-    if (ticks.empty()) return out.str();
-
-    // Prepare per-tick buffer slices if requested
+    std::string out;
+    out.reserve(16 + (includeBuffers ? 12 : 4) * std::min<size_t>(total, 4096));
+    MacroText::Writer writer(out, includeBuffers);
+
+    // Text is P1-facing: ticks recorded facing left (per spans) get 4/6 and diagonals flipped.
+    // Spans are walked alongside the stream instead of being expanded per tick.
+    size_t spanIdx = 0;
+    int spanLeft = s.spans.empty() ? 0 : s.spans[0].ticks;
     size_t bufPos = 0;
-    auto buildBufToken = [&](size_t tickIndex) {
-        std::ostringstream bt;
-        uint16_t k = 0;
-        if (tickIndex < s.bufCountsPerTick.size()) k = s.bufCountsPerTick[tickIndex];
-        bt << "{" << k << ":";
-        if (k > 0) bt << ' ';
-        for (uint16_t i = 0; i < k && bufPos < s.bufStream.size(); ++i) {
-            uint8_t v = s.bufStream[bufPos++];
-            // Normalize buffer value to P1-facing if we know recorded facing for this tick
-            int8_t f = (tickIndex < faces.size()) ? faces[tickIndex] : 0;
-            if (f == -1) v = FlipMaskHoriz(v);
-            // Prefer token form when it matches our mapping; fallback to hex otherwise
-            std::string valTok = MaskToToken(v);
-            // No way to disambiguate invalid combos, but MaskToToken always yields something;
-            // Emit hex when v has impossible combinations (both U&D or L&R)
-            bool u = (v & GAME_INPUT_UP) != 0, d = (v & GAME_INPUT_DOWN) != 0, l = (v & GAME_INPUT_LEFT) != 0, r = (v & GAME_INPUT_RIGHT) != 0;
-            if ((u && d) || (l && r)) {
-                bt << "0x" << ToHexString((int)v, 2);
-            } else {
-                bt << valTok;
-            }
-            if (i + 1 < k) bt << ' ';
+    std::vector<uint8_t> tickWrites;
+    for (size_t t = 0; t < total; ++t) {
+        while (spanIdx < s.spans.size() && spanLeft <= 0) {
+            ++spanIdx;
+            spanLeft = (spanIdx < s.spans.size()) ? s.spans[spanIdx].ticks : 0;
         }
-        bt << "}";
-        return bt.str();
-    };
-
-    // Build tokens with optional RLE compression
-    std::vector<std::string> perTick;
-    perTick.reserve(ticks.size());
-    for (size_t i = 0; i < ticks.size(); ++i) {
-        uint8_t m = ticks[i];
-        // Normalize to P1-facing in text: if recorded facing was left, flip 4/6 (and diagonals)
-        int8_t f = (i < faces.size()) ? faces[i] : 0;
-        if (f == -1) m = FlipMaskHoriz(m);
-        std::string tok = MaskToToken(m);
+        int8_t facing = 0;
+        uint8_t m = 0;
+        if (spanIdx < s.spans.size()) {
+            facing = s.spans[spanIdx].facing;
+            m = s.spans[spanIdx].mask;
+            --spanLeft;
+        }
+        if (fromStream) m = s.macroStream[t];
+        const bool flip = (facing == -1);
+        if (flip) m = FlipMaskHoriz(m);
+        tickWrites.clear();
         if (includeBuffers) {
-            tok += ' ';
-            tok += buildBufToken(i);
+            const uint16_t k = (t < s.bufCountsPerTick.size()) ? s.bufCountsPerTick[t] : 0;
+            for (uint16_t i = 0; i < k && bufPos < s.bufStream.size(); ++i) {
+                uint8_t v = s.bufStream[bufPos++];
+                tickWrites.push_back(flip ? FlipMaskHoriz(v) : v);
+            }
         }
-        perTick.push_back(std::move(tok));
-    }
-    // RLE compress only identical full tokens
-    std::ostringstream seq;
-    seq << ' ';
-    size_t i = 0;
-    while (i < perTick.size()) {
-        size_t j = i + 1;
-        while (j < perTick.size() && perTick[j] == perTick[i]) ++j;
-        size_t run = j - i;
-        seq << perTick[i];
-        if (run > 1) seq << 'x' << run;
-        if (j < perTick.size()) seq << ' ';
-        i = j;
+        writer.Tick(m, tickWrites.data(), (uint16_t)tickWrites.size());
     }
-    out << seq.str();
-    return out.str();
+    writer.Finish();
+    return out;
 }
 
 static void ClearSlotForImport(Slot& s) {
@@ -1564,6 +1480,7 @@ static void ClearSlotForImport(Slot& s) {
     s.bufStartIdx = 0;
     s.bufEndIdx = 0;
     s.hasData = false;
+    MacroLibrary::ReleaseView(s.libView);
 }
 
 static void BuildSpansFromStream(Slot& s) {
@@ -1605,7 +1522,6 @@ static void BuildSyntheticSnapshotsFromBuf(Slot& s) {
     size_t bufPos = 0;
 
     s.fullBufferSnapshots.reserve(s.macroStream.size());
-    s.bufIndexPerTick.reserve(s.macroStream.size());
 
     for (size_t t = 0; t < s.macroStream.size(); ++t) {
         const uint16_t k = s.bufCountsPerTick[t];
@@ -1618,198 +1534,41 @@ static void BuildSyntheticSnapshotsFromBuf(Slot& s) {
     }
 }
 
+// Receives parsed ticks: counts them (validation pass, no slot) or appends them to a slot's columns
+class SlotTickSink : public MacroText::TickSink {
+public:
+    explicit SlotTickSink(Slot* dst) : m_dst(dst) {}
+    void OnTicks(uint8_t mask, const uint8_t* writes, uint16_t writeCount, uint32_t repeat) override {
+        ticks += repeat;
+        if (!m_dst) return;
+        for (uint32_t r = 0; r < repeat; ++r) {
+            m_dst->macroStream.push_back(mask);
+            m_dst->bufCountsPerTick.push_back(writeCount);
+            for (uint16_t i = 0; i < writeCount; ++i) m_dst->bufStream.push_back(writes[i]);
+        }
+    }
+    size_t ticks = 0;
+private:
+    Slot* m_dst;
+};
+
 bool DeserializeSlot(int slot, const std::string& text, std::string& errorOut) {
     errorOut.clear();
     slot = ClampSlot(slot);
     Slot& dst = s_slots[slot - 1];
 
-    // Tokenize with brace-aware scanning
-    std::vector<std::string> tokens;
-    tokens.reserve(256);
-    size_t n = text.size();
-    size_t p = 0;
-    auto skipSpace = [&](size_t& i){ while (i < n && std::isspace((unsigned char)text[i])) ++i; };
-    skipSpace(p);
-    // Optional header "EFZMACRO 1"
-    if (p < n) {
-        size_t hdrEnd = p;
-        // Read first two non-space tokens to check header
-        std::string t1, t2;
-        while (hdrEnd < n && !std::isspace((unsigned char)text[hdrEnd])) ++hdrEnd;
-        t1 = text.substr(p, hdrEnd - p);
-        p = hdrEnd; skipSpace(p);
-        hdrEnd = p; while (hdrEnd < n && !std::isspace((unsigned char)text[hdrEnd])) ++hdrEnd;
-        t2 = text.substr(p, hdrEnd - p);
-        if (!t1.empty() && !t2.empty() && (_stricmp(t1.c_str(), "EFZMACRO") == 0)) {
-            // Verify version
-            if (t2 != "1") { errorOut = "Unsupported macro version: " + t2; return false; }
-            p = hdrEnd; // move beyond version
-        } else {
-            // No header; reset to start to parse normally
-            p = 0;
-        }
-    }
-    skipSpace(p);
-    while (p < n) {
-        if (std::isspace((unsigned char)text[p])) { ++p; continue; }
-        size_t start = p;
-        if (text[p] == '{') {
-            // Should not start with group; groups attach to preceding tick token
-            errorOut = "Unexpected '{' without preceding tick token";
-            return false;
-        }
-        // Read until whitespace OR brace start (we'll include following group as part of this token pack)
-        while (p < n && !std::isspace((unsigned char)text[p])) {
-            if (text[p] == '{') break;
-            ++p;
-        }
-        size_t baseEnd = p;
-        // Allow optional whitespace between base token and its attached brace group
-        // Example: "5 {3: ...}" should be treated as a single pack just like "5{3: ...}"
-        if (p < n && std::isspace((unsigned char)text[p])) {
-            size_t q = p;
-            // Peek past spaces to see if a brace group follows
-            while (q < n && std::isspace((unsigned char)text[q])) ++q;
-            if (q < n && text[q] == '{') {
-                p = q; // Attach the upcoming brace group to this pack
-            }
-        }
-        // Capture any attached brace group including spaces inside until matching '}'
-        int brace = 0;
-        if (p < n && text[p] == '{') {
-            brace = 1; ++p;
-            while (p < n && brace > 0) {
-                if (text[p] == '{') ++brace;
-                else if (text[p] == '}') --brace;
-                ++p;
-            }
-            if (brace != 0) { errorOut = "Unterminated buffer group"; return false; }
-        }
-        // Attach an immediate or space-separated repeat suffix xN/XN to this pack
-        // Example forms to accept: "5C}x12", "5C} x12", and even "5C x12" (no group)
-        if (p < n) {
-            size_t qx = p;
-            // Skip any spaces between token and suffix
-            while (qx < n && std::isspace((unsigned char)text[qx])) ++qx;
-            if (qx < n && (text[qx] == 'x' || text[qx] == 'X')) {
-                size_t r = qx + 1;
-                size_t rStart = r;
-                while (r < n && std::isdigit((unsigned char)text[r])) ++r;
-                if (r > rStart) {
-                    p = r; // consume suffix into this token pack
-                }
-            }
-        }
-        size_t end = p;
-        tokens.push_back(text.substr(start, end - start));
-        skipSpace(p);
-    }
-
-    if (tokens.empty()) {
-        // Allow clearing slot
-        ClearSlotForImport(dst);
-        return true;
-    }
-
-    // Parse sequence
-    std::vector<uint8_t> macro;
-    std::vector<uint16_t> counts;
-    std::vector<uint8_t> buf;
-
-    auto parseUInt = [](const std::string& s, size_t i, uint32_t& out)->size_t{
-        out = 0; size_t start = i; while (i < s.size() && std::isdigit((unsigned char)s[i])) { out = out*10 + (s[i]-'0'); ++i; }
-        return (i > start) ? i : start;
-    };
-
-    for (size_t iTok = 0; iTok < tokens.size(); ++iTok) {
-        const std::string& packFull = tokens[iTok];
-        // Handle trailing repeat suffix xN or XN at end of pack (applies to both base-only and base+group forms)
-        uint32_t repeat = 1;
-        std::string pack = packFull;
-        if (!pack.empty()) {
-            size_t end = pack.size();
-            size_t j = end;
-            // Move j back over trailing digits
-            while (j > 0 && std::isdigit((unsigned char)pack[j - 1])) --j;
-            if (j > 0 && j < end && (pack[j - 1] == 'x' || pack[j - 1] == 'X')) {
-                // Parse repeat
-                uint32_t val = 0; size_t k = j; k = parseUInt(pack, k, val);
-                if (k == j || val == 0) { errorOut = "Invalid repeat suffix in '" + pack + "'"; return false; }
-                repeat = val;
-                // Remove the suffix from the working pack
-                pack = pack.substr(0, j - 1);
-                // Trim trailing spaces
-                while (!pack.empty() && std::isspace((unsigned char)pack.back())) pack.pop_back();
-            }
-        }
-        // Split into base and optional group on the adjusted pack (without trailing xN)
-        size_t bracePos = pack.find('{');
-        std::string base = (bracePos == std::string::npos) ? pack : pack.substr(0, bracePos);
-        std::string group = (bracePos == std::string::npos) ? std::string() : pack.substr(bracePos);
-        // Trim trailing spaces from base
-        while (!base.empty() && std::isspace((unsigned char)base.back())) base.pop_back();
-        std::string baseTok = base;
-    // Parse base token mask
-        uint8_t baseMask = 0;
-        if (!TryTokenToMask(baseTok, baseMask)) { errorOut = "Bad tick token: '" + baseTok + "'"; return false; }
-
-        // Optional group parsing {k: v1 v2 ...}
-        std::vector<uint8_t> thisTickBuf;
-        uint16_t thisTickK = 0;
-        if (!group.empty()) {
-            // Strip braces
-            if (group.front() != '{') { errorOut = "Malformed buffer group in '" + packFull + "'"; return false; }
-            if (group.back() != '}') { errorOut = "Malformed buffer group in '" + packFull + "'"; return false; }
-            std::string inner = group.substr(1, group.size()-2);
-            // Parse k:
-            size_t q = 0; while (q < inner.size() && std::isspace((unsigned char)inner[q])) ++q;
-            uint32_t kVal = 0; size_t q2 = parseUInt(inner, q, kVal);
-            if (q2 == q) { errorOut = "Buffer group missing count in '" + pack + "'"; return false; }
-            while (q2 < inner.size() && std::isspace((unsigned char)inner[q2])) ++q2;
-            if (q2 >= inner.size() || inner[q2] != ':') { errorOut = "Buffer group missing ':' in '" + pack + "'"; return false; }
-            q = q2 + 1;
-            // Parse values
-            while (q < inner.size()) {
-                while (q < inner.size() && std::isspace((unsigned char)inner[q])) ++q;
-                if (q >= inner.size()) break;
-                // Read next token until space
-                size_t start = q; while (q < inner.size() && !std::isspace((unsigned char)inner[q])) ++q;
-                std::string vtok = inner.substr(start, q - start);
-                if (vtok.empty()) break;
-                uint8_t vmask = 0;
-                if (vtok.size() >= 3 && (vtok[0] == '0') && (vtok[1] == 'x' || vtok[1] == 'X')) {
-                    // Hex
-                    uint32_t vv = 0;
-                    std::stringstream ss; ss << std::hex << vtok; ss >> vv;
-                    vmask = (uint8_t)(vv & 0xFF);
-                } else {
-                    if (!TryTokenToMask(vtok, vmask)) { errorOut = "Bad buffer value token: '" + vtok + "'"; return false; }
-                }
-                thisTickBuf.push_back(vmask);
-            }
-            thisTickK = (uint16_t)kVal;
-            if (thisTickK != thisTickBuf.size()) {
-                errorOut = "Buffer group count mismatch (k!=values) in '" + pack + "'";
-                return false;
-            }
-        } else {
-            // Default: one write equal to tick mask
-            thisTickK = 1; thisTickBuf.push_back(baseMask);
-        }
-
-        // Emit repeat
-        for (uint32_t r = 0; r < repeat; ++r) {
-            macro.push_back(baseMask);
-            counts.push_back(thisTickK);
-            buf.insert(buf.end(), thisTickBuf.begin(), thisTickBuf.end());
-        }
+    // Validate first so a bad macro leaves the slot unchanged, then parse straight into the columns
+    MacroText::ParseError err;
+    SlotTickSink check(nullptr);
+    if (!MacroText::Parse(text, check, err)) {
+        errorOut = err.message + " (at offset " + std::to_string(err.offset) + ")";
+        return false;
     }
-
-    // Commit to slot
     ClearSlotForImport(dst);
-    dst.macroStream = std::move(macro);
-    dst.bufCountsPerTick = std::move(counts);
-    dst.bufStream = std::move(buf);
+    if (check.ticks == 0) return true; // allow clearing slot
+
+    SlotTickSink sink(&dst);
+    MacroText::Parse(text, sink, err);
     dst.hasData = !dst.macroStream.empty();
     BuildSpansFromStream(dst);
     // For imported macros, synthesize buffer snapshots/indices so
@@ -1820,4 +1579,52 @@ bool DeserializeSlot(int slot, const std::string& text, std::string& errorOut) {
     return true;
 }
 
-} // namespace MacroController
\ No newline at end of file
+bool BindLibraryEntry(int slot, size_t entryIndex) {
+    if (s_state.load() != State::Idle) return false;
+    MacroLibrary::EntryView v;
+    if (!MacroLibrary::GetView(entryIndex, v) || v.ticks == 0) return false;
+    slot = ClampSlot(slot);
+    Slot& dst = s_slots[slot - 1];
+    ClearSlotForImport(dst);
+    // Library streams are P1-facing; spans carry no facing, so playback treats every tick as recorded facing right
+    dst.macroStream.BindView(v.macro, v.ticks);
+    dst.bufCountsPerTick.BindView(v.counts, v.ticks);
+    dst.bufStream.BindView(v.buf, v.bufLength);
+    dst.libView = v;
+    BuildSpansFromStream(dst);
+    dst.hasData = true;
+    LogOut("[MACRO][LIB] slot=" + std::to_string(slot) + " bound entry " + std::to_string((int)entryIndex) +
+           " ticks=" + std::to_string(v.ticks) + " bufBytes=" + std::to_string(v.bufLength), detailedLogging.load());
+    return true;
+}
+
+int SaveSlotToLibrary(int slot, const std::string& name, const std::string& situation, int charId) {
+    slot = ClampSlot(slot);
+    const Slot& s = s_slots[slot - 1];
+    if (!s.hasData || s.macroStream.empty()) return -1;
+    std::vector<uint8_t> macro = s.macroStream.ToVector();
+    std::vector<uint16_t> counts;
+    std::vector<uint8_t> buf;
+    if (s.bufCountsPerTick.size() == macro.size()) {
+        counts = s.bufCountsPerTick.ToVector();
+        buf = s.bufStream.ToVector();
+    } else {
+        // Stream-only slot: one buffer write equal to the tick mask (same default as the text format)
+        counts.assign(macro.size(), 1);
+        buf = macro;
+    }
+    // Normalize to P1-facing like SerializeSlot, using the recorded facing from spans
+    size_t t = 0, bufPos = 0;
+    for (const auto& sp : s.spans) {
+        for (int k = 0; k < sp.ticks && t < macro.size(); ++k, ++t) {
+            const bool flip = (sp.facing == -1);
+            if (flip) macro[t] = FlipMaskHoriz(macro[t]);
+            for (uint16_t w = 0; w < counts[t] && bufPos < buf.size(); ++w, ++bufPos) {
+                if (flip) buf[bufPos] = FlipMaskHoriz(buf[bufPos]);
+            }
+        }
+    }
+    return MacroLibrary::Append(name, situation, charId, macro, counts, buf);
+}
+
+} // namespace MacroController
@@ -0,0 +1,334 @@
+#include "../include/game/macro_library.h"
+#include "../include/utils/config.h"
+#include "../include/utils/utilities.h"
+#include "../include/core/logger.h"
+#include <windows.h>
+#include <cstring>
+#include <mutex>
+
+namespace {
+    struct Mapping {
+        HANDLE handle = NULL;
+        const uint8_t* view = nullptr;
+        uint64_t size = 0;
+        uint32_t id = 0;
+        int pins = 0;          // EntryViews handed out by GetView and not yet released
+    };
+
+    std::mutex s_mutex;
+    bool s_open = false;
+    // Library present but unreadable (bad magic/version/ranges): stays empty and Append refuses to touch it
+    bool s_corrupt = false;
+    std::string s_path;
+    // back() is the current view; older views stay mapped only while pinned by slots bound to them
+    std::vector<Mapping> s_maps;
+    uint32_t s_nextMappingId = 1;
+    const MacroLibEntry* s_index = nullptr;
+    uint32_t s_count = 0;
+
+    std::string DefaultLibraryPath() {
+        std::string cfg = Config::GetConfigFilePath();
+        size_t slash = cfg.find_last_of("\\/");
+        if (slash == std::string::npos) return "efz_macros.efzlib";
+        return cfg.substr(0, slash + 1) + "efz_macros.efzlib";
+    }
+
+    bool InRange(uint64_t off, uint64_t len, uint64_t size) {
+        return off <= size && len <= size - off;
+    }
+
+    bool ValidateView(const uint8_t* view, uint64_t size, std::string& why) {
+        if (size < sizeof(MacroLibFileHeader)) { why = "truncated header"; return false; }
+        const MacroLibFileHeader* h = reinterpret_cast<const MacroLibFileHeader*>(view);
+        if (h->magic != MACROLIB_MAGIC) { why = "bad magic"; return false; }
+        if (h->version != MACROLIB_VERSION) { why = "unsupported version " + std::to_string(h->version); return false; }
+        if (h->headerSize != sizeof(MacroLibFileHeader) || h->entrySize != sizeof(MacroLibEntry)) { why = "layout mismatch"; return false; }
+        if ((h->indexOffset & 3) || !InRange(h->indexOffset, (uint64_t)h->entryCount * sizeof(MacroLibEntry), size)) {
+            why = "index out of range"; return false;
+        }
+        const MacroLibEntry* e = reinterpret_cast<const MacroLibEntry*>(view + h->indexOffset);
+        for (uint32_t i = 0; i < h->entryCount; ++i) {
+            if (!InRange(e[i].nameOffset, e[i].nameLength, size) ||
+                !InRange(e[i].situationOffset, e[i].situationLength, size) ||
+                !InRange(e[i].macroOffset, e[i].ticks, size) ||
+                (e[i].countsOffset & 1) || !InRange(e[i].countsOffset, (uint64_t)e[i].ticks * 2, size) ||
+                !InRange(e[i].bufOffset, e[i].bufLength, size)) {
+                why = "entry " + std::to_string(i) + " out of range";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void UnmapLocked(Mapping& m) {
+        if (m.view) UnmapViewOfFile(m.view);
+        if (m.handle) CloseHandle(m.handle);
+        m.view = nullptr;
+        m.handle = NULL;
+    }
+
+    // Unmap every non-current mapping nothing pins any more
+    void DropRetiredLocked() {
+        if (s_maps.empty()) return;
+        const size_t current = s_maps.size() - 1;
+        size_t keep = 0;
+        for (size_t i = 0; i < s_maps.size(); ++i) {
+            if (i != current && s_maps[i].pins <= 0) { UnmapLocked(s_maps[i]); continue; }
+            s_maps[keep++] = s_maps[i];
+        }
+        s_maps.resize(keep);
+    }
+
+    void CloseAllLocked() {
+        for (Mapping& m : s_maps) UnmapLocked(m);
+        s_maps.clear();
+        s_index = nullptr;
+        s_count = 0;
+        s_corrupt = false;
+    }
+
+    // Map the file at s_path as the new current view. Missing/empty file = empty library.
+    bool MapCurrentLocked() {
+        s_index = nullptr;
+        s_count = 0;
+        s_corrupt = false;
+        HANDLE file = CreateFileA(s_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) {
+            DWORD err = GetLastError();
+            if (err == ERROR_FILE_NOT_FOUND || err == ERROR_PATH_NOT_FOUND) return true;
+            LogOut("[MACRO_LIB] Failed to open " + s_path + " (error " + std::to_string(err) + ")", true);
+            return false;
+        }
+        LARGE_INTEGER sz{};
+        if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0) {
+            CloseHandle(file);
+            return true;
+        }
+        Mapping m;
+        m.size = (uint64_t)sz.QuadPart;
+        m.handle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m.handle) m.view = (const uint8_t*)MapViewOfFile(m.handle, FILE_MAP_READ, 0, 0, 0);
+        DWORD mapErr = GetLastError();
+        CloseHandle(file); // the mapping keeps the file referenced
+        if (!m.view) {
+            if (m.handle) CloseHandle(m.handle);
+            LogOut("[MACRO_LIB] Failed to map " + s_path + " (error " + std::to_string(mapErr) + ")", true);
+            return false;
+        }
+        std::string why;
+        if (!ValidateView(m.view, m.size, why)) {
+            UnmapViewOfFile(m.view);
+            CloseHandle(m.handle);
+            s_corrupt = true;
+            LogOut("[MACRO_LIB] Ignoring " + s_path + ": " + why, true);
+            return false;
+        }
+        m.id = s_nextMappingId++;
+        s_maps.push_back(m);
+        DropRetiredLocked();
+        const MacroLibFileHeader* h = reinterpret_cast<const MacroLibFileHeader*>(m.view);
+        s_index = reinterpret_cast<const MacroLibEntry*>(m.view + h->indexOffset);
+        s_count = h->entryCount;
+        return true;
+    }
+
+    const MacroLibEntry* EntryLocked(size_t index) {
+        return (s_index && index < s_count) ? &s_index[index] : nullptr;
+    }
+
+    const uint8_t* CurrentViewLocked() {
+        return s_maps.empty() ? nullptr : s_maps.back().view;
+    }
+
+    void PadTo4(std::vector<uint8_t>& out, uint64_t base) {
+        while ((base + out.size()) & 3) out.push_back(0);
+    }
+
+    bool WriteAt(HANDLE file, uint64_t offset, const void* data, size_t len) {
+        LARGE_INTEGER pos; pos.QuadPart = (LONGLONG)offset;
+        if (!SetFilePointerEx(file, pos, NULL, FILE_BEGIN)) return false;
+        DWORD written = 0;
+        return WriteFile(file, data, (DWORD)len, &written, NULL) && written == (DWORD)len;
+    }
+}
+
+namespace MacroLibrary {
+
+bool Open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    CloseAllLocked();
+    s_path = path.empty() ? DefaultLibraryPath() : path;
+    s_open = true;
+    bool ok = MapCurrentLocked();
+    if (ok) {
+        LogOut("[MACRO_LIB] " + s_path + ": " + std::to_string(s_count) + " macro(s)", detailedLogging.load());
+    }
+    return ok;
+}
+
+void Close() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    CloseAllLocked();
+    s_open = false;
+}
+
+bool IsOpen() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_open;
+}
+
+std::string CurrentPath() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_path;
+}
+
+size_t Count() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_count;
+}
+
+bool GetInfo(size_t index, EntryInfo& out) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    const MacroLibEntry* e = EntryLocked(index);
+    if (!e) return false;
+    const char* base = reinterpret_cast<const char*>(CurrentViewLocked());
+    out.name.assign(base + e->nameOffset, e->nameLength);
+    out.situation.assign(base + e->situationOffset, e->situationLength);
+    out.charId = e->charId;
+    out.ticks = e->ticks;
+    out.bufLength = e->bufLength;
+    return true;
+}
+
+bool GetView(size_t index, EntryView& out) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    const MacroLibEntry* e = EntryLocked(index);
+    if (!e) return false;
+    const uint8_t* base = CurrentViewLocked();
+    out.macro = base + e->macroOffset;
+    out.counts = reinterpret_cast<const uint16_t*>(base + e->countsOffset);
+    out.buf = base + e->bufOffset;
+    out.ticks = e->ticks;
+    out.bufLength = e->bufLength;
+    Mapping& current = s_maps.back();
+    ++current.pins;
+    out.mapping = current.id;
+    return true;
+}
+
+void ReleaseView(EntryView& view) {
+    if (view.mapping) {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (Mapping& m : s_maps) {
+            if (m.id != view.mapping) continue;
+            --m.pins;
+            break;
+        }
+        DropRetiredLocked();
+    }
+    view = EntryView{};
+}
+
+int Find(const std::string& name, int charId) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    const char* base = reinterpret_cast<const char*>(CurrentViewLocked());
+    for (uint32_t i = 0; i < s_count; ++i) {
+        const MacroLibEntry& e = s_index[i];
+        if (e.nameLength != name.size() || memcmp(base + e.nameOffset, name.data(), name.size()) != 0) continue;
+        if (charId < 0 || e.charId < 0 || e.charId == charId) return (int)i;
+    }
+    return -1;
+}
+
+int Append(const std::string& name, const std::string& situation, int charId,
+           const std::vector<uint8_t>& macro, const std::vector<uint16_t>& counts,
+           const std::vector<uint8_t>& buf) {
+    if (name.empty() || name.size() > 0xFFFF || situation.size() > 0xFFFF) return -1;
+    if (macro.empty() || counts.size() != macro.size()) return -1;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (!s_open) return -1;
+    if (s_corrupt) {
+        LogOut("[MACRO_LIB] Refusing to append to unreadable library " + s_path, true);
+        return -1;
+    }
+
+    HANDLE file = CreateFileA(s_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                              OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        LogOut("[MACRO_LIB] Failed to open " + s_path + " for writing (error " + std::to_string(GetLastError()) + ")", true);
+        return -1;
+    }
+
+    MacroLibFileHeader hdr{};
+    hdr.magic = MACROLIB_MAGIC;
+    hdr.version = MACROLIB_VERSION;
+    hdr.headerSize = sizeof(MacroLibFileHeader);
+    hdr.entrySize = sizeof(MacroLibEntry);
+
+    LARGE_INTEGER sz{};
+    GetFileSizeEx(file, &sz);
+    uint64_t end = (uint64_t)sz.QuadPart;
+    bool ok = true;
+    if (end < sizeof(MacroLibFileHeader)) {
+        // New library: header first so the file is valid (and empty) from here on
+        hdr.indexOffset = sizeof(MacroLibFileHeader);
+        ok = WriteAt(file, 0, &hdr, sizeof(hdr));
+        end = sizeof(MacroLibFileHeader);
+    }
+
+    // Entry blob followed by the complete new index, written past the current end
+    std::vector<uint8_t> out;
+    out.reserve(name.size() + situation.size() + macro.size() + counts.size() * 2 + buf.size() +
+                (s_count + 1) * sizeof(MacroLibEntry) + 16);
+    PadTo4(out, end);
+    MacroLibEntry e{};
+    e.nameOffset = (uint32_t)(end + out.size());
+    e.nameLength = (uint16_t)name.size();
+    out.insert(out.end(), name.begin(), name.end());
+    e.situationOffset = (uint32_t)(end + out.size());
+    e.situationLength = (uint16_t)situation.size();
+    out.insert(out.end(), situation.begin(), situation.end());
+    PadTo4(out, end);
+    e.charId = (int16_t)charId;
+    e.ticks = (uint32_t)macro.size();
+    e.macroOffset = (uint32_t)(end + out.size());
+    out.insert(out.end(), macro.begin(), macro.end());
+    PadTo4(out, end);
+    e.countsOffset = (uint32_t)(end + out.size());
+    const uint8_t* countBytes = reinterpret_cast<const uint8_t*>(counts.data());
+    out.insert(out.end(), countBytes, countBytes + counts.size() * sizeof(uint16_t));
+    e.bufOffset = (uint32_t)(end + out.size());
+    e.bufLength = (uint32_t)buf.size();
+    out.insert(out.end(), buf.begin(), buf.end());
+    PadTo4(out, end);
+
+    hdr.indexOffset = (uint32_t)(end + out.size());
+    hdr.entryCount = s_count + 1;
+    if (s_count) {
+        const uint8_t* idx = reinterpret_cast<const uint8_t*>(s_index);
+        out.insert(out.end(), idx, idx + (size_t)s_count * sizeof(MacroLibEntry));
+    }
+    const uint8_t* eb = reinterpret_cast<const uint8_t*>(&e);
+    out.insert(out.end(), eb, eb + sizeof(e));
+
+    if (end + out.size() > 0xFFFFFFFFull) {
+        LogOut("[MACRO_LIB] Library would exceed 4 GB; not appending", true);
+        ok = false;
+    }
+    // Data and index must be durable before the header points at them
+    ok = ok && WriteAt(file, end, out.data(), out.size()) && FlushFileBuffers(file);
+    ok = ok && WriteAt(file, 0, &hdr, sizeof(hdr)) && FlushFileBuffers(file);
+    CloseHandle(file);
+    if (!ok) {
+        LogOut("[MACRO_LIB] Failed to append '" + name + "' to " + s_path, true);
+        return -1;
+    }
+
+    if (!MapCurrentLocked()) return -1;
+    LogOut("[MACRO_LIB] Added '" + name + "' (" + std::to_string(e.ticks) + " ticks) to " + s_path, true);
+    return (int)(s_count - 1);
+}
+
+} // namespace MacroLibrary
@@ -0,0 +1,121 @@
+#include "../include/game/macro_replay.h"
+#include "../include/input/input_buffer_model.h"
+
+namespace MacroReplay {
+
+namespace {
+    constexpr uint8_t kDirMask = 0x0F;   // GAME_INPUT_UP | DOWN | LEFT | RIGHT
+    constexpr uint8_t kBtnMask = 0xF0;   // GAME_INPUT_A | B | C | D
+}
+
+void TickStepper::Reset() {
+    m_queue.clear();
+    m_head = 0;
+    m_writesLeft = 0;
+    m_baseline = 0;
+}
+
+void TickStepper::BeginTick(uint8_t baselineMask, uint16_t writeCount) {
+    m_baseline = baselineMask;
+    m_queue.clear();
+    m_head = 0;
+    m_writesLeft = writeCount;
+}
+
+void TickStepper::QueueWrite(uint8_t raw) {
+    m_queue.push_back(raw);
+}
+
+uint8_t TickStepper::Subframe(int frameDiv, int* writesIssued) {
+    // Baseline applies fully from the first subframe; buffer button bits for this subframe override as they appear
+    uint8_t frameMask = m_baseline;
+    // Frames remaining in this tick (including this frame): 3 at frameDiv 0, 2 at 1, 1 at 2
+    int framesLeft = kSubframesPerTick - frameDiv;
+    int writesToDo = 0;
+    if (m_writesLeft > 0 && framesLeft > 0) {
+        writesToDo = (m_writesLeft + framesLeft - 1) / framesLeft;
+    }
+    int issued = 0;
+    for (int w = 0; w < writesToDo && m_head < m_queue.size(); ++w) {
+        uint8_t raw = m_queue[m_head++];
+        m_writesLeft = (m_writesLeft > 0) ? static_cast<uint16_t>(m_writesLeft - 1) : 0;
+        // Later writes in the same subframe overwrite earlier ones' buttons
+        uint8_t btnBits = static_cast<uint8_t>(raw & kBtnMask);
+        if (btnBits) frameMask = static_cast<uint8_t>((frameMask & kDirMask) | btnBits);
+        ++issued;
+    }
+    if (writesIssued) *writesIssued = issued;
+    return frameMask;
+}
+
+FidelityReport VerifyStream(const uint8_t* macro, const uint16_t* counts, uint32_t ticks,
+                            const uint8_t* buf, uint32_t bufLength, int advancePhase) {
+    FidelityReport r;
+    r.ticks = ticks;
+    r.expectedEntries = bufLength;
+    if (advancePhase < 0 || advancePhase >= kSubframesPerTick) advancePhase = 0;
+
+    TickStepper stepper;
+    InputBufferModel::Ring ring;
+    std::vector<uint8_t> captured;
+    captured.reserve(kSubframesPerTick);
+    uint32_t bufPos = 0;
+    uint16_t windowStart = ring.Index();
+
+    auto compare = [&](uint8_t produced) {
+        uint32_t at = r.producedEntries++;
+        if (at >= bufLength) return;
+        uint8_t expected = buf[at];
+        if (produced == expected) return;
+        ++r.mismatches;
+        if ((produced ^ expected) & kDirMask) ++r.directionMismatches;
+        if ((produced ^ expected) & kBtnMask) ++r.buttonMismatches;
+        if (r.firstMismatch < 0) {
+            r.firstMismatch = at;
+            r.firstExpected = expected;
+            r.firstProduced = produced;
+        }
+    };
+
+    // The recorder captures ring[windowStart .. index) once per 64 Hz window
+    auto captureWindow = [&]() {
+        captured.clear();
+        ring.CollectSince(windowStart, captured);
+        for (uint8_t v : captured) compare(v);
+        windowStart = ring.Index();
+    };
+
+    // One continuous subframe timeline: tick t occupies subframes [advancePhase + 3t, advancePhase + 3t + 3)
+    // and steps them as its own frameDiv 0..2, while capture windows stay on multiples of 3. A late
+    // tick therefore straddles two capture windows instead of squeezing its writes into one subframe.
+    const uint64_t totalSubframes = (uint64_t)advancePhase + (uint64_t)ticks * kSubframesPerTick;
+    uint32_t t = 0;
+    for (uint64_t g = 0; g < totalSubframes; ++g) {
+        if (g >= (uint64_t)advancePhase) {
+            const int k = (int)((g - advancePhase) % kSubframesPerTick);
+            if (k == 0) {
+                uint16_t writes = counts ? counts[t] : 0;
+                stepper.BeginTick(macro[t], writes);
+                for (uint16_t i = 0; i < writes && bufPos < bufLength; ++i) stepper.QueueWrite(buf[bufPos++]);
+            }
+            int issued = 0;
+            uint8_t poll = stepper.Subframe(k, &issued);
+            if (issued > 0) ring.Push(poll);
+            if (k == kSubframesPerTick - 1) ++t;
+        }
+        if (g % kSubframesPerTick == kSubframesPerTick - 1) captureWindow();
+    }
+    captureWindow();
+    if (r.producedEntries < bufLength) {
+        // Missing tail counts as mismatched entries
+        if (r.firstMismatch < 0) {
+            r.firstMismatch = r.producedEntries;
+            r.firstExpected = buf[r.producedEntries];
+            r.firstProduced = 0;
+        }
+        r.mismatches += bufLength - r.producedEntries;
+    }
+    return r;
+}
+
+} // namespace MacroReplay
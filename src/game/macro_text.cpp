@@ -0,0 +1,278 @@
+#include "../include/game/macro_text.h"
+#include <cstring>
+
+namespace {
+    using namespace MacroText;
+
+    constexpr uint8_t kDirMask = kUp | kDown | kLeft | kRight;
+
+    inline bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+    inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+    inline char Upper(char c) { return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c; }
+
+    int HexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        c = Upper(c);
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool EqualsNoCase(std::string_view a, const char* b) {
+        size_t n = strlen(b);
+        if (a.size() != n) return false;
+        for (size_t i = 0; i < n; ++i) if (Upper(a[i]) != Upper(b[i])) return false;
+        return true;
+    }
+
+    uint8_t NumpadToDir(char c) {
+        switch (c) {
+            case '1': return kDown | kLeft;
+            case '2': return kDown;
+            case '3': return kDown | kRight;
+            case '4': return kLeft;
+            case '5': return 0;
+            case '6': return kRight;
+            case '7': return kUp | kLeft;
+            case '8': return kUp;
+            case '9': return kUp | kRight;
+            case 'N': return 0; // alias
+            default:  return 0xFF; // invalid sentinel
+        }
+    }
+
+    char DirToNumpad(uint8_t m) {
+        const bool u = (m & kUp) != 0, d = (m & kDown) != 0, l = (m & kLeft) != 0, r = (m & kRight) != 0;
+        // Resolve invalid combos by neutral (5)
+        if ((u && d) || (l && r)) return '5';
+        if (u && r) return '9';
+        if (u && l) return '7';
+        if (d && r) return '3';
+        if (d && l) return '1';
+        if (u) return '8';
+        if (d) return '2';
+        if (r) return '6';
+        if (l) return '4';
+        return '5';
+    }
+
+    // Decimal digits at text[p..]; advances p. Fails on no digits or a value above `limit`.
+    bool ReadUInt(std::string_view text, size_t& p, uint32_t limit, uint32_t& out) {
+        const size_t start = p;
+        uint64_t v = 0;
+        while (p < text.size() && IsDigit(text[p])) {
+            v = v * 10 + (uint64_t)(text[p] - '0');
+            if (v > limit) return false;
+            ++p;
+        }
+        out = (uint32_t)v;
+        return p > start;
+    }
+
+    bool Fail(ParseError& err, size_t offset, std::string message) {
+        err.offset = offset;
+        err.message = std::move(message);
+        return false;
+    }
+
+    void AppendUInt(std::string& out, uint32_t v) {
+        char tmp[10];
+        int n = 0;
+        do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+        while (n) out.push_back(tmp[--n]);
+    }
+}
+
+namespace MacroText {
+
+bool TokenToMask(std::string_view tok, uint8_t& outMask) {
+    if (tok.empty()) return false;
+    // Accept 'N' or 'n' as neutral
+    if (tok.size() == 1 && Upper(tok[0]) == 'N') { outMask = 0; return true; }
+    const uint8_t dir = NumpadToDir(Upper(tok[0]));
+    if (dir == 0xFF) return false;
+    uint8_t btn = 0;
+    for (size_t i = 1; i < tok.size(); ++i) {
+        switch (Upper(tok[i])) {
+            case 'A': btn |= kA; break;
+            case 'B': btn |= kB; break;
+            case 'C': btn |= kC; break;
+            case 'D': btn |= kD; break;
+            default: return false; // unexpected char
+        }
+    }
+    outMask = (uint8_t)(dir | btn);
+    return true;
+}
+
+void AppendMaskToken(std::string& out, uint8_t mask) {
+    out.push_back(DirToNumpad(mask & kDirMask));
+    // Buttons in A..D order
+    if (mask & kA) out.push_back('A');
+    if (mask & kB) out.push_back('B');
+    if (mask & kC) out.push_back('C');
+    if (mask & kD) out.push_back('D');
+}
+
+bool Parse(std::string_view text, TickSink& sink, ParseError& err) {
+    const size_t n = text.size();
+    size_t p = 0;
+    auto skipSpace = [&](size_t& i) { while (i < n && IsSpace(text[i])) ++i; };
+    auto wordEnd = [&](size_t i) { while (i < n && !IsSpace(text[i])) ++i; return i; };
+
+    skipSpace(p);
+    // Optional header "EFZMACRO 1"
+    {
+        const size_t e = wordEnd(p);
+        if (EqualsNoCase(text.substr(p, e - p), "EFZMACRO")) {
+            const size_t hdrAt = p;
+            p = e; skipSpace(p);
+            const size_t ve = wordEnd(p);
+            const std::string_view ver = text.substr(p, ve - p);
+            if (ver.empty()) return Fail(err, hdrAt, "Missing macro version");
+            if (ver != "1") return Fail(err, p, "Unsupported macro version: " + std::string(ver));
+            p = ve;
+        }
+    }
+
+    // Buffer values of the current pack; capacity is kept across calls
+    thread_local std::vector<uint8_t> writes;
+    for (;;) {
+        skipSpace(p);
+        if (p >= n) break;
+        const size_t packAt = p;
+        if (text[p] == '{') return Fail(err, p, "Unexpected '{' without preceding tick token");
+
+        // Base token, up to whitespace or an attached buffer group
+        size_t e = p;
+        while (e < n && !IsSpace(text[e]) && text[e] != '{') ++e;
+        std::string_view base = text.substr(p, e - p);
+        p = e;
+
+        // Inline repeat suffix: "5Ax50"
+        uint32_t repeat = 1;
+        bool haveRepeat = false;
+        const size_t xPos = base.find_first_of("xX");
+        if (xPos != std::string_view::npos) {
+            size_t r = xPos + 1;
+            if (!ReadUInt(base, r, kMaxRepeat, repeat) || r != base.size() || repeat == 0) {
+                return Fail(err, packAt + xPos, "Invalid repeat suffix in '" + std::string(base) + "'");
+            }
+            base = base.substr(0, xPos);
+            haveRepeat = true;
+        }
+        uint8_t mask = 0;
+        if (!TokenToMask(base, mask)) return Fail(err, packAt, "Bad tick token: '" + std::string(base) + "'");
+
+        // Optional buffer group {k: v1 v2 ...}, attached directly or after whitespace
+        writes.clear();
+        uint32_t k = 1;
+        size_t q = p;
+        skipSpace(q);
+        if (q < n && text[q] == '{') {
+            const size_t groupAt = q;
+            if (haveRepeat) return Fail(err, groupAt, "Buffer group after repeat suffix in '" + std::string(text.substr(packAt, e - packAt)) + "'");
+            p = q + 1;
+            skipSpace(p);
+            if (!ReadUInt(text, p, 0xFFFF, k)) return Fail(err, p, "Buffer group missing or invalid count");
+            skipSpace(p);
+            if (p >= n || text[p] != ':') return Fail(err, p, "Buffer group missing ':'");
+            ++p;
+            for (;;) {
+                skipSpace(p);
+                if (p >= n) return Fail(err, groupAt, "Unterminated buffer group");
+                if (text[p] == '}') { ++p; break; }
+                const size_t valAt = p;
+                while (p < n && !IsSpace(text[p]) && text[p] != '}') ++p;
+                const std::string_view vtok = text.substr(valAt, p - valAt);
+                uint8_t v = 0;
+                if (vtok.size() >= 3 && vtok[0] == '0' && Upper(vtok[1]) == 'X') {
+                    uint32_t hex = 0;
+                    for (size_t i = 2; i < vtok.size(); ++i) {
+                        const int h = HexValue(vtok[i]);
+                        if (h < 0) return Fail(err, valAt, "Bad buffer value token: '" + std::string(vtok) + "'");
+                        hex = ((hex << 4) | (uint32_t)h) & 0xFFFF;
+                    }
+                    v = (uint8_t)(hex & 0xFF);
+                } else if (!TokenToMask(vtok, v)) {
+                    return Fail(err, valAt, "Bad buffer value token: '" + std::string(vtok) + "'");
+                }
+                writes.push_back(v);
+            }
+            if (k != writes.size()) return Fail(err, groupAt, "Buffer group count mismatch (k!=values)");
+        } else {
+            // Default: one write equal to tick mask
+            writes.push_back(mask);
+        }
+
+        // Repeat suffix after the group or after whitespace: "5C}x12", "5C} x12", "5C x12"
+        size_t r = p;
+        skipSpace(r);
+        if (r + 1 < n && (text[r] == 'x' || text[r] == 'X') && IsDigit(text[r + 1])) {
+            if (haveRepeat) return Fail(err, r, "Duplicate repeat suffix");
+            size_t d = r + 1;
+            if (!ReadUInt(text, d, kMaxRepeat, repeat) || repeat == 0) return Fail(err, r, "Invalid repeat suffix");
+            p = d;
+        }
+
+        sink.OnTicks(mask, writes.data(), (uint16_t)k, repeat);
+    }
+    return true;
+}
+
+Writer::Writer(std::string& out, bool includeBuffers) : m_out(out), m_includeBuffers(includeBuffers) {
+    m_out.append("EFZMACRO 1");
+}
+
+void Writer::Tick(uint8_t mask, const uint8_t* writes, uint16_t writeCount) {
+    // Runs are split at kMaxRepeat so every xN suffix we emit parses back
+    if (m_havePending && m_run < kMaxRepeat && mask == m_mask &&
+        (!m_includeBuffers || (writeCount == m_writeCount &&
+                               (writeCount == 0 || memcmp(writes, m_writes.data(), writeCount) == 0)))) {
+        ++m_run;
+        return;
+    }
+    FlushPending();
+    m_havePending = true;
+    m_mask = mask;
+    m_run = 1;
+    m_writeCount = m_includeBuffers ? writeCount : 0;
+    if (m_includeBuffers) m_writes.assign(writes, writes + writeCount);
+}
+
+void Writer::Finish() {
+    FlushPending();
+}
+
+void Writer::FlushPending() {
+    if (!m_havePending) return;
+    m_havePending = false;
+    m_out.push_back(' ');
+    AppendMaskToken(m_out, m_mask);
+    if (m_includeBuffers) {
+        m_out.append(" {");
+        AppendUInt(m_out, m_writeCount);
+        m_out.push_back(':');
+        for (uint16_t i = 0; i < m_writeCount; ++i) {
+            const uint8_t v = m_writes[i];
+            m_out.push_back(' ');
+            // Token form when it round-trips; hex for impossible combinations (both U&D or L&R)
+            if (((v & kUp) && (v & kDown)) || ((v & kLeft) && (v & kRight))) {
+                static const char kHex[] = "0123456789ABCDEF";
+                m_out.append("0x");
+                m_out.push_back(kHex[v >> 4]);
+                m_out.push_back(kHex[v & 0xF]);
+            } else {
+                AppendMaskToken(m_out, v);
+            }
+        }
+        m_out.push_back('}');
+    }
+    if (m_run > 1) {
+        m_out.push_back('x');
+        AppendUInt(m_out, m_run);
+    }
+}
+
+} // namespace MacroText
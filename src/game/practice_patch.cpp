@@ -4,6 +4,7 @@
 #include <sstream>
 #include <iomanip>
 #include "../include/core/memory.h"
+#include "../include/core/memory_txn.h"
 #include "../include/core/logger.h"
 #include "../include/game/game_state.h"
 
@@ -13,6 +14,7 @@
 
 #include "../include/game/practice_patch.h"
 #include "../include/game/per_frame_sample.h"
+#include "../include/game/move_props.h"
 #include "../include/gui/overlay.h"
 #include "../include/input/input_core.h"  // Include this to get AI_CONTROL_FLAG_OFFSET
 #include "../include/input/input_motion.h" // for direction/stance constants
@@ -81,7 +83,7 @@ bool EnablePlayer2InPracticeMode() {
     
     // Set Player 2 to be human controlled (0 = human, 1 = CPU)
     uint8_t humanControlled = 0;
-    if (!SafeWriteMemory(gameStatePtr + P2_CPU_FLAG_OFFSET, &humanControlled, sizeof(uint8_t))) {
+    if (!JournaledWrite(WriteOwner::PracticePatch, gameStatePtr + P2_CPU_FLAG_OFFSET, humanControlled)) {
         LogOut("[PRACTICE_PATCH] Failed to patch Player 2 CPU flag", true);
         return false;
     }
@@ -498,7 +500,7 @@ bool DisablePlayer2InPracticeMode() {
 
     // Set Player 2 to be CPU controlled (1 = CPU, 0 = human)
     uint8_t cpuControlled = 1;
-    if (!SafeWriteMemory(gameStatePtr + P2_CPU_FLAG_OFFSET, &cpuControlled, sizeof(uint8_t))) {
+    if (!JournaledWrite(WriteOwner::PracticePatch, gameStatePtr + P2_CPU_FLAG_OFFSET, cpuControlled)) {
         LogOut("[PRACTICE_PATCH] Failed to restore Player 2 CPU flag", true);
         return false;
     }
@@ -531,7 +533,7 @@ void EnsureDefaultControlFlagsOnMatchStart() {
     uintptr_t gameStatePtr = GetGameStatePtr();
     if (gameStatePtr) {
         uint8_t p2Cpu = 1; // 1 = CPU, 0 = human
-        if (SafeWriteMemory(gameStatePtr + P2_CPU_FLAG_OFFSET, &p2Cpu, sizeof(uint8_t))) {
+        if (JournaledWrite(WriteOwner::PracticePatch, gameStatePtr + P2_CPU_FLAG_OFFSET, p2Cpu)) {
             LogOut("[PRACTICE_PATCH] MatchStart: P2 CPU flag set to 1 (CPU)", true);
         } else {
             LogOut("[PRACTICE_PATCH] MatchStart: Failed to set P2 CPU flag", true);
@@ -602,7 +604,7 @@ bool SetPracticeAutoBlockEnabled(bool enabled, const char* reason) {
     uint32_t cur = 0;
     SafeReadMemory(gs + PRACTICE_AUTO_BLOCK_OFFSET, &cur, sizeof(cur));
     if (cur == val) return true; // no change
-    bool ok = SafeWriteMemory(gs + PRACTICE_AUTO_BLOCK_OFFSET, &val, sizeof(val));
+    bool ok = JournaledWrite(WriteOwner::PracticePatch, gs + PRACTICE_AUTO_BLOCK_OFFSET, val);
     if (ok) {
         std::ostringstream oss;
         oss << "Auto-Block " << (enabled ? "ON" : "OFF")
@@ -635,7 +637,7 @@ bool SetPracticeBlockMode(int mode) {
     uint8_t current = 0; SafeReadMemory(gs + PRACTICE_BLOCK_MODE_OFFSET, &current, sizeof(current));
     uint8_t v = (uint8_t)mode;
     if (current == v) return true;
-    bool ok = SafeWriteMemory(gs + PRACTICE_BLOCK_MODE_OFFSET, &v, sizeof(v));
+    bool ok = JournaledWrite(WriteOwner::PracticePatch, gs + PRACTICE_BLOCK_MODE_OFFSET, v);
     if (ok) {
         // Map to stance semantics for 0/2; keep First for 1
         if (v == 0) {
@@ -713,10 +715,10 @@ static bool SampleAttackerFrameFlags(int attacker /*1=P1, 2=P2*/, int &level, bo
     } else if (attacker == 2) {
         state = static_cast<uint16_t>(sample.moveID2);
     } else {
-        if (!SafeReadMemory(pBase + MOVE_ID_OFFSET, &state, sizeof(state))) return false;
+        if (!ReadSampledPlayerField(pBase, MOVE_ID_OFFSET, state)) return false;
     }
-    if (!SafeReadMemory(pBase + CURRENT_FRAME_INDEX_OFFSET, &frame, sizeof(frame))) return false;
-    if (!SafeReadMemory(pBase + ANIM_TABLE_OFFSET, &animTab, sizeof(animTab))) return false;
+    if (!ReadSampledPlayerField(pBase, CURRENT_FRAME_INDEX_OFFSET, frame)) return false;
+    if (!ReadSampledPlayerField(pBase, ANIM_TABLE_OFFSET, animTab)) return false;
     if (!animTab) return false;
 
     // Invalidate cache if base/anim changed
@@ -887,8 +889,8 @@ void SetExternalAutoBlockController(bool enabled) {
 static bool ReadP2BlockFields(uint8_t &dirOut, uint8_t &stanceOut) {
     uintptr_t p2 = GetPlayerBase(2); if (!p2) return false;
     uint8_t dir=0, stance=0;
-    SafeReadMemory(p2 + 392, &dir, sizeof(dir));
-    SafeReadMemory(p2 + 393, &stance, sizeof(stance));
+    ReadSampledPlayerField(p2, 392, dir);
+    ReadSampledPlayerField(p2, 393, stance);
     dirOut = dir; stanceOut = stance;
     return true;
 }
@@ -933,31 +935,11 @@ static void AssistP2DirectionForStance(uint8_t desiredStance, bool wantGuard, in
 }
 
 static bool ReadPositions(double &p1Y, double &p2Y) {
-    static uintptr_t s_p1YAddr = 0;
-    static uintptr_t s_p2YAddr = 0;
-    static int s_cacheCounter = 0;
-
-    uintptr_t base = GetEFZBase();
-    if (!base) { s_p1YAddr = s_p2YAddr = 0; return false; }
-
-    // Refresh cached addresses occasionally or if missing
-    if (!s_p1YAddr || !s_p2YAddr || (++s_cacheCounter >= 192)) {
-        s_p1YAddr = ResolvePointer(base, EFZ_BASE_OFFSET_P1, YPOS_OFFSET);
-        s_p2YAddr = ResolvePointer(base, EFZ_BASE_OFFSET_P2, YPOS_OFFSET);
-        s_cacheCounter = 0;
-    }
-
-    if (!s_p1YAddr || !s_p2YAddr) return false;
-
-    bool ok1 = SafeReadMemory(s_p1YAddr, &p1Y, sizeof(p1Y));
-    bool ok2 = SafeReadMemory(s_p2YAddr, &p2Y, sizeof(p2Y));
-    if (!ok1 || !ok2) {
-        // Invalidate cache on failure so we’ll resolve next call
-        if (!ok1) s_p1YAddr = 0;
-        if (!ok2) s_p2YAddr = 0;
-        return false;
-    }
-    return true;
+    // Y positions come from the frame monitor's tick snapshot (direct read off the monitor thread)
+    uintptr_t p1 = GetPlayerBase(1);
+    uintptr_t p2 = GetPlayerBase(2);
+    if (!p1 || !p2) return false;
+    return ReadSampledPlayerField(p1, YPOS_OFFSET, p1Y) && ReadSampledPlayerField(p2, YPOS_OFFSET, p2Y);
 }
 
 // Helper: classify common states by moveID
@@ -1021,7 +1003,7 @@ void MonitorDummyAutoBlock(short p1MoveID, short p2MoveID, short prevP1MoveID, s
     const bool hitNow = (!IsP2InHitstun(prevP2MoveID) && IsP2InHitstun(p2MoveID));
     auto isAllowedNeutral = [](short m){
         // Allowed MoveIDs: 0,1,2,3,4,7,8,9,13 (same as Continuous Recovery)
-        return (m == 0 || m == 1 || m == 2 || m == 3 || m == 4 || m == 7 || m == 8 || m == 9 || m == 13);
+        return MoveProps::Has(m, MoveProps::RecoveryNeutral);
     };
     const bool neutralNow = isAllowedNeutral(p2MoveID);
     const bool transitionedToNeutral = (!isAllowedNeutral(prevP2MoveID) && neutralNow);
@@ -1265,7 +1247,7 @@ void MonitorDummyAutoBlock(short p1MoveID, short p2MoveID, short prevP1MoveID, s
         // we should skip adaptive stance adjustments to avoid log spam and unintended stance overwrites.
         uintptr_t baseAI = GetPlayerBase(2);
         if (!baseAI) return; // can't evaluate
-        uint32_t aiFlag = 1; SafeReadMemory(baseAI + AI_CONTROL_FLAG_OFFSET, &aiFlag, sizeof(aiFlag));
+        uint32_t aiFlag = 1; ReadSampledPlayerField(baseAI, AI_CONTROL_FLAG_OFFSET, aiFlag);
         if (aiFlag == 0) {
             // Suppressed; optional throttled debug
             static int s_aiGateDbg = 0; if (detailedLogging.load() && (s_aiGateDbg++ & 0x3F) == 0) {
@@ -1325,6 +1307,7 @@ void MonitorDummyAutoBlock(short p1MoveID, short p2MoveID, short prevP1MoveID, s
                     short prevBlk=0; short prevMove=0;
                     bool prevWasBlocking=false;
                     if (p2) {
+                        // Written back below: read live memory, not the tick snapshot
                         SafeReadMemory(p2 + BLOCKSTUN_OFFSET, &prevBlk, sizeof(prevBlk));
                         SafeReadMemory(p2 + MOVE_ID_OFFSET, &prevMove, sizeof(prevMove));
                         prevWasBlocking = IsP2BlockingOrBlockstun(prevMove);
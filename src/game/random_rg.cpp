@@ -34,6 +34,7 @@ namespace RandomRG {
         bool heads = (rand() & 1) != 0;
     uint8_t arm = heads ? 0x3C : 0x00;
     // IMPORTANT: RG arm byte is at +334 (decimal), not 0x334.
+    // Not journaled: transient engine timer, nothing meaningful to restore
     SafeWriteMemory(p2 + 334, &arm, sizeof(arm));
 
         // Basic logging only on state change to keep output readable
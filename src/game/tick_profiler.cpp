@@ -0,0 +1,151 @@
+#include "../include/game/tick_profiler.h"
+#include "../include/utils/config.h"
+#include "../include/core/logger.h"
+#include <fstream>
+
+namespace {
+    constexpr int kSections = (int)TickSection::Count;
+
+    struct Histogram {
+        std::atomic<uint32_t> buckets[TickProfiler::kBuckets];
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sumNs{0};
+        std::atomic<uint64_t> maxNs{0};
+        std::atomic<uint64_t> overBudget{0};
+    };
+
+    Histogram s_hist[kSections];
+    std::atomic<bool> s_resetRequested{false};
+
+    const char* const kSectionNames[kSections] = {
+        "Snapshot", "Framestep", "MacroTick", "MotionRecognizer", "FrameAdvantage", "DummyAutoBlock",
+        "AutoActions", "AutoAirtech", "CharEnforcement", "RFFreeze", "Tick"
+    };
+
+    constexpr uint64_t kBudgetNs = 1000000000ull / 192;
+
+    // Values below kSubBuckets map 1:1; above that, bucket = (exponent group, top 3 mantissa bits)
+    int BucketFor(uint64_t ns) {
+        using namespace TickProfiler;
+        if (ns < (uint64_t)kSubBuckets) return (int)ns;
+        int msb = 63;
+        while (!(ns >> msb)) --msb;
+        int shift = msb - kSubBucketBits;
+        int idx = (shift + 1) * kSubBuckets + (int)((ns >> shift) & (kSubBuckets - 1));
+        return idx < kBuckets ? idx : kBuckets - 1;
+    }
+
+    // Upper edge of a bucket in ns (percentiles report the conservative side)
+    uint64_t BucketUpperNs(int b) {
+        using namespace TickProfiler;
+        if (b < kSubBuckets) return (uint64_t)b;
+        int shift = b / kSubBuckets - 1;
+        uint64_t sub = (uint64_t)(b % kSubBuckets);
+        return ((kSubBuckets + sub + 1) << shift) - 1;
+    }
+
+    void ResetAll() {
+        for (Histogram& h : s_hist) {
+            for (auto& b : h.buckets) b.store(0, std::memory_order_relaxed);
+            h.count.store(0, std::memory_order_relaxed);
+            h.sumNs.store(0, std::memory_order_relaxed);
+            h.maxNs.store(0, std::memory_order_relaxed);
+            h.overBudget.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::string DefaultCsvPath() {
+        std::string cfg = Config::GetConfigFilePath();
+        size_t slash = cfg.find_last_of("\\/");
+        if (slash == std::string::npos) return "efz_tick_profile.csv";
+        return cfg.substr(0, slash + 1) + "efz_tick_profile.csv";
+    }
+}
+
+namespace TickProfiler {
+
+const char* SectionName(TickSection s) {
+    return (int)s < kSections ? kSectionNames[(int)s] : "?";
+}
+
+void Record(TickSection s, uint64_t ns) {
+    if ((int)s >= kSections) return;
+    // Single writer (frame monitor thread): plain load/store instead of locked RMW
+    Histogram& h = s_hist[(int)s];
+    auto& b = h.buckets[BucketFor(ns)];
+    b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    h.count.store(h.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    h.sumNs.store(h.sumNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    if (ns > h.maxNs.load(std::memory_order_relaxed)) h.maxNs.store(ns, std::memory_order_relaxed);
+    if (ns > kBudgetNs) h.overBudget.store(h.overBudget.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void EndTick() {
+    if (s_resetRequested.load(std::memory_order_relaxed) && s_resetRequested.exchange(false)) {
+        ResetAll();
+    }
+}
+
+SectionStats GetStats(TickSection s) {
+    SectionStats out;
+    if ((int)s >= kSections) return out;
+    const Histogram& h = s_hist[(int)s];
+    uint32_t snap[kBuckets];
+    uint64_t total = 0;
+    for (int i = 0; i < kBuckets; ++i) { snap[i] = h.buckets[i].load(std::memory_order_relaxed); total += snap[i]; }
+    out.count = total;
+    if (total == 0) return out;
+
+    const uint64_t sum = h.sumNs.load(std::memory_order_relaxed);
+    const uint64_t cnt = h.count.load(std::memory_order_relaxed);
+    out.meanUs = cnt ? (sum / 1000.0) / (double)cnt : 0.0;
+    out.maxUs = h.maxNs.load(std::memory_order_relaxed) / 1000.0;
+    out.overBudget = h.overBudget.load(std::memory_order_relaxed);
+
+    const uint64_t rank50 = (total * 50 + 99) / 100;
+    const uint64_t rank99 = (total * 99 + 99) / 100;
+    uint64_t seen = 0;
+    bool have50 = false;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += snap[i];
+        if (!have50 && seen >= rank50) { out.p50Us = BucketUpperNs(i) / 1000.0; have50 = true; }
+        if (seen >= rank99) { out.p99Us = BucketUpperNs(i) / 1000.0; break; }
+    }
+    // Bucket edges can overshoot the exact maximum
+    if (out.p50Us > out.maxUs) out.p50Us = out.maxUs;
+    if (out.p99Us > out.maxUs) out.p99Us = out.maxUs;
+    return out;
+}
+
+void RequestReset() {
+    s_resetRequested.store(true, std::memory_order_relaxed);
+}
+
+bool ExportCsv(const std::string& path, std::string* writtenPath) {
+    const std::string target = path.empty() ? DefaultCsvPath() : path;
+    std::ofstream f(target, std::ios::out | std::ios::trunc);
+    if (!f.is_open()) {
+        LogOut("[TICK_PROFILE] Failed to open " + target + " for writing", true);
+        return false;
+    }
+    f << "section,count,mean_us,p50_us,p99_us,max_us,over_budget\n";
+    for (int s = 0; s < kSections; ++s) {
+        SectionStats st = GetStats((TickSection)s);
+        f << kSectionNames[s] << ',' << st.count << ',' << st.meanUs << ',' << st.p50Us << ','
+          << st.p99Us << ',' << st.maxUs << ',' << st.overBudget << '\n';
+    }
+    // Raw histograms (non-empty buckets only) for offline plotting
+    f << "\nsection,bucket_upper_ns,count\n";
+    for (int s = 0; s < kSections; ++s) {
+        for (int i = 0; i < kBuckets; ++i) {
+            uint32_t n = s_hist[s].buckets[i].load(std::memory_order_relaxed);
+            if (n) f << kSectionNames[s] << ',' << BucketUpperNs(i) << ',' << n << '\n';
+        }
+    }
+    if (!f.good()) return false;
+    if (writtenPath) *writtenPath = target;
+    LogOut("[TICK_PROFILE] Exported tick cost histograms to " + target, true);
+    return true;
+}
+
+} // namespace TickProfiler
@@ -0,0 +1,209 @@
+#include "../include/game/trace_recorder.h"
+#include "../include/game/per_frame_sample.h"
+#include "../include/game/frame_monitor.h"
+#include "../include/input/injection_control.h"
+#include "../include/input/immediate_input.h"
+#include "../include/utils/utilities.h"
+#include "../include/utils/config.h"
+#include "../include/core/logger.h"
+#include <windows.h>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+static_assert(TRACE_PLAYER_BYTES == PLAYER_SNAPSHOT_BYTES, "trace player window out of sync with PerFrameSample");
+static_assert(TRACE_GAMESTATE_BYTES == GAMESTATE_SNAPSHOT_BYTES, "trace game-state window out of sync with PerFrameSample");
+
+namespace {
+    std::atomic<bool> s_recording{false};
+    // Held by RecordTick for the duration of one record and by Start/Stop while (un)mapping.
+    // Uncontended in steady state (only the frame monitor takes it per tick).
+    std::mutex s_mapMutex;
+    HANDLE s_file = INVALID_HANDLE_VALUE;
+    HANDLE s_mapping = NULL;
+    uint8_t* s_view = nullptr;
+    TraceFileHeader* s_header = nullptr;
+    TraceRecord* s_records = nullptr;
+    uint32_t s_capacity = 0;
+    std::string s_path;
+    std::atomic<uint64_t> s_written{0};
+
+    // Overlay events raised since the last recorded tick (any thread)
+    std::mutex s_overlayMutex;
+    std::atomic<uint32_t> s_pendingOverlay{0};
+    TraceOverlayEvent s_overlayBuf[TRACE_OVERLAY_EVENTS];
+
+    uint16_t HashCategory(const std::string& s) {
+        if (s.empty()) return 0;
+        uint32_t h = 2166136261u;
+        for (unsigned char c : s) { h ^= c; h *= 16777619u; }
+        uint16_t folded = (uint16_t)(h ^ (h >> 16));
+        return folded ? folded : 1;
+    }
+
+    std::string DefaultTracePath() {
+        std::string cfg = Config::GetConfigFilePath();
+        size_t slash = cfg.find_last_of("\\/");
+        if (slash == std::string::npos) return "efz_trace.bin";
+        return cfg.substr(0, slash + 1) + "efz_trace.bin";
+    }
+
+    void CloseMappingLocked() {
+        if (s_view) {
+            FlushViewOfFile(s_view, 0);
+            UnmapViewOfFile(s_view);
+        }
+        if (s_mapping) CloseHandle(s_mapping);
+        if (s_file != INVALID_HANDLE_VALUE) CloseHandle(s_file);
+        s_view = nullptr; s_mapping = NULL; s_file = INVALID_HANDLE_VALUE;
+        s_header = nullptr; s_records = nullptr; s_capacity = 0;
+    }
+
+    void FillInput(TraceInputState& in, int player) {
+        in.manualOverride = g_manualInputOverride[player].load(std::memory_order_relaxed) ? 1 : 0;
+        in.manualMask = g_manualInputMask[player].load(std::memory_order_relaxed);
+        in.pollOverride = g_pollOverrideActive[player].load(std::memory_order_relaxed) ? 1 : 0;
+        in.pollMask = g_pollOverrideMask[player].load(std::memory_order_relaxed);
+        in.immediateMask = ImmediateInput::GetCurrentDesired(player);
+        in.immediateOnly = g_injectImmediateOnly[player].load(std::memory_order_relaxed) ? 1 : 0;
+    }
+}
+
+namespace TraceRecorder {
+
+bool Start(const std::string& path, uint32_t capacity) {
+    if (capacity == 0) capacity = kDefaultCapacity;
+    std::lock_guard<std::mutex> lock(s_mapMutex);
+    if (s_view) {
+        s_recording.store(false, std::memory_order_release);
+        CloseMappingLocked();
+    }
+
+    s_path = path.empty() ? DefaultTracePath() : path;
+    const uint64_t total = sizeof(TraceFileHeader) + (uint64_t)capacity * sizeof(TraceRecord);
+
+    s_file = CreateFileA(s_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                         CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (s_file == INVALID_HANDLE_VALUE) {
+        LogOut("[TRACE] Failed to create " + s_path + " (error " + std::to_string(GetLastError()) + ")", true);
+        return false;
+    }
+    s_mapping = CreateFileMappingA(s_file, NULL, PAGE_READWRITE, (DWORD)(total >> 32), (DWORD)(total & 0xFFFFFFFFu), NULL);
+    if (s_mapping) s_view = (uint8_t*)MapViewOfFile(s_mapping, FILE_MAP_WRITE, 0, 0, (SIZE_T)total);
+    if (!s_view) {
+        LogOut("[TRACE] Failed to map " + std::to_string(total) + " bytes (error " + std::to_string(GetLastError()) + ")", true);
+        CloseMappingLocked();
+        return false;
+    }
+
+    s_header = reinterpret_cast<TraceFileHeader*>(s_view);
+    s_records = reinterpret_cast<TraceRecord*>(s_view + sizeof(TraceFileHeader));
+    s_capacity = capacity;
+    memset(s_header, 0, sizeof(*s_header));
+    s_header->magic = TRACE_MAGIC;
+    s_header->version = TRACE_VERSION;
+    s_header->headerSize = sizeof(TraceFileHeader);
+    s_header->recordSize = sizeof(TraceRecord);
+    s_header->capacity = capacity;
+    s_header->tickHz = 192;
+    s_header->startTickMs = GetTickCount64();
+    s_written.store(0, std::memory_order_relaxed);
+    s_pendingOverlay.store(0, std::memory_order_relaxed);
+    s_recording.store(true, std::memory_order_release);
+
+    LogOut("[TRACE] Recording to " + s_path + " (" + std::to_string(capacity) + " ticks, " +
+           std::to_string(total / (1024 * 1024)) + " MB)", true);
+    return true;
+}
+
+void Stop() {
+    if (!s_recording.exchange(false, std::memory_order_acq_rel)) return;
+    std::lock_guard<std::mutex> lock(s_mapMutex);
+    uint64_t n = s_written.load(std::memory_order_relaxed);
+    CloseMappingLocked();
+    LogOut("[TRACE] Stopped: " + std::to_string(n) + " ticks written to " + s_path, true);
+}
+
+bool IsRecording() {
+    return s_recording.load(std::memory_order_acquire);
+}
+
+uint64_t RecordedTicks() {
+    return s_written.load(std::memory_order_relaxed);
+}
+
+std::string CurrentPath() {
+    std::lock_guard<std::mutex> lock(s_mapMutex);
+    return s_path;
+}
+
+void RecordTick(const PerFrameSample& sample, const FrameSnapshot& snap) {
+    if (!s_recording.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(s_mapMutex);
+    if (!s_records) return;
+
+    uint64_t seq = s_written.load(std::memory_order_relaxed);
+    TraceRecord& r = s_records[seq % s_capacity];
+    r.seq = seq;
+    r.tickMs = sample.tickMs;
+    r.frame = sample.frame;
+    uint16_t f = 0;
+    if (sample.charsInitialized) f |= TRACE_F_CHARS_INIT;
+    if (sample.online)           f |= TRACE_F_ONLINE;
+    if (sample.p1.valid)         f |= TRACE_F_P1_VALID;
+    if (sample.p2.valid)         f |= TRACE_F_P2_VALID;
+    if (sample.gs.valid)         f |= TRACE_F_GS_VALID;
+    if (sample.actionable1)      f |= TRACE_F_ACTIONABLE1;
+    if (sample.actionable2)      f |= TRACE_F_ACTIONABLE2;
+    if (sample.neutral1)         f |= TRACE_F_NEUTRAL1;
+    if (sample.neutral2)         f |= TRACE_F_NEUTRAL2;
+    if (snap.p2BlockEdge)        f |= TRACE_F_P2_BLOCK_EDGE;
+    if (snap.p2HitstunEdge)      f |= TRACE_F_P2_HITSTUN_EDGE;
+    r.flags = f;
+    r.phase = (uint8_t)sample.phase;
+    r.mode = (uint8_t)sample.mode;
+    r.moveID1 = sample.moveID1;
+    r.moveID2 = sample.moveID2;
+    r.prevMoveID1 = sample.prevMoveID1;
+    r.prevMoveID2 = sample.prevMoveID2;
+    r.p1X = snap.p1X; r.p2X = snap.p2X;
+    r.p1Y = snap.p1Y; r.p2Y = snap.p2Y;
+    r.p1RF = snap.p1RF; r.p2RF = snap.p2RF;
+    r.p1Hp = snap.p1Hp; r.p2Hp = snap.p2Hp;
+    r.p1Meter = snap.p1Meter; r.p2Meter = snap.p2Meter;
+    r.p1CharId = snap.p1CharId; r.p2CharId = snap.p2CharId;
+    FillInput(r.input[0], 1);
+    FillInput(r.input[1], 2);
+
+    memset(r.overlay, 0, sizeof(r.overlay));
+    r.overlayCount = 0;
+    if (s_pendingOverlay.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> ol(s_overlayMutex);
+        uint32_t n = s_pendingOverlay.exchange(0, std::memory_order_acq_rel);
+        r.overlayCount = (uint8_t)(n > 255 ? 255 : n);
+        memcpy(r.overlay, s_overlayBuf, sizeof(TraceOverlayEvent) * (n < TRACE_OVERLAY_EVENTS ? n : TRACE_OVERLAY_EVENTS));
+    }
+
+    memcpy(r.p1Raw, sample.p1.raw, sizeof(r.p1Raw));
+    memcpy(r.p2Raw, sample.p2.raw, sizeof(r.p2Raw));
+    memcpy(r.gsRaw, sample.gs.raw, sizeof(r.gsRaw));
+
+    s_written.store(seq + 1, std::memory_order_relaxed);
+    s_header->written = seq + 1;
+}
+
+void NoteOverlayEvent(const std::string& text, const std::string& category) {
+    if (!s_recording.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(s_overlayMutex);
+    uint32_t idx = s_pendingOverlay.load(std::memory_order_relaxed);
+    if (idx < TRACE_OVERLAY_EVENTS) {
+        TraceOverlayEvent& e = s_overlayBuf[idx];
+        memset(&e, 0, sizeof(e));
+        e.categoryHash = HashCategory(category);
+        size_t n = text.size() < sizeof(e.text) - 1 ? text.size() : sizeof(e.text) - 1;
+        memcpy(e.text, text.data(), n);
+    }
+    s_pendingOverlay.store(idx + 1, std::memory_order_release);
+}
+
+} // namespace TraceRecorder
@@ -15,6 +15,8 @@
 #include "../include/input/input_motion.h"
 #include "../include/utils/bgm_control.h"
 #include "../include/input/input_debug.h"
+#include "../include/input/motion_recognizer.h"
+#include "../include/input/input_history.h"
 #include <algorithm> 
 #include <vector>
 #include <string>
@@ -43,11 +45,17 @@ extern void SpamAttackButton(uintptr_t playerBase, uint8_t button, int frames, c
 // Switch players
 #include "../include/utils/switch_players.h"
 #include "../include/game/macro_controller.h"
+#include "../include/game/macro_library.h"
 #include "../include/utils/pause_integration.h"
 #include "../include/game/practice_offsets.h"
 #include "../include/core/version.h"
 #include "../include/utils/network.h"
 #include "../include/input/framestep.h"
+#include "../include/game/trace_recorder.h"
+#include "../include/game/tick_profiler.h"
+#include "../include/core/task_scheduler.h"
+#include "../include/game/attack_table.h"
+#include "../include/game/exchange_stats.h"
 
 // Add these constants at the top of the file after includes
 // These are from input_motion.cpp but we need them here
@@ -178,6 +186,100 @@ namespace ImGuiGui {
         LogOut("[IMGUI_GUI] GUI state initialized", detailedLogging.load());
     }
 
+    // Exchanges recorded this session; all numbers come from the incremental aggregates
+    static void RenderExchangeStats() {
+        static int s_punishFrames = 4;
+        const ExchangeStats::Summary sum = ExchangeStats::GetSummary();
+
+        ImGui::Text("Exchanges: %u", sum.total);
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%u kept for export, max %d)", sum.stored, ExchangeStats::kCapacity);
+        for (int o = 0; o < (int)ExchangeStats::Outcome::Count; ++o) {
+            if (o) ImGui::SameLine();
+            ImGui::Text("%s: %u", ExchangeStats::OutcomeName((ExchangeStats::Outcome)o), sum.byOutcome[o]);
+        }
+
+        ImGui::SetNextItemWidth(160);
+        ImGui::SliderInt("Punish threshold (F)", &s_punishFrames, 1, 20);
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Startup of the defender's fastest option. Gaps at least this long and\nblocked exchanges at or below minus this are counted as punishable.");
+        ImGui::Text("Punishable gaps: %u of %u", ExchangeStats::PunishableGaps(sum, s_punishFrames), sum.gaps);
+        ImGui::Text("Punishable on block: %u of %u", ExchangeStats::PunishableBlocks(sum, s_punishFrames),
+                    sum.byOutcome[(int)ExchangeStats::Outcome::Block]);
+
+        float gapBins[ExchangeStats::kGapBins];
+        for (int i = 0; i < ExchangeStats::kGapBins; ++i) gapBins[i] = (float)sum.gapBins[i];
+        ImGui::PlotHistogram("Gap (0..20F)", gapBins, ExchangeStats::kGapBins, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+        float advBins[ExchangeStats::kAdvantageBins];
+        for (int i = 0; i < ExchangeStats::kAdvantageBins; ++i) advBins[i] = (float)sum.advantageBins[i];
+        ImGui::PlotHistogram("Block adv (-30..+30F)", advBins, ExchangeStats::kAdvantageBins, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+
+        if (ImGui::CollapsingHeader("Per move")) {
+            static ExchangeStats::MoveStats s_moves[2 * ExchangeStats::kMaxMoveId];
+            const int n = ExchangeStats::CopyMoveStats(s_moves, 2 * ExchangeStats::kMaxMoveId);
+            if (ImGui::BeginTable("exchange_moves", 7, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg |
+                                  ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY, ImVec2(0, 200))) {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Player");
+                ImGui::TableSetupColumn("Move");
+                ImGui::TableSetupColumn("Count");
+                ImGui::TableSetupColumn("Block/Hit");
+                ImGui::TableSetupColumn("Adv min");
+                ImGui::TableSetupColumn("Adv avg");
+                ImGui::TableSetupColumn("Adv max");
+                ImGui::TableHeadersRow();
+                ImGuiListClipper clipper;
+                clipper.Begin(n);
+                while (clipper.Step()) {
+                    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                        const ExchangeStats::MoveStats& m = s_moves[i];
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn(); ImGui::Text("P%d", (int)m.player);
+                        ImGui::TableNextColumn(); ImGui::Text("%d", (int)m.moveID);
+                        ImGui::TableNextColumn(); ImGui::Text("%u", m.count);
+                        ImGui::TableNextColumn(); ImGui::Text("%u/%u", m.blocks, m.hits);
+                        if (m.withAdvantage) {
+                            ImGui::TableNextColumn(); ImGui::Text("%+.2f", m.advantageMin / 3.0);
+                            ImGui::TableNextColumn(); ImGui::Text("%+.2f", (double)m.advantageSum / m.withAdvantage / 3.0);
+                            ImGui::TableNextColumn(); ImGui::Text("%+.2f", m.advantageMax / 3.0);
+                        } else {
+                            ImGui::TableNextColumn(); ImGui::TextDisabled("-");
+                            ImGui::TableNextColumn(); ImGui::TextDisabled("-");
+                            ImGui::TableNextColumn(); ImGui::TextDisabled("-");
+                        }
+                    }
+                }
+                ImGui::EndTable();
+            }
+        }
+
+        if (ImGui::CollapsingHeader("Recent")) {
+            ExchangeStats::Row rows[12];
+            const int n = ExchangeStats::CopyRecent(rows, 12);
+            for (int i = 0; i < n; ++i) {
+                const ExchangeStats::Row& r = rows[i];
+                ImGui::Text("P%d %d -> %s (%d)", (int)r.attacker, (int)r.attackerMove,
+                            ExchangeStats::OutcomeName(r.outcome), (int)r.defenderMove);
+                if (r.advantage != ExchangeStats::kNone) { ImGui::SameLine(); ImGui::Text("adv %+.2f", r.advantage / 3.0); }
+                if (r.gap != ExchangeStats::kNone) { ImGui::SameLine(); ImGui::Text("gap %.2f", r.gap / 3.0); }
+                if (r.rgFa1 != ExchangeStats::kNone) { ImGui::SameLine(); ImGui::Text("FA1 %+.2f FA2 %+.2f", r.rgFa1 / 3.0, r.rgFa2 / 3.0); }
+            }
+        }
+
+        if (ImGui::Button("Reset##exchanges")) {
+            ExchangeStats::Reset();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Export CSV##exchanges")) {
+            std::string written;
+            if (ExchangeStats::ExportCsv("", &written)) {
+                DirectDrawHook::AddMessage("Exchange log saved", "SYSTEM", RGB(100,255,100), 1500, 0, 100);
+            } else {
+                DirectDrawHook::AddMessage("Exchange log: export FAILED", "SYSTEM", RGB(255,100,100), 1500, 0, 100);
+            }
+        }
+        ImGui::TextDisabled("Frames are visual frames; exchanges come from the frame advantage tracker");
+    }
+
     // Game Values Tab (reworked layout)
     void RenderGameValuesTab() {
         ImGui::PushItemWidth(120);
@@ -851,6 +953,12 @@ namespace ImGuiGui {
                 }
                 if (ImGui::IsItemHovered()) ImGui::SetTooltip("Toggles the numeric frame advantage readout (including RG FA1/FA2).");
 
+                bool showMeter = g_ShowFrameMeterOverlay.load();
+                if (ImGui::Checkbox("Show Frame Meter", &showMeter)) {
+                    g_ShowFrameMeterOverlay.store(showMeter);
+                }
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Per-frame bar of both players: startup (green), active (red), recovery (blue),\nblockstun (yellow), hitstun (orange), other busy states (purple), actionable (grey).");
+
                 // Framestep mode (Vanilla EFZ only)
                 if (GetEfzRevivalVersion() == EfzRevivalVersion::Vanilla) {
                     ImGui::Spacing();
@@ -879,6 +987,14 @@ namespace ImGuiGui {
                 ImGui::EndTabItem();
             }
 
+            // Stats sub-tab: session exchange log (ExchangeStats) with gap / punish histograms
+            ImGuiTabItemFlags _setStats = (rq == 3) ? ImGuiTabItemFlags_SetSelected : 0;
+            if (ImGui::BeginTabItem("Stats", nullptr, _setStats)) {
+                guiState.mainMenuSubTab = 3;
+                RenderExchangeStats();
+                ImGui::EndTabItem();
+            }
+
             ImGui::EndTabBar();
         }
 
@@ -1752,6 +1868,57 @@ namespace ImGuiGui {
                     ImGui::TextWrapped("Hint: Use numpad directions with A/B/C/D and repeats, e.g. 5Ax50, 6, or 2 3 6C. Optional per-tick buffers: {3: 5 0x9A 6A}");
                     ImGui::PopStyleColor();
                 }
+                ImGui::SeparatorText("Macro Library");
+                {
+                    static int s_libSelected = -1;
+                    static char s_libName[64] = "";
+                    static char s_libSituation[64] = "";
+                    static bool s_libForP2Char = true;
+                    const int p2Char = guiState.localData.p2CharID;
+                    const size_t libCount = MacroLibrary::Count();
+                    ImGui::Text("%d macro(s) in %s", (int)libCount, MacroLibrary::CurrentPath().c_str());
+                    if (ImGui::BeginListBox("##macro_lib", ImVec2(-1, 6 * ImGui::GetTextLineHeightWithSpacing()))) {
+                        for (size_t i = 0; i < libCount; ++i) {
+                            MacroLibrary::EntryInfo info;
+                            if (!MacroLibrary::GetInfo(i, info)) continue;
+                            std::string label = info.name + "  [" +
+                                (info.charId < 0 ? std::string("Any") : CharacterSettings::GetCharacterName(info.charId)) +
+                                (info.situation.empty() ? std::string() : ", " + info.situation) + "]  " +
+                                std::to_string(info.ticks) + "t##lib" + std::to_string(i);
+                            if (ImGui::Selectable(label.c_str(), s_libSelected == (int)i)) s_libSelected = (int)i;
+                        }
+                        ImGui::EndListBox();
+                    }
+                    ImGui::BeginDisabled(s_libSelected < 0 || s_libSelected >= (int)libCount);
+                    if (ImGui::Button("Load into Slot")) {
+                        if (MacroController::BindLibraryEntry(curSlot, (size_t)s_libSelected)) {
+                            s_forceReload = true;
+                            s_editMode = false;
+                            DirectDrawHook::AddMessage("Loaded library macro into slot", "MACRO", RGB(180,255,180), 1000, 0, 120);
+                        } else {
+                            DirectDrawHook::AddMessage("Macro: Cannot load (stop record/replay first)", "MACRO", RGB(255,180,120), 1000, 0, 120);
+                        }
+                    }
+                    ImGui::EndDisabled();
+                    ImGui::InputText("Name##lib", s_libName, sizeof(s_libName));
+                    ImGui::InputText("Situation##lib", s_libSituation, sizeof(s_libSituation));
+                    ImGui::Checkbox("Tag with P2 character", &s_libForP2Char);
+                    if (s_libForP2Char) {
+                        ImGui::SameLine();
+                        ImGui::TextDisabled("(%s)", CharacterSettings::GetCharacterName(p2Char).c_str());
+                    }
+                    ImGui::BeginDisabled(s_libName[0] == '\0' || MacroController::IsSlotEmpty(curSlot));
+                    if (ImGui::Button("Save Slot to Library")) {
+                        int idx = MacroController::SaveSlotToLibrary(curSlot, s_libName, s_libSituation, s_libForP2Char ? p2Char : -1);
+                        if (idx >= 0) {
+                            s_libSelected = idx;
+                            DirectDrawHook::AddMessage("Saved macro to library", "MACRO", RGB(180,255,180), 1000, 0, 120);
+                        } else {
+                            DirectDrawHook::AddMessage("Macro: Library save failed", "MACRO", RGB(255,120,120), 1000, 0, 120);
+                        }
+                    }
+                    ImGui::EndDisabled();
+                }
                 ImGui::SeparatorText("Hotkeys");
                 ImGui::BulletText("Record: %s", GetKeyName(cfg.macroRecordKey).c_str());
                 ImGui::BulletText("Play: %s", GetKeyName(cfg.macroPlayKey).c_str());
@@ -3190,6 +3357,184 @@ namespace ImGuiGui {
             g_ShowOverlayDebugBorders.store(showBorders);
         }
         ImGui::Separator();
+        // Binary per-tick trace (memory-mapped ring file)
+        ImGui::Text("Tick Trace:");
+        bool tracing = TraceRecorder::IsRecording();
+        if (ImGui::Checkbox("Record per-tick trace", &tracing)) {
+            if (tracing) {
+                if (!TraceRecorder::Start()) {
+                    DirectDrawHook::AddMessage("Trace: FAILED to start", "SYSTEM", RGB(255,100,100), 1500, 0, 100);
+                }
+            } else {
+                TraceRecorder::Stop();
+            }
+        }
+        if (TraceRecorder::IsRecording()) {
+            unsigned long long ticks = (unsigned long long)TraceRecorder::RecordedTicks();
+            ImGui::SameLine();
+            ImGui::TextDisabled("%llu ticks (%.1fs)", ticks, ticks / 192.0);
+            ImGui::TextDisabled("%s", TraceRecorder::CurrentPath().c_str());
+        } else {
+            ImGui::SameLine();
+            ImGui::TextDisabled("Ring of ~85s at 192 Hz, overwrites oldest");
+        }
+        ImGui::Separator();
+        // Frame monitor tick cost (always-on histograms; budget is one 192 Hz frame)
+        if (ImGui::CollapsingHeader("Tick Cost (frame monitor)")) {
+            ImGui::TextDisabled("Budget per tick: %.0f us", TickProfiler::kBudgetUs);
+            if (ImGui::BeginTable("tick_cost", 6, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+                ImGui::TableSetupColumn("Section");
+                ImGui::TableSetupColumn("Samples");
+                ImGui::TableSetupColumn("p50 (us)");
+                ImGui::TableSetupColumn("p99 (us)");
+                ImGui::TableSetupColumn("Max (us)");
+                ImGui::TableSetupColumn("Over budget");
+                ImGui::TableHeadersRow();
+                for (int i = 0; i < (int)TickSection::Count; ++i) {
+                    TickProfiler::SectionStats st = TickProfiler::GetStats((TickSection)i);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(TickProfiler::SectionName((TickSection)i));
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)st.count);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", st.p50Us);
+                    ImGui::TableNextColumn();
+                    // Highlight sections whose tail eats a noticeable slice of the frame
+                    if (st.p99Us > TickProfiler::kBudgetUs * 0.25) ImGui::TextColored(ImVec4(1.0f, 0.55f, 0.3f, 1.0f), "%.1f", st.p99Us);
+                    else ImGui::Text("%.1f", st.p99Us);
+                    ImGui::TableNextColumn();
+                    if (st.maxUs > TickProfiler::kBudgetUs) ImGui::TextColored(ImVec4(1.0f, 0.35f, 0.35f, 1.0f), "%.1f", st.maxUs);
+                    else ImGui::Text("%.1f", st.maxUs);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)st.overBudget);
+                }
+                ImGui::EndTable();
+            }
+            if (ImGui::Button("Reset##tickcost")) {
+                TickProfiler::RequestReset();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Export CSV##tickcost")) {
+                std::string written;
+                if (TickProfiler::ExportCsv("", &written)) {
+                    DirectDrawHook::AddMessage("Tick profile saved", "SYSTEM", RGB(100,255,100), 1500, 0, 100);
+                } else {
+                    DirectDrawHook::AddMessage("Tick profile: export FAILED", "SYSTEM", RGB(255,100,100), 1500, 0, 100);
+                }
+            }
+        }
+        ImGui::Separator();
+        // Shared background scheduler: per-task wakeup jitter (start time minus deadline)
+        if (ImGui::CollapsingHeader("Scheduler Tasks")) {
+            TaskScheduler::TaskStats stats[TaskScheduler::kMaxTasks];
+            const int n = TaskScheduler::GetStats(stats, TaskScheduler::kMaxTasks);
+            if (ImGui::BeginTable("sched_tasks", 6, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+                ImGui::TableSetupColumn("Task");
+                ImGui::TableSetupColumn("Runs");
+                ImGui::TableSetupColumn("Late avg (us)");
+                ImGui::TableSetupColumn("Late max (us)");
+                ImGui::TableSetupColumn(">2ms late");
+                ImGui::TableSetupColumn("Run avg (us)");
+                ImGui::TableHeadersRow();
+                for (int i = 0; i < n; ++i) {
+                    const TaskScheduler::TaskStats& st = stats[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(st.name);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)st.runs);
+                    ImGui::TableNextColumn(); ImGui::Text("%.0f", st.meanLateUs);
+                    ImGui::TableNextColumn(); ImGui::Text("%.0f", st.maxLateUs);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)st.lateOver2ms);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", st.meanRunUs);
+                }
+                ImGui::EndTable();
+            }
+            if (ImGui::Button("Reset##schedtasks")) {
+                TaskScheduler::ResetStats();
+            }
+        }
+        ImGui::Separator();
+        // Motions completed by either player (frame monitor recognizer, newest first)
+        if (ImGui::CollapsingHeader("Recognized Motions")) {
+            if (ImGui::BeginTable("recognized_motions", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchSame)) {
+                ImGui::TableSetupColumn("P1");
+                ImGui::TableSetupColumn("P2");
+                ImGui::TableHeadersRow();
+                MotionRecognizer::MotionHit hits[2][MotionRecognizer::kRecentHits];
+                const int n1 = MotionRecognizer::GetRecentHits(1, hits[0], MotionRecognizer::kRecentHits);
+                const int n2 = MotionRecognizer::GetRecentHits(2, hits[1], MotionRecognizer::kRecentHits);
+                const int rows = (std::max)(n1, n2);
+                for (int r = 0; r < rows; ++r) {
+                    ImGui::TableNextRow();
+                    for (int p = 0; p < 2; ++p) {
+                        ImGui::TableNextColumn();
+                        if (r >= (p == 0 ? n1 : n2)) continue;
+                        const MotionRecognizer::MotionHit& h = hits[p][r];
+                        ImGui::Text("%s", GetMotionTypeName(h.motionId).c_str());
+                        ImGui::SameLine();
+                        ImGui::TextDisabled("%uf, lag %u", (unsigned)h.frames, (unsigned)h.buttonLag);
+                    }
+                }
+                ImGui::EndTable();
+            }
+            ImGui::TextDisabled("Frames and lag are input buffer entries (64 Hz)");
+        }
+        // Per-tick input history published by the frame monitor (no game memory reads here)
+        if (ImGui::CollapsingHeader("Input History")) {
+            bool showOverlay = g_ShowInputHistoryOverlay.load();
+            if (ImGui::Checkbox("Show input history overlay", &showOverlay)) {
+                g_ShowInputHistoryOverlay.store(showOverlay);
+            }
+            InputHistory::Run runs[InputHistory::kMaxRuns];
+            char line[512];
+            for (int p = 1; p <= 2; ++p) {
+                const int n = InputHistory::CopyRuns(p, runs, 16);
+                InputHistory::FormatRuns(runs, n, line, sizeof(line));
+                ImGui::Text("P%d:", p);
+                ImGui::SameLine();
+                ImGui::TextWrapped("%s", n ? line : "(no input yet)");
+            }
+            ImGui::TextDisabled("Newest first, facing-relative; counts are 192 Hz ticks (%u published)",
+                                (unsigned)InputHistory::PublishedTicks());
+            // Raw per-tick masks, oldest first (the last one is the current tick)
+            constexpr int kRecentTicks = 24;
+            uint8_t recent[kRecentTicks];
+            for (int p = 1; p <= 2; ++p) {
+                const int n = InputHistory::CopyRecent(p, recent, kRecentTicks);
+                int len = 0;
+                for (int i = 0; i < n && len < (int)sizeof(line) - 8; ++i) {
+                    if (i) line[len++] = ' ';
+                    len += InputHistory::FormatMask(recent[i], line + len, (int)sizeof(line) - len);
+                }
+                line[len] = '\0';
+                ImGui::Text("P%d ticks:", p);
+                ImGui::SameLine();
+                ImGui::TextUnformatted(n ? line : "(no input yet)");
+            }
+        }
+        // Per-character attack table (built in the background when a character loads)
+        if (ImGui::CollapsingHeader("Attack Data")) {
+            // Last attack seen per player stays listed so short moves remain readable
+            static short s_lastAttack[2] = { -1, -1 };
+            FrameSnapshot snap{};
+            const bool haveSnap = TryGetLatestSnapshot(snap, 250);
+            for (int p = 1; p <= 2; ++p) {
+                if (!AttackTable::IsReady(p)) {
+                    ImGui::Text("P%d: table not built", p);
+                    continue;
+                }
+                const short cur = haveSnap ? (p == 1 ? snap.p1Move : snap.p2Move) : -1;
+                if (cur >= 0 && AttackTable::Lookup(p, cur)) s_lastAttack[p - 1] = cur;
+                const short mv = s_lastAttack[p - 1];
+                const AttackTable::MoveData* m = mv >= 0 ? AttackTable::Lookup(p, mv) : nullptr;
+                if (!m) {
+                    ImGui::Text("P%d: %d attack moves, none used yet", p, AttackTable::MoveCount(p));
+                    continue;
+                }
+                ImGui::Text("P%d move %d%s: %s  active %d+%d/%d  dmg %u  blockstun %u  hitstop %u", p, (int)mv,
+                            mv == cur ? "*" : "", AttackTable::HeightName(*m), (int)m->firstActive,
+                            (int)m->activeFrames, (int)m->frames, (unsigned)m->damage, (unsigned)m->blockstun,
+                            (unsigned)m->hitstop);
+            }
+            ImGui::TextDisabled("* = current move; frame counts are animation frame blocks");
+        }
+        ImGui::Separator();
         // Final Memory (FM) tools
         ImGui::Text("Final Memory Tools:");
         if (ImGui::Button("Apply FM HP bypass (allow FM at any HP)")) {
@@ -4089,9 +4434,9 @@ namespace ImGuiGui {
             // Determine which sub-tab group is active based on the current top-level tab
             const int dir = (direction >= 0) ? 1 : -1;
             if (guiState.currentTab == 0) {
-                // Main Menu: 3 sub-tabs
+                // Main Menu: 4 sub-tabs
                 int idx = guiState.mainMenuSubTab;
-                int count = 3;
+                int count = 4;
                 idx = (idx + dir) % count; if (idx < 0) idx += count;
                 guiState.mainMenuSubTab = idx;
                 guiState.requestedMainMenuSubTab = idx;
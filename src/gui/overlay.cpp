@@ -5,7 +5,9 @@
 #include <thread>
 #include <atomic>
 #include "../include/gui/overlay.h"
+#include "../include/gui/overlay_messages.h"
 #include "../include/core/logger.h"
+#include "../include/core/task_scheduler.h"
 #include "../include/utils/utilities.h"
 
 #include "../include/core/memory.h"   
@@ -22,9 +24,13 @@
 // ADD these includes for the new rendering loop
 #include "../include/gui/imgui_impl.h"
 #include "../include/utils/config.h"
+#include "../include/game/trace_recorder.h"
 #include <Xinput.h>
 // XInput loaded dynamically via XInputShim
 #include "../include/utils/xinput_shim.h"
+#include "../include/input/input_handler.h"
+#include "../include/input/input_history.h"
+#include "../include/game/frame_meter.h"
 #include <cmath>
 #include "../../include/gui/gif_player.h"
 
@@ -58,8 +64,12 @@ namespace {
     UINT g_prevRtW = 0;
     UINT g_prevRtH = 0;
     std::atomic<bool> g_rtSizeLogged{false};  // Use atomic for thread-safe first-log detection
+    // Trace category for permanent messages (FA / gap readouts, banners), which have none of their own
+    const std::string kPermanentTraceCategory = "permanent";
 }
 std::atomic<bool> g_ShowRGDebugToasts{false};
+std::atomic<bool> g_ShowInputHistoryOverlay{false};
+std::atomic<bool> g_ShowFrameMeterOverlay{false};
 
 // --- Define static members of DirectDrawHook ---
 DirectDrawCreateFunc DirectDrawHook::originalDirectDrawCreate = nullptr;
@@ -68,10 +78,6 @@ BlitFunc DirectDrawHook::originalBlit = nullptr;
 FlipFunc DirectDrawHook::originalFlip = nullptr;
 IDirectDrawSurface7* DirectDrawHook::primarySurface = nullptr;
 HWND DirectDrawHook::gameWindow = nullptr;
-std::mutex DirectDrawHook::messagesMutex;
-std::deque<OverlayMessage> DirectDrawHook::messages;
-std::vector<OverlayMessage> DirectDrawHook::permanentMessages;
-int DirectDrawHook::nextMessageId = 0;
 bool DirectDrawHook::isHooked = false;
 // --- End static member definitions ---
 
@@ -200,6 +206,9 @@ HRESULT WINAPI HookedEndScene(LPDIRECT3DDEVICE9 pDevice) {
         return oEndScene(pDevice);
     }
 
+    // Hotkeys: one edge-detected pass per rendered frame over the snapshot refreshed above
+    PollHotkeysOncePerFrame();
+
     static bool imguiInit = false;
     if (!imguiInit) {
         if (ImGuiImpl::Initialize(pDevice)) {
@@ -478,6 +487,69 @@ void DirectDrawHook::RenderSimpleText(IDirectDrawSurface7* surface, const std::s
     surface->ReleaseDC(hdc);
 }
 
+// Newest runs of each player as a column per side (P1 left, P2 right), mapped into the 640x480 area
+static void RenderInputHistoryOverlay(ImDrawList* list, float ox, float oy, float scale) {
+    constexpr int kRows = 14;
+    constexpr float kTop = 110.0f, kRowH = 14.0f, kMargin = 8.0f, kColW = 64.0f;
+    InputHistory::Run runs[kRows];
+    for (int p = 1; p <= 2; ++p) {
+        const int n = InputHistory::CopyRuns(p, runs, kRows);
+        if (n == 0) continue;
+        const float x = ox + (p == 1 ? kMargin : 640.0f - kMargin - kColW) * scale;
+        const float y0 = oy + kTop * scale;
+        list->AddRectFilled(ImVec2(x - 4.0f, y0 - 2.0f), ImVec2(x + kColW * scale, y0 + n * kRowH * scale + 2.0f),
+                            IM_COL32(0, 0, 0, 150));
+        for (int i = 0; i < n; ++i) {
+            char label[8];
+            InputHistory::FormatMask(runs[i].mask, label, sizeof(label));
+            char row[24];
+            _snprintf_s(row, sizeof(row), _TRUNCATE, "%-5s %u", label, (unsigned)runs[i].ticks);
+            const ImU32 col = (runs[i].mask & 0xF0) ? IM_COL32(255, 220, 120, 255) : IM_COL32(220, 220, 220, 255);
+            list->AddText(ImVec2(x, y0 + i * kRowH * scale), col, row);
+        }
+    }
+}
+
+// Frame meter as two rows of cells (P1 over P2), one quad per visual frame, all reserved in one batch
+static void RenderFrameMeterOverlay(ImDrawList* list, float ox, float oy, float scale) {
+    constexpr float kLeft = 80.0f, kTop = 404.0f, kPitch = 6.0f, kCellW = 5.0f, kRowH = 8.0f, kRowGap = 2.0f;
+    static const ImU32 kColors[FrameMeter::kCellCount] = {
+        IM_COL32(30, 30, 30, 255),      // Empty
+        IM_COL32(70, 70, 70, 255),      // Actionable
+        IM_COL32(140, 110, 200, 255),   // Busy
+        IM_COL32(40, 110, 220, 255),    // Recovery
+        IM_COL32(30, 190, 120, 255),    // Startup
+        IM_COL32(220, 200, 40, 255),    // Blockstun
+        IM_COL32(240, 140, 40, 255),    // Hitstun
+        IM_COL32(220, 40, 60, 255),     // Active
+    };
+    // Copy only when the monitor published; otherwise redraw the cached cells
+    static uint8_t s_cells[2][FrameMeter::kColumns];
+    static int s_count[2] = { 0, 0 };
+    static uint32_t s_version = ~0u;
+    const uint32_t version = FrameMeter::Version();
+    if (version != s_version) {
+        s_version = version;
+        for (int p = 0; p < 2; ++p) s_count[p] = FrameMeter::CopyColumns(p + 1, s_cells[p], FrameMeter::kColumns);
+    }
+    const int cells = s_count[0] + s_count[1];
+    if (cells == 0) return;
+
+    const float x0 = ox + kLeft * scale;
+    const float y0 = oy + kTop * scale;
+    list->AddRectFilled(ImVec2(x0 - 2.0f, y0 - 2.0f),
+                        ImVec2(x0 + FrameMeter::kColumns * kPitch * scale + 1.0f, y0 + (2 * kRowH + kRowGap) * scale + 2.0f),
+                        IM_COL32(0, 0, 0, 150));
+    list->PrimReserve(cells * 6, cells * 4);
+    for (int p = 0; p < 2; ++p) {
+        const float y = y0 + p * (kRowH + kRowGap) * scale;
+        for (int i = 0; i < s_count[p]; ++i) {
+            const float x = x0 + i * kPitch * scale;
+            list->PrimRect(ImVec2(x, y), ImVec2(x + kCellW * scale, y + kRowH * scale), kColors[s_cells[p][i]]);
+        }
+    }
+}
+
 // NEW: Implement the D3D9 overlay renderer
 void DirectDrawHook::RenderD3D9Overlays(LPDIRECT3DDEVICE9 pDevice) {
     // Use background list for borders/messages and foreground for the cursor so it draws above windows
@@ -485,19 +557,30 @@ void DirectDrawHook::RenderD3D9Overlays(LPDIRECT3DDEVICE9 pDevice) {
     if (!bgList)
         return;
 
-    std::lock_guard<std::mutex> lock(messagesMutex);
+    // Messages are copied out of the lock-free store; the copy is reused until a writer publishes
+    // or the next temporary message expires, so a quiet frame costs two loads
+    static OverlayMessages::Message s_msgs[OverlayMessages::kSlots];
+    static int s_msgCount = 0;
+    static uint32_t s_msgVersion = ~0u;
+    static uint64_t s_msgRefreshAtMs = 0;
+    const uint64_t nowMs = OverlayMessages::NowMs();
+    const uint32_t msgVersion = OverlayMessages::Version();
+    if (msgVersion != s_msgVersion || nowMs >= s_msgRefreshAtMs) {
+        bool complete = true;
+        s_msgCount = OverlayMessages::Snapshot(s_msgs, OverlayMessages::kSlots, nowMs, &complete);
+        s_msgVersion = complete ? msgVersion : ~0u;     // a slot caught mid-write is picked up next frame
+        s_msgRefreshAtMs = UINT64_MAX;
+        for (int i = 0; i < s_msgCount; ++i) {
+            if (!s_msgs[i].permanent && s_msgs[i].expireMs < s_msgRefreshAtMs) s_msgRefreshAtMs = s_msgs[i].expireMs;
+        }
+    }
 
     // If the ImGui menu is visible and there are no messages, skip message rendering only
     // (but still allow the cursor to render on top of the UI)
     const bool menuVisibleNow = ImGuiImpl::IsVisible();
     bool skipMessageRendering = false;
-    if (menuVisibleNow && !g_ShowOverlayDebugBorders.load()) {
-        bool haveActiveTemp = false;
-        auto nowChk = std::chrono::steady_clock::now();
-        for (const auto& m : messages) { if (m.expireTime > nowChk) { haveActiveTemp = true; break; } }
-        if (!haveActiveTemp && permanentMessages.empty()) {
-            skipMessageRendering = true; // do not return; we still want to draw the cursor
-        }
+    if (menuVisibleNow && !g_ShowOverlayDebugBorders.load() && s_msgCount == 0) {
+        skipMessageRendering = true; // do not return; we still want to draw the cursor
     }
 
     // --- Identify current D3D9 render target (needed for mapping to inner 4:3 area) ---
@@ -561,23 +644,33 @@ void DirectDrawHook::RenderD3D9Overlays(LPDIRECT3DDEVICE9 pDevice) {
         bgList->AddRect(ImVec2(ox + 1.0f, oy + 1.0f), ImVec2(ox + gw - 1.0f, oy + gh - 1.0f), IM_COL32(0, 255, 0, 200), 0.0f, 0, 2.0f);
     }
 
+    // Input history costs one flag check while hidden
+    if (g_ShowInputHistoryOverlay.load(std::memory_order_relaxed) && !menuVisibleNow) {
+        RenderInputHistoryOverlay(bgList, ox, oy, scale);
+    }
+    if (g_ShowFrameMeterOverlay.load(std::memory_order_relaxed) && !menuVisibleNow) {
+        RenderFrameMeterOverlay(bgList, ox, oy, scale);
+    }
+
     // Optional: draw a single combined background for split frame-advantage messages
     bool faCombinedBgDrawn = false;
     if (!ImGuiImpl::IsVisible()) {
         if (g_FrameAdvantageId != -1 && g_FrameAdvantage2Id != -1) {
-            const OverlayMessage* faLeft = nullptr;
-            const OverlayMessage* faRight = nullptr;
-            for (const auto& pm : permanentMessages) {
+            const OverlayMessages::Message* faLeft = nullptr;
+            const OverlayMessages::Message* faRight = nullptr;
+            for (int i = 0; i < s_msgCount; ++i) {
+                const OverlayMessages::Message& pm = s_msgs[i];
+                if (!pm.permanent) continue;
                 if (pm.id == g_FrameAdvantageId) faLeft = &pm;
                 else if (pm.id == g_FrameAdvantage2Id) faRight = &pm;
             }
             if (faLeft && faRight) {
                 // Map positions
-                ImVec2 leftPos(ox + faLeft->xPos * scale, oy + faLeft->yPos * scale);
-                ImVec2 rightPos(ox + faRight->xPos * scale, oy + faRight->yPos * scale);
+                ImVec2 leftPos(ox + faLeft->x * scale, oy + faLeft->y * scale);
+                ImVec2 rightPos(ox + faRight->x * scale, oy + faRight->y * scale);
                 // Measure text sizes (no additional scaling, consistent with existing renderer)
-                ImVec2 leftSize = ImGui::CalcTextSize(faLeft->text.c_str());
-                ImVec2 rightSize = ImGui::CalcTextSize(faRight->text.c_str());
+                ImVec2 leftSize = ImGui::CalcTextSize(faLeft->text);
+                ImVec2 rightSize = ImGui::CalcTextSize(faRight->text);
                 // Build union background rect with same padding as individual messages
                 ImVec2 ul(
                     (leftPos.x < rightPos.x ? leftPos.x : rightPos.x) - 4.0f,
@@ -594,17 +687,17 @@ void DirectDrawHook::RenderD3D9Overlays(LPDIRECT3DDEVICE9 pDevice) {
     }
 
     // Helper lambda to render a message with a background
-    auto renderMessage = [&](const OverlayMessage& msg) {
+    auto renderMessage = [&](const OverlayMessages::Message& msg) {
         // Check if this is a trigger overlay by position
-        bool isTriggerOverlay = (msg.xPos >= 510 && msg.yPos >= 100 && msg.yPos <= 200);
+        bool isTriggerOverlay = (msg.x >= 510 && msg.y >= 100 && msg.y <= 200);
         
     // Map starting position from 640x480 virtual space to inner game area within current RT
-    ImVec2 textPos(ox + msg.xPos * scale, oy + msg.yPos * scale);
+    ImVec2 textPos(ox + msg.x * scale, oy + msg.y * scale);
         // Avoid CalcTextSize if we won't draw a background or adjust alignment
         ImVec2 textSize(0.f, 0.f);
     const bool needSize = (!ImGuiImpl::IsVisible()) || isTriggerOverlay;
         if (needSize) {
-            textSize = ImGui::CalcTextSize(msg.text.c_str());
+            textSize = ImGui::CalcTextSize(msg.text);
         }
         
         // Background quads are expensive in DX9; skip them when menu is up
@@ -638,28 +731,16 @@ void DirectDrawHook::RenderD3D9Overlays(LPDIRECT3DDEVICE9 pDevice) {
         int b = ((msg.color >> 16) & 0xFF);
         
         // Draw text
-    bgList->AddText(ImVec2((float)textPos.x, (float)textPos.y), IM_COL32(r, g, b, 255), msg.text.c_str());
+    bgList->AddText(ImVec2((float)textPos.x, (float)textPos.y), IM_COL32(r, g, b, 255), msg.text);
     };
 
     // Render messages with a soft cap when menu is open (unless skipped to reduce draw calls)
     if (!skipMessageRendering) {
         const bool limitMessages = ImGuiImpl::IsVisible();
         const int cap = limitMessages ? 24 : INT_MAX;
-        int drawn = 0;
-        // Permanent first
-        for (const auto& msg : permanentMessages) {
-            renderMessage(msg);
-            if (++drawn >= cap) break;
-        }
-        // Then temporary until cap
-        if (drawn < cap) {
-            const auto now = std::chrono::steady_clock::now();
-            for (const auto& msg : messages) {
-                if (msg.expireTime > now) {
-                    renderMessage(msg);
-                    if (++drawn >= cap) break;
-                }
-            }
+        // Snapshot order: permanent first, then temporary
+        for (int i = 0; i < s_msgCount && i < cap; ++i) {
+            renderMessage(s_msgs[i]);
         }
     }
 
@@ -801,10 +882,9 @@ void DirectDrawHook::RenderD3D9Overlays(LPDIRECT3DDEVICE9 pDevice) {
 void DirectDrawHook::RenderAllMessages(IDirectDrawSurface7* surface) {
     if (!surface) return;
     
-    std::lock_guard<std::mutex> lock(messagesMutex);
-    
-    // Get the current time
-    auto now = std::chrono::steady_clock::now();
+    // Copy the live messages out of the store (expired temporary messages are simply not copied)
+    static OverlayMessages::Message s_msgs[OverlayMessages::kSlots];
+    const int msgCount = OverlayMessages::Snapshot(s_msgs, OverlayMessages::kSlots, OverlayMessages::NowMs());
     
     // Check if character data is initialized
     uintptr_t base = GetEFZBase();
@@ -926,20 +1006,10 @@ void DirectDrawHook::RenderAllMessages(IDirectDrawSurface7* surface) {
             LogOut("[OVERLAY] Rendered Hello World with enhanced visibility", detailedLogging.load());
         }
         
-        // Render permanent messages
-        for (const auto& msg : permanentMessages) {
-            RenderText(hdc, msg.text, msg.xPos, msg.yPos, msg.color);
-        }
-        
-        // Render temporary messages and remove expired ones
-        auto it = messages.begin();
-        while (it != messages.end()) {
-            if (now >= it->expireTime) {
-                it = messages.erase(it);
-            } else {
-                RenderText(hdc, it->text, it->xPos, it->yPos, it->color);
-                ++it;
-            }
+        // Render permanent messages, then temporary ones
+        for (int i = 0; i < msgCount; ++i) {
+            const OverlayMessages::Message& msg = s_msgs[i];
+            RenderText(hdc, msg.text, msg.x, msg.y, (COLORREF)msg.color);
         }
         
     } catch (...) {
@@ -1015,11 +1085,7 @@ bool DirectDrawHook::Initialize() {
 
 // Clean up the hook
 void DirectDrawHook::Shutdown() {
-    {
-        std::lock_guard<std::mutex> lock(messagesMutex);
-        messages.clear();
-        permanentMessages.clear();
-    }
+    OverlayMessages::Clear();
     ShutdownD3D9();
     // Detach DirectDrawCreate detour if installed
     if (originalDirectDrawCreate) {
@@ -1032,73 +1098,45 @@ void DirectDrawHook::Shutdown() {
     }
 }
 
-// Add a temporary message
+// Add a temporary message; replaces the previous temporary message of the same category
 void DirectDrawHook::AddMessage(const std::string& text, const std::string& category, COLORREF color, int durationMs, int x, int y) {
-    std::lock_guard<std::mutex> lock(messagesMutex);
-
-    // Remove existing temporary messages of the same category
-    if (!category.empty()) {
-        messages.erase(std::remove_if(messages.begin(), messages.end(),
-            [&](const OverlayMessage& msg) {
-                return !msg.isPermanent && msg.category == category;
-            }), messages.end());
-    }
-
-    auto expireTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(durationMs);
-    messages.push_back({text, color, expireTime, x, y, false, -1, category});
+    TraceRecorder::NoteOverlayEvent(text, category);
+    const uint16_t cat = OverlayMessages::Category(category.data(), category.size());
+    OverlayMessages::AddTemporary(text.data(), text.size(), cat, (uint32_t)color,
+                                  OverlayMessages::NowMs() + (uint64_t)(durationMs > 0 ? durationMs : 0), x, y);
 }
 
 // Add a permanent message
 int DirectDrawHook::AddPermanentMessage(const std::string& text, COLORREF color, int x, int y) {
-    std::lock_guard<std::mutex> lock(messagesMutex);
-    
-    // FIX: Declare newId and increment the static counter
-    int newId = nextMessageId++;
-    
-    // FIX: Add the missing 'category' member to the initializer list.
-    // Permanent messages don't need a category, so we use an empty string.
-    permanentMessages.push_back({text, color, {}, x, y, true, newId, ""});
-    
-    return newId;
+    TraceRecorder::NoteOverlayEvent(text, kPermanentTraceCategory);
+    const int id = OverlayMessages::AddPermanent(text.data(), text.size(), (uint32_t)color, x, y);
+    if (id < 0) {
+        LogOut("[OVERLAY] No free permanent message slot for: " + text, detailedLogging.load());
+    }
+    return id;
 }
 
-// Update an existing permanent message
+// Update an existing permanent message (FA / gap readouts call this every tick; only changes are traced)
 void DirectDrawHook::UpdatePermanentMessage(int id, const std::string& newText, COLORREF newColor) {
-    std::lock_guard<std::mutex> lock(messagesMutex);
-    
-    for (auto& msg : permanentMessages) {
-        if (msg.id == id) {
-            msg.text = newText;
-            msg.color = newColor;
-            break;
-        }
+    if (OverlayMessages::UpdatePermanent(id, newText.data(), newText.size(), (uint32_t)newColor)) {
+        TraceRecorder::NoteOverlayEvent(newText, kPermanentTraceCategory);
     }
 }
 
 // Remove a permanent message
 void DirectDrawHook::RemovePermanentMessage(int id) {
-    std::lock_guard<std::mutex> lock(messagesMutex);
-    permanentMessages.erase(std::remove_if(permanentMessages.begin(), permanentMessages.end(),
-        [id](const OverlayMessage& msg) { return msg.id == id; }), permanentMessages.end());
+    OverlayMessages::RemovePermanent(id);
 }
 
 // NEW: Remove messages by category
 void DirectDrawHook::RemoveMessagesByCategory(const std::string& category) {
-    std::lock_guard<std::mutex> lock(messagesMutex);
     if (category.empty()) return;
-
-    // Remove temporary messages of the specified category
-    messages.erase(std::remove_if(messages.begin(), messages.end(),
-        [&](const OverlayMessage& msg) {
-            return !msg.isPermanent && msg.category == category;
-        }), messages.end());
+    OverlayMessages::RemoveCategory(OverlayMessages::Category(category.data(), category.size()));
 }
 
 // Remove all messages
 void DirectDrawHook::ClearAllMessages() {
-    std::lock_guard<std::mutex> lock(messagesMutex);
-    messages.clear();
-    permanentMessages.clear();
+    OverlayMessages::Clear();
 }
 
 // --- NEW: D3D9 Hook Initialization and Shutdown ---
@@ -1262,13 +1300,12 @@ bool DirectDrawHook::InitializeD3D9() {
     LogOut("[OVERLAY] D3D9 EndScene hook installed successfully.", true);
 
     // Diagnostic: Verify EndScene is observed soon; otherwise log hints why overlay might appear missing
-    std::thread([]{
-        Sleep(6000);
+    TaskScheduler::ScheduleOnce("D3D9.EndSceneCheck", 6000 * 1000, []{
         if (!g_EndSceneObserved.load()) {
             LogOut("[OVERLAY][D3D9] EndScene not observed within 6s after hook enable.", true);
             LogOut("[OVERLAY][D3D9] Possible causes: EFZ is not rendering via D3D9 yet (no wrapper), game not yet in a render loop, or another overlay modified the vtable.", true);
         }
-    }).detach();
+    });
     return true;
 }
 
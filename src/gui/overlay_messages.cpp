@@ -0,0 +1,255 @@
+#include "../include/gui/overlay_messages.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+namespace OverlayMessages {
+
+namespace {
+    constexpr int kTextWords = kTextBytes / 4;
+    constexpr int kReadRetries = 16;
+    constexpr int kCategoryBytes = 24;
+    static_assert(kTextBytes % 4 == 0, "text is stored as 32-bit words");
+
+    enum SlotState : uint32_t { Free = 0, Temporary = 1, Permanent = 2 };
+
+    // Payload in relaxed atomics so a racing reader copy is well defined; seq decides whether it is kept
+    struct Slot {
+        std::atomic<uint32_t> seq;
+        std::atomic<uint32_t> state;
+        std::atomic<int32_t>  id;
+        std::atomic<uint32_t> category;
+        std::atomic<uint32_t> color;
+        std::atomic<int32_t>  x;
+        std::atomic<int32_t>  y;
+        std::atomic<uint64_t> expireMs;
+        std::atomic<uint32_t> order;
+        std::atomic<uint32_t> len;
+        std::atomic<uint32_t> text[kTextWords];
+    };
+
+    Slot s_slots[kSlots];                   // [0, kTempSlots) temporary, the rest permanent
+    std::atomic<uint32_t> s_version{0};
+
+    // Writer side, s_writeMutex held
+    std::mutex s_writeMutex;
+    int s_nextId = 0;
+    uint32_t s_nextOrder = 0;
+    char s_categories[kMaxCategories][kCategoryBytes];
+    int s_categoryCount = 1;                // id 0 is kNoCategory
+
+    void BeginWrite(Slot& s) {
+        s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    void EndWrite(Slot& s) {
+        s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        s_version.fetch_add(1, std::memory_order_release);
+    }
+
+    void StoreText(Slot& s, const char* text, size_t len) {
+        if (len > (size_t)kTextBytes - 1) len = kTextBytes - 1;
+        uint32_t words[kTextWords] = {};
+        if (len) memcpy(words, text, len);
+        const int used = static_cast<int>(len / 4 + 1);     // includes the terminator
+        for (int i = 0; i < used; ++i) s.text[i].store(words[i], std::memory_order_relaxed);
+        s.len.store(static_cast<uint32_t>(len), std::memory_order_relaxed);
+    }
+
+    // Writer side: does the slot already hold this text (after truncation)?
+    bool SameText(const Slot& s, const char* text, size_t len) {
+        if (len > (size_t)kTextBytes - 1) len = kTextBytes - 1;
+        if (s.len.load(std::memory_order_relaxed) != len) return false;
+        for (size_t i = 0; i < len; i += 4) {
+            const uint32_t w = s.text[i / 4].load(std::memory_order_relaxed);
+            const size_t n = len - i < 4 ? len - i : 4;
+            if (memcmp(&w, text + i, n) != 0) return false;
+        }
+        return true;
+    }
+
+    void Fill(Slot& s, SlotState state, int id, uint16_t category, uint32_t color, uint64_t expireMs, int x, int y,
+              const char* text, size_t len) {
+        BeginWrite(s);
+        s.state.store(state, std::memory_order_relaxed);
+        s.id.store(id, std::memory_order_relaxed);
+        s.category.store(category, std::memory_order_relaxed);
+        s.color.store(color, std::memory_order_relaxed);
+        s.x.store(x, std::memory_order_relaxed);
+        s.y.store(y, std::memory_order_relaxed);
+        s.expireMs.store(expireMs, std::memory_order_relaxed);
+        s.order.store(s_nextOrder++, std::memory_order_relaxed);
+        StoreText(s, text, len);
+        EndWrite(s);
+    }
+
+    void Release(Slot& s) {
+        BeginWrite(s);
+        s.state.store(Free, std::memory_order_relaxed);
+        EndWrite(s);
+    }
+
+    Slot* FindPermanent(int id) {
+        if (id < 0) return nullptr;
+        for (int i = kTempSlots; i < kSlots; ++i) {
+            Slot& s = s_slots[i];
+            if (s.state.load(std::memory_order_relaxed) == Permanent && s.id.load(std::memory_order_relaxed) == id)
+                return &s;
+        }
+        return nullptr;
+    }
+
+    // Copies one slot if it holds a message live at nowMs; false when empty, expired or mid-write
+    bool ReadSlot(const Slot& s, Message& m, uint64_t nowMs, bool& torn) {
+        for (int attempt = 0; attempt < kReadRetries; ++attempt) {
+            const uint32_t before = s.seq.load(std::memory_order_acquire);
+            if (before & 1u) continue;
+            const uint32_t state = s.state.load(std::memory_order_relaxed);
+            bool live = state != Free;
+            if (live) {
+                m.id = s.id.load(std::memory_order_relaxed);
+                m.category = static_cast<uint16_t>(s.category.load(std::memory_order_relaxed));
+                m.permanent = state == Permanent;
+                m.color = s.color.load(std::memory_order_relaxed);
+                m.x = s.x.load(std::memory_order_relaxed);
+                m.y = s.y.load(std::memory_order_relaxed);
+                m.expireMs = s.expireMs.load(std::memory_order_relaxed);
+                m.order = s.order.load(std::memory_order_relaxed);
+                uint32_t len = s.len.load(std::memory_order_relaxed);
+                if (len > (uint32_t)kTextBytes - 1) len = kTextBytes - 1;
+                const int used = static_cast<int>(len / 4 + 1);
+                for (int i = 0; i < used; ++i) {
+                    const uint32_t w = s.text[i].load(std::memory_order_relaxed);
+                    memcpy(m.text + i * 4, &w, 4);
+                }
+                m.text[len] = '\0';
+                live = m.permanent || m.expireMs > nowMs;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) == before) return live;
+        }
+        torn = true;
+        return false;
+    }
+
+    // Insertion sort by order; at most kSlots entries
+    void SortByOrder(Message* m, int n) {
+        for (int i = 1; i < n; ++i) {
+            for (int j = i; j > 0 && m[j - 1].order > m[j].order; --j) {
+                Message t;
+                memcpy(&t, &m[j], sizeof(Message));
+                memcpy(&m[j], &m[j - 1], sizeof(Message));
+                memcpy(&m[j - 1], &t, sizeof(Message));
+            }
+        }
+    }
+}
+
+uint64_t NowMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint16_t Category(const char* name, size_t len) {
+    if (!name || len == 0) return kNoCategory;
+    if (len > (size_t)kCategoryBytes - 1) len = kCategoryBytes - 1;
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    for (int i = 1; i < s_categoryCount; ++i) {
+        if (strncmp(s_categories[i], name, len) == 0 && s_categories[i][len] == '\0') return static_cast<uint16_t>(i);
+    }
+    if (s_categoryCount >= kMaxCategories) return kNoCategory;
+    memcpy(s_categories[s_categoryCount], name, len);
+    s_categories[s_categoryCount][len] = '\0';
+    return static_cast<uint16_t>(s_categoryCount++);
+}
+
+void AddTemporary(const char* text, size_t len, uint16_t category, uint32_t color, uint64_t expireMs, int x, int y) {
+    const uint64_t now = NowMs();
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    Slot* target = nullptr;
+    Slot* soonest = nullptr;
+    for (int i = 0; i < kTempSlots; ++i) {
+        Slot& s = s_slots[i];
+        const bool used = s.state.load(std::memory_order_relaxed) == Temporary;
+        const uint64_t expire = s.expireMs.load(std::memory_order_relaxed);
+        if (used && category != kNoCategory && s.category.load(std::memory_order_relaxed) == category) {
+            target = &s;        // one temporary message per category
+            break;
+        }
+        if (!target && (!used || expire <= now)) target = &s;
+        if (!soonest || expire < soonest->expireMs.load(std::memory_order_relaxed)) soonest = &s;
+    }
+    if (!target) target = soonest;
+    Fill(*target, Temporary, -1, category, color, expireMs, x, y, text, len);
+}
+
+int AddPermanent(const char* text, size_t len, uint32_t color, int x, int y) {
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    for (int i = kTempSlots; i < kSlots; ++i) {
+        Slot& s = s_slots[i];
+        if (s.state.load(std::memory_order_relaxed) != Free) continue;
+        const int id = s_nextId++;
+        Fill(s, Permanent, id, kNoCategory, color, 0, x, y, text, len);
+        return id;
+    }
+    return -1;
+}
+
+bool UpdatePermanent(int id, const char* text, size_t len, uint32_t color) {
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    Slot* s = FindPermanent(id);
+    if (!s) return false;
+    if (SameText(*s, text, len) && s->color.load(std::memory_order_relaxed) == color) return false;
+    BeginWrite(*s);
+    s->color.store(color, std::memory_order_relaxed);
+    StoreText(*s, text, len);
+    EndWrite(*s);
+    return true;
+}
+
+void RemovePermanent(int id) {
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    if (Slot* s = FindPermanent(id)) Release(*s);
+}
+
+void RemoveCategory(uint16_t category) {
+    if (category == kNoCategory) return;
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    for (int i = 0; i < kTempSlots; ++i) {
+        Slot& s = s_slots[i];
+        if (s.state.load(std::memory_order_relaxed) == Temporary && s.category.load(std::memory_order_relaxed) == category)
+            Release(s);
+    }
+}
+
+void Clear() {
+    std::lock_guard<std::mutex> lock(s_writeMutex);
+    for (Slot& s : s_slots) {
+        if (s.state.load(std::memory_order_relaxed) != Free) Release(s);
+    }
+}
+
+uint32_t Version() {
+    return s_version.load(std::memory_order_acquire);
+}
+
+int Snapshot(Message* out, int max, uint64_t nowMs, bool* complete) {
+    bool torn = false;
+    int n = 0;
+    // Permanent pool first, then temporary; each pool sorted on its own
+    int groupStart = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        const int begin = pass == 0 ? kTempSlots : 0;
+        const int end = pass == 0 ? kSlots : kTempSlots;
+        for (int i = begin; i < end && n < max; ++i) {
+            if (ReadSlot(s_slots[i], out[n], nowMs, torn)) ++n;
+        }
+        SortByOrder(out + groupStart, n - groupStart);
+        groupStart = n;
+    }
+    if (complete) *complete = !torn;
+    return n;
+}
+
+} // namespace OverlayMessages
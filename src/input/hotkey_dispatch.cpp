@@ -0,0 +1,66 @@
+#include "../include/input/hotkey_dispatch.h"
+
+namespace HotkeyDispatch {
+
+void Table::Clear() {
+    m_count = 0;
+    m_watched = KeySet{};
+}
+
+bool Table::Bind(Action action, int vk, int padMask) {
+    const bool hasKey = vk > 0 && vk < 256;
+    const bool hasPad = padMask > 0;
+    if (action == Action::None || (!hasKey && !hasPad) || m_count >= kMaxBindings) return false;
+    Binding& b = m_bindings[m_count++];
+    b.action = action;
+    b.vk = hasKey ? static_cast<uint8_t>(vk) : 0;
+    b.padMask = hasPad ? static_cast<uint32_t>(padMask) : 0;
+    if (hasKey) m_watched.Set(vk);
+    return true;
+}
+
+Hit Table::Evaluate(const Snapshot& prev, const Snapshot& cur, unsigned padFilter) const {
+    KeySet keyDown;
+    for (int w = 0; w < 4; ++w) keyDown.bits[w] = cur.keys.bits[w] & ~prev.keys.bits[w];
+    uint32_t padDown[kMaxPads];
+    uint32_t anyPadDown = 0;
+    for (int p = 0; p < kMaxPads; ++p) {
+        padDown[p] = ((padFilter >> p) & 1u) ? (cur.pads[p] & ~prev.pads[p]) : 0u;
+        anyPadDown |= padDown[p];
+    }
+    if (!keyDown.Any() && !anyPadDown) return {};
+
+    for (int i = 0; i < m_count; ++i) {
+        const Binding& b = m_bindings[i];
+        if (b.vk && keyDown.Test(b.vk)) return { b.action, -1 };
+        if (b.padMask & anyPadDown) {
+            for (int p = 0; p < kMaxPads; ++p) {
+                if (padDown[p] & b.padMask) return { b.action, p };
+            }
+        }
+    }
+    return {};
+}
+
+const char* ActionName(Action action) {
+    switch (action) {
+        case Action::ToggleMenu:        return "ToggleMenu";
+        case Action::ToggleImGui:       return "ToggleImGui";
+        case Action::Teleport:          return "Teleport";
+        case Action::SavePosition:      return "SavePosition";
+        case Action::SwapPositions:     return "SwapPositions";
+        case Action::SwitchPlayers:     return "SwitchPlayers";
+        case Action::MacroRecord:       return "MacroRecord";
+        case Action::MacroPlay:         return "MacroPlay";
+        case Action::MacroSlot:         return "MacroSlot";
+        case Action::ToggleStats:       return "ToggleStats";
+        case Action::ResetFrameCounter: return "ResetFrameCounter";
+        case Action::FramestepPause:    return "FramestepPause";
+        case Action::FramestepStep:     return "FramestepStep";
+        case Action::Help:              return "Help";
+        case Action::AutoJump:          return "AutoJump";
+        default:                        return "None";
+    }
+}
+
+} // namespace HotkeyDispatch
@@ -2,14 +2,12 @@
 #include "../include/input/input_core.h"
 #include "../include/core/logger.h"
 #include "../include/core/memory.h"
-#include <thread>
-#include <chrono>
+#include "../include/core/task_scheduler.h"
 
 namespace ImmediateInput {
 
-static std::thread s_thread;
 static std::atomic<bool> s_running{false};
-static std::atomic<bool> s_stop{false};
+static std::atomic<TaskScheduler::TaskId> s_task{TaskScheduler::kInvalidTask};
 
 struct Slot {
     std::atomic<uint8_t> desired{0};
@@ -20,107 +18,98 @@ struct Slot {
 
 static Slot s_slot[3]; // 1=P1, 2=P2
 
-static void Worker() {
-    using clock = std::chrono::steady_clock;
-    const auto frameDur = std::chrono::milliseconds(1000 / 64); // ~15.625ms
-    auto next = clock::now();
-
-    while (!s_stop.load(std::memory_order_relaxed)) {
-        auto now = clock::now();
-        if (now < next) {
-            std::this_thread::sleep_for(next - now);
-        }
-        next += frameDur;
-
-        for (int p = 1; p <= 2; ++p) {
-            // Use acquire to ensure we see desired before checking ticks
-            uint8_t curDesired = s_slot[p].desired.load(std::memory_order_acquire);
-            int t = s_slot[p].ticks.load(std::memory_order_relaxed);
-            uint8_t last = s_slot[p].lastWritten.load(std::memory_order_relaxed);
-            bool needNeutral = s_slot[p].needNeutralEdge.exchange(false);
-
-            // Timed press handling
-            if (t > 0) {
-                // Ensure the desired is asserted; if it changed between ticks, ensure edge
-                if (curDesired == 0) {
-                    // no-op: nothing to press
-                    s_slot[p].ticks.store(0, std::memory_order_relaxed);
-                    continue;
-                }
-                // If we just wrote a non-zero last time, keep holding
-                // On transition or periodic re-press, create an edge by forcing a neutral first
-                if (last != 0 && last == curDesired) {
-                    // keep holding (reassert to ensure game sees it)
-                    WritePlayerInputImmediate(p, curDesired);
-                    
-                    // Debug: Log wake jump writes
-                    if ((curDesired & GAME_INPUT_UP) != 0) {
-                        uint16_t moveID = 0;
-                        uintptr_t playerPtr = GetPlayerPointer(p);
-                        if (playerPtr) {
-                            SafeReadMemory(playerPtr + MOVE_ID_OFFSET, &moveID, sizeof(uint16_t));
-                        }
-                        LogOut("[IMMEDIATE_INPUT] Holding UP for P" + std::to_string(p) + 
-                               " mask=" + std::to_string(curDesired) + 
-                               " ticksLeft=" + std::to_string(t-1) +
-                               " moveID=" + std::to_string(moveID), true);
-                    }
-                } else {
-                    // ensure a neutral edge when transitioning to a new non-zero
-                    if (last != 0) {
-                        WritePlayerInputImmediate(p, 0);
-                    }
-                    WritePlayerInputImmediate(p, curDesired);
-                    
-                    // Debug: Log initial wake jump write
-                    if ((curDesired & GAME_INPUT_UP) != 0) {
-                        uint16_t moveID = 0;
-                        uintptr_t playerPtr = GetPlayerPointer(p);
-                        if (playerPtr) {
-                            SafeReadMemory(playerPtr + MOVE_ID_OFFSET, &moveID, sizeof(uint16_t));
-                        }
-                        LogOut("[IMMEDIATE_INPUT] Initial UP write for P" + std::to_string(p) + 
-                               " mask=" + std::to_string(curDesired) + 
-                               " ticksLeft=" + std::to_string(t-1) +
-                               " moveID=" + std::to_string(moveID), true);
+// One visual frame of immediate-register writes; runs on the shared scheduler at 64 Hz
+static void Tick() {
+    for (int p = 1; p <= 2; ++p) {
+        // Use acquire to ensure we see desired before checking ticks
+        uint8_t curDesired = s_slot[p].desired.load(std::memory_order_acquire);
+        int t = s_slot[p].ticks.load(std::memory_order_relaxed);
+        uint8_t last = s_slot[p].lastWritten.load(std::memory_order_relaxed);
+        bool needNeutral = s_slot[p].needNeutralEdge.exchange(false);
+
+        // Timed press handling
+        if (t > 0) {
+            // Ensure the desired is asserted; if it changed between ticks, ensure edge
+            if (curDesired == 0) {
+                // no-op: nothing to press
+                s_slot[p].ticks.store(0, std::memory_order_relaxed);
+                continue;
+            }
+            // If we just wrote a non-zero last time, keep holding
+            // On transition or periodic re-press, create an edge by forcing a neutral first
+            if (last != 0 && last == curDesired) {
+                // keep holding (reassert to ensure game sees it)
+                WritePlayerInputImmediate(p, curDesired);
+                
+                // Debug: Log wake jump writes
+                if ((curDesired & GAME_INPUT_UP) != 0) {
+                    uint16_t moveID = 0;
+                    uintptr_t playerPtr = GetPlayerPointer(p);
+                    if (playerPtr) {
+                        SafeReadMemory(playerPtr + MOVE_ID_OFFSET, &moveID, sizeof(uint16_t));
                     }
+                    LogOut("[IMMEDIATE_INPUT] Holding UP for P" + std::to_string(p) + 
+                           " mask=" + std::to_string(curDesired) + 
+                           " ticksLeft=" + std::to_string(t-1) +
+                           " moveID=" + std::to_string(moveID), true);
                 }
-                s_slot[p].lastWritten.store(curDesired, std::memory_order_relaxed);
-                s_slot[p].ticks.store(t - 1, std::memory_order_relaxed);
-                if (t - 1 <= 0) {
-                    // auto-release to neutral on completion
+            } else {
+                // ensure a neutral edge when transitioning to a new non-zero
+                if (last != 0) {
                     WritePlayerInputImmediate(p, 0);
-                    s_slot[p].lastWritten.store(0, std::memory_order_relaxed);
-                    s_slot[p].desired.store(0, std::memory_order_relaxed);
                 }
-                continue;
+                WritePlayerInputImmediate(p, curDesired);
+                
+                // Debug: Log initial wake jump write
+                if ((curDesired & GAME_INPUT_UP) != 0) {
+                    uint16_t moveID = 0;
+                    uintptr_t playerPtr = GetPlayerPointer(p);
+                    if (playerPtr) {
+                        SafeReadMemory(playerPtr + MOVE_ID_OFFSET, &moveID, sizeof(uint16_t));
+                    }
+                    LogOut("[IMMEDIATE_INPUT] Initial UP write for P" + std::to_string(p) + 
+                           " mask=" + std::to_string(curDesired) + 
+                           " ticksLeft=" + std::to_string(t-1) +
+                           " moveID=" + std::to_string(moveID), true);
+                }
             }
-
-            // Continuous hold handling
-            if (needNeutral && curDesired != 0) {
-                // Force a neutral edge before reasserting non-zero mask
+            s_slot[p].lastWritten.store(curDesired, std::memory_order_relaxed);
+            s_slot[p].ticks.store(t - 1, std::memory_order_relaxed);
+            if (t - 1 <= 0) {
+                // auto-release to neutral on completion
                 WritePlayerInputImmediate(p, 0);
                 s_slot[p].lastWritten.store(0, std::memory_order_relaxed);
-                // Next loop will assert the non-zero
+                s_slot[p].desired.store(0, std::memory_order_relaxed);
             }
+            continue;
+        }
 
-            if (curDesired != 0) {
-                // Maintain hold; ensure the mask is reasserted periodically since the game may clear per frame
-                if (last != 0 && last != curDesired) {
-                    WritePlayerInputImmediate(p, 0);
-                }
-                WritePlayerInputImmediate(p, curDesired);
-                s_slot[p].lastWritten.store(curDesired, std::memory_order_relaxed);
-            } else {
-                if (last != 0) {
-                    WritePlayerInputImmediate(p, 0);
-                    s_slot[p].lastWritten.store(0, std::memory_order_relaxed);
-                }
+        // Continuous hold handling
+        if (needNeutral && curDesired != 0) {
+            // Force a neutral edge before reasserting non-zero mask
+            WritePlayerInputImmediate(p, 0);
+            s_slot[p].lastWritten.store(0, std::memory_order_relaxed);
+            // Next loop will assert the non-zero
+        }
+
+        if (curDesired != 0) {
+            // Maintain hold; ensure the mask is reasserted periodically since the game may clear per frame
+            if (last != 0 && last != curDesired) {
+                WritePlayerInputImmediate(p, 0);
+            }
+            WritePlayerInputImmediate(p, curDesired);
+            s_slot[p].lastWritten.store(curDesired, std::memory_order_relaxed);
+        } else {
+            if (last != 0) {
+                WritePlayerInputImmediate(p, 0);
+                s_slot[p].lastWritten.store(0, std::memory_order_relaxed);
             }
         }
     }
+}
 
-    // On exit, ensure neutral
+// Runs after the periodic task is cancelled, on the same worker, so it cannot race a last Tick
+static void ReleaseAll() {
     for (int p = 1; p <= 2; ++p) {
         WritePlayerInputImmediate(p, 0);
         s_slot[p].lastWritten.store(0, std::memory_order_relaxed);
@@ -133,20 +122,20 @@ static void Worker() {
 void Start() {
     bool expected = false;
     if (!s_running.compare_exchange_strong(expected, true)) return;
-    s_stop.store(false);
     for (int p = 1; p <= 2; ++p) {
         s_slot[p].desired.store(0);
         s_slot[p].ticks.store(0);
         s_slot[p].lastWritten.store(0);
         s_slot[p].needNeutralEdge.store(false);
     }
-    s_thread = std::thread([]{ Worker(); });
-    s_thread.detach();
+    s_task.store(TaskScheduler::SchedulePeriodic("ImmediateInput", 1000000 / 64, []{ Tick(); })); // ~15.625ms
 }
 
 void Stop() {
     if (!s_running.exchange(false)) return;
-    s_stop.store(true);
+    TaskScheduler::Cancel(s_task.exchange(TaskScheduler::kInvalidTask));
+    // On stop, ensure neutral
+    TaskScheduler::ScheduleOnce("ImmediateInput.release", 0, []{ ReleaseAll(); });
 }
 
 bool IsRunning() { return s_running.load(); }
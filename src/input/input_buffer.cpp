@@ -1,4 +1,5 @@
 #include "../include/input/input_buffer.h"
+#include "../include/input/input_buffer_model.h"
 #include "../include/input/input_core.h"
 #include "../include/core/constants.h"
 #include "../include/core/memory.h"
@@ -12,6 +13,8 @@
 #include "../include/input/input_motion.h"  
 #include "../include/game/game_state.h"  
 #include "../include/input/input_freeze.h"
+#include "../include/core/task_scheduler.h"
+#include "../include/core/fast_log.h"
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -21,15 +24,14 @@
 // Define the buffer constants here
 // IMPORTANT: The actual input buffer is 180 bytes long. Using 0x180 (384)
 // would overwrite into other fields (including the index at 0x260), causing anomalies.
-const uint16_t INPUT_BUFFER_SIZE = 180;    // 180 bytes circular buffer (0xB4)
-const uintptr_t INPUT_BUFFER_OFFSET = 0x1AB;  // Buffer start offset in player struct
-const uintptr_t INPUT_BUFFER_INDEX_OFFSET = 0x260;  // Current buffer index offset
+// Values come from the portable model (input_buffer_model.h) shared with the offline macro verifier.
+const uint16_t INPUT_BUFFER_SIZE = InputBufferModel::kRingSize;             // 180 bytes circular buffer (0xB4)
+const uintptr_t INPUT_BUFFER_OFFSET = InputBufferModel::kRingOffset;        // Buffer start offset in player struct
+const uintptr_t INPUT_BUFFER_INDEX_OFFSET = InputBufferModel::kIndexOffset; // Current buffer index offset
 
 // Define the freeze buffer variables here
 std::atomic<bool> g_bufferFreezingActive(false);
 std::atomic<bool> g_indexFreezingActive(false);
-std::atomic<bool> g_freezeThreadInitialized(false);  // Thread startup confirmation
-std::thread g_bufferFreezeThread;
 std::vector<uint8_t> g_frozenBufferValues;
 uint16_t g_frozenBufferStartIndex = 0;
 uint16_t g_frozenBufferLength = 0;
@@ -271,11 +273,145 @@ static bool RegeneratePatternForFacing(int playerNum, int motionType, int button
     return false;
 }
 
-// Define buffer functions
-void FreezeBufferValuesThread(int playerNum) {
+// ---------------------------------------------------------------------------
+// Hook-synchronous freeze
+//
+// A freeze session is armed by the Freeze* helpers (pattern image + optional index lock in the
+// g_frozen* globals) and then applied by HookedProcessCharacterInput, immediately before the
+// engine's own ProcessCharacterInput reads the owner's ring. Every engine input tick therefore sees
+// exactly the frozen image, and nothing runs between ticks. Each tick reads the 180-byte ring once
+// and rewrites only the runs that differ from the image, so a settled freeze costs one read.
+// ---------------------------------------------------------------------------
+namespace {
+    struct FreezeTickState {
+        uintptr_t playerPtr = 0;        // owner's character struct at arm time
+        short     lastMoveID = -1;
+        uint8_t   lastMotionToken = 0;
+        bool      moveIDChanged = false;
+        int       consecutiveMoveTicks = 0;
+        int       ticks = 0;
+        uint32_t  bytesWritten = 0;
+    };
+    // Written by ArmBufferFreeze before g_bufferFreezingActive is set; owned by the hook afterwards
+    FreezeTickState g_freezeTick;
+
+    // Hook ticks currently inside ApplyBufferFreezeTick; StopBufferFreezing waits for zero
+    std::atomic<int> g_freezeTicksInFlight{0};
+    std::atomic<uint32_t> g_freezeGeneration{0};
+
+    // Engine input ticks (192 Hz) before a session gives up (~1.2 s of match time)
+    constexpr int kFreezeTickLimit = 230;
+    // Wall-clock backstop for sessions whose hook stops being called (pause, leaving the match)
+    constexpr uint32_t kFreezeWatchdogUs = 2000000;
+    constexpr size_t kRingBytes = InputBufferModel::kRingSize;
+
+    struct FreezeTickGuard {
+        FreezeTickGuard()  { g_freezeTicksInFlight.fetch_add(1); }
+        ~FreezeTickGuard() { g_freezeTicksInFlight.fetch_sub(1); }
+    };
+}
+
+// Write the frozen image into the ring, touching only bytes that differ. Returns bytes written.
+static uint32_t WriteFrozenImageDiff(uintptr_t playerPtr) {
+    if (g_frozenBufferLength == 0 || g_frozenBufferValues.size() < g_frozenBufferLength) return 0;
+
+    uint8_t ring[kRingBytes];
+    const uint16_t ringSize = static_cast<uint16_t>(std::min<size_t>(INPUT_BUFFER_SIZE, kRingBytes));
+    const uint16_t start = static_cast<uint16_t>(g_frozenBufferStartIndex % ringSize);
+    const uint16_t len = std::min<uint16_t>(g_frozenBufferLength, ringSize);
+    const uint8_t* image = g_frozenBufferValues.data();
+
+    if (!SafeReadMemory(playerPtr + INPUT_BUFFER_OFFSET, ring, ringSize)) {
+        // Unreadable ring: fall back to writing the whole image (two segments around the wrap)
+        uint16_t len1 = std::min<uint16_t>(len, ringSize - start);
+        SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + start, image, len1);
+        if (len > len1) SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET, image + len1, len - len1);
+        return len;
+    }
+
+    uint32_t written = 0;
+    uint16_t i = 0;
+    while (i < len) {
+        uint16_t pos = (start + i) % ringSize;
+        if (ring[pos] == image[i]) { ++i; continue; }
+        // Extend the differing run without crossing the wrap point
+        uint16_t runStart = i;
+        while (i < len && ring[(start + i) % ringSize] != image[i] &&
+               (i == runStart || (start + i) % ringSize != 0)) {
+            ++i;
+        }
+        SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + pos, image + runStart, i - runStart);
+        written += i - runStart;
+    }
+    return written;
+}
+
+// Neutralize the frozen pattern region plus a few entries behind the index so nothing replays
+static void NeutralizeFrozenRegion(uintptr_t playerPtr) {
+    if (!playerPtr) return;
+    if (g_frozenBufferLength > 0) {
+        uint8_t zeros[kRingBytes] = {};
+        uint16_t start = g_frozenBufferStartIndex;
+        uint16_t len = std::min<uint16_t>(g_frozenBufferLength, INPUT_BUFFER_SIZE);
+        uint16_t len1 = std::min<uint16_t>(len, INPUT_BUFFER_SIZE - start);
+        uint16_t len2 = len - len1;
+        if (len1 > 0) SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + start, zeros, len1);
+        if (len2 > 0) SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET, zeros, len2);
+    }
+    uint16_t curIdx = 0;
+    SafeReadMemory(playerPtr + INPUT_BUFFER_INDEX_OFFSET, &curIdx, sizeof(uint16_t));
+    for (int n = 0; n < 4; ++n) {
+        uint16_t w = (curIdx + INPUT_BUFFER_SIZE - n) % INPUT_BUFFER_SIZE;
+        uint8_t z = 0x00;
+        SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + w, &z, sizeof(uint8_t));
+    }
+}
+
+static void EndFreezeFromHook(int playerNum, const char* reason) {
+    NeutralizeFrozenRegion(g_freezeTick.playerPtr);
+    g_bufferFreezingActive = false;
+    g_indexFreezingActive = false;
+    g_activeFreezePlayer.store(0);
+    EFZ_LOG(LogCat::BufferFreeze, detailedLogging.load(),
+            "[BUFFER_FREEZE] End session P%d (%s) ticks=%d bytesWritten=%u",
+            playerNum, reason, g_freezeTick.ticks, g_freezeTick.bytesWritten);
+}
+
+void ArmBufferFreeze(int playerNum) {
+    uintptr_t playerPtr = GetPlayerPointer(playerNum);
+    if (!playerPtr) {
+        LogOut("[INPUT_BUFFER] Invalid player pointer, buffer freeze not armed", true);
+        g_bufferFreezingActive = false;
+        g_activeFreezePlayer.store(0);
+        return;
+    }
+
+    // One-time sanity check: ensure buffer does not overlap index
+    static std::atomic<bool> s_layoutChecked{false};
+    if (!s_layoutChecked.exchange(true)) {
+        uintptr_t bufStart = playerPtr + INPUT_BUFFER_OFFSET;
+        uintptr_t bufEnd   = bufStart + INPUT_BUFFER_SIZE - 1;
+        uintptr_t idxAddr  = playerPtr + INPUT_BUFFER_INDEX_OFFSET;
+        if (detailedLogging.load()) {
+            std::stringstream ss;
+            ss << "[INPUT_BUFFER] Layout: start=0x" << std::hex << bufStart
+               << " end=0x" << bufEnd << " index=0x" << idxAddr
+               << std::dec;
+            LogOut(ss.str(), true);
+        }
+        if (bufEnd >= idxAddr && idxAddr >= bufStart) {
+            LogOut("[INPUT_BUFFER][WARN] Buffer region overlaps index! Adjust sizes/offsets.", true);
+        }
+    }
+
+    g_freezeTick = FreezeTickState{};
+    g_freezeTick.playerPtr = playerPtr;
+    SafeReadMemory(playerPtr + MOVE_ID_OFFSET, &g_freezeTick.lastMoveID, sizeof(short));
+    SafeReadMemory(playerPtr + MOTION_TOKEN_OFFSET, &g_freezeTick.lastMotionToken, sizeof(uint8_t));
+
     if (detailedLogging.load()) {
         std::stringstream ss;
-        ss << "[INPUT_BUFFER] Starting buffer freeze thread for P" << playerNum
+        ss << "[INPUT_BUFFER] Arming hook buffer freeze for P" << playerNum
            << " startIdx=" << g_frozenBufferStartIndex
            << " len=" << g_frozenBufferLength
            << " idxLock=" << (g_indexFreezingActive.load() ? std::to_string(g_frozenIndexValue) : std::string("off"))
@@ -284,307 +420,87 @@ void FreezeBufferValuesThread(int playerNum) {
            << " facing=" << (g_lastKnownFacing ? "right" : "left");
         LogOut(ss.str(), true);
     }
+
+    uint32_t generation = g_freezeGeneration.fetch_add(1) + 1;
     g_activeFreezePlayer.store(playerNum);
-    
-    uintptr_t initialPlayerPtr = GetPlayerPointer(playerNum);
-    if (!initialPlayerPtr) {
-        LogOut("[INPUT_BUFFER] Invalid player pointer at thread start, aborting", true);
-        g_bufferFreezingActive = false;
-        return;
-    }
-    
-    // One-time sanity check: ensure buffer does not overlap index
-    static std::atomic<bool> s_layoutChecked{false};
-    if (!s_layoutChecked.load()) {
-        uintptr_t testPlayer = initialPlayerPtr;
-        if (testPlayer) {
-            uintptr_t bufStart = testPlayer + INPUT_BUFFER_OFFSET;
-            uintptr_t bufEnd   = bufStart + INPUT_BUFFER_SIZE - 1;
-            uintptr_t idxAddr  = testPlayer + INPUT_BUFFER_INDEX_OFFSET;
-            if (detailedLogging.load()) {
-                std::stringstream ss;
-                ss << "[INPUT_BUFFER] Layout: start=0x" << std::hex << bufStart
-                   << " end=0x" << bufEnd << " index=0x" << idxAddr
-                   << std::dec;
-                LogOut(ss.str(), true);
-            }
-            if (bufEnd >= idxAddr && idxAddr >= bufStart) {
-                LogOut("[INPUT_BUFFER][WARN] Buffer region overlaps index! Adjust sizes/offsets.", true);
-            }
-        }
-        s_layoutChecked.store(true);
-    }
+    g_bufferFreezingActive = true;   // publishes g_freezeTick and the frozen image to the hook
 
-    // Get the move ID address for monitoring move execution
-    uintptr_t base = GetEFZBase();
-    uintptr_t moveIDAddr = ResolvePointer(base, 
-        (playerNum == 1) ? EFZ_BASE_OFFSET_P1 : EFZ_BASE_OFFSET_P2, 
-        MOVE_ID_OFFSET);
-    
-    // Also monitor motion token to detect successful motion queuing
-    uintptr_t motionTokenAddr = initialPlayerPtr + MOTION_TOKEN_OFFSET;
-    
-    short lastMoveID = -1;
-    uint8_t lastMotionToken = 0;
-    bool moveIDChanged = false;
-    bool motionTokenChanged = false;
-    int consecutiveMoveTicks = 0;
-    const int freezeLimit = 300; // Hard limit on freeze frames
-    
-    // Get initial move ID and motion token for comparison
-    SafeReadMemory(moveIDAddr, &lastMoveID, sizeof(short));
-    SafeReadMemory(motionTokenAddr, &lastMotionToken, sizeof(uint8_t));
-    
-    // Signal that thread has fully initialized
-    g_freezeThreadInitialized.store(true);
-    
-    // AGGRESSIVE PHASE: Write very frequently at the start
-    const int aggressivePhaseFrames = 15;
-    for (int i = 0; i < aggressivePhaseFrames && g_bufferFreezingActive; i++) {
-        if (g_onlineModeActive.load()) { g_bufferFreezingActive = false; break; }
-        // Check player pointer validity
-        uintptr_t playerPtr = GetPlayerPointer(playerNum);
-        if (!playerPtr || playerPtr != initialPlayerPtr) {
-            LogOut("[INPUT_BUFFER] Player pointer changed during aggressive phase, aborting", true);
-            g_bufferFreezingActive = false;
-            break;
-        }
-        
-        // Check for facing direction changes (cross-up detection)
-        if (g_frozenMotionType >= 0) {
-            bool currentFacing = GetPlayerFacingDirection(playerNum);
-            if (currentFacing != g_lastKnownFacing) {
-                if (detailedLogging.load()) {
-                    LogOut("[BUFFER_FREEZE][CROSSUP] Facing direction changed: " +
-                          std::string(g_lastKnownFacing ? "right" : "left") + " → " +
-                          std::string(currentFacing ? "right" : "left") + " during freeze!", true);
-                }
-                g_lastKnownFacing = currentFacing;
-                // Regenerate pattern with new facing direction
-                RegeneratePatternForFacing(playerNum, g_frozenMotionType, g_frozenButtonMask, currentFacing);
-            }
-        }
-        
-        // Write buffer values very frequently (every iteration)
-        // Optimize: two contiguous writes instead of per-byte writes across ring
-        if (g_frozenBufferLength > 0) {
-            uint16_t start = g_frozenBufferStartIndex;
-            uint16_t len1 = (uint16_t)std::min<uint16_t>(g_frozenBufferLength, INPUT_BUFFER_SIZE - start);
-            uint16_t len2 = g_frozenBufferLength - len1;
-            // First contiguous segment
-            if (len1 > 0) {
-                SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + start,
-                                g_frozenBufferValues.data(), len1 * sizeof(uint8_t));
-            }
-            // Wrapped segment at buffer start
-            if (len2 > 0) {
-                SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET,
-                                g_frozenBufferValues.data() + len1, len2 * sizeof(uint8_t));
-            }
-        }
-        
-        // Ensure index stays frozen
-        if (g_indexFreezingActive) {
-            // Avoid redundant writes if index is already at desired value
-            uint16_t curIdx = 0xFFFF;
-            if (!SafeReadMemory(playerPtr + INPUT_BUFFER_INDEX_OFFSET, &curIdx, sizeof(uint16_t)) || curIdx != g_frozenIndexValue) {
-                SafeWriteMemory(playerPtr + INPUT_BUFFER_INDEX_OFFSET,
-                                &g_frozenIndexValue, sizeof(uint16_t));
-            }
-        }
-        
-        // Check for move ID changes
-        short currentMoveID = 0;
-        if (SafeReadMemory(moveIDAddr, &currentMoveID, sizeof(short))) {
-            if (currentMoveID != lastMoveID) {
-                if (detailedLogging.load()) {
-                    LogOut("[BUFFER_FREEZE] MoveID changed: " + std::to_string(lastMoveID) + 
-                          " → " + std::to_string(currentMoveID), true);
-                }
-                lastMoveID = currentMoveID;
-                moveIDChanged = true;
-            }
+    TaskScheduler::ScheduleOnce("BufferFreeze.watchdog", kFreezeWatchdogUs, [generation]() {
+        if (g_freezeGeneration.load() == generation && g_bufferFreezingActive.load()) {
+            LogOut("[BUFFER_FREEZE] Watchdog: no input ticks consumed the freeze, stopping", detailedLogging.load());
+            StopBufferFreezing();
         }
-        
-        // Check for motion token changes (indicates motion was queued)
-        uint8_t currentMotionToken = 0;
-        if (SafeReadMemory(motionTokenAddr, &currentMotionToken, sizeof(uint8_t))) {
-            if (currentMotionToken != lastMotionToken && currentMotionToken != 0 && currentMotionToken != 0x63) {
-                if (detailedLogging.load()) {
-                    std::stringstream ss;
-                    ss << "[BUFFER_FREEZE] Motion token changed: 0x" 
-                       << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(lastMotionToken)
-                       << " → 0x" << std::setw(2) << std::setfill('0') << static_cast<int>(currentMotionToken)
-                       << " (motion queued, waiting for execution)";
-                    LogOut(ss.str(), true);
-                }
-                motionTokenChanged = true;
-                // Don't break yet - wait for moveID to change confirming execution
-            }
-            lastMotionToken = currentMotionToken;
-        }
-        
-        // Very short sleep for aggressive phase
-        std::this_thread::sleep_for(std::chrono::milliseconds(2));
-    }
-    
-    // NORMAL PHASE: Continue with standard frequency
-    int freezeCount = aggressivePhaseFrames;
-    while (g_bufferFreezingActive && freezeCount < freezeLimit && !g_isShuttingDown.load()) {
-        if (g_onlineModeActive.load()) { LogOut("[INPUT_BUFFER] Online mode active, stopping buffer freeze", true); break; }
-        // Check game state and player pointer validity
-        GamePhase currentPhase = GetCurrentGamePhase();
-        if (currentPhase != GamePhase::Match) {
-            LogOut("[INPUT_BUFFER] Game phase changed, stopping buffer freeze", true);
-            break;
-        }
-        
-        uintptr_t currentPlayerPtr = GetPlayerPointer(playerNum);
-        if (!currentPlayerPtr || currentPlayerPtr != initialPlayerPtr) {
-            LogOut("[INPUT_BUFFER] Player pointer changed, stopping buffer freeze", true);
-            break;
-        }
-        
-        // Check for facing direction changes (cross-up detection)
-        if (g_frozenMotionType >= 0 && freezeCount % 3 == 0) {
-            bool currentFacing = GetPlayerFacingDirection(playerNum);
-            if (currentFacing != g_lastKnownFacing) {
-                if (detailedLogging.load()) {
-                    LogOut("[BUFFER_FREEZE][CROSSUP] Facing direction changed: " +
-                          std::string(g_lastKnownFacing ? "right" : "left") + " → " +
-                          std::string(currentFacing ? "right" : "left") + " during freeze!", true);
-                }
-                g_lastKnownFacing = currentFacing;
-                // Regenerate pattern with new facing direction
-                RegeneratePatternForFacing(playerNum, g_frozenMotionType, g_frozenButtonMask, currentFacing);
-            }
-        }
-        
-        // Rewrite buffer values every 3rd frame
-        if (freezeCount % 3 == 0) {
-            if (g_frozenBufferLength > 0) {
-                uint16_t start = g_frozenBufferStartIndex;
-                uint16_t len1 = (uint16_t)std::min<uint16_t>(g_frozenBufferLength, INPUT_BUFFER_SIZE - start);
-                uint16_t len2 = g_frozenBufferLength - len1;
-                if (len1 > 0) {
-                    SafeWriteMemory(currentPlayerPtr + INPUT_BUFFER_OFFSET + start,
-                                    g_frozenBufferValues.data(), len1 * sizeof(uint8_t));
-                }
-                if (len2 > 0) {
-                    SafeWriteMemory(currentPlayerPtr + INPUT_BUFFER_OFFSET,
-                                    g_frozenBufferValues.data() + len1, len2 * sizeof(uint8_t));
-                }
-            }
-        }
-        
-        // Always keep index frozen
-        if (g_indexFreezingActive) {
-            uint16_t curIdx = 0xFFFF;
-            if (!SafeReadMemory(currentPlayerPtr + INPUT_BUFFER_INDEX_OFFSET, &curIdx, sizeof(uint16_t)) || curIdx != g_frozenIndexValue) {
-                SafeWriteMemory(currentPlayerPtr + INPUT_BUFFER_INDEX_OFFSET,
-                                &g_frozenIndexValue, sizeof(uint16_t));
-            }
-        }
-        
-        // Check for move ID changes
-        short currentMoveID = 0;
-        if (SafeReadMemory(moveIDAddr, &currentMoveID, sizeof(short))) {
-            if (currentMoveID != lastMoveID) {
-                if (detailedLogging.load()) {
-                    LogOut("[BUFFER_FREEZE] MoveID changed: " + std::to_string(lastMoveID) + 
-                          " → " + std::to_string(currentMoveID), true);
-                }
-                lastMoveID = currentMoveID;
-                moveIDChanged = true;
-            }
-            
-            // Detect successful special move execution (non-zero moveID for multiple ticks)
-            if (currentMoveID != 0 && moveIDChanged) {
-                consecutiveMoveTicks++;
-                if (consecutiveMoveTicks >= 3) {
-                    if (detailedLogging.load()) {
-                        LogOut("[BUFFER_FREEZE] Motion recognized! Move ID: " + 
-                              std::to_string(currentMoveID), true);
-                    }
-                    break; // Exit early on successful execution
-                }
-            } else {
-                consecutiveMoveTicks = 0;
-            }
-        }
-        
-        // Check for motion token changes (indicates motion was queued)
-        uint8_t currentMotionToken = 0;
-        if (SafeReadMemory(motionTokenAddr, &currentMotionToken, sizeof(uint8_t))) {
-            if (currentMotionToken != lastMotionToken && currentMotionToken != 0 && currentMotionToken != 0x63) {
-                if (detailedLogging.load()) {
-                    std::stringstream ss;
-                    ss << "[BUFFER_FREEZE] Motion token changed: 0x" 
-                       << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(lastMotionToken)
-                       << " → 0x" << std::setw(2) << std::setfill('0') << static_cast<int>(currentMotionToken)
-                       << " (motion queued, waiting for execution)";
-                    LogOut(ss.str(), true);
-                }
-                motionTokenChanged = true;
-                // Don't break yet - wait for moveID to change confirming execution
+    });
+}
+
+void ApplyBufferFreezeTick(int playerNum, uintptr_t characterPtr) {
+    FreezeTickGuard guard;
+    if (!g_bufferFreezingActive.load() || g_activeFreezePlayer.load() != playerNum) return;
+
+    if (g_onlineModeActive.load()) { EndFreezeFromHook(playerNum, "online mode"); return; }
+    if (characterPtr != g_freezeTick.playerPtr) { EndFreezeFromHook(playerNum, "player pointer changed"); return; }
+    if (GetCurrentGamePhase() != GamePhase::Match) { EndFreezeFromHook(playerNum, "game phase changed"); return; }
+
+    // Watch the previous tick's outcome: exit once the engine has committed to a new move
+    short currentMoveID = 0;
+    if (SafeReadMemory(characterPtr + MOVE_ID_OFFSET, &currentMoveID, sizeof(short))) {
+        if (currentMoveID != g_freezeTick.lastMoveID) {
+            EFZ_LOG(LogCat::BufferFreeze, detailedLogging.load(), "[BUFFER_FREEZE] MoveID changed: %d -> %d",
+                    (int)g_freezeTick.lastMoveID, (int)currentMoveID);
+            g_freezeTick.lastMoveID = currentMoveID;
+            g_freezeTick.moveIDChanged = true;
+        }
+        if (currentMoveID != 0 && g_freezeTick.moveIDChanged) {
+            if (++g_freezeTick.consecutiveMoveTicks >= 3) {
+                EFZ_LOG(LogCat::BufferFreeze, detailedLogging.load(), "[BUFFER_FREEZE] Motion recognized! Move ID: %d",
+                        (int)currentMoveID);
+                EndFreezeFromHook(playerNum, "motion recognized");
+                return;
             }
-            lastMotionToken = currentMotionToken;
+        } else {
+            g_freezeTick.consecutiveMoveTicks = 0;
         }
-        
-        freezeCount++;
-        // Standard sleep time
-        std::this_thread::sleep_for(std::chrono::milliseconds(4));
     }
-    
-    // Cleanup phase - DO NOT forcibly wipe entire buffer here; just neutralize trailing inputs
-    if (detailedLogging.load()) {
-        LogOut("[BUFFER_FREEZE] Buffer freeze thread ended (counter=" + std::to_string(freezeCount) + ")", true);
+    uint8_t currentMotionToken = 0;
+    if (SafeReadMemory(characterPtr + MOTION_TOKEN_OFFSET, &currentMotionToken, sizeof(uint8_t))) {
+        if (currentMotionToken != g_freezeTick.lastMotionToken && currentMotionToken != 0 && currentMotionToken != 0x63) {
+            EFZ_LOG(LogCat::BufferFreeze, detailedLogging.load(),
+                    "[BUFFER_FREEZE] Motion token changed: 0x%02X -> 0x%02X (motion queued, waiting for execution)",
+                    g_freezeTick.lastMotionToken, currentMotionToken);
+        }
+        g_freezeTick.lastMotionToken = currentMotionToken;
     }
-    
-    // Reset initialization flag so next freeze will wait for thread startup
-    g_freezeThreadInitialized.store(false);
-    
-    if (g_frozenBufferLength > 0) {
-        uintptr_t playerPtr = GetPlayerPointer(playerNum);
-        if (playerPtr) {
-            // Overwrite pattern region with neutral to avoid ghost follow‑ups
-            if (g_frozenBufferLength > 0) {
-                uint16_t start = g_frozenBufferStartIndex;
-                uint16_t len1 = (uint16_t)std::min<uint16_t>(g_frozenBufferLength, INPUT_BUFFER_SIZE - start);
-                uint16_t len2 = g_frozenBufferLength - len1;
-                // Prepare temporary zero buffers (stack-allocated, small)
-                std::vector<uint8_t> zeros1(len1, 0x00);
-                std::vector<uint8_t> zeros2(len2, 0x00);
-                if (len1 > 0) {
-                    SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + start, zeros1.data(), len1 * sizeof(uint8_t));
-                }
-                if (len2 > 0) {
-                    SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET, zeros2.data(), len2 * sizeof(uint8_t));
-                }
-            }
-            // Push a few neutral frames at index tail
-            uint16_t curIdx = 0;
-            SafeReadMemory(playerPtr + INPUT_BUFFER_INDEX_OFFSET, &curIdx, sizeof(uint16_t));
-            for (int n=0; n<4; ++n) {
-                uint16_t w = (curIdx + INPUT_BUFFER_SIZE - n) % INPUT_BUFFER_SIZE;
-                uint8_t z = 0x00;
-                SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + w, &z, sizeof(uint8_t));
+
+    if (g_freezeTick.ticks >= kFreezeTickLimit) { EndFreezeFromHook(playerNum, "tick limit"); return; }
+    g_freezeTick.ticks++;
+
+    // Cross-up: regenerate the image for the new facing before it is applied
+    if (g_frozenMotionType >= 0) {
+        bool currentFacing = GetPlayerFacingDirection(playerNum);
+        if (currentFacing != g_lastKnownFacing) {
+            if (detailedLogging.load()) {
+                LogOut("[BUFFER_FREEZE][CROSSUP] Facing direction changed: " +
+                      std::string(g_lastKnownFacing ? "right" : "left") + " → " +
+                      std::string(currentFacing ? "right" : "left") + " during freeze!", true);
             }
+            g_lastKnownFacing = currentFacing;
+            RegeneratePatternForFacing(playerNum, g_frozenMotionType, g_frozenButtonMask, currentFacing);
         }
     }
-    
-    g_bufferFreezingActive = false;
-    g_indexFreezingActive = false;
-    g_activeFreezePlayer.store(0);
-    
-    if (detailedLogging.load()) {
-        LogOut("[BUFFER_FREEZE] End session P" + std::to_string(playerNum) + " (thread ended)", true);
+
+    g_freezeTick.bytesWritten += WriteFrozenImageDiff(characterPtr);
+
+    if (g_indexFreezingActive) {
+        uint16_t curIdx = 0xFFFF;
+        if (!SafeReadMemory(characterPtr + INPUT_BUFFER_INDEX_OFFSET, &curIdx, sizeof(uint16_t)) || curIdx != g_frozenIndexValue) {
+            SafeWriteMemory(characterPtr + INPUT_BUFFER_INDEX_OFFSET, &g_frozenIndexValue, sizeof(uint16_t));
+        }
     }
 }
 
 // Capture current buffer section and begin freezing it
 bool CaptureAndFreezeBuffer(int playerNum, uint16_t startIndex, uint16_t length, int motionType, int buttonMask) {
-    // Stop any existing freeze thread
+    // Stop any existing freeze session
     StopBufferFreezing();
     
     // Store motion info for potential pattern regeneration
@@ -640,36 +556,8 @@ bool CaptureAndFreezeBuffer(int playerNum, uint16_t startIndex, uint16_t length,
         LogOut(ss.str(), true);
     }
     
-    // Start freezing
-    g_freezeThreadInitialized.store(false);  // Reset before creating thread
-    g_bufferFreezingActive = true;
-    g_activeFreezePlayer.store(playerNum);
-    g_bufferFreezeThread = std::thread(FreezeBufferValuesThread, playerNum);
-    g_bufferFreezeThread.detach();  // Detach to prevent termination
-    
-    // CRITICAL: Wait for thread to fully initialize before returning.
-    // This prevents race condition where auto_action's ProcessAutoControlRestore
-    // checks g_bufferFreezingActive before the thread has even started its loop.
-    // Max wait 10ms (should take <1ms normally).
-    auto startWait = std::chrono::steady_clock::now();
-    int waitIterations = 0;
-    while (!g_freezeThreadInitialized.load()) {
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - startWait).count();
-        if (elapsed > 10) {
-            LogOut("[INPUT_BUFFER][WARN] Thread startup timeout after " + std::to_string(elapsed) + 
-                  "ms (waited " + std::to_string(waitIterations) + " iterations), active=" + 
-                  std::to_string(g_bufferFreezingActive.load()), true);
-            break;
-        }
-        waitIterations++;
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
-    }
-    
-    if (detailedLogging.load() && waitIterations > 0) {
-        LogOut("[INPUT_BUFFER] Thread initialization confirmed after " + std::to_string(waitIterations) + 
-              " wait iterations", true);
-    }
+    // Start freezing; applied from the next input tick of this player
+    ArmBufferFreeze(playerNum);
     
     LogOut("[INPUT_BUFFER] Buffer freezing activated for P" + std::to_string(playerNum) + 
            " starting at index " + std::to_string(startIndex) +
@@ -707,14 +595,20 @@ void StopBufferFreezing() {
             LogOut("[INPUT_BUFFER] StopBufferFreezing() called (no active owner)", true);
         }
         
-    // Wait briefly for thread to wind down (keep minimal to avoid frame hitch)
+    // Let an input tick that already entered ApplyBufferFreezeTick finish (microseconds, bounded)
     auto tWaitStart = clock::now();
-    std::this_thread::sleep_for(std::chrono::milliseconds(8));
+    while (g_freezeTicksInFlight.load() != 0 &&
+           clock::now() - tWaitStart < std::chrono::milliseconds(5)) {
+        std::this_thread::yield();
+    }
     auto tWaitEnd = clock::now();
         
         // IMPORTANT: Write neutral inputs to the last few buffer entries
         // to prevent lingering input patterns from triggering moves
         auto tCleanStart = clock::now();
+        if (owner != 0) {
+            NeutralizeFrozenRegion(GetPlayerPointer(owner));
+        }
         uintptr_t base = GetEFZBase();
         if (base) {
             for (int player = 1; player <= 2; player++) {
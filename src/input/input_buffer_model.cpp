@@ -0,0 +1,35 @@
+#include "../include/input/input_buffer_model.h"
+#include <cstring>
+
+namespace InputBufferModel {
+
+void Ring::Reset(uint16_t index) {
+    memset(m_ring, 0, sizeof(m_ring));
+    m_index = static_cast<uint16_t>(index % kRingSize);
+}
+
+void Ring::Load(const uint8_t* ring, uint16_t index) {
+    memcpy(m_ring, ring, sizeof(m_ring));
+    m_index = static_cast<uint16_t>(index % kRingSize);
+}
+
+void Ring::Push(uint8_t mask) {
+    m_ring[m_index] = mask;
+    m_index = static_cast<uint16_t>((m_index + 1) % kRingSize);
+}
+
+uint8_t Ring::Latest() const {
+    return m_ring[(m_index + kRingSize - 1) % kRingSize];
+}
+
+size_t Ring::CollectSince(uint16_t prevIndex, std::vector<uint8_t>& out) const {
+    size_t n = 0;
+    for (uint16_t cur = static_cast<uint16_t>(prevIndex % kRingSize); cur != m_index;
+         cur = static_cast<uint16_t>((cur + 1) % kRingSize)) {
+        out.push_back(m_ring[cur]);
+        ++n;
+    }
+    return n;
+}
+
+} // namespace InputBufferModel
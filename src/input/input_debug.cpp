@@ -106,42 +106,6 @@ void DumpInputBuffer(int playerNum) {
     LogOut(bufferLog.str(), true);
 }
 
-// Visualize the input buffer for display
-std::string GetInputBufferVisualization(int playerNum, int window) {
-    uintptr_t playerPtr = GetPlayerPointer(playerNum);
-    if (!playerPtr) {
-        return "Error: Player pointer not found";
-    }
-    
-    // Read current buffer index
-    uint16_t currentIndex = 0;
-    if (!SafeReadMemory(playerPtr + INPUT_BUFFER_INDEX_OFFSET, &currentIndex, sizeof(uint16_t))) {
-        return "Error: Failed to read buffer index";
-    }
-    
-    std::ostringstream visualization;
-    visualization << "Buffer[" << currentIndex << "]: ";
-    
-    // Show recent buffer entries
-    for (int i = 0; i < window; i++) {
-        uint16_t readIdx = (currentIndex - window + i + INPUT_BUFFER_SIZE) % INPUT_BUFFER_SIZE;
-        uint8_t inputMask = 0;
-        SafeReadMemory(playerPtr + INPUT_BUFFER_OFFSET + readIdx, &inputMask, sizeof(uint8_t));
-        
-        // Format the output
-        if (i > 0) visualization << " ";
-        
-        // Highlight the current position
-        if (i == window - 1) {
-            visualization << "[" << DecodeInputMask(inputMask) << "]";
-        } else {
-            visualization << DecodeInputMask(inputMask);
-        }
-    }
-    
-    return visualization.str();
-}
-
 // Log the next value that will be written to the buffer
 void LogNextBufferValue(int playerNum) {
     uintptr_t playerPtr = GetPlayerPointer(playerNum);
@@ -11,13 +11,13 @@
 #include "../include/input/input_motion.h" 
 #include "../include/game/frame_monitor.h"
 // These functions are implemented in input_buffer.cpp
-extern void FreezeBufferValuesThread(int playerNum);
+extern void ArmBufferFreeze(int playerNum);
 extern bool CaptureAndFreezeBuffer(int playerNum, uint16_t startIndex, uint16_t length, int motionType, int buttonMask);
 extern bool FreezeBufferIndex(int playerNum, uint16_t indexValue);
 extern void StopBufferFreezing(void);
 // Helper to freeze the perfect Dragon Punch motion
 bool FreezePerfectDragonPunch(int playerNum) {
-    // Stop any existing freeze thread
+    // Stop any existing freeze session
     StopBufferFreezing();
     
     if (detailedLogging.load()) {
@@ -56,10 +56,8 @@ bool FreezePerfectDragonPunch(int playerNum) {
     g_frozenIndexValue = (g_frozenBufferStartIndex + 20) % INPUT_BUFFER_SIZE;
     g_indexFreezingActive = true;
     
-    // Start freezing thread
-    g_bufferFreezingActive = true;
-    g_bufferFreezeThread = std::thread(FreezeBufferValuesThread, playerNum);
-    g_bufferFreezeThread.detach();  // Detach to prevent termination
+    // Applied from the next input tick of this player
+    ArmBufferFreeze(playerNum);
     
     if (detailedLogging.load()) {
         LogOut("[BUFFER_FREEZE] Perfect Dragon Punch motion freezing activated at index " + 
@@ -70,7 +68,7 @@ bool FreezePerfectDragonPunch(int playerNum) {
 
 // Enhanced version with diagnostic dump and adjusted index placement
 bool FreezePerfectDragonPunchEnhanced(int playerNum) {
-    // Stop any existing freeze thread
+    // Stop any existing freeze session
     StopBufferFreezing();
     
     if (detailedLogging.load()) {
@@ -131,13 +129,8 @@ bool FreezePerfectDragonPunchEnhanced(int playerNum) {
         LogOut(ss.str(), true);
     }
     
-    // Start freezing thread
-    g_bufferFreezingActive = true;
-    g_bufferFreezeThread = std::thread([playerNum]() {
-    if (detailedLogging.load()) { LogOut("[BUFFER_DEBUG] Enhanced freeze thread starting", true); }
-        FreezeBufferValuesThread(playerNum);
-    });
-    g_bufferFreezeThread.detach();  // Detach to prevent termination
+    // Applied from the next input tick of this player
+    ArmBufferFreeze(playerNum);
     
     if (detailedLogging.load()) {
         LogOut("[BUFFER_DEBUG] Enhanced DP buffer freeze activated for P" + 
@@ -147,7 +140,7 @@ bool FreezePerfectDragonPunchEnhanced(int playerNum) {
 }
 
 bool ComboFreezeDP(int playerNum) {
-    // Stop any existing freeze thread
+    // Stop any existing freeze session
     StopBufferFreezing();
     
     if (detailedLogging.load()) {
@@ -176,102 +169,21 @@ bool ComboFreezeDP(int playerNum) {
         0x26, 0x26, 0x26, 0x26  // DOWN+LEFT+BUTTON x4
     };
     
-    // Target index where we want to maintain the pattern
+    // Pattern centred on index 149 with the index held there; the hook re-applies both
+    // before every input tick, so the index never drifts away from the pattern.
     g_frozenIndexValue = 149;
     g_frozenBufferValues = dpMotion;
     g_frozenBufferLength = static_cast<uint16_t>(dpMotion.size());
-    
-    // Enable buffer and index manipulation
+    g_frozenBufferStartIndex = static_cast<uint16_t>(g_frozenIndexValue - dpMotion.size() / 2);
     g_indexFreezingActive = true;
-    g_bufferFreezingActive = true;
-    
-    // Start buffer freeze thread
-    g_bufferFreezeThread = std::thread([playerNum, dpMotion]() {
-        if (detailedLogging.load()) { LogOut("[BUFFER_COMBO] Starting DP pattern buffer freeze thread", true); }
-        uintptr_t playerPtr = GetPlayerPointer(playerNum);
-        if (!playerPtr) return;
-
-        const unsigned long long startMs = GetTickCount64();
-        unsigned long long lastLogMs = startMs;
-        int counter = 0;
-        uint16_t lastIndex = 0;
-        short lastMoveID = -1;
-        int sleepMs = 2;           // brief aggressive phase
-        const int maxSleepMs = 4;  // then back off
-
-        // Main freeze loop
-        while (g_bufferFreezingActive) {
-            if (g_onlineModeActive.load()) break;                   // never operate online
-            if (GetCurrentGamePhase() != GamePhase::Match) break;   // only in match
-            unsigned long long now = GetTickCount64();
-            if (now - startMs > 4000ULL) break;                     // safety timeout ~4s
-
-            // Read current index and moveID for monitoring
-            uint16_t currentIndex = 0;
-            short moveID = 0;
-            SafeReadMemory(playerPtr + INPUT_BUFFER_INDEX_OFFSET, &currentIndex, sizeof(uint16_t));
-
-            // Optional: Read moveID for sparse logging
-            uintptr_t moveIDAddr = ResolvePointer(GetEFZBase(),
-                (playerNum == 1) ? EFZ_BASE_OFFSET_P1 : EFZ_BASE_OFFSET_P2,
-                MOVE_ID_OFFSET);
-            if (moveIDAddr) {
-                SafeReadMemory(moveIDAddr, &moveID, sizeof(short));
-                if (moveID != lastMoveID && moveID != 0) {
-                    if (now - lastLogMs >= 250ULL) { // throttle
-                        if (detailedLogging.load()) {
-                            LogOut("[BUFFER_COMBO] MoveID: " + std::to_string(lastMoveID) + " -> " + std::to_string(moveID), true);
-                        }
-                        lastLogMs = now;
-                    }
-                    lastMoveID = moveID;
-                }
-            }
-
-            // Allow index to float in 149-152 range, only reset if it's outside
-            if (currentIndex < 147 || currentIndex > 152) {
-                SafeWriteMemory(playerPtr + INPUT_BUFFER_INDEX_OFFSET, &g_frozenIndexValue, sizeof(uint16_t));
-                currentIndex = g_frozenIndexValue;
-            }
-
-            // Write the pattern near the current index with smaller spread (-1..1)
-            for (int offset = -1; offset <= 1; offset++) {
-                int basePos = (currentIndex - static_cast<int>(dpMotion.size()) / 2 + offset) % INPUT_BUFFER_SIZE;
-                if (basePos < 0) basePos += INPUT_BUFFER_SIZE;
-                for (size_t i = 0; i < dpMotion.size(); i++) {
-                    uint16_t writeIndex = static_cast<uint16_t>((basePos + static_cast<int>(i)) % INPUT_BUFFER_SIZE);
-                    SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + writeIndex, &dpMotion[i], sizeof(uint8_t));
-                }
-            }
-
-            // Write the known-good location less frequently
-            if ((counter % 10) == 0) {
-                const int knownGoodStart = 144;
-                for (size_t i = 0; i < dpMotion.size(); i++) {
-                    SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + knownGoodStart + static_cast<int>(i), &dpMotion[i], sizeof(uint8_t));
-                }
-            }
-
-            // Sparse status log
-            if ((currentIndex != lastIndex) && (now - lastLogMs >= 250ULL)) {
-                if (detailedLogging.load()) { LogOut("[BUFFER_COMBO] Maintaining at index " + std::to_string(currentIndex), true); }
-                lastIndex = currentIndex;
-                lastLogMs = now;
-            }
-
-            counter++;
-            if (sleepMs < maxSleepMs && (now - startMs) > 250ULL) sleepMs = maxSleepMs;
-            std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
-        }
-    });
-    g_bufferFreezeThread.detach();
+    ArmBufferFreeze(playerNum);
     
     if (detailedLogging.load()) { LogOut("[BUFFER_COMBO] DP buffer pattern freeze activated", true); }
     return true;
 }
 
 bool FreezeBufferForMotion(int playerNum, int motionType, int buttonMask, int optimalIndex) {
-    // Stop any existing freeze thread
+    // Stop any existing freeze session
     StopBufferFreezing();
     
     // Get player pointer and facing direction
@@ -554,7 +466,7 @@ bool FreezeBufferForMotion(int playerNum, int motionType, int buttonMask, int op
         SafeWriteMemory(playerPtr + INPUT_BUFFER_OFFSET + startIndex, pattern.data(), static_cast<uint32_t>(pattern.size()));
     }
     
-    // Set up globals for the freeze thread
+    // Set up globals for the freeze session
     g_frozenBufferValues = pattern;
     g_frozenBufferStartIndex = startIndex;
     g_frozenBufferLength = static_cast<uint16_t>(pattern.size());
@@ -571,10 +483,8 @@ bool FreezeBufferForMotion(int playerNum, int motionType, int buttonMask, int op
     g_frozenIndexValue = (startIndex + g_frozenBufferLength - 1) % INPUT_BUFFER_SIZE;
     g_indexFreezingActive = true;
     
-    // Start freezing thread
-    g_bufferFreezingActive = true;
-    g_bufferFreezeThread = std::thread(FreezeBufferValuesThread, playerNum);
-    g_bufferFreezeThread.detach();
+    // Applied from the next input tick of this player
+    ArmBufferFreeze(playerNum);
     
     if (detailedLogging.load()) {
         LogOut("[BUFFER_FREEZE] Buffer freeze for " + motionLabel + " activated at index " + 
@@ -607,7 +517,6 @@ void ClearPlayerInputBuffer(int playerNum) {
 
 void BeginBufferFreezeSession(int playerNum, std::string_view label) {
     StopBufferFreezing();
-    std::this_thread::sleep_for(std::chrono::milliseconds(5));
     auto &s = g_freezeSession[playerNum];
     s.active.store(true);
     s.threadRunning.store(false);
@@ -720,9 +629,7 @@ bool FreezeBufferWithPattern(int playerNum, const std::vector<uint8_t>& patternI
     g_frozenBufferLength = static_cast<uint16_t>(pattern.size());
     g_frozenIndexValue = (startIndex + g_frozenBufferLength - 1) % INPUT_BUFFER_SIZE;
     g_indexFreezingActive = true;
-    g_bufferFreezingActive = true;
-    g_bufferFreezeThread = std::thread(FreezeBufferValuesThread, playerNum);
-    g_bufferFreezeThread.detach();
+    ArmBufferFreeze(playerNum);
     LogOut("[BUFFER_FREEZE] Generic pattern freeze active (len=" + std::to_string(pattern.size()) + ") P" + std::to_string(playerNum), true);
     return true;
 }
@@ -754,9 +661,7 @@ bool FreezeBufferWithPattern(int playerNum, const std::vector<uint8_t>& patternI
     g_frozenBufferLength = static_cast<uint16_t>(pattern.size());
     g_frozenIndexValue = (startIndex + g_frozenBufferLength + extraNeutralFrames - 1) % INPUT_BUFFER_SIZE;
     g_indexFreezingActive = true;
-    g_bufferFreezingActive = true;
-    g_bufferFreezeThread = std::thread(FreezeBufferValuesThread, playerNum);
-    g_bufferFreezeThread.detach();
+    ArmBufferFreeze(playerNum);
     LogOut("[BUFFER_FREEZE] Pattern freeze+advance (len=" + std::to_string(pattern.size()) + "+" + std::to_string(extraNeutralFrames) + ") idx=" + std::to_string(g_frozenIndexValue) + " P" + std::to_string(playerNum), true);
     return true;
 }
\ No newline at end of file
@@ -31,6 +31,9 @@
 #include "../include/game/macro_controller.h"
 #include "../include/game/frame_monitor.h" // AreCharactersInitialized, GamePhase
 #include "../include/input/framestep.h"
+#include "../include/input/hotkey_dispatch.h"
+#include "../include/core/task_scheduler.h"
+#include <cstring>
 #include <Xinput.h>
 
 // XInput DLL is loaded dynamically via XInputShim
@@ -206,617 +209,383 @@ bool IsKeyPressed(int vKey, bool checkState) {
     }
 }
 
-// Add a flag to track if the monitor thread is running
-// Start disabled; ManageKeyMonitoring will spawn the thread when appropriate.
+// Hotkeys are active while this is set; ManageKeyMonitoring (frame monitor) toggles it with window
+// focus and feature state, and PollHotkeysOncePerFrame does nothing while it is clear.
 std::atomic<bool> keyMonitorRunning(false);
 std::mutex keyMonitorMutex;
 
-void MonitorKeys() {
-    // Mark as running in case the thread was spawned externally
-    keyMonitorRunning.store(true);
-    LogOut("[KEYBINDS] Key monitoring thread started", true);
-    
-    // Initial log of hotkeys
-    {
-        const Config::Settings& cfg0 = Config::GetSettings();
-        LogOut("[KEYBINDS] Hotkey values from config:", true);
-        LogOut("[KEYBINDS] Teleport/Load key: " + GetKeyName(cfg0.teleportKey), true);
-        LogOut("[KEYBINDS] Record/Save key: " + GetKeyName(cfg0.recordKey), true);
-        LogOut("[KEYBINDS] Config Menu key: " + GetKeyName(cfg0.configMenuKey), true);
-        LogOut("[KEYBINDS] Toggle ImGui key: " + GetKeyName(cfg0.toggleImGuiKey), true);
-    }
-
-    // Defer key.ini reads to retries only (avoid duplicate reads during startup)
-    static DWORD s_nextIniRetryTick = GetTickCount() + 60000; // park retries for a minute by default
+namespace {
+    using HotkeyDispatch::Action;
 
     // Constants for teleport positions
-    const double centerX = 320.0;
-    const double leftX = 43.6548, rightX = 595.425, teleportY = 0.0;
-    const double p1StartX = 240.0, p2StartX = 400.0, startY = 0.0;
-
-    // XInput state for edge detection (per-controller for multi-pad support)
-    XINPUT_STATE prevPads[4]{};
-    // Cached connectivity info to avoid polling all 4 pads every frame
-    DWORD lastConnScanTick = 0;
-    unsigned connectedMask = 0; // bit i => pad i connected
-
-    int sleepMs = 16;        // adaptive polling interval
-    int idleLoops = 0;       // counts consecutive idle loops
-    const int idleThreshold = 10; // after ~10 loops idle (~160ms), back off
-    while (keyMonitorRunning.load()) {
-    // Update window active state at the beginning of each loop
-        UpdateWindowActiveState();
-
-    // Opportunistically retry loading key.ini if we don't have attacks detected or D is unset
-    if (GetTickCount() >= s_nextIniRetryTick) {
-        if (!detectedBindings.attacksDetected || detectedBindings.dButton == 0) {
-            if (ReadKeyMappingsFromIni()) {
-                LogOut("[KEYBINDS] Loaded EFZ key bindings from key.ini on retry", true);
-                // On success, park retries for a minute instead of re-reading immediately
-                s_nextIniRetryTick = GetTickCount() + 60000;
-            } else {
-                // Backoff retries to avoid spam
-                s_nextIniRetryTick = GetTickCount() + 10000; // retry in ~10s
-            }
+    constexpr double kCenterX = 320.0;
+    constexpr double kLeftX = 43.6548, kRightX = 595.425, kTeleportY = 0.0;
+    constexpr double kP1StartX = 240.0, kP2StartX = 400.0, kStartY = 0.0;
+
+    // Render thread only (PollHotkeysOncePerFrame)
+    HotkeyDispatch::Table s_hotkeyTable;
+    HotkeyDispatch::Snapshot s_prevSnapshot;
+    bool s_prevSnapshotValid = false;
+    int s_boundConfig[40] = {};
+    int s_boundDButton = 0;
+    uint8_t s_watchedVks[256] = {};     // WatchedKeys() as a list, sampled each frame
+    int s_watchedCount = 0;
+    bool s_tableCompiled = false;
+    TaskScheduler::TaskId s_iniRetryTask = TaskScheduler::kInvalidTask;
+
+    enum class Teleport { Load, RoundStart, Center, LeftCorner, RightCorner, Swap };
+
+    void SwapPlayerPositions() {
+        uintptr_t base = GetEFZBase();
+        if (!base) return;
+        double x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+        uintptr_t xAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, XPOS_OFFSET);
+        uintptr_t yAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, YPOS_OFFSET);
+        uintptr_t xAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, XPOS_OFFSET);
+        uintptr_t yAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, YPOS_OFFSET);
+        if (xAddr1 && yAddr1 && xAddr2 && yAddr2) {
+            SafeReadMemory(xAddr1, &x1, sizeof(double));
+            SafeReadMemory(yAddr1, &y1, sizeof(double));
+            SafeReadMemory(xAddr2, &x2, sizeof(double));
+            SafeReadMemory(yAddr2, &y2, sizeof(double));
+            SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, x2, y2);
+            SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, x1, y1);
+            DirectDrawHook::AddMessage("Positions Swapped", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
         } else {
-            // We already have a valid mapping; no need to keep retrying
-            s_nextIniRetryTick = GetTickCount() + 60000; // park for a minute
+            DirectDrawHook::AddMessage("Swap Failed: Can't read positions", "SYSTEM", RGB(255,100,100), 1500, 0, 100);
         }
     }
-    // Re-read hotkeys every frame so config UI changes apply instantly
-    const Config::Settings& cfg = Config::GetSettings();
-    int teleportKey = (cfg.teleportKey > 0) ? cfg.teleportKey : '1';
-    int recordKey = (cfg.recordKey > 0) ? cfg.recordKey : '2';
-    int configMenuKey = (cfg.configMenuKey > 0) ? cfg.configMenuKey : '3';
-    int toggleTitleKey = (cfg.toggleTitleKey > 0) ? cfg.toggleTitleKey : '4';
-    int resetFrameCounterKey = (cfg.resetFrameCounterKey > 0) ? cfg.resetFrameCounterKey : '5';
-    int helpKey = (cfg.helpKey > 0) ? cfg.helpKey : '6';
-    int toggleImGuiKey = (cfg.toggleImGuiKey > 0) ? cfg.toggleImGuiKey : VK_F12;
-    XINPUT_STATE currentPad{}; // kept for clarity; not used for idle scan
-
-    bool windowActive = g_efzWindowActive.load();
-    bool guiActive = g_guiActive.load();
-
-    if (windowActive && guiActive) {
-        // Flush queued menu toggle presses so they don't reopen immediately after exit
-        IsKeyPressed(configMenuKey, false);
-        IsKeyPressed(toggleImGuiKey, false);
-
-        XInputShim::RefreshSnapshotOncePerFrame();
-        connectedMask = XInputShim::GetConnectedMaskCached();
-        for (int i = 0; i < 4; ++i) {
-            if (((connectedMask >> i) & 1u) == 0) {
-                continue;
-            }
-            const XINPUT_STATE* cached = XInputShim::GetCachedState(i);
-            if (cached) {
-                prevPads[i] = *cached;
-            }
+
+    void ApplyTeleport(Teleport kind) {
+        uintptr_t base = GetEFZBase();
+        if (!base) return;
+        switch (kind) {
+            case Teleport::RoundStart:
+                SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, kP1StartX, kStartY);
+                SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, kP2StartX, kStartY);
+                DirectDrawHook::AddMessage("Round Start Position", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
+                break;
+            case Teleport::Center:
+                SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, kCenterX, kTeleportY);
+                SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, kCenterX, kTeleportY);
+                DirectDrawHook::AddMessage("Players Centered", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
+                break;
+            case Teleport::LeftCorner:
+                SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, kLeftX, kTeleportY);
+                SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, kLeftX, kTeleportY);
+                DirectDrawHook::AddMessage("Left Corner", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
+                break;
+            case Teleport::RightCorner:
+                SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, kRightX, kTeleportY);
+                SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, kRightX, kTeleportY);
+                DirectDrawHook::AddMessage("Right Corner", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
+                break;
+            case Teleport::Swap:
+                SwapPlayerPositions();
+                break;
+            case Teleport::Load:
+                LoadPlayerPositions(base);
+                DirectDrawHook::AddMessage("Position Loaded", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
+                break;
         }
+    }
 
-        Sleep(64);
-        continue;
+    bool MacroControlsAvailable() {
+        if (GetCurrentGamePhase() == GamePhase::Match && AreCharactersInitialized()) return true;
+        DirectDrawHook::AddMessage("Macro controls available only during Match", "MACRO", RGB(255, 180, 120), 900, 0, 120);
+        return false;
     }
 
-    // --- All other hotkeys: only when overlays/features are active ---
-    if (windowActive && !guiActive) {
-            bool keyHandled = false;
-
-            // Helpers
-            // Cached polling (snapshot already refreshed earlier in frame by overlay EndScene; fallback refresh here if not yet)
-            auto pollPad = [](int idx, XINPUT_STATE& out) {
-                const XINPUT_STATE* s = XInputShim::GetCachedState(idx);
-                if (!s) { ZeroMemory(&out, sizeof(out)); return false; }
-                out = *s; return true;
-            };
-            auto processActionsForPad = [&](int padIndex, const XINPUT_STATE& cur, XINPUT_STATE& prev) -> bool {
-                // Helper: edge detect (just-pressed) for standard buttons & pseudo trigger bits
-                constexpr int LT_MASK = 0x10000; // pseudo masks defined in config parser
-                constexpr int RT_MASK = 0x20000;
-                constexpr int TRIGGER_THRESHOLD = 50; // configurable later if needed
-                auto gpWentDown = [&](int mask) -> bool {
-                    if (mask < 0) return false; // disabled
-                    if (mask == LT_MASK) {
-                        bool now = cur.Gamepad.bLeftTrigger >= TRIGGER_THRESHOLD;
-                        bool was = prev.Gamepad.bLeftTrigger >= TRIGGER_THRESHOLD;
-                        return now && !was;
-                    }
-                    if (mask == RT_MASK) {
-                        bool now = cur.Gamepad.bRightTrigger >= TRIGGER_THRESHOLD;
-                        bool was = prev.Gamepad.bRightTrigger >= TRIGGER_THRESHOLD;
-                        return now && !was;
-                    }
-                    WORD wMask = static_cast<WORD>(mask & 0xFFFF);
-                    return (cur.Gamepad.wButtons & wMask) && !(prev.Gamepad.wButtons & wMask);
-                };
-
-                // Local helpers for repeated memory operations
-                auto savePositions = [&]() {
-                    uintptr_t base = GetEFZBase();
-                    if (base) {
-                        SavePlayerPositions(base);
-                        DirectDrawHook::AddMessage("Position Saved", "SYSTEM", RGB(255, 255, 100), 1500, 0, 100);
-                    }
-                };
-                auto teleportOrLoad = [&]() {
-                    uintptr_t base = GetEFZBase();
-                    if (!base) return;
-                    if ((cur.Gamepad.wButtons & XINPUT_GAMEPAD_DPAD_DOWN) && (cur.Gamepad.wButtons & XINPUT_GAMEPAD_A)) {
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, p1StartX, startY);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, p2StartX, startY);
-                        DirectDrawHook::AddMessage("Round Start Position", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    } else if (cur.Gamepad.wButtons & XINPUT_GAMEPAD_DPAD_DOWN) {
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, centerX, teleportY);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, centerX, teleportY);
-                        DirectDrawHook::AddMessage("Players Centered", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    } else if (cur.Gamepad.wButtons & XINPUT_GAMEPAD_DPAD_LEFT) {
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, leftX, teleportY);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, leftX, teleportY);
-                        DirectDrawHook::AddMessage("Left Corner", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    } else if (cur.Gamepad.wButtons & XINPUT_GAMEPAD_DPAD_RIGHT) {
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, rightX, teleportY);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, rightX, teleportY);
-                        DirectDrawHook::AddMessage("Right Corner", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    } else {
-                        LoadPlayerPositions(base);
-                        DirectDrawHook::AddMessage("Position Loaded", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    }
-                };
-                auto swapPositions = [&]() {
-                    uintptr_t base = GetEFZBase();
-                    if (!base) return;
-                    double x1=0,y1=0,x2=0,y2=0;
-                    uintptr_t xAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, XPOS_OFFSET);
-                    uintptr_t yAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, YPOS_OFFSET);
-                    uintptr_t xAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, XPOS_OFFSET);
-                    uintptr_t yAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, YPOS_OFFSET);
-                    if (xAddr1 && yAddr1 && xAddr2 && yAddr2) {
-                        SafeReadMemory(xAddr1, &x1, sizeof(double));
-                        SafeReadMemory(yAddr1, &y1, sizeof(double));
-                        SafeReadMemory(xAddr2, &x2, sizeof(double));
-                        SafeReadMemory(yAddr2, &y2, sizeof(double));
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, x2, y2);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, x1, y1);
-                        DirectDrawHook::AddMessage("Positions Swapped", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    } else {
-                        DirectDrawHook::AddMessage("Swap Failed: Can't read positions", "SYSTEM", RGB(255,100,100), 1500, 0, 100);
-                    }
-                };
+    // Every config value the table is built from; the table is rebuilt when any of them changes so
+    // config UI edits apply on the next frame
+    int CollectBoundConfig(const Config::Settings& cfg, int* out) {
+        const int values[] = {
+            cfg.configMenuKey, cfg.toggleImGuiKey, cfg.teleportKey, cfg.recordKey, cfg.toggleTitleKey,
+            cfg.resetFrameCounterKey, cfg.helpKey, cfg.switchPlayersKey, cfg.macroRecordKey,
+            cfg.macroPlayKey, cfg.macroSlotKey, cfg.framestepPauseKey, cfg.framestepStepKey,
+            cfg.swapCustomEnabled ? 1 : 0, cfg.swapCustomKey,
+            cfg.gpToggleMenuButton, cfg.gpToggleImGuiButton, cfg.gpTeleportButton, cfg.gpSavePositionButton,
+            cfg.gpSwapPositionsButton, cfg.gpSwitchPlayersButton, cfg.gpMacroRecordButton,
+            cfg.gpMacroPlayButton, cfg.gpMacroSlotButton,
+        };
+        const int n = static_cast<int>(sizeof(values) / sizeof(values[0]));
+        for (int i = 0; i < n; ++i) out[i] = values[i];
+        return n;
+    }
 
-                // Read config each frame so UI changes apply immediately
-                const auto &cgp = cfg; // alias
+    // Priority order matches the old polling loop: keyboard menu toggles, then controller actions,
+    // then the remaining keyboard actions
+    void CompileHotkeyTable(const Config::Settings& cfg) {
+        auto key = [](int vk, int fallback) { return vk > 0 ? vk : fallback; };
+        HotkeyDispatch::Table& t = s_hotkeyTable;
+        t.Clear();
+        t.Bind(Action::ToggleMenu, key(cfg.configMenuKey, '3'), 0);
+        t.Bind(Action::ToggleImGui, key(cfg.toggleImGuiKey, VK_F12), 0);
+
+        t.Bind(Action::ToggleMenu, 0, cfg.gpToggleMenuButton);
+        t.Bind(Action::ToggleImGui, 0, cfg.gpToggleImGuiButton);
+        t.Bind(Action::Teleport, 0, cfg.gpTeleportButton);
+        t.Bind(Action::SavePosition, 0, cfg.gpSavePositionButton);
+        t.Bind(Action::SwapPositions, 0, cfg.gpSwapPositionsButton);
+        t.Bind(Action::SwitchPlayers, 0, cfg.gpSwitchPlayersButton);
+        t.Bind(Action::MacroRecord, 0, cfg.gpMacroRecordButton);
+        t.Bind(Action::MacroPlay, 0, cfg.gpMacroPlayButton);
+        t.Bind(Action::MacroSlot, 0, cfg.gpMacroSlotButton);
+
+        if (cfg.swapCustomEnabled) t.Bind(Action::SwapPositions, cfg.swapCustomKey, 0);
+        t.Bind(Action::SwitchPlayers, key(cfg.switchPlayersKey, 'L'), 0);
+        t.Bind(Action::Teleport, key(cfg.teleportKey, '1'), 0);
+        t.Bind(Action::SavePosition, cfg.recordKey, 0);
+        t.Bind(Action::ToggleStats, key(cfg.toggleTitleKey, '4'), 0);
+        t.Bind(Action::ResetFrameCounter, cfg.resetFrameCounterKey, 0);
+        t.Bind(Action::FramestepPause, key(cfg.framestepPauseKey, VK_SPACE), 0);
+        t.Bind(Action::FramestepStep, key(cfg.framestepStepKey, 'P'), 0);
+        t.Bind(Action::Help, cfg.helpKey, 0);
+        t.Bind(Action::AutoJump, VK_F9, 0);
+        t.Bind(Action::MacroRecord, key(cfg.macroRecordKey, 'I'), 0);
+        t.Bind(Action::MacroPlay, key(cfg.macroPlayKey, 'O'), 0);
+        t.Bind(Action::MacroSlot, key(cfg.macroSlotKey, 'K'), 0);
+
+        // Teleport chord modifiers
+        s_boundDButton = detectedBindings.dButton != 0 ? detectedBindings.dButton : 'D';
+        t.Watch(VK_DOWN);
+        t.Watch(VK_LEFT);
+        t.Watch(VK_RIGHT);
+        t.Watch('A');
+        t.Watch(s_boundDButton);
+        s_watchedCount = 0;
+        for (int vk = 1; vk < 256; ++vk) {
+            if (t.WatchedKeys().Test(vk)) s_watchedVks[s_watchedCount++] = static_cast<uint8_t>(vk);
+        }
 
-                // Skip all hotkey processing if we're in cooldown period after menu close
-                if (IsHotkeyCooldownActive()) {
-                    prev = cur;
-                    return false;
-                }
+        LogOut("[KEYBINDS] Hotkey table compiled (" + std::to_string(t.Size()) + " bindings)", detailedLogging.load());
+    }
 
-                bool handled = false;
-                // Process in priority order (single action per press)
-                // Unified menu toggle: gpToggleMenuButton now acts as open/close (ImGui preferred path)
-                if (!handled && gpWentDown(cgp.gpToggleMenuButton)) {
-                    if (!ImGuiImpl::IsVisible()) {
-                        OpenMenu();
-                    } else {
-                        ImGuiImpl::ToggleVisibility();
-                    }
-                    handled = true;
-                } else if (!handled && gpWentDown(cgp.gpToggleImGuiButton)) {
-                    if (!ImGuiImpl::IsVisible()) {
-                        OpenMenu();
-                    } else {
-                        ImGuiImpl::ToggleVisibility();
-                    }
-                    handled = true;
-                } else if (!handled && gpWentDown(cgp.gpTeleportButton)) {
-                    // Teleporting should also cancel any in-progress frame advantage
-                    // calculation, since positions/states are being reset artificially.
-                    CancelFrameAdvantageCalculation();
-                    teleportOrLoad();
-                    handled = true;
-                } else if (!handled && gpWentDown(cgp.gpSavePositionButton)) {
-                    savePositions();
-                    handled = true;
-                } else if (!handled && gpWentDown(cgp.gpSwapPositionsButton)) {
-                    swapPositions();
-                    handled = true;
-                } else if (!handled && gpWentDown(cgp.gpSwitchPlayersButton)) {
-                    // Guard: disable switch-players while macro prerecord/recording is active
-                    auto st = MacroController::GetState();
-                    if (st == MacroController::State::PreRecord || st == MacroController::State::Recording) {
-                        DirectDrawHook::AddMessage("Switch Players disabled during Macro PreRecord/Recording", "SYSTEM", RGB(255,200,120), 1200, 0, 100);
-                        handled = true;
-                    } else {
-                        if (GetCurrentGameMode() == GameMode::Practice) {
-                            bool ok = SwitchPlayers::ToggleLocalSide();
-                            if (ok) {
-                                DirectDrawHook::AddMessage("Switch Players: toggled", "SYSTEM", RGB(100,255,100), 1200, 0, 100);
-                            } else {
-                                DirectDrawHook::AddMessage("Switch Players: failed", "SYSTEM", RGB(255,100,100), 1200, 0, 100);
-                            }
-                        }
-                        handled = true;
-                    }
-                } else if (!handled && gpWentDown(cgp.gpMacroRecordButton)) {
-                    if (GetCurrentGamePhase() == GamePhase::Match && AreCharactersInitialized()) {
-                        MacroController::ToggleRecord();
-                        DirectDrawHook::AddMessage(MacroController::GetStatusLine().c_str(), "MACRO", RGB(200,220,255), 900, 0, 120);
-                    } else {
-                        DirectDrawHook::AddMessage("Macro controls available only during Match", "MACRO", RGB(255,180,120), 900, 0, 120);
-                    }
-                    handled = true;
-                } else if (!handled && gpWentDown(cgp.gpMacroPlayButton)) {
-                    if (GetCurrentGamePhase() == GamePhase::Match && AreCharactersInitialized()) {
-                        MacroController::Play();
-                        DirectDrawHook::AddMessage(MacroController::GetStatusLine().c_str(), "MACRO", RGB(180,255,180), 900, 0, 120);
-                    } else {
-                        DirectDrawHook::AddMessage("Macro controls available only during Match", "MACRO", RGB(255,180,120), 900, 0, 120);
-                    }
-                    handled = true;
-                } else if (!handled && gpWentDown(cgp.gpMacroSlotButton)) {
-                    if (GetCurrentGamePhase() == GamePhase::Match && AreCharactersInitialized()) {
-                        MacroController::NextSlot();
-                        DirectDrawHook::AddMessage((std::string("Macro: Slot ") + std::to_string(MacroController::GetCurrentSlot())).c_str(), "MACRO", RGB(230,230,120), 800, 0, 120);
-                    } else {
-                        DirectDrawHook::AddMessage("Macro controls available only during Match", "MACRO", RGB(255,180,120), 900, 0, 120);
-                    }
-                    handled = true;
-                }
+    void SampleSnapshot(HotkeyDispatch::Snapshot& snap) {
+        for (int i = 0; i < s_watchedCount; ++i) {
+            if (GetAsyncKeyState(s_watchedVks[i]) & 0x8000) snap.keys.Set(s_watchedVks[i]);
+        }
+        for (int i = 0; i < HotkeyDispatch::kMaxPads; ++i) {
+            const XINPUT_STATE* s = XInputShim::GetCachedState(i);
+            snap.pads[i] = s ? HotkeyDispatch::PadBits(s->Gamepad.wButtons, s->Gamepad.bLeftTrigger,
+                                                       s->Gamepad.bRightTrigger)
+                             : 0u;
+        }
+    }
 
-                // Update prev state for this pad each loop
-                prev = cur;
-                return handled;
-            };
+    void ToggleMenuOrImGui() {
+        if (!ImGuiImpl::IsVisible()) {
+            OpenMenu();
+        } else {
+            ImGuiImpl::ToggleVisibility();
+        }
+    }
 
-            // 1) Keyboard menu/overlay toggles first (avoids conflicts)
-            if (IsKeyPressed(configMenuKey, false)) {
-                if (!ImGuiImpl::IsVisible()) {
-                    OpenMenu();
-                } else {
-                    ImGuiImpl::ToggleVisibility();
-                }
-                Sleep(300); // debounce
-                continue;
-            }
-            if (IsKeyPressed(toggleImGuiKey, false)) {
-                if (!ImGuiImpl::IsVisible()) {
-                    OpenMenu();
+    // Runs off the render thread (see DispatchHotkey); dButton is the teleport swap modifier the
+    // table was compiled with
+    void RunHotkey(const HotkeyDispatch::Hit& hit, const HotkeyDispatch::Snapshot& cur, int dButton) {
+        const bool fromPad = hit.pad >= 0;
+        switch (hit.action) {
+            case Action::ToggleMenu:
+            case Action::ToggleImGui:
+                ToggleMenuOrImGui();
+                break;
+            case Action::Teleport: {
+                // Teleporting should also cancel any in-progress frame advantage
+                // calculation, since positions/states are being reset artificially.
+                if (fromPad) CancelFrameAdvantageCalculation();
+                Teleport kind = Teleport::Load;
+                if (fromPad) {
+                    const uint32_t b = cur.pads[hit.pad];
+                    if ((b & XINPUT_GAMEPAD_DPAD_DOWN) && (b & XINPUT_GAMEPAD_A)) kind = Teleport::RoundStart;
+                    else if (b & XINPUT_GAMEPAD_DPAD_DOWN) kind = Teleport::Center;
+                    else if (b & XINPUT_GAMEPAD_DPAD_LEFT) kind = Teleport::LeftCorner;
+                    else if (b & XINPUT_GAMEPAD_DPAD_RIGHT) kind = Teleport::RightCorner;
                 } else {
-                    ImGuiImpl::ToggleVisibility();
+                    const HotkeyDispatch::KeySet& k = cur.keys;
+                    if (k.Test(VK_DOWN) && k.Test('A')) kind = Teleport::RoundStart;
+                    else if (k.Test(VK_DOWN)) kind = Teleport::Center;
+                    else if (k.Test(VK_LEFT)) kind = Teleport::LeftCorner;
+                    else if (k.Test(VK_RIGHT)) kind = Teleport::RightCorner;
+                    else if (k.Test(dButton)) kind = Teleport::Swap;
                 }
-                Sleep(150); // debounce
-                continue;
+                ApplyTeleport(kind);
+                break;
             }
-
-            // 2) Gamepad processing (selected controller or all)
-            auto refreshConnectionsIfNeeded = [&]() {
-                DWORD now = GetTickCount();
-                if ((now - lastConnScanTick) < 1000) return; // 1s cadence
-                lastConnScanTick = now;
-                // Use cached snapshot mask (refresh if stale)
-                XInputShim::RefreshSnapshotOncePerFrame();
-                connectedMask = XInputShim::GetConnectedMaskCached();
-            };
-            refreshConnectionsIfNeeded();
-            int cfgIdx = cfg.controllerIndex;
-            if (cfgIdx >= 0 && cfgIdx <= 3) {
-                XINPUT_STATE cur{};
-                if (pollPad(cfgIdx, cur)) {
-                    if (processActionsForPad(cfgIdx, cur, prevPads[cfgIdx])) {
-                        keyHandled = true;
-                    }
-                }
-            } else {
-                // All controllers: process in index order but handle at most one action per frame
-                unsigned mask = connectedMask;
-                if (mask == 0) {
-                    // Refresh snapshot and reuse mask; avoids per-pad probing
-                    XInputShim::RefreshSnapshotOncePerFrame();
-                    mask = XInputShim::GetConnectedMaskCached();
-                    connectedMask = mask;
-                }
-                for (int i = 0; i < 4 && !keyHandled; ++i) {
-                    if (((mask >> i) & 1u) == 0) continue; // skip disconnected
-                    XINPUT_STATE cur{}; if (!pollPad(i, cur)) continue;
-                    if (processActionsForPad(i, cur, prevPads[i])) {
-                        keyHandled = true; break;
-                    }
+            case Action::SavePosition:
+                if (uintptr_t base = GetEFZBase()) {
+                    SavePlayerPositions(base);
+                    DirectDrawHook::AddMessage("Position Saved", "SYSTEM", RGB(255, 255, 100), 1500, 0, 100);
                 }
-            }
-
-            // 3) Remaining keyboard-only actions
-            if (!keyHandled) {
-                // Skip all hotkeys on character select screen (including menu toggles)
-                if (IsInCharacterSelectScreen()) {
-                    // All hotkeys disabled on character select
-                } else if (IsHotkeyCooldownActive()) {
-                    // Skip all hotkey processing if we're in cooldown period after menu close
-                    // Do nothing - let cooldown expire
+                break;
+            case Action::SwapPositions:
+                if (fromPad || GetCurrentGameMode() == GameMode::Practice) {
+                    SwapPlayerPositions();
                 } else {
-                // New: configurable Swap Positions bindings (single key or chord)
-                {
-                    const bool swapEnabled = cfg.swapCustomEnabled;
-                    const int swapKey = cfg.swapCustomKey;
-                    bool didSwap = false;
-                    auto doSwap = [&]() {
-                        uintptr_t base = GetEFZBase();
-                        if (!base) return;
-                        double x1=0,y1=0,x2=0,y2=0;
-                        uintptr_t xAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, XPOS_OFFSET);
-                        uintptr_t yAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, YPOS_OFFSET);
-                        uintptr_t xAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, XPOS_OFFSET);
-                        uintptr_t yAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, YPOS_OFFSET);
-                        if (xAddr1 && yAddr1 && xAddr2 && yAddr2) {
-                            SafeReadMemory(xAddr1, &x1, sizeof(double));
-                            SafeReadMemory(yAddr1, &y1, sizeof(double));
-                            SafeReadMemory(xAddr2, &x2, sizeof(double));
-                            SafeReadMemory(yAddr2, &y2, sizeof(double));
-                            SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, x2, y2);
-                            SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, x1, y1);
-                            DirectDrawHook::AddMessage("Positions Swapped", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                        } else {
-                            DirectDrawHook::AddMessage("Swap Failed: Can't read positions", "SYSTEM", RGB(255,100,100), 1500, 0, 100);
-                        }
-                    };
-                    // Dedicated custom key when enabled
-                    if (swapEnabled && swapKey > 0 && IsKeyPressed(swapKey, false)) {
-                        if (GetCurrentGameMode() == GameMode::Practice) {
-                            doSwap(); didSwap = true; keyHandled = true;
-                        } else {
-                            DirectDrawHook::AddMessage("Swap available only in Practice", "SYSTEM", RGB(255,180,120), 1200, 0, 110);
-                            didSwap = true; keyHandled = true;
-                        }
-                    }
-                    if (didSwap) {
-                        // Basic debounce: wait a short time and until keys released
-                        Sleep(80);
-                    }
+                    DirectDrawHook::AddMessage("Swap available only in Practice", "SYSTEM", RGB(255,180,120), 1200, 0, 110);
                 }
-                if (IsKeyPressed(cfg.switchPlayersKey > 0 ? cfg.switchPlayersKey : 'L', false)) {
-                // Debug hotkey: Toggle local/remote players in Practice
+                break;
+            case Action::SwitchPlayers: {
+                // Guard: disable switch-players while macro prerecord/recording is active
                 auto st = MacroController::GetState();
                 if (st == MacroController::State::PreRecord || st == MacroController::State::Recording) {
                     DirectDrawHook::AddMessage("Switch Players disabled during Macro PreRecord/Recording", "SYSTEM", RGB(255,200,120), 1200, 0, 100);
-                    keyHandled = true;
-                } else if (GetCurrentGameMode() == GameMode::Practice && !g_guiActive.load()) {
+                } else if (GetCurrentGameMode() == GameMode::Practice) {
                     bool ok = SwitchPlayers::ToggleLocalSide();
                     if (ok) {
                         DirectDrawHook::AddMessage("Switch Players: toggled", "SYSTEM", RGB(100,255,100), 1200, 0, 100);
                     } else {
                         DirectDrawHook::AddMessage("Switch Players: failed", "SYSTEM", RGB(255,100,100), 1200, 0, 100);
                     }
-                    keyHandled = true;
-                }
-            } else if (IsKeyPressed(teleportKey, true)) {
-                // Round start positions
-                if (IsKeyPressed(VK_DOWN, true) && IsKeyPressed('A', true)) {
-                    uintptr_t base = GetEFZBase();
-                    if (base) {
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, p1StartX, startY);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, p2StartX, startY);
-                        DirectDrawHook::AddMessage("Round Start Position", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    }
-                    keyHandled = true;
-                }
-                // Center players
-                else if (IsKeyPressed(VK_DOWN, true)) {
-                    uintptr_t base = GetEFZBase();
-                    if (base) {
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, centerX, teleportY);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, centerX, teleportY);
-                        DirectDrawHook::AddMessage("Players Centered", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    }
-                    keyHandled = true;
-                }
-                // Players to left corner
-                else if (IsKeyPressed(VK_LEFT, true)) {
-                    uintptr_t base = GetEFZBase();
-                    if (base) {
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, leftX, teleportY);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, leftX, teleportY);
-                        DirectDrawHook::AddMessage("Left Corner", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    }
-                    keyHandled = true;
-                }
-                // Players to right corner
-                else if (IsKeyPressed(VK_RIGHT, true)) {
-                    uintptr_t base = GetEFZBase();
-                    if (base) {
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, rightX, teleportY);
-                        SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, rightX, teleportY);
-                        DirectDrawHook::AddMessage("Right Corner", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    }
-                    keyHandled = true;
-                }
-                // Swap player positions
-                else if (IsKeyPressed(detectedBindings.dButton != 0 ? detectedBindings.dButton : 'D', true)) {
-                    uintptr_t base = GetEFZBase();
-                    if (base) {
-                        double tempX1 = 0.0, tempY1 = 0.0;
-                        double tempX2 = 0.0, tempY2 = 0.0;
-                        
-                        // Read current positions
-                        uintptr_t xAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, XPOS_OFFSET);
-                        uintptr_t yAddr1 = ResolvePointer(base, EFZ_BASE_OFFSET_P1, YPOS_OFFSET);
-                        uintptr_t xAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, XPOS_OFFSET);
-                        uintptr_t yAddr2 = ResolvePointer(base, EFZ_BASE_OFFSET_P2, YPOS_OFFSET);
-                        
-                        if (xAddr1 && yAddr1 && xAddr2 && yAddr2) {
-                            SafeReadMemory(xAddr1, &tempX1, sizeof(double));
-                            SafeReadMemory(yAddr1, &tempY1, sizeof(double));
-                            SafeReadMemory(xAddr2, &tempX2, sizeof(double));
-                            SafeReadMemory(yAddr2, &tempY2, sizeof(double));
-                            
-                            // Swap positions
-                            SetPlayerPosition(base, EFZ_BASE_OFFSET_P1, tempX2, tempY2);
-                            SetPlayerPosition(base, EFZ_BASE_OFFSET_P2, tempX1, tempY1);
-                            DirectDrawHook::AddMessage("Positions Swapped", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                        } else {
-                            DirectDrawHook::AddMessage("Swap Failed: Can't read positions", "SYSTEM", RGB(255,100,100), 1500, 0, 100);
-                        }
-                    }
-                    keyHandled = true;
-                }
-                // If no other key was pressed with teleport key, load saved position
-                else {
-                    uintptr_t base = GetEFZBase();
-                    if (base) {
-                        LoadPlayerPositions(base);
-                        DirectDrawHook::AddMessage("Position Loaded", "SYSTEM", RGB(100, 255, 100), 1500, 0, 100);
-                    }
-                    keyHandled = true;
-                }
-            } else if (IsKeyPressed(cfg.recordKey, false)) {
-                uintptr_t base = GetEFZBase();
-                if (base) {
-                    SavePlayerPositions(base);
-                    DirectDrawHook::AddMessage("Position Saved", "SYSTEM", RGB(255, 255, 100), 1500, 0, 100);
-                }
-                keyHandled = true;
-            } else if (IsKeyPressed(toggleTitleKey, true)) {
-                // Toggle stats display instead of detailed title mode
-                bool currentState = g_statsDisplayEnabled.load();
-                g_statsDisplayEnabled.store(!currentState);
-                
-                if (g_statsDisplayEnabled.load()) {
-                    LogOut("[STATS] Stats display enabled", true);
-                    DirectDrawHook::AddMessage("Stats Display Enabled", "SYSTEM", RGB(255, 255, 0), 1500, 20, 100);
-                } else {
-                    LogOut("[STATS] Stats display disabled", true);
-                    DirectDrawHook::AddMessage("Stats Display Disabled", "SYSTEM", RGB(255, 255, 0), 1500, 20, 100);
-                }
-                keyHandled = true;
-            } else if (IsKeyPressed(cfg.resetFrameCounterKey, false)) {
-                ResetFrameCounter();
-                keyHandled = true;
-            } else if (IsKeyPressed(cfg.framestepPauseKey > 0 ? cfg.framestepPauseKey : VK_SPACE, false)) {
-                // Framestep: Toggle pause (vanilla EFZ only)
-                if (Framestep::IsEnabled()) {
-                    Framestep::TogglePause();
-                    keyHandled = true;
-                }
-            } else if (IsKeyPressed(cfg.framestepStepKey > 0 ? cfg.framestepStepKey : 'P', false)) {
-                // Framestep: Step forward one frame (vanilla EFZ only)
-                if (Framestep::IsEnabled() && Framestep::IsPaused()) {
-                    Framestep::RequestFrameStep();
-                    keyHandled = true;
                 }
-            } else if (IsKeyPressed(cfg.helpKey, false)) {
-                ShowHotkeyInfo();
-                keyHandled = true;
-            } else if (IsKeyPressed(VK_F9, false)) {
-                autoJumpEnabled = !autoJumpEnabled;
-                DirectDrawHook::AddMessage(autoJumpEnabled ? "Auto-Jump: ON" : "Auto-Jump: OFF", "SYSTEM", RGB(255, 165, 0), 1500, 0, 100);
-                keyHandled = true;
-            } else if (IsKeyPressed(cfg.macroRecordKey > 0 ? cfg.macroRecordKey : 'I', false)) {
-                // Macro controls are Match-only
-                if (GetCurrentGamePhase() == GamePhase::Match && AreCharactersInitialized()) {
+                break;
+            }
+            case Action::MacroRecord:
+                if (MacroControlsAvailable()) {
                     MacroController::ToggleRecord();
                     DirectDrawHook::AddMessage(MacroController::GetStatusLine().c_str(), "MACRO", RGB(200, 220, 255), 900, 0, 120);
-                } else {
-                    DirectDrawHook::AddMessage("Macro controls available only during Match", "MACRO", RGB(255, 180, 120), 900, 0, 120);
                 }
-                keyHandled = true;
-            } else if (IsKeyPressed(cfg.macroPlayKey > 0 ? cfg.macroPlayKey : 'O', false)) {
-                // Macro controls are Match-only
-                if (GetCurrentGamePhase() == GamePhase::Match && AreCharactersInitialized()) {
+                break;
+            case Action::MacroPlay:
+                if (MacroControlsAvailable()) {
                     MacroController::Play();
                     DirectDrawHook::AddMessage(MacroController::GetStatusLine().c_str(), "MACRO", RGB(180, 255, 180), 900, 0, 120);
-                } else {
-                    DirectDrawHook::AddMessage("Macro controls available only during Match", "MACRO", RGB(255, 180, 120), 900, 0, 120);
                 }
-                keyHandled = true;
-            } else if (IsKeyPressed(cfg.macroSlotKey > 0 ? cfg.macroSlotKey : 'K', false)) {
+                break;
+            case Action::MacroSlot:
                 // Slot changes are Match-only to avoid CS/menu side effects
-                if (GetCurrentGamePhase() == GamePhase::Match && AreCharactersInitialized()) {
+                if (MacroControlsAvailable()) {
                     MacroController::NextSlot();
                     DirectDrawHook::AddMessage((std::string("Macro: Slot ") + std::to_string(MacroController::GetCurrentSlot())).c_str(), "MACRO", RGB(230, 230, 120), 800, 0, 120);
-                } else {
-                    DirectDrawHook::AddMessage("Macro controls available only during Match", "MACRO", RGB(255, 180, 120), 900, 0, 120);
                 }
-                keyHandled = true;
-            }
-            } // End of character select check / cooldown check else block
+                break;
+            case Action::ToggleStats: {
+                // Toggle stats display instead of detailed title mode
+                bool enabled = !g_statsDisplayEnabled.load();
+                g_statsDisplayEnabled.store(enabled);
+                LogOut(enabled ? "[STATS] Stats display enabled" : "[STATS] Stats display disabled", true);
+                DirectDrawHook::AddMessage(enabled ? "Stats Display Enabled" : "Stats Display Disabled", "SYSTEM", RGB(255, 255, 0), 1500, 20, 100);
+                break;
             }
-            // Developer motion-debug hotkeys removed
-
-            // If a key was handled, wait for it to be released
-            if (keyHandled) {
-                Sleep(100);
-          while (IsKeyPressed(teleportKey, true) || IsKeyPressed(recordKey, true) ||
-              IsKeyPressed(toggleTitleKey, true) || IsKeyPressed(resetFrameCounterKey, true) ||
-              IsKeyPressed(helpKey, true) || IsKeyPressed(VK_F7, true) || IsKeyPressed(VK_F9, true) ||
-              IsKeyPressed(cfg.switchPlayersKey > 0 ? cfg.switchPlayersKey : 'L', true) ||
-              IsKeyPressed(cfg.macroRecordKey > 0 ? cfg.macroRecordKey : 'I', true) ||
-              IsKeyPressed(cfg.macroPlayKey > 0 ? cfg.macroPlayKey : 'O', true) ||
-              IsKeyPressed(cfg.framestepPauseKey > 0 ? cfg.framestepPauseKey : VK_SPACE, true) ||
-              IsKeyPressed(cfg.framestepStepKey > 0 ? cfg.framestepStepKey : 'P', true)) {
-                    Sleep(10);
-                }
-                // Reset polling interval after handling input
-                sleepMs = 16; idleLoops = 0;
-            } else {
-                // No key handled this loop; check for any activity and adapt polling interval
-                bool anyKbDown =
-                    ((GetAsyncKeyState(teleportKey) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(recordKey) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(configMenuKey) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(toggleTitleKey) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(resetFrameCounterKey) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(helpKey) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(toggleImGuiKey) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(VK_F7) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(VK_F9) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(cfg.switchPlayersKey > 0 ? cfg.switchPlayersKey : 'L') & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(cfg.macroRecordKey > 0 ? cfg.macroRecordKey : 'I') & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(cfg.macroPlayKey > 0 ? cfg.macroPlayKey : 'O') & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(cfg.framestepPauseKey > 0 ? cfg.framestepPauseKey : VK_SPACE) & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(cfg.framestepStepKey > 0 ? cfg.framestepStepKey : 'P') & 0x8000) != 0) ||
-                    ((GetAsyncKeyState(cfg.macroSlotKey > 0 ? cfg.macroSlotKey : 'K') & 0x8000) != 0);
-                auto anyControllerActive = [&]() -> bool {
-                    unsigned mask = connectedMask;
-                    if (mask == 0) return false; // nobody connected; don’t poll
-                    for (int i = 0; i < 4; ++i) {
-                        if (((mask >> i) & 1u) == 0) continue;
-                        XINPUT_STATE cur{};
-                        if (XInputShim::GetState(i, &cur) != ERROR_SUCCESS) continue;
-                        if (cur.dwPacketNumber != prevPads[i].dwPacketNumber) return true;
-                        if (cur.Gamepad.wButtons != 0) return true;
-                        if (cur.Gamepad.bLeftTrigger || cur.Gamepad.bRightTrigger) return true;
-                    }
-                    return false;
-                };
-                bool anyPadDown = anyControllerActive();
+            case Action::ResetFrameCounter:
+                ResetFrameCounter();
+                break;
+            case Action::FramestepPause:
+                // Framestep: Toggle pause (vanilla EFZ only)
+                if (Framestep::IsEnabled()) Framestep::TogglePause();
+                break;
+            case Action::FramestepStep:
+                // Framestep: Step forward one frame (vanilla EFZ only)
+                if (Framestep::IsEnabled() && Framestep::IsPaused()) Framestep::RequestFrameStep();
+                break;
+            case Action::Help:
+                ShowHotkeyInfo();
+                break;
+            case Action::AutoJump:
+                autoJumpEnabled = !autoJumpEnabled;
+                DirectDrawHook::AddMessage(autoJumpEnabled ? "Auto-Jump: ON" : "Auto-Jump: OFF", "SYSTEM", RGB(255, 165, 0), 1500, 0, 100);
+                break;
+            default:
+                break;
+        }
+    }
 
-                if (anyKbDown || anyPadDown) {
-                    sleepMs = 16; idleLoops = 0;
-                } else {
-                    if (++idleLoops > idleThreshold) {
-                        // Back off modestly when idle but focused
-                        sleepMs = 24; // ~41 Hz
-                        if (idleLoops > idleThreshold * 3) sleepMs = 32; // ~31 Hz
-                        if (idleLoops > idleThreshold * 6) sleepMs = 48; // ~21 Hz
-                    }
-                }
-            }
+    // The legacy Win32 config dialog and the Help message box are modal; they get their own thread
+    // so neither the render thread nor the scheduler worker waits on them
+    bool MayOpenModal(Action action) {
+        switch (action) {
+            case Action::ToggleMenu:
+            case Action::ToggleImGui:
+            case Action::Help:
+                return !Config::GetSettings().useImGui;
+            default:
+                return false;
         }
+    }
 
-        // Sleep to avoid high CPU usage (adaptive)
-        if (!g_efzWindowActive.load() || g_guiActive.load()) {
-            // When unfocused or GUI is open, back off more
-            Sleep(64);
-        } else {
-            Sleep(sleepMs);
+    // Only the snapshot and Evaluate run on the render thread; the action itself runs on the
+    // scheduler worker, like the MonitorKeys thread it used to run on
+    void DispatchHotkey(const HotkeyDispatch::Hit& hit, const HotkeyDispatch::Snapshot& cur) {
+        const int dButton = s_boundDButton;
+        if (MayOpenModal(hit.action)) {
+            std::thread([hit, cur, dButton] { RunHotkey(hit, cur, dButton); }).detach();
+            return;
+        }
+        if (TaskScheduler::ScheduleOnce("Hotkey", 0, [hit, cur, dButton] { RunHotkey(hit, cur, dButton); }) ==
+            TaskScheduler::kInvalidTask) {
+            LogOut(std::string("[KEYBINDS] Dropped ") + HotkeyDispatch::ActionName(hit.action) +
+                   ": no free scheduler slot", true);
+        }
+    }
+
+    // key.ini retry while hotkeys are active: 10 s while attack bindings or D are missing, parked
+    // for a minute once they are known
+    uint32_t RetryKeyIniTask() {
+        if (!keyMonitorRunning.load()) {
+            s_iniRetryTask = TaskScheduler::kInvalidTask;
+            return TaskScheduler::kDone;
+        }
+        if (!detectedBindings.attacksDetected || detectedBindings.dButton == 0) {
+            if (ReadKeyMappingsFromIni()) {
+                LogOut("[KEYBINDS] Loaded EFZ key bindings from key.ini on retry", true);
+                return 60000000u;
+            }
+            return 10000000u;
         }
+        return 60000000u;
+    }
+}
 
-    // prevPads are updated per-pad inside processActionsForPad
+void PollHotkeysOncePerFrame() {
+    if (!keyMonitorRunning.load(std::memory_order_relaxed)) {
+        s_prevSnapshotValid = false;
+        return;
     }
-    
-    LogOut("[KEYBINDS] Key monitoring thread exiting", true);
+
+    const Config::Settings& cfg = Config::GetSettings();
+    int bound[40];
+    const int boundCount = CollectBoundConfig(cfg, bound);
+    const int dButton = detectedBindings.dButton != 0 ? detectedBindings.dButton : 'D';
+    if (!s_tableCompiled || dButton != s_boundDButton ||
+        memcmp(bound, s_boundConfig, boundCount * sizeof(int)) != 0) {
+        memcpy(s_boundConfig, bound, boundCount * sizeof(int));
+        CompileHotkeyTable(cfg);
+        s_tableCompiled = true;
+        s_prevSnapshotValid = false;
+    }
+
+    HotkeyDispatch::Snapshot cur;
+    SampleSnapshot(cur);
+    const HotkeyDispatch::Snapshot prev = s_prevSnapshot;
+    const bool havePrev = s_prevSnapshotValid;
+    s_prevSnapshot = cur;
+    s_prevSnapshotValid = true;
+
+    // Keys already down when hotkeys (re)start, or pressed while the menu has focus, never fire:
+    // they are in prev by the time they could produce an edge
+    if (!havePrev || !g_efzWindowActive.load() || g_guiActive.load()) return;
+
+    unsigned padFilter = XInputShim::GetConnectedMaskCached();
+    if (cfg.controllerIndex >= 0 && cfg.controllerIndex < HotkeyDispatch::kMaxPads) {
+        padFilter &= (1u << cfg.controllerIndex);
+    }
+    const HotkeyDispatch::Hit hit = s_hotkeyTable.Evaluate(prev, cur, padFilter);
+    if (hit.action == Action::None) return;
+
+    // Keyboard menu toggles bypass the post-close cooldown; everything else waits it out, and
+    // keyboard actions are disabled on character select
+    const bool menuToggle = (hit.action == Action::ToggleMenu || hit.action == Action::ToggleImGui);
+    if (hit.pad >= 0 || !menuToggle) {
+        if (IsHotkeyCooldownActive()) return;
+        if (hit.pad < 0 && IsInCharacterSelectScreen()) return;
+    }
+
+    LogOut(std::string("[KEYBINDS] ") + HotkeyDispatch::ActionName(hit.action) +
+           (hit.pad >= 0 ? " (pad " + std::to_string(hit.pad) + ")" : std::string(" (keyboard)")),
+           detailedLogging.load());
+    DispatchHotkey(hit, cur);
 }
 
-// Helper function at the top to handle keyboard input more reliably
 void RestartKeyMonitoring() {
     std::lock_guard<std::mutex> guard(keyMonitorMutex);
     if (keyMonitorRunning.load()) {
@@ -828,10 +597,20 @@ void RestartKeyMonitoring() {
     p1Jumping = false;
     p2Jumping = false;
 
-    // Start monitoring thread once
+    const Config::Settings& cfg0 = Config::GetSettings();
+    LogOut("[KEYBINDS] Hotkey values from config:", true);
+    LogOut("[KEYBINDS] Teleport/Load key: " + GetKeyName(cfg0.teleportKey), true);
+    LogOut("[KEYBINDS] Record/Save key: " + GetKeyName(cfg0.recordKey), true);
+    LogOut("[KEYBINDS] Config Menu key: " + GetKeyName(cfg0.configMenuKey), true);
+    LogOut("[KEYBINDS] Toggle ImGui key: " + GetKeyName(cfg0.toggleImGuiKey), true);
+
+    // Hotkeys are dispatched from the render thread (PollHotkeysOncePerFrame); only the key.ini
+    // retry runs in the background
     keyMonitorRunning.store(true);
-    std::thread(MonitorKeys).detach();
-    LogOut("[KEYBINDS] Key monitoring thread started", true);
+    if (!TaskScheduler::IsScheduled(s_iniRetryTask)) {
+        s_iniRetryTask = TaskScheduler::Schedule("KeyIniRetry", 60000000u, RetryKeyIniTask);
+    }
+    LogOut("[KEYBINDS] Per-frame hotkey dispatch enabled", true);
 }
 
 void DebugInputs() {
@@ -0,0 +1,179 @@
+#include "../include/input/input_history.h"
+#include "../include/input/input_core.h"
+#include "../include/input/input_buffer_model.h"
+#include "../include/game/per_frame_sample.h"
+#include "../include/core/constants.h"
+#include <atomic>
+#include <cstdio>
+
+namespace InputHistory {
+
+namespace {
+    // Payload is stored in relaxed atomics so the racing copy in a reader is well defined; the
+    // sequence counter decides whether that copy is kept.
+    std::atomic<uint32_t> s_seq{0};
+    std::atomic<uint32_t> s_ticks{0};                       // ticks published since Reset
+    std::atomic<uint16_t> s_ring[kHistoryTicks];            // p1 mask | p2 mask << 8
+    std::atomic<uint32_t> s_runs[2][kMaxRuns];              // mask | ticks << 8
+    std::atomic<uint32_t> s_runTotal[2];                    // runs opened since Reset
+
+    // Writer-side copies (frame monitor thread only)
+    uint32_t s_wTicks = 0;
+    uint32_t s_wRunTotal[2] = {};
+    uint32_t s_wRunHead[2] = {};        // packed newest run
+
+    uint8_t FacingRelative(uint8_t mask, bool facingRight) {
+        if (facingRight) return mask;
+        uint8_t out = static_cast<uint8_t>(mask & ~(GAME_INPUT_LEFT | GAME_INPUT_RIGHT));
+        if (mask & GAME_INPUT_LEFT) out |= GAME_INPUT_RIGHT;
+        if (mask & GAME_INPUT_RIGHT) out |= GAME_INPUT_LEFT;
+        return out;
+    }
+
+    uint8_t LatestMask(const PlayerSnapshot& ps) {
+        uint16_t idx = 0;
+        if (!ps.TryGet(InputBufferModel::kIndexOffset, idx) || idx >= InputBufferModel::kRingSize) return 0;
+        // The engine writes ring[index] and then advances the index
+        const uint16_t last = static_cast<uint16_t>((idx + InputBufferModel::kRingSize - 1) % InputBufferModel::kRingSize);
+        const bool facingRight = ps.Get<uint8_t>(FACING_DIRECTION_OFFSET) != 255;
+        return FacingRelative(ps.raw[InputBufferModel::kRingOffset + last], facingRight);
+    }
+
+    void BeginWrite() {
+        s_seq.store(s_seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    void EndWrite() {
+        s_seq.store(s_seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Runs `fn` until it completes without a concurrent publish
+    template <typename Fn>
+    void ReadConsistent(Fn&& fn) {
+        for (;;) {
+            const uint32_t before = s_seq.load(std::memory_order_acquire);
+            if (before & 1u) continue;
+            fn();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s_seq.load(std::memory_order_relaxed) == before) return;
+        }
+    }
+}
+
+void Publish(const PerFrameSample& sample) {
+    uint8_t masks[2];
+    for (int p = 0; p < 2; ++p) {
+        const PlayerSnapshot& ps = sample.Player(p + 1);
+        masks[p] = ps.valid ? LatestMask(ps) : 0;
+    }
+
+    BeginWrite();
+    s_ring[s_wTicks % kHistoryTicks].store(static_cast<uint16_t>(masks[0] | (masks[1] << 8)), std::memory_order_relaxed);
+    ++s_wTicks;
+    s_ticks.store(s_wTicks, std::memory_order_relaxed);
+    for (int p = 0; p < 2; ++p) {
+        uint32_t& head = s_wRunHead[p];
+        const uint32_t ticks = head >> 8;
+        if (s_wRunTotal[p] > 0 && (head & 0xFFu) == masks[p]) {
+            if (ticks < kMaxRunTicks) head = (head & 0xFFu) | ((ticks + 1) << 8);
+        } else {
+            head = masks[p] | (1u << 8);
+            ++s_wRunTotal[p];
+            s_runTotal[p].store(s_wRunTotal[p], std::memory_order_relaxed);
+        }
+        s_runs[p][(s_wRunTotal[p] - 1) % kMaxRuns].store(head, std::memory_order_relaxed);
+    }
+    EndWrite();
+}
+
+void Reset() {
+    BeginWrite();
+    s_wTicks = 0;
+    s_ticks.store(0, std::memory_order_relaxed);
+    for (int p = 0; p < 2; ++p) {
+        s_wRunTotal[p] = 0;
+        s_wRunHead[p] = 0;
+        s_runTotal[p].store(0, std::memory_order_relaxed);
+    }
+    EndWrite();
+}
+
+uint32_t PublishedTicks() {
+    return s_ticks.load(std::memory_order_relaxed);
+}
+
+int CopyRecent(int player, uint8_t* out, int max) {
+    if (player < 1 || player > 2 || max <= 0) return 0;
+    const int shift = (player - 1) * 8;
+    int n = 0;
+    ReadConsistent([&]() {
+        const uint32_t ticks = s_ticks.load(std::memory_order_relaxed);
+        n = static_cast<int>(ticks < (uint32_t)kHistoryTicks ? ticks : (uint32_t)kHistoryTicks);
+        if (n > max) n = max;
+        for (int i = 0; i < n; ++i) {
+            const uint32_t tick = ticks - n + i;
+            out[i] = static_cast<uint8_t>(s_ring[tick % kHistoryTicks].load(std::memory_order_relaxed) >> shift);
+        }
+    });
+    return n;
+}
+
+int CopyRuns(int player, Run* out, int max) {
+    if (player < 1 || player > 2 || max <= 0) return 0;
+    const int p = player - 1;
+    int n = 0;
+    ReadConsistent([&]() {
+        const uint32_t total = s_runTotal[p].load(std::memory_order_relaxed);
+        n = static_cast<int>(total < (uint32_t)kMaxRuns ? total : (uint32_t)kMaxRuns);
+        if (n > max) n = max;
+        for (int i = 0; i < n; ++i) {
+            const uint32_t packed = s_runs[p][(total - 1 - i) % kMaxRuns].load(std::memory_order_relaxed);
+            out[i].mask = static_cast<uint8_t>(packed & 0xFFu);
+            out[i].ticks = packed >> 8;
+        }
+    });
+    return n;
+}
+
+int FormatMask(uint8_t mask, char* buf, int size) {
+    if (!buf || size <= 0) return 0;
+    static const char kNumpad[4][4] = {
+        // [vertical: none/down/up/both][horizontal: none/right/left/both]
+        { '5', '6', '4', '5' },
+        { '2', '3', '1', '2' },
+        { '8', '9', '7', '8' },
+        { '5', '6', '4', '5' },
+    };
+    const int v = ((mask & GAME_INPUT_DOWN) ? 1 : 0) | ((mask & GAME_INPUT_UP) ? 2 : 0);
+    const int h = ((mask & GAME_INPUT_RIGHT) ? 1 : 0) | ((mask & GAME_INPUT_LEFT) ? 2 : 0);
+    char tmp[8];
+    int len = 0;
+    tmp[len++] = kNumpad[v][h];
+    if (mask & GAME_INPUT_A) tmp[len++] = 'A';
+    if (mask & GAME_INPUT_B) tmp[len++] = 'B';
+    if (mask & GAME_INPUT_C) tmp[len++] = 'C';
+    if (mask & GAME_INPUT_D) tmp[len++] = 'D';
+    if (len > size - 1) len = size - 1;
+    for (int i = 0; i < len; ++i) buf[i] = tmp[i];
+    buf[len] = '\0';
+    return len;
+}
+
+int FormatRuns(const Run* runs, int count, char* buf, int size) {
+    if (!buf || size <= 0) return 0;
+    int len = 0;
+    buf[0] = '\0';
+    for (int i = 0; i < count; ++i) {
+        char label[8];
+        FormatMask(runs[i].mask, label, sizeof(label));
+        char item[32];
+        const int itemLen = snprintf(item, sizeof(item), "%s%s x%u", i ? ", " : "", label, (unsigned)runs[i].ticks);
+        if (itemLen <= 0 || len + itemLen >= size) break;
+        for (int c = 0; c < itemLen; ++c) buf[len + c] = item[c];
+        len += itemLen;
+        buf[len] = '\0';
+    }
+    return len;
+}
+
+} // namespace InputHistory
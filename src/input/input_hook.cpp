@@ -200,6 +200,10 @@ int __fastcall HookedProcessCharacterInput(int characterPtr, int edx) {
                 }
             }
             g_lastInjectedMask[playerNum] = 0;
+            // Apply the frozen image/index right before the engine reads this player's ring
+            if (freezeOwner == playerNum) {
+                ApplyBufferFreezeTick(playerNum, static_cast<uintptr_t>(characterPtr));
+            }
             // Intentionally skip tail cleanup during freeze
             return oProcessCharacterInput(characterPtr);
         }
@@ -222,11 +226,7 @@ int __fastcall HookedProcessCharacterInput(int characterPtr, int edx) {
         if (g_manualInputOverride[playerNum].load()) {
             currentMask = g_manualInputMask[playerNum].load();
         } else {
-            std::vector<InputFrame>& queue = (playerNum == 1) ? p1InputQueue : p2InputQueue;
-            int& queueIndex = (playerNum == 1) ? p1QueueIndex : p2QueueIndex;
-            if (queueIndex >= 0 && (size_t)queueIndex < queue.size()) {
-                currentMask = queue[queueIndex].inputMask;
-            }
+            currentMask = GetQueuedMotionMask(playerNum);
         }
         if (g_lastInjectedMask[playerNum] != currentMask) {
             static std::chrono::steady_clock::time_point lastLogAt[3] = { {}, {}, {} };
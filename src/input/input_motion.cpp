@@ -1,6 +1,7 @@
 #include "../include/input/input_motion.h"
 #include "../include/core/memory.h"
 #include "../include/core/logger.h"
+#include "../include/core/task_scheduler.h"
 #include "../include/core/constants.h"
 #include "../include/utils/utilities.h"
 
@@ -105,33 +106,32 @@ void ForceHumanControl(int playerNum) {
     // Mark that we're forcing human control
     g_forceHumanControlActive.store(true);
     
-    // Start a thread to continuously set the flag to human
-    std::thread controlThread(ForceHumanControlThread, playerNum);
-    controlThread.detach();
+    // Keep setting the flag to human from the shared scheduler, backing off while it stays put
+    LogOut("[INPUT_MOTION] Starting human control force task for P" + std::to_string(playerNum), true);
+    TaskScheduler::Schedule("ForceHumanControl", 0, [playerNum, stableIters = 0]() mutable -> uint32_t {
+        return ForceHumanControlTick(playerNum, stableIters);
+    });
 }
 
-void ForceHumanControlThread(int playerNum) {
-    LogOut("[INPUT_MOTION] Starting human control force thread for P" + std::to_string(playerNum), true);
+uint32_t ForceHumanControlTick(int playerNum, int& stableIters) {
+    if (!g_forceHumanControlActive.load() || g_isShuttingDown.load() || g_onlineModeActive.load()) {
+        LogOut("[INPUT_MOTION] Human control force task terminated", true);
+        return TaskScheduler::kDone;
+    }
     int sleepMs = 16;
-    int stableIters = 0;
-    while (g_forceHumanControlActive.load() && !g_isShuttingDown.load() && !g_onlineModeActive.load()) {
-        // Read current flag to avoid unnecessary writes
-        bool alreadyHuman = IsAIControlFlagHuman(playerNum);
-        if (!alreadyHuman) {
-            SetAIControlFlag(playerNum, true);
-            sleepMs = 16;
-            stableIters = 0;
-        } else {
-            // Back off progressively when stable
-            stableIters++;
-            if (stableIters > 15) sleepMs = 32;   // ~31 Hz
-            if (stableIters > 60) sleepMs = 64;   // ~16 Hz
-            if (stableIters > 180) sleepMs = 128; // ~8 Hz
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+    // Read current flag to avoid unnecessary writes
+    bool alreadyHuman = IsAIControlFlagHuman(playerNum);
+    if (!alreadyHuman) {
+        SetAIControlFlag(playerNum, true);
+        stableIters = 0;
+    } else {
+        // Back off progressively when stable
+        stableIters++;
+        if (stableIters > 15) sleepMs = 32;   // ~31 Hz
+        if (stableIters > 60) sleepMs = 64;   // ~16 Hz
+        if (stableIters > 180) sleepMs = 128; // ~8 Hz
     }
-    
-    LogOut("[INPUT_MOTION] Human control force thread terminated", true);
+    return (uint32_t)sleepMs * 1000;
 }
 
 bool HoldUp(int playerNum) {
@@ -0,0 +1,264 @@
+#include "../include/input/motion_recognizer.h"
+#include "../include/input/motion_constants.h"
+#include "../include/input/input_core.h"
+#include "../include/input/input_buffer.h"
+#include "../include/game/per_frame_sample.h"
+#include "../include/core/constants.h"
+#include "../include/core/fast_log.h"
+#include <cstring>
+#include <mutex>
+
+namespace {
+    using MotionRecognizer::MotionFamily;
+    using MotionRecognizer::MotionHit;
+    using MotionRecognizer::kMaxPatternLength;
+
+    // Single source of truth for special/super motion families. Keep in sync with motion_constants.h.
+    const MotionFamily kFamilies[] = {
+        { "236",        "236",        { MOTION_236A, MOTION_236B, MOTION_236C, MOTION_236D }, false },
+        { "623",        "623",        { MOTION_623A, MOTION_623B, MOTION_623C, MOTION_623D }, false },
+        { "214",        "214",        { MOTION_214A, MOTION_214B, MOTION_214C, MOTION_214D }, false },
+        { "421",        "421",        { MOTION_421A, MOTION_421B, MOTION_421C, MOTION_421D }, false },
+        { "41236",      "41236",      { MOTION_41236A, MOTION_41236B, MOTION_41236C, MOTION_41236D }, false },
+        { "236236",     "236236",     { MOTION_236236A, MOTION_236236B, MOTION_236236C, MOTION_236236D }, false },
+        { "214214",     "214214",     { MOTION_214214A, MOTION_214214B, MOTION_214214C, MOTION_214214D }, false },
+        { "641236",     "641236",     { MOTION_641236A, MOTION_641236B, MOTION_641236C, MOTION_641236D }, false },
+        { "412",        "412",        { MOTION_412A, MOTION_412B, MOTION_412C, MOTION_412D }, false },
+        { "22",         "252",        { MOTION_22A, MOTION_22B, MOTION_22C, MOTION_22D }, false },
+        { "214236",     "214236",     { MOTION_214236A, MOTION_214236B, MOTION_214236C, MOTION_214236D }, false },
+        { "463214",     "463214",     { MOTION_463214A, MOTION_463214B, MOTION_463214C, MOTION_463214D }, false },
+        { "4123641236", "4123641236", { MOTION_4123641236A, MOTION_4123641236B, MOTION_4123641236C, MOTION_4123641236D }, false },
+        { "6321463214", "6321463214", { MOTION_6321463214A, MOTION_6321463214B, MOTION_6321463214C, MOTION_6321463214D }, false },
+        { "Forward Dash", "656",      { MOTION_FORWARD_DASH, 0, 0, 0 }, true },
+        { "Back Dash",    "454",      { MOTION_BACK_DASH, 0, 0, 0 }, true },
+    };
+    constexpr size_t kFamilyCount = sizeof(kFamilies) / sizeof(kFamilies[0]);
+    static_assert(kFamilyCount <= (size_t)MotionRecognizer::kMaxFamilies, "raise kMaxFamilies");
+
+    const uint8_t kButtonBits[4] = { GAME_INPUT_A, GAME_INPUT_B, GAME_INPUT_C, GAME_INPUT_D };
+
+    // KMP automaton over numpad symbols 1..9 for one family
+    struct Compiled {
+        uint8_t len;
+        bool    ignoresNeutral;                         // pattern has no 5: neutral entries are skipped
+        uint8_t next[kMaxPatternLength + 1][10];
+    };
+
+    const Compiled* CompiledFamilies() {
+        static const struct Table {
+            Compiled c[kFamilyCount];
+            Table() {
+                for (size_t f = 0; f < kFamilyCount; ++f) {
+                    Compiled& k = c[f];
+                    memset(&k, 0, sizeof(k));
+                    const char* p = kFamilies[f].dirs;
+                    const int m = (int)strlen(p);
+                    k.len = (uint8_t)m;
+                    k.ignoresNeutral = strchr(p, '5') == nullptr;
+                    k.next[0][p[0] - '0'] = 1;
+                    int x = 0; // state reached by the pattern minus its first symbol
+                    for (int j = 1; j <= m; ++j) {
+                        for (int sym = 0; sym < 10; ++sym) k.next[j][sym] = k.next[x][sym];
+                        if (j < m) {
+                            k.next[j][p[j] - '0'] = (uint8_t)(j + 1);
+                            x = k.next[x][p[j] - '0'];
+                        }
+                    }
+                }
+            }
+        } table;
+        return table.c;
+    }
+
+    uint8_t NumpadSymbol(uint8_t mask) {
+        const bool u = (mask & GAME_INPUT_UP) != 0, d = (mask & GAME_INPUT_DOWN) != 0;
+        const bool l = (mask & GAME_INPUT_LEFT) != 0, r = (mask & GAME_INPUT_RIGHT) != 0;
+        const int vert = (u && !d) ? 2 : (d && !u) ? 0 : 1;      // row: 0 = down, 1 = middle, 2 = up
+        const int horz = (l && !r) ? 0 : (r && !l) ? 2 : 1;      // column: 0 = back, 2 = forward
+        return (uint8_t)(vert * 3 + horz + 1);
+    }
+
+    struct PlayerFeed {
+        MotionRecognizer::Matcher matcher;
+        bool      synced = false;
+        uintptr_t base = 0;
+        uint16_t  lastIndex = 0;
+        int       tickHitCount = 0;
+        MotionHit tickHits[MotionRecognizer::kMaxHitsPerTick];
+    };
+    PlayerFeed s_feed[2];
+
+    // Recent hits for the GUI (written only when a motion completes)
+    std::mutex s_recentMutex;
+    MotionHit s_recent[2][MotionRecognizer::kRecentHits];
+    int s_recentCount[2] = { 0, 0 };
+    int s_recentHead[2] = { 0, 0 };
+}
+
+namespace MotionRecognizer {
+
+const MotionFamily* FindFamily(int motionId, int* buttonIndex) {
+    if (motionId == MOTION_NONE) return nullptr;
+    for (const MotionFamily& f : kFamilies) {
+        for (int b = 0; b < 4; ++b) {
+            if (f.ids[b] == motionId) {
+                if (buttonIndex) *buttonIndex = b;
+                return &f;
+            }
+        }
+    }
+    return nullptr;
+}
+
+size_t FamilyCount() { return kFamilyCount; }
+const MotionFamily& Family(size_t index) { return kFamilies[index < kFamilyCount ? index : 0]; }
+
+Matcher::Matcher() {
+    Reset();
+}
+
+void Matcher::Reset() {
+    memset(m_states, 0, sizeof(m_states));
+    m_entry = 0;
+    m_prevSymbol = 5;
+    m_prevButtons = 0;
+}
+
+int Matcher::Feed(uint8_t mask, bool facingRight, MotionHit* out, int max) {
+    const Compiled* compiled = CompiledFamilies();
+    if (!facingRight) {
+        // Mirror to P1-facing
+        const uint8_t lr = mask & (GAME_INPUT_LEFT | GAME_INPUT_RIGHT);
+        mask = (uint8_t)((mask & ~(GAME_INPUT_LEFT | GAME_INPUT_RIGHT)) |
+                         ((lr & GAME_INPUT_LEFT) ? GAME_INPUT_RIGHT : 0) | ((lr & GAME_INPUT_RIGHT) ? GAME_INPUT_LEFT : 0));
+    }
+    const uint32_t now = ++m_entry;
+    const uint8_t sym = NumpadSymbol(mask);
+    const uint8_t buttons = mask & (GAME_INPUT_A | GAME_INPUT_B | GAME_INPUT_C | GAME_INPUT_D);
+    const uint8_t pressed = buttons & (uint8_t)~m_prevButtons;
+    const bool dirChanged = sym != m_prevSymbol;
+    m_prevSymbol = sym;
+    m_prevButtons = buttons;
+
+    // Families that end on the same entry overlap (236 inside 41236): report only the longest
+    int best = -1, bestButton = -1;
+    uint32_t fired = 0;
+    for (size_t f = 0; f < kFamilyCount; ++f) {
+        const Compiled& c = compiled[f];
+        FamilyState& st = m_states[f];
+        if (dirChanged && !(sym == 5 && c.ignoresNeutral)) {
+            uint8_t s = st.state;
+            if (s > 0 && now - st.stepAt[s] > kStepGap) s = 0;
+            const uint8_t k = c.next[s][sym];
+            // The new partial match is the last k-1 matched directions plus this one
+            for (int i = 1; i < k; ++i) st.stepAt[i] = st.stepAt[s - k + 1 + i];
+            if (k) st.stepAt[k] = now;
+            st.state = k;
+        }
+        if (st.state != c.len) continue;
+
+        int b = -1;
+        if (kFamilies[f].buttonless) {
+            if (!dirChanged || st.stepAt[c.len] != now) continue;
+        } else {
+            if (!pressed || now - st.stepAt[c.len] > kButtonWindow) continue;
+            for (b = 0; b < 4 && !(pressed & kButtonBits[b]); ++b) {}
+        }
+        fired |= 1u << f;
+        if (best < 0 || c.len > compiled[best].len) {
+            best = (int)f;
+            bestButton = b;
+        }
+    }
+    if (best < 0) return 0;
+
+    const Compiled& c = compiled[best];
+    FamilyState& st = m_states[best];
+    if (max > 0) {
+        MotionHit& h = out[0];
+        h.motionId = kFamilies[best].ids[bestButton < 0 ? 0 : bestButton];
+        h.button = bestButton < 0 ? 0 : kButtonBits[bestButton];
+        h.player = 0;
+        h.frames = (uint16_t)(now - st.stepAt[1]);
+        h.buttonLag = (uint16_t)(now - st.stepAt[c.len]);
+        h.entry = now;
+    }
+    // Consume the input: every family completed by this entry restarts
+    for (size_t f = 0; f < kFamilyCount; ++f) {
+        if (fired & (1u << f)) m_states[f].state = 0;
+    }
+    return max > 0 ? 1 : 0;
+}
+
+void Update(const PerFrameSample& sample) {
+    for (int p = 0; p < 2; ++p) {
+        PlayerFeed& feed = s_feed[p];
+        feed.tickHitCount = 0;
+        const PlayerSnapshot& ps = sample.Player(p + 1);
+        uint16_t idx = 0;
+        if (!ps.TryGet(INPUT_BUFFER_INDEX_OFFSET, idx) || idx >= INPUT_BUFFER_SIZE) {
+            feed.synced = false;
+            continue;
+        }
+        if (!feed.synced || feed.base != ps.base) {
+            // (Re)attach: start from the current index instead of replaying old history
+            feed.matcher.Reset();
+            feed.synced = true;
+            feed.base = ps.base;
+            feed.lastIndex = idx;
+            continue;
+        }
+        const bool facingRight = ps.Get<uint8_t>(FACING_DIRECTION_OFFSET) != 255;
+        const uint16_t fresh = (uint16_t)((idx + INPUT_BUFFER_SIZE - feed.lastIndex) % INPUT_BUFFER_SIZE);
+        for (uint16_t i = 0; i < fresh; ++i) {
+            const uint16_t pos = (uint16_t)((feed.lastIndex + i) % INPUT_BUFFER_SIZE);
+            const uint8_t mask = ps.raw[INPUT_BUFFER_OFFSET + pos];
+            feed.tickHitCount += feed.matcher.Feed(mask, facingRight, feed.tickHits + feed.tickHitCount,
+                                                   kMaxHitsPerTick - feed.tickHitCount);
+        }
+        feed.lastIndex = idx;
+        if (!feed.tickHitCount) continue;
+
+        std::lock_guard<std::mutex> lock(s_recentMutex);
+        for (int h = 0; h < feed.tickHitCount; ++h) {
+            MotionHit& hit = feed.tickHits[h];
+            hit.player = (uint8_t)(p + 1);
+            s_recent[p][s_recentHead[p]] = hit;
+            s_recentHead[p] = (s_recentHead[p] + 1) % kRecentHits;
+            if (s_recentCount[p] < kRecentHits) ++s_recentCount[p];
+            int bi = 0;
+            const MotionFamily* fam = FindFamily(hit.motionId, &bi);
+            EFZ_LOG(LogCat::Motion, detailedLogging.load(), "[MOTION] P%d %s%s frames=%u lag=%u entry=%u",
+                    p + 1, fam ? fam->name : "?", (fam && !fam->buttonless) ? (bi == 3 ? "S" : bi == 2 ? "C" : bi == 1 ? "B" : "A") : "",
+                    (unsigned)hit.frames, (unsigned)hit.buttonLag, (unsigned)hit.entry);
+        }
+    }
+}
+
+void Reset() {
+    for (PlayerFeed& feed : s_feed) {
+        feed.synced = false;
+        feed.tickHitCount = 0;
+    }
+}
+
+int GetTickHits(int player, MotionHit* out, int max) {
+    if (player < 1 || player > 2) return 0;
+    const PlayerFeed& feed = s_feed[player - 1];
+    int n = feed.tickHitCount < max ? feed.tickHitCount : max;
+    for (int i = 0; i < n; ++i) out[i] = feed.tickHits[i];
+    return n;
+}
+
+int GetRecentHits(int player, MotionHit* out, int max) {
+    if (player < 1 || player > 2) return 0;
+    std::lock_guard<std::mutex> lock(s_recentMutex);
+    const int p = player - 1;
+    int n = s_recentCount[p] < max ? s_recentCount[p] : max;
+    for (int i = 0; i < n; ++i) {
+        out[i] = s_recent[p][(s_recentHead[p] - 1 - i + kRecentHits) % kRecentHits];
+    }
+    return n;
+}
+
+} // namespace MotionRecognizer
@@ -0,0 +1,123 @@
+#include "../include/input/motion_templates.h"
+#include "../include/input/motion_constants.h"
+#include "../include/input/input_core.h"
+
+namespace MotionTemplates {
+
+namespace {
+    constexpr uint8_t kA = GAME_INPUT_A, kB = GAME_INPUT_B, kC = GAME_INPUT_C, kD = GAME_INPUT_D;
+
+    // Numpad notation, P1-facing (6 = forward = RIGHT)
+    constexpr uint8_t NumpadToMask(char c) {
+        switch (c) {
+            case '1': return GAME_INPUT_DOWN | GAME_INPUT_LEFT;
+            case '2': return GAME_INPUT_DOWN;
+            case '3': return GAME_INPUT_DOWN | GAME_INPUT_RIGHT;
+            case '4': return GAME_INPUT_LEFT;
+            case '6': return GAME_INPUT_RIGHT;
+            case '7': return GAME_INPUT_UP | GAME_INPUT_LEFT;
+            case '8': return GAME_INPUT_UP;
+            case '9': return GAME_INPUT_UP | GAME_INPUT_RIGHT;
+            default:  return 0;
+        }
+    }
+
+    constexpr uint8_t Mirror(uint8_t m) {
+        uint8_t out = static_cast<uint8_t>(m & ~(GAME_INPUT_LEFT | GAME_INPUT_RIGHT));
+        if (m & GAME_INPUT_LEFT) out |= GAME_INPUT_RIGHT;
+        if (m & GAME_INPUT_RIGHT) out |= GAME_INPUT_LEFT;
+        return out;
+    }
+
+    // "236" + C -> 2 x3, 3 x3, 6+C x6. A '5' before the last step is a short neutral separator;
+    // a lone "5" is a standing normal.
+    constexpr Sequence Build(const char* numpad, uint8_t button, bool facingRight) {
+        Sequence s{};
+        int steps = 0;
+        while (numpad[steps]) ++steps;
+        int n = 0;
+        for (int i = 0; i < steps; ++i) {
+            const bool last = (i == steps - 1);
+            uint8_t mask = NumpadToMask(numpad[i]);
+            if (!facingRight) mask = Mirror(mask);
+            int frames = kDirFrames;
+            if (last && button) frames = kButtonFrames;
+            else if (!last && numpad[i] == '5') frames = kNeutralFrames;
+            if (last) mask = static_cast<uint8_t>(mask | button);
+            for (int f = 0; f < frames && n < kMaxFrames; ++f) s.frames[n++] = mask;
+        }
+        s.length = static_cast<uint8_t>(n);
+        s.button = button;
+        return s;
+    }
+
+    struct Template {
+        int id;
+        Sequence facing[2];     // [0] facing right, [1] facing left
+    };
+
+    constexpr Template Make(int id, const char* numpad, uint8_t button) {
+        return Template{ id, { Build(numpad, button, true), Build(numpad, button, false) } };
+    }
+
+#define EFZ_MOTION_ABCD(prefix, numpad) \
+    Make(prefix##A, numpad, kA), Make(prefix##B, numpad, kB), Make(prefix##C, numpad, kC), Make(prefix##D, numpad, kD)
+
+    constexpr Template kTemplates[] = {
+        // Normals: direction held with the button
+        EFZ_MOTION_ABCD(MOTION_5, "5"),
+        EFZ_MOTION_ABCD(MOTION_2, "2"),
+        EFZ_MOTION_ABCD(MOTION_J, "8"),
+        EFZ_MOTION_ABCD(MOTION_6, "6"),
+        EFZ_MOTION_ABCD(MOTION_4, "4"),
+        // Specials / supers
+        EFZ_MOTION_ABCD(MOTION_236, "236"),
+        EFZ_MOTION_ABCD(MOTION_623, "623"),
+        EFZ_MOTION_ABCD(MOTION_214, "214"),
+        EFZ_MOTION_ABCD(MOTION_421, "214"),         // entered as down, down-back, back
+        EFZ_MOTION_ABCD(MOTION_41236, "41236"),
+        EFZ_MOTION_ABCD(MOTION_236236, "236236"),
+        EFZ_MOTION_ABCD(MOTION_214214, "214214"),
+        EFZ_MOTION_ABCD(MOTION_641236, "641236"),
+        EFZ_MOTION_ABCD(MOTION_412, "412"),
+        EFZ_MOTION_ABCD(MOTION_22, "252"),
+        EFZ_MOTION_ABCD(MOTION_214236, "214236"),
+        EFZ_MOTION_ABCD(MOTION_463214, "463214"),
+        EFZ_MOTION_ABCD(MOTION_4123641236, "4123641236"),
+        EFZ_MOTION_ABCD(MOTION_6321463214, "6321463214"),
+        // Dashes: F, N, F / B, N, B
+        Make(MOTION_FORWARD_DASH, "656", 0),
+        Make(MOTION_BACK_DASH, "454", 0),
+    };
+
+#undef EFZ_MOTION_ABCD
+
+    constexpr int kTemplateCount = static_cast<int>(sizeof(kTemplates) / sizeof(kTemplates[0]));
+    constexpr int kMaxMotionId = MOTION_BACK_DASH;
+
+    // Direct id -> template lookup (0 = none, otherwise index + 1)
+    struct IdIndex { uint8_t slot[kMaxMotionId + 1]; };
+    constexpr IdIndex BuildIndex() {
+        IdIndex x{};
+        for (int i = 0; i < kTemplateCount; ++i) x.slot[kTemplates[i].id] = static_cast<uint8_t>(i + 1);
+        return x;
+    }
+    constexpr IdIndex kIndex = BuildIndex();
+
+    static_assert(kTemplateCount < 255, "template index is a byte");
+    static_assert(kTemplates[kIndex.slot[MOTION_236A] - 1].facing[0].length == 2 * kDirFrames + kButtonFrames,
+                  "236 template length");
+    static_assert(kTemplates[kIndex.slot[MOTION_6321463214D] - 1].facing[0].length <= kMaxFrames,
+                  "kMaxFrames too small for the longest motion");
+    static_assert(kTemplates[kIndex.slot[MOTION_FORWARD_DASH] - 1].facing[1].frames[0] == GAME_INPUT_LEFT,
+                  "forward dash mirrors when facing left");
+}
+
+const Sequence* Find(int motionId, bool facingRight) {
+    if (motionId < 0 || motionId > kMaxMotionId) return nullptr;
+    const uint8_t slot = kIndex.slot[motionId];
+    if (!slot) return nullptr;
+    return &kTemplates[slot - 1].facing[facingRight ? 0 : 1];
+}
+
+} // namespace MotionTemplates
@@ -255,6 +255,10 @@ namespace Config {
             file << "; Default: 10000 (10 seconds). Set 0 to toggle immediately on any neutral edge.\n";
             file << "autoBlockNeutralTimeoutMs = 10000\n\n";
 
+            file << "; Macro recorder memory budget in KB (per slot / all slots). Recording stops when exceeded.\n";
+            file << "macroSlotBudgetKB = 4096\n";
+            file << "macroTotalBudgetKB = 16384\n\n";
+
             file << "; Virtual Cursor (software controller-driven cursor) settings\n";
             file << "; Master enable (1=on,0=off)\n";
             file << "enableVirtualCursor = 1\n";
@@ -535,6 +539,11 @@ namespace Config {
             }
             // Practice: neutral timeout for dummy auto-block modes (ms)
             settings.autoBlockNeutralTimeoutMs = GetValueInt("General", "autoBlockNeutralTimeoutMs", 10000);
+            // Macro recorder memory budget (KB)
+            settings.macroSlotBudgetKB = GetValueInt("General", "macroSlotBudgetKB", 4096);
+            settings.macroTotalBudgetKB = GetValueInt("General", "macroTotalBudgetKB", 16384);
+            if (settings.macroSlotBudgetKB < 64) settings.macroSlotBudgetKB = 64;
+            if (settings.macroTotalBudgetKB < settings.macroSlotBudgetKB) settings.macroTotalBudgetKB = settings.macroSlotBudgetKB;
             
             // Hotkey settings - REVERTED to number key defaults
             settings.teleportKey = GetValueInt("Hotkeys", "TeleportKey", 0x31);          // Default: '1'
@@ -693,6 +702,9 @@ namespace Config {
             // Practice options
             file << "; Practice: Dummy Auto-Block neutral timeout (ms) for First Hit/After First Hit modes.\n";
             file << "autoBlockNeutralTimeoutMs = " << settings.autoBlockNeutralTimeoutMs << "\n\n";
+            file << "; Macro recorder memory budget in KB (per slot / all slots)\n";
+            file << "macroSlotBudgetKB = " << settings.macroSlotBudgetKB << "\n";
+            file << "macroTotalBudgetKB = " << settings.macroTotalBudgetKB << "\n\n";
             file << "; Virtual Cursor settings\n";
             file << "enableVirtualCursor = " << (settings.enableVirtualCursor?"1":"0") << "\n";
             file << "virtualCursorAllowWindowed = " << (settings.virtualCursorAllowWindowed?"1":"0") << "\n";
@@ -816,6 +828,8 @@ namespace Config {
             if (k == "autofixhponneutral") settings.autoFixHPOnNeutral = (value == "1");
             if (k == "frameadvantagedisplayduration") { try { settings.frameAdvantageDisplayDuration = std::stof(value); } catch(...){} }
             if (k == "autoblockneutraltimeoutms") { try { settings.autoBlockNeutralTimeoutMs = std::stoi(value); } catch(...) { settings.autoBlockNeutralTimeoutMs = 10000; } }
+            if (k == "macroslotbudgetkb") { try { settings.macroSlotBudgetKB = std::stoi(value); } catch(...) { settings.macroSlotBudgetKB = 4096; } if (settings.macroSlotBudgetKB < 64) settings.macroSlotBudgetKB = 64; if (settings.macroTotalBudgetKB < settings.macroSlotBudgetKB) settings.macroTotalBudgetKB = settings.macroSlotBudgetKB; }
+            if (k == "macrototalbudgetkb") { try { settings.macroTotalBudgetKB = std::stoi(value); } catch(...) { settings.macroTotalBudgetKB = 16384; } if (settings.macroTotalBudgetKB < settings.macroSlotBudgetKB) settings.macroTotalBudgetKB = settings.macroSlotBudgetKB; }
         }
         else if (sec == "hotkeys") {
             int intValue = ParseKeyValue(value);
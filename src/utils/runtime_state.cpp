@@ -0,0 +1,319 @@
+// Runtime state shared by the feature logic: trigger / auto-action settings, practice toggles,
+// the cached base-pointer lookups and the MoveProps-backed move predicates. Nothing here touches
+// hooks, windows or the console, so tools/trace_replay links this file on any host.
+#include "../include/utils/utilities.h"
+
+#include "../include/core/constants.h"
+#include "../include/core/fast_log.h"
+#include "../include/core/memory.h"
+#include "../include/game/auto_action.h"
+#include "../include/game/frame_monitor.h"
+#include "../include/game/move_props.h"
+
+std::atomic<int> frameCounter(0);
+std::atomic<bool> detailedLogging(false);
+std::atomic<bool> autoAirtechEnabled(false);
+std::atomic<int> autoAirtechDirection(0);  // 0=forward, 1=backward
+std::atomic<bool> autoJumpEnabled(false);     // This was missing!
+std::atomic<int> jumpDirection(0);            // 0=straight, 1=forward, 2=backward
+std::atomic<bool> p1Jumping(false);
+std::atomic<bool> p2Jumping(false);
+std::atomic<int> jumpTarget(3);
+DisplayData displayData{};
+
+std::atomic<bool> g_onlineModeActive(false);
+// Suppress auto-action clear logging (used for one-shot CS persistent clear)
+std::atomic<bool> g_suppressAutoActionClearLogging(false);
+
+// NEW: Define the manual input override atomics
+std::atomic<bool> g_manualInputOverride[3] = {false, false, false};
+std::atomic<uint8_t> g_manualInputMask[3] = {0, 0, 0};
+std::atomic<bool> g_manualJumpHold[3] = {false, false, false}; // NEW: Definition for jump hold
+
+// Continuous Recovery runtime settings (defaults)
+std::atomic<bool> g_contRecoveryEnabled{false};
+std::atomic<int>  g_contRecoveryApplyTo{3}; // default Both
+std::atomic<int>  g_contRecHpMode{0};
+std::atomic<int>  g_contRecHpCustom{MAX_HP};
+std::atomic<int>  g_contRecMeterMode{0};
+std::atomic<int>  g_contRecMeterCustom{MAX_METER};
+std::atomic<int>  g_contRecRfMode{0};
+std::atomic<double> g_contRecRfCustom{MAX_RF};
+std::atomic<bool> g_contRecRfForceBlueIC{false};
+
+// NEW: Per-player Continuous Recovery runtime settings (defaults OFF)
+std::atomic<bool> g_contRecEnabledP1{false};
+std::atomic<int>  g_contRecHpModeP1{0};
+std::atomic<int>  g_contRecHpCustomP1{MAX_HP};
+std::atomic<int>  g_contRecMeterModeP1{0};
+std::atomic<int>  g_contRecMeterCustomP1{MAX_METER};
+std::atomic<int>  g_contRecRfModeP1{0};
+std::atomic<double> g_contRecRfCustomP1{MAX_RF};
+std::atomic<bool> g_contRecRfForceBlueICP1{false};
+std::atomic<bool> g_contRecEnabledP2{false};
+std::atomic<int>  g_contRecHpModeP2{0};
+std::atomic<int>  g_contRecHpCustomP2{MAX_HP};
+std::atomic<int>  g_contRecMeterModeP2{0};
+std::atomic<int>  g_contRecMeterCustomP2{MAX_METER};
+std::atomic<int>  g_contRecRfModeP2{0};
+std::atomic<double> g_contRecRfCustomP2{MAX_RF};
+std::atomic<bool> g_contRecRfForceBlueICP2{false};
+
+// Auto-action settings - replace single trigger with individual triggers
+std::atomic<bool> autoActionEnabled(false);
+std::atomic<int> autoActionType(ACTION_5A);
+std::atomic<int> autoActionCustomID(200); // Default to 5A
+std::atomic<int> autoActionPlayer(2);     // Default to P2 (training dummy)
+
+// Individual trigger settings
+std::atomic<bool> triggerAfterBlockEnabled(false);
+std::atomic<bool> triggerOnWakeupEnabled(false);
+std::atomic<bool> triggerAfterHitstunEnabled(false);
+std::atomic<bool> triggerAfterAirtechEnabled(false);
+std::atomic<bool> triggerOnRGEnabled(false);
+// Global trigger randomization toggle (default OFF)
+std::atomic<bool> triggerRandomizeEnabled(false);
+
+// Delay settings (in visual frames)
+std::atomic<int> triggerAfterBlockDelay(DEFAULT_TRIGGER_DELAY);
+std::atomic<int> triggerOnWakeupDelay(DEFAULT_TRIGGER_DELAY);
+std::atomic<int> triggerAfterHitstunDelay(DEFAULT_TRIGGER_DELAY);
+std::atomic<int> triggerAfterAirtechDelay(DEFAULT_TRIGGER_DELAY);
+std::atomic<int> triggerOnRGDelay(DEFAULT_TRIGGER_DELAY);
+
+// Auto-airtech delay support
+std::atomic<int> autoAirtechDelay(0); // Default to instant activation
+
+// Immediate-only injection flags (index 0 unused)
+std::atomic<bool> g_injectImmediateOnly[3] = {false, false, false};
+
+// Individual action settings for each trigger
+std::atomic<int> triggerAfterBlockAction(ACTION_5A);
+std::atomic<int> triggerOnWakeupAction(ACTION_5A);
+std::atomic<int> triggerAfterHitstunAction(ACTION_5A);
+std::atomic<int> triggerAfterAirtechAction(ACTION_5A);
+std::atomic<int> triggerOnRGAction(ACTION_5A);
+
+// Multi-action pools per trigger (disabled by default)
+std::atomic<uint32_t> triggerAfterBlockActionPoolMask{0};
+std::atomic<uint32_t> triggerOnWakeupActionPoolMask{0};
+std::atomic<uint32_t> triggerAfterHitstunActionPoolMask{0};
+std::atomic<uint32_t> triggerAfterAirtechActionPoolMask{0};
+std::atomic<uint32_t> triggerOnRGActionPoolMask{0};
+std::atomic<bool>     triggerAfterBlockUsePool{false};
+std::atomic<bool>     triggerOnWakeupUsePool{false};
+std::atomic<bool>     triggerAfterHitstunUsePool{false};
+std::atomic<bool>     triggerAfterAirtechUsePool{false};
+std::atomic<bool>     triggerOnRGUsePool{false};
+
+// Runtime per-trigger option rows (populated on Apply)
+int           g_afterBlockOptionCount = 0;
+TriggerOption g_afterBlockOptions[MAX_TRIGGER_OPTIONS] = {};
+int           g_onWakeupOptionCount = 0;
+TriggerOption g_onWakeupOptions[MAX_TRIGGER_OPTIONS] = {};
+int           g_afterHitstunOptionCount = 0;
+TriggerOption g_afterHitstunOptions[MAX_TRIGGER_OPTIONS] = {};
+int           g_afterAirtechOptionCount = 0;
+TriggerOption g_afterAirtechOptions[MAX_TRIGGER_OPTIONS] = {};
+int           g_onRGOptionCount = 0;
+TriggerOption g_onRGOptions[MAX_TRIGGER_OPTIONS] = {};
+
+// Forward dash follow-up selection (0=None, 1=5A,2=5B,3=5C,4=2A,5=2B,6=2C)
+std::atomic<int> forwardDashFollowup(0);
+// 0 = post-dash injection (existing behavior), 1 = dash-normal timing (inject during dash state window)
+std::atomic<bool> forwardDashFollowupDashMode(false);
+
+// Custom action IDs for each trigger
+std::atomic<int> triggerAfterBlockCustomID{ (int)BASE_ATTACK_5A };
+std::atomic<int> triggerOnWakeupCustomID{ (int)BASE_ATTACK_5A };
+std::atomic<int> triggerAfterHitstunCustomID{ (int)BASE_ATTACK_5A };
+std::atomic<int> triggerAfterAirtechCustomID{ (int)BASE_ATTACK_JA };  // Default to jumping A for airtech
+std::atomic<int> triggerOnRGCustomID{ (int)BASE_ATTACK_5A };
+
+// Individual strength settings (0=A, 1=B, 2=C, 3=D)
+std::atomic<int> triggerAfterBlockStrength(0);
+std::atomic<int> triggerOnWakeupStrength(0);
+std::atomic<int> triggerAfterHitstunStrength(0);
+std::atomic<int> triggerAfterAirtechStrength(0);
+std::atomic<int> triggerOnRGStrength(0);
+
+// Per-trigger macro slot selections (0=None, 1..MaxSlots)
+std::atomic<int> triggerAfterBlockMacroSlot{ 0 };
+std::atomic<int> triggerOnWakeupMacroSlot{ 0 };
+std::atomic<int> triggerAfterHitstunMacroSlot{ 0 };
+std::atomic<int> triggerAfterAirtechMacroSlot{ 0 };
+std::atomic<int> triggerOnRGMacroSlot{ 0 };
+
+// Debug/experimental: allow buffering (pre-freeze) of wakeup specials/supers/dashes instead of f1 injection
+std::atomic<bool> g_wakeBufferingEnabled{false};
+
+// Global toggle: enable/disable Counter RG early-restore behavior (default OFF)
+std::atomic<bool> g_counterRGEnabled{false};
+
+// UI: gate for the regular Frame Advantage overlay (default ON)
+std::atomic<bool> g_showFrameAdvantageOverlay{true};
+
+// Deep frame advantage instrumentation toggle
+std::atomic<bool> g_deepFrameAdvDebug{false};
+
+// --- Lightweight shared positions cache -------------------------------
+static std::atomic<double> s_cachedP1Y{0.0};
+static std::atomic<double> s_cachedP2Y{0.0};
+static std::atomic<unsigned long long> s_posCacheTickMs{0};
+
+void UpdatePositionCache(double /*p1X*/, double p1Y, double /*p2X*/, double p2Y) {
+    s_cachedP1Y.store(p1Y, std::memory_order_relaxed);
+    s_cachedP2Y.store(p2Y, std::memory_order_relaxed);
+    s_posCacheTickMs.store(GetTickCount64(), std::memory_order_relaxed);
+}
+
+bool TryGetCachedYPositions(double &p1Y, double &p2Y, unsigned int maxAgeMs) {
+    unsigned long long t = s_posCacheTickMs.load(std::memory_order_relaxed);
+    if (t == 0) return false;
+    unsigned long long now = GetTickCount64();
+    if (now - t > static_cast<unsigned long long>(maxAgeMs)) return false;
+    p1Y = s_cachedP1Y.load(std::memory_order_relaxed);
+    p2Y = s_cachedP2Y.load(std::memory_order_relaxed);
+    return true;
+}
+
+// Cached EFZ base module handle to avoid repeated GetModuleHandleA calls.
+namespace { std::atomic<uintptr_t> g_cachedEfzBase{0}; }
+
+uintptr_t GetEFZBase() {
+    uintptr_t val = g_cachedEfzBase.load(std::memory_order_acquire);
+    if (val) return val;
+    val = GetGameMemory().ModuleBase(); // live process: GetModuleHandleA(NULL)
+    if (!val) return 0;
+    g_cachedEfzBase.store(val, std::memory_order_release);
+    return val;
+}
+
+void InvalidateEFZBaseCache() { g_cachedEfzBase.store(0, std::memory_order_release); }
+
+// -----------------------------------------------------------------------------
+// Game state pointer caching
+// The game state object (at EFZ_BASE_OFFSET_GAME_STATE) is allocated once at
+// startup (initializeGameSystem). Its pointer remains stable; internal fields
+// are reset between matches. Safe to cache for lifetime of process unless we
+// explicitly disable features / enter online mode.
+namespace { std::atomic<uintptr_t> g_cachedGameState{0}; }
+
+uintptr_t GetGameStatePtr() {
+    uintptr_t gs = g_cachedGameState.load(std::memory_order_acquire);
+    if (gs) return gs;
+    uintptr_t base = GetEFZBase(); if (!base) return 0;
+    uintptr_t tmp = 0; if (!ReadGamePointer(base + EFZ_BASE_OFFSET_GAME_STATE, tmp)) return 0;
+    if (tmp) g_cachedGameState.store(tmp, std::memory_order_release);
+    return tmp;
+}
+
+void InvalidateGameStatePtrCache() { g_cachedGameState.store(0, std::memory_order_release); }
+
+bool AreCharactersInitialized() {
+    uintptr_t base = GetEFZBase();
+    if (!base) {
+        return false;
+    }
+
+    // Check if both P1 and P2 character pointers exist
+    uintptr_t p1StructAddr = 0;
+    uintptr_t p2StructAddr = 0;
+    ReadGamePointer(base + EFZ_BASE_OFFSET_P1, p1StructAddr);
+    ReadGamePointer(base + EFZ_BASE_OFFSET_P2, p2StructAddr);
+
+    // Check if both pointers are valid and at least one has a non-zero HP value
+    if (p1StructAddr && p2StructAddr) {
+        int hp1 = 0, hp2 = 0;
+        uintptr_t hp1Addr = p1StructAddr + HP_OFFSET;
+        uintptr_t hp2Addr = p2StructAddr + HP_OFFSET;
+
+        SafeReadMemory(hp1Addr, &hp1, sizeof(int));
+        SafeReadMemory(hp2Addr, &hp2, sizeof(int));
+
+        // Consider initialized if both pointers exist and at least one has HP
+        return (hp1 > 0 || hp2 > 0);
+    }
+    
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Player base pointer caching
+// Player pointers (EFZ_BASE_OFFSET_P1/P2) are set to 0 at startup and populated
+// during character load sequences. They are reused for each match but may be
+// re-assigned when returning to character select and starting a new battle.
+// Strategy:
+//  - Cache after first successful read when AreCharactersInitialized()==true
+//  - Invalidate when AreCharactersInitialized()==false OR screen state != Battle (3)
+//  - Provide explicit invalidation for feature disable / online entry.
+namespace { std::atomic<uintptr_t> g_cachedPlayerBase[3] = {0,0,0}; }
+
+static bool ShouldInvalidatePlayerCache() {
+    // When characters not initialized, cached bases invalid.
+    if (!AreCharactersInitialized()) return true;
+    // Screen state check: only trust during battle (3) and possibly win (5) for post-match reads.
+    uint8_t screenState = 0; uintptr_t base = GetEFZBase();
+    if (base) SafeReadMemory(base + EFZ_BASE_OFFSET_SCREEN_STATE, &screenState, sizeof(screenState));
+    if (screenState != 3 && screenState != 5) return true; // battle or win screen retain
+    return false;
+}
+
+uintptr_t GetPlayerBase(int playerIndex) {
+    if (playerIndex != 1 && playerIndex != 2) return 0;
+    if (ShouldInvalidatePlayerCache()) {
+        uintptr_t had1 = g_cachedPlayerBase[1].exchange(0, std::memory_order_acq_rel);
+        uintptr_t had2 = g_cachedPlayerBase[2].exchange(0, std::memory_order_acq_rel);
+        // Player structs may be freed from here on; drop validated pages once per transition
+        if (had1 || had2) GetGameMemory().InvalidateRegions();
+        return 0;
+    }
+    uintptr_t cached = g_cachedPlayerBase[playerIndex].load(std::memory_order_acquire);
+    if (cached) return cached;
+    uintptr_t base = GetEFZBase(); if (!base) return 0;
+    uintptr_t ptr = 0; uintptr_t off = (playerIndex==1)?EFZ_BASE_OFFSET_P1:EFZ_BASE_OFFSET_P2;
+    if (!ReadGamePointer(base + off, ptr)) return 0;
+    // Basic sanity: require non-null and readable HP field before caching.
+    if (ptr) {
+        int hpDummy=0; if (!SafeReadMemory(ptr + HP_OFFSET, &hpDummy, sizeof(hpDummy))) return 0;
+        g_cachedPlayerBase[playerIndex].store(ptr, std::memory_order_release);
+    }
+    return ptr;
+}
+
+void InvalidatePlayerBaseCache() {
+    g_cachedPlayerBase[1].store(0, std::memory_order_release);
+    g_cachedPlayerBase[2].store(0, std::memory_order_release);
+    GetGameMemory().InvalidateRegions();
+}
+
+// Add these helper functions to better detect state changes
+bool IsActionable(short moveID) {
+    // Neutral whitelist vs. explicit inactionable groups (dash, stun, attack, tech, superflash, ...)
+    uint16_t props = MoveProps::Get(moveID);
+    if (props & MoveProps::Actionable) return true;
+    if (props & MoveProps::Prohibited) return false;
+
+    // Treat unknown states as NOT actionable by default (stricter) but allow debug override
+    static int unknownLogBudget = 0; // refilled periodically elsewhere if needed
+    bool result = false;
+    if (g_deepFrameAdvDebug.load() && unknownLogBudget < 200) { // limit spam
+        EFZ_LOG(LogCat::ActionableDbg, false, "[ACTIONABLE_DBG] Treating unknown moveID %d as NOT actionable", moveID);
+        ++unknownLogBudget;
+    }
+    return result;
+}
+
+// Note: Wakeup triggers use IsActionable directly; CROUCH_TO_STAND_ID (7) is considered
+// actionable so wake actions can fire ASAP when state 96 ends.
+
+bool IsBlockstun(short moveID) {
+    // Guard IDs plus the 140..165 standing/crouching block range, minus forward/back dash
+    // start/recovery + sentinel so the auto-action dash follow-up isn't treated as stun.
+    return MoveProps::Has(moveID, MoveProps::Blockstun);
+}
+
+bool IsRecoilGuard(short moveID) {
+    return MoveProps::Has(moveID, MoveProps::RecoilGuard);
+}
+
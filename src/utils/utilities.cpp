@@ -2,11 +2,15 @@
 
 #include "../include/core/constants.h"
 #include "../include/core/logger.h"
+#include "../include/core/fast_log.h"
 #include "../include/core/memory.h"
+#include "../include/core/memory_txn.h"
 #include "../include/input/input_handler.h"
 #include "../include/core/di_keycodes.h"
 #include "../include/game/frame_analysis.h"   
 #include "../include/game/frame_advantage.h"
+#include "../include/game/move_props.h"
+#include "../include/game/trace_recorder.h"
 #include "../include/utils/config.h"
 #include "../include/gui/imgui_impl.h"
 #include "../include/gui/imgui_gui.h"
@@ -40,45 +44,10 @@
 
 std::atomic<bool> g_efzWindowActive(false);
 std::atomic<bool> g_guiActive(false);
-std::atomic<bool> g_onlineModeActive(false);
-// Suppress auto-action clear logging (used for one-shot CS persistent clear)
-std::atomic<bool> g_suppressAutoActionClearLogging(false);
 // Sticky, one-way hard stop once online is confirmed
 static std::atomic<bool> g_hardStoppedOnce{false};
 
-// NEW: Define the manual input override atomics
-std::atomic<bool> g_manualInputOverride[3] = {false, false, false};
-std::atomic<uint8_t> g_manualInputMask[3] = {0, 0, 0};
-std::atomic<bool> g_manualJumpHold[3] = {false, false, false}; // NEW: Definition for jump hold
-
-// Continuous Recovery runtime settings (defaults)
-std::atomic<bool> g_contRecoveryEnabled{false};
-std::atomic<int>  g_contRecoveryApplyTo{3}; // default Both
-std::atomic<int>  g_contRecHpMode{0};
-std::atomic<int>  g_contRecHpCustom{MAX_HP};
-std::atomic<int>  g_contRecMeterMode{0};
-std::atomic<int>  g_contRecMeterCustom{MAX_METER};
-std::atomic<int>  g_contRecRfMode{0};
-std::atomic<double> g_contRecRfCustom{MAX_RF};
-std::atomic<bool> g_contRecRfForceBlueIC{false};
-
-// NEW: Per-player Continuous Recovery runtime settings (defaults OFF)
-std::atomic<bool> g_contRecEnabledP1{false};
-std::atomic<int>  g_contRecHpModeP1{0};
-std::atomic<int>  g_contRecHpCustomP1{MAX_HP};
-std::atomic<int>  g_contRecMeterModeP1{0};
-std::atomic<int>  g_contRecMeterCustomP1{MAX_METER};
-std::atomic<int>  g_contRecRfModeP1{0};
-std::atomic<double> g_contRecRfCustomP1{MAX_RF};
-std::atomic<bool> g_contRecRfForceBlueICP1{false};
-std::atomic<bool> g_contRecEnabledP2{false};
-std::atomic<int>  g_contRecHpModeP2{0};
-std::atomic<int>  g_contRecHpCustomP2{MAX_HP};
-std::atomic<int>  g_contRecMeterModeP2{0};
-std::atomic<int>  g_contRecMeterCustomP2{MAX_METER};
-std::atomic<int>  g_contRecRfModeP2{0};
-std::atomic<double> g_contRecRfCustomP2{MAX_RF};
-std::atomic<bool> g_contRecRfForceBlueICP2{false};
+// Trigger/auto-action settings, base-pointer lookups and move predicates live in runtime_state.cpp
 
 // (Removed restoration of previous trigger states; triggers must always be manually re-enabled after mode changes)
 
@@ -379,6 +348,12 @@ void DisableFeatures() {
         return;
     
     LogOut("[SYSTEM] Game left valid mode. Disabling patches and overlays.", true);
+
+    // Put back the practice controller flags we journaled (auto-block, block mode, P2 control)
+    // before forcing both sides to human below
+    if (!RevertAllWrites()) {
+        LogOut("[SYSTEM] Some practice flags could not be restored", true);
+    }
     
     // CRITICAL: Restore normal control flags when leaving Practice mode
     // to prevent control swap issues in other modes
@@ -457,27 +432,6 @@ void DisableFeatures() {
     // Key monitoring will be handled separately by ManageKeyMonitoring()
 }
 
-// --- Lightweight shared positions cache -------------------------------
-static std::atomic<double> s_cachedP1Y{0.0};
-static std::atomic<double> s_cachedP2Y{0.0};
-static std::atomic<unsigned long long> s_posCacheTickMs{0};
-
-void UpdatePositionCache(double /*p1X*/, double p1Y, double /*p2X*/, double p2Y) {
-    s_cachedP1Y.store(p1Y, std::memory_order_relaxed);
-    s_cachedP2Y.store(p2Y, std::memory_order_relaxed);
-    s_posCacheTickMs.store(GetTickCount64(), std::memory_order_relaxed);
-}
-
-bool TryGetCachedYPositions(double &p1Y, double &p2Y, unsigned int maxAgeMs) {
-    unsigned long long t = s_posCacheTickMs.load(std::memory_order_relaxed);
-    if (t == 0) return false;
-    unsigned long long now = GetTickCount64();
-    if (now - t > static_cast<unsigned long long>(maxAgeMs)) return false;
-    p1Y = s_cachedP1Y.load(std::memory_order_relaxed);
-    p2Y = s_cachedP2Y.load(std::memory_order_relaxed);
-    return true;
-}
-
 // Cooperatively stop mod activity when entering online play, then hard-stop all hooks/threads.
 void EnterOnlineMode() {
     // Ensure we only run once
@@ -487,6 +441,8 @@ void EnterOnlineMode() {
     LogOut("[ONLINE] Entering online mode: disabling mod features, unhooking, and stopping threads", true);
     // Stop immediate input writer
     ImmediateInput::Stop();
+    // Stop the tick trace recorder (it would capture online state)
+    TraceRecorder::Stop();
 
     // Stop any active buffer/index freezing immediately
     StopBufferFreezing();
@@ -655,16 +611,6 @@ void WriteStartupLog(const std::string& message) {
 }
 
 std::atomic<bool> menuOpen(false);
-std::atomic<int> frameCounter(0);
-std::atomic<bool> detailedLogging(false);
-std::atomic<bool> autoAirtechEnabled(false);
-std::atomic<int> autoAirtechDirection(0);  // 0=forward, 1=backward
-std::atomic<bool> autoJumpEnabled(false);     // This was missing!
-std::atomic<int> jumpDirection(0);            // 0=straight, 1=forward, 2=backward
-std::atomic<bool> p1Jumping(false);
-std::atomic<bool> p2Jumping(false);
-std::atomic<int> jumpTarget(3);
-DisplayData displayData{};
 
 // Initialize key bindings with default values
 KeyBindings detectedBindings = {
@@ -701,103 +647,6 @@ int g_statsAIFlagsId = -1; // new: AI control flags line in stats overlay
 int g_statsBlockstunId = -1; // new: Blockstun counters line
 int g_statsUntechId = -1;    // new: Hitstun/Untech counters line
 
-// Auto-action settings - replace single trigger with individual triggers
-std::atomic<bool> autoActionEnabled(false);
-std::atomic<int> autoActionType(ACTION_5A);
-std::atomic<int> autoActionCustomID(200); // Default to 5A
-std::atomic<int> autoActionPlayer(2);     // Default to P2 (training dummy)
-
-// Individual trigger settings
-std::atomic<bool> triggerAfterBlockEnabled(false);
-std::atomic<bool> triggerOnWakeupEnabled(false);
-std::atomic<bool> triggerAfterHitstunEnabled(false);
-std::atomic<bool> triggerAfterAirtechEnabled(false);
-std::atomic<bool> triggerOnRGEnabled(false);
-// Global trigger randomization toggle (default OFF)
-std::atomic<bool> triggerRandomizeEnabled(false);
-
-// Delay settings (in visual frames)
-std::atomic<int> triggerAfterBlockDelay(DEFAULT_TRIGGER_DELAY);
-std::atomic<int> triggerOnWakeupDelay(DEFAULT_TRIGGER_DELAY);
-std::atomic<int> triggerAfterHitstunDelay(DEFAULT_TRIGGER_DELAY);
-std::atomic<int> triggerAfterAirtechDelay(DEFAULT_TRIGGER_DELAY);
-std::atomic<int> triggerOnRGDelay(DEFAULT_TRIGGER_DELAY);
-
-// Auto-airtech delay support
-std::atomic<int> autoAirtechDelay(0); // Default to instant activation
-
-// Immediate-only injection flags (index 0 unused)
-std::atomic<bool> g_injectImmediateOnly[3] = {false, false, false};
-
-// Individual action settings for each trigger
-std::atomic<int> triggerAfterBlockAction(ACTION_5A);
-std::atomic<int> triggerOnWakeupAction(ACTION_5A);
-std::atomic<int> triggerAfterHitstunAction(ACTION_5A);
-std::atomic<int> triggerAfterAirtechAction(ACTION_5A);
-std::atomic<int> triggerOnRGAction(ACTION_5A);
-
-// Multi-action pools per trigger (disabled by default)
-std::atomic<uint32_t> triggerAfterBlockActionPoolMask{0};
-std::atomic<uint32_t> triggerOnWakeupActionPoolMask{0};
-std::atomic<uint32_t> triggerAfterHitstunActionPoolMask{0};
-std::atomic<uint32_t> triggerAfterAirtechActionPoolMask{0};
-std::atomic<uint32_t> triggerOnRGActionPoolMask{0};
-std::atomic<bool>     triggerAfterBlockUsePool{false};
-std::atomic<bool>     triggerOnWakeupUsePool{false};
-std::atomic<bool>     triggerAfterHitstunUsePool{false};
-std::atomic<bool>     triggerAfterAirtechUsePool{false};
-std::atomic<bool>     triggerOnRGUsePool{false};
-
-// Runtime per-trigger option rows (populated on Apply)
-int           g_afterBlockOptionCount = 0;
-TriggerOption g_afterBlockOptions[MAX_TRIGGER_OPTIONS] = {};
-int           g_onWakeupOptionCount = 0;
-TriggerOption g_onWakeupOptions[MAX_TRIGGER_OPTIONS] = {};
-int           g_afterHitstunOptionCount = 0;
-TriggerOption g_afterHitstunOptions[MAX_TRIGGER_OPTIONS] = {};
-int           g_afterAirtechOptionCount = 0;
-TriggerOption g_afterAirtechOptions[MAX_TRIGGER_OPTIONS] = {};
-int           g_onRGOptionCount = 0;
-TriggerOption g_onRGOptions[MAX_TRIGGER_OPTIONS] = {};
-
-// Forward dash follow-up selection (0=None, 1=5A,2=5B,3=5C,4=2A,5=2B,6=2C)
-std::atomic<int> forwardDashFollowup(0);
-// 0 = post-dash injection (existing behavior), 1 = dash-normal timing (inject during dash state window)
-std::atomic<bool> forwardDashFollowupDashMode(false);
-
-// Custom action IDs for each trigger
-std::atomic<int> triggerAfterBlockCustomID{ (int)BASE_ATTACK_5A };
-std::atomic<int> triggerOnWakeupCustomID{ (int)BASE_ATTACK_5A };
-std::atomic<int> triggerAfterHitstunCustomID{ (int)BASE_ATTACK_5A };
-std::atomic<int> triggerAfterAirtechCustomID{ (int)BASE_ATTACK_JA };  // Default to jumping A for airtech
-std::atomic<int> triggerOnRGCustomID{ (int)BASE_ATTACK_5A };
-
-// Individual strength settings (0=A, 1=B, 2=C, 3=D)
-std::atomic<int> triggerAfterBlockStrength(0);
-std::atomic<int> triggerOnWakeupStrength(0);
-std::atomic<int> triggerAfterHitstunStrength(0);
-std::atomic<int> triggerAfterAirtechStrength(0);
-std::atomic<int> triggerOnRGStrength(0);
-
-// Per-trigger macro slot selections (0=None, 1..MaxSlots)
-std::atomic<int> triggerAfterBlockMacroSlot{ 0 };
-std::atomic<int> triggerOnWakeupMacroSlot{ 0 };
-std::atomic<int> triggerAfterHitstunMacroSlot{ 0 };
-std::atomic<int> triggerAfterAirtechMacroSlot{ 0 };
-std::atomic<int> triggerOnRGMacroSlot{ 0 };
-
-// Debug/experimental: allow buffering (pre-freeze) of wakeup specials/supers/dashes instead of f1 injection
-std::atomic<bool> g_wakeBufferingEnabled{false};
-
-// Global toggle: enable/disable Counter RG early-restore behavior (default OFF)
-std::atomic<bool> g_counterRGEnabled{false};
-
-// UI: gate for the regular Frame Advantage overlay (default ON)
-std::atomic<bool> g_showFrameAdvantageOverlay{true};
-
-// Deep frame advantage instrumentation toggle
-std::atomic<bool> g_deepFrameAdvDebug{false};
-
 void EnsureLocaleConsistency() {
     static bool localeSet = false;
     if (!localeSet) {
@@ -814,175 +663,6 @@ std::string FormatPosition(double x, double y) {
     return ss.str();
 }
 
-// Cached EFZ base module handle to avoid repeated GetModuleHandleA calls.
-namespace { std::atomic<uintptr_t> g_cachedEfzBase{0}; }
-
-uintptr_t GetEFZBase() {
-    uintptr_t val = g_cachedEfzBase.load(std::memory_order_acquire);
-    if (val) return val;
-    HMODULE h = GetModuleHandleA(NULL); // NULL = current process module
-    if (!h) return 0;
-    val = reinterpret_cast<uintptr_t>(h);
-    g_cachedEfzBase.store(val, std::memory_order_release);
-    return val;
-}
-
-void InvalidateEFZBaseCache() { g_cachedEfzBase.store(0, std::memory_order_release); }
-
-// -----------------------------------------------------------------------------
-// Game state pointer caching
-// The game state object (at EFZ_BASE_OFFSET_GAME_STATE) is allocated once at
-// startup (initializeGameSystem). Its pointer remains stable; internal fields
-// are reset between matches. Safe to cache for lifetime of process unless we
-// explicitly disable features / enter online mode.
-namespace { std::atomic<uintptr_t> g_cachedGameState{0}; }
-
-uintptr_t GetGameStatePtr() {
-    uintptr_t gs = g_cachedGameState.load(std::memory_order_acquire);
-    if (gs) return gs;
-    uintptr_t base = GetEFZBase(); if (!base) return 0;
-    uintptr_t tmp = 0; if (!SafeReadMemory(base + EFZ_BASE_OFFSET_GAME_STATE, &tmp, sizeof(tmp))) return 0;
-    if (tmp) g_cachedGameState.store(tmp, std::memory_order_release);
-    return tmp;
-}
-
-void InvalidateGameStatePtrCache() { g_cachedGameState.store(0, std::memory_order_release); }
-
-// -----------------------------------------------------------------------------
-// Player base pointer caching
-// Player pointers (EFZ_BASE_OFFSET_P1/P2) are set to 0 at startup and populated
-// during character load sequences. They are reused for each match but may be
-// re-assigned when returning to character select and starting a new battle.
-// Strategy:
-//  - Cache after first successful read when AreCharactersInitialized()==true
-//  - Invalidate when AreCharactersInitialized()==false OR screen state != Battle (3)
-//  - Provide explicit invalidation for feature disable / online entry.
-namespace { std::atomic<uintptr_t> g_cachedPlayerBase[3] = {0,0,0}; }
-
-static bool ShouldInvalidatePlayerCache() {
-    // When characters not initialized, cached bases invalid.
-    if (!AreCharactersInitialized()) return true;
-    // Screen state check: only trust during battle (3) and possibly win (5) for post-match reads.
-    uint8_t screenState = 0; uintptr_t base = GetEFZBase();
-    if (base) SafeReadMemory(base + EFZ_BASE_OFFSET_SCREEN_STATE, &screenState, sizeof(screenState));
-    if (screenState != 3 && screenState != 5) return true; // battle or win screen retain
-    return false;
-}
-
-uintptr_t GetPlayerBase(int playerIndex) {
-    if (playerIndex != 1 && playerIndex != 2) return 0;
-    if (ShouldInvalidatePlayerCache()) {
-        g_cachedPlayerBase[1].store(0, std::memory_order_release);
-        g_cachedPlayerBase[2].store(0, std::memory_order_release);
-        return 0;
-    }
-    uintptr_t cached = g_cachedPlayerBase[playerIndex].load(std::memory_order_acquire);
-    if (cached) return cached;
-    uintptr_t base = GetEFZBase(); if (!base) return 0;
-    uintptr_t ptr = 0; uintptr_t off = (playerIndex==1)?EFZ_BASE_OFFSET_P1:EFZ_BASE_OFFSET_P2;
-    if (!SafeReadMemory(base + off, &ptr, sizeof(ptr))) return 0;
-    // Basic sanity: require non-null and readable HP field before caching.
-    if (ptr) {
-        int hpDummy=0; if (!SafeReadMemory(ptr + HP_OFFSET, &hpDummy, sizeof(hpDummy))) return 0;
-        g_cachedPlayerBase[playerIndex].store(ptr, std::memory_order_release);
-    }
-    return ptr;
-}
-
-void InvalidatePlayerBaseCache() {
-    g_cachedPlayerBase[1].store(0, std::memory_order_release);
-    g_cachedPlayerBase[2].store(0, std::memory_order_release);
-}
-
-// Add these helper functions to better detect state changes
-bool IsActionable(short moveID) {
-    // Explicit neutral whitelist
-    bool neutral = (moveID == IDLE_MOVE_ID || 
-                    moveID == WALK_FWD_ID || 
-                    moveID == WALK_BACK_ID || 
-                    moveID == CROUCH_ID ||
-                    moveID == CROUCH_TO_STAND_ID ||
-                    // Airborne falling is considered actionable (air actions possible)
-                    moveID == FALLING_ID ||
-                    // Treat landing variants as actionable immediately
-                    moveID == LANDING_ID || moveID == LANDING_1_ID || moveID == LANDING_2_ID || moveID == LANDING_3_ID);
-
-    if (neutral) return true;
-
-    // Explicit inactionable groups from engine
-    bool isDash = (moveID == FORWARD_DASH_START_ID || moveID == FORWARD_DASH_RECOVERY_ID ||
-                   moveID == BACKWARD_DASH_START_ID || moveID == BACKWARD_DASH_RECOVERY_ID ||
-                   moveID == FORWARD_DASH_RECOVERY_SENTINEL_ID);
-    bool isGroundTechSeq = (moveID == GROUNDTECH_RECOVERY || moveID == GROUNDTECH_PRE || moveID == GROUNDTECH_START || moveID == GROUNDTECH_END);
-    bool isSuperflash = (moveID == GROUND_IC_ID || moveID == AIR_IC_ID);
-
-    bool prohibited = (IsAttackMove(moveID) || 
-                       IsBlockstunState(moveID) || 
-                       IsHitstun(moveID) || 
-                       IsLaunched(moveID) ||
-                       IsThrown(moveID) ||
-                       IsAirtech(moveID) || 
-                       IsGroundtech(moveID) ||
-                       IsFrozen(moveID) ||
-                       IsRecoilGuard(moveID) ||
-                       isDash || isGroundTechSeq || isSuperflash ||
-                       moveID == STAND_GUARD_ID || 
-                       moveID == CROUCH_GUARD_ID || 
-                       moveID == AIR_GUARD_ID);
-
-    if (prohibited) return false;
-
-    // Treat unknown states as NOT actionable by default (stricter) but allow debug override
-    static int unknownLogBudget = 0; // refilled periodically elsewhere if needed
-    bool result = false;
-    if (g_deepFrameAdvDebug.load() && unknownLogBudget < 200) { // limit spam
-        LogOut("[ACTIONABLE_DBG] Treating unknown moveID " + std::to_string(moveID) + " as NOT actionable", false);
-        ++unknownLogBudget;
-    }
-    return result;
-}
-
-// Note: Wakeup triggers use IsActionable directly; CROUCH_TO_STAND_ID (7) is considered
-// actionable so wake actions can fire ASAP when state 96 ends.
-
-bool IsBlockstun(short moveID) {
-    std::locale::global(std::locale("C")); 
-    
-    // Directly check for core blockstun IDs
-    if (moveID == STAND_GUARD_ID || 
-        moveID == CROUCH_GUARD_ID || 
-        moveID == CROUCH_GUARD_STUN1 ||
-        moveID == CROUCH_GUARD_STUN2 || 
-        moveID == AIR_GUARD_ID) {
-        return true;
-    }
-    
-    // Check the range that includes many standing blockstun states BUT explicitly
-    // exclude dash related IDs (forward/back dash start & recovery + sentinel) so the
-    // auto-action dash follow-up & restore logic does not treat active dashes as stun.
-    if (moveID == 150 || moveID == 152 || 
-        (moveID >= 140 && moveID <= 149) ||
-        (moveID >= 153 && moveID <= 165)) {
-        // Forward/back dash IDs must not be blockstun.
-        if (moveID == FORWARD_DASH_START_ID ||
-            moveID == FORWARD_DASH_RECOVERY_ID ||
-            moveID == FORWARD_DASH_RECOVERY_SENTINEL_ID ||
-            moveID == BACKWARD_DASH_START_ID ||
-            moveID == BACKWARD_DASH_RECOVERY_ID) {
-            return false; // explicitly exclude
-        }
-        return true;
-    }
-    
-    return false;
-}
-
-bool IsRecoilGuard(short moveID) {
-    std::locale::global(std::locale("C")); 
-    // This ensures consistent decimal point format
-    return moveID == RG_STAND_ID || moveID == RG_CROUCH_ID || moveID == RG_AIR_ID;
-}
-
 bool IsEFZWindowActive() {
     std::locale::global(std::locale("C")); 
     HWND fg = GetForegroundWindow();
@@ -1240,12 +920,7 @@ std::string GetKeyName(int virtualKey) {
 }
 
 bool IsDashState(short moveID) {
-    std::locale::global(std::locale("C")); 
-    // This ensures consistent decimal point format
-    return moveID == FORWARD_DASH_START_ID || 
-           moveID == FORWARD_DASH_RECOVERY_ID ||
-           moveID == BACKWARD_DASH_START_ID || 
-           moveID == BACKWARD_DASH_RECOVERY_ID;
+    return MoveProps::Has(moveID, MoveProps::Dash);
 }
 
 
@@ -0,0 +1,257 @@
+// efz_fa_replay: golden traces and throughput for the frame-advantage engine.
+//
+//   efz_fa_replay [--list] [--verbose] [--bench TICKS] [--repeat N]
+//
+// Each built-in scenario is a tick-by-tick moveID trace of both players (plus the global game-speed
+// freeze flag) written as segments, with the events FrameAdvantageEngine::Step must produce for it:
+// blocked and hit strings with a gap, recoil guard, an air block that lands, and a superflash freeze
+// inside an exchange. Actionability comes from the MoveProps table the same way IsActionable decides
+// it for known moveIDs. Any missing, extra or different event fails the scenario; the exit code is 1
+// if a scenario failed. --bench feeds a synthetic stream of TICKS ticks built from the scenarios
+// (shuffled, with idle gaps) through Step --repeat times and reports ticks per second.
+// Builds on any host.
+#include "../../include/core/constants.h"
+#include "../../include/game/frame_advantage_engine.h"
+#include "../../include/game/move_props.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using FrameAdvantageEngine::ConnectKind;
+using FrameAdvantageEngine::Event;
+using FrameAdvantageEngine::EventKind;
+
+struct Segment {
+    int   ticks;
+    short p1, p2;
+    bool  frozen;
+};
+
+struct Expected {
+    int         frame;
+    EventKind   kind;
+    int         player;
+    int         value;      // Gap / FrameAdvantage
+    ConnectKind connect;    // Connect
+};
+
+struct Scenario {
+    const char*           name;
+    std::vector<Segment>  segments;
+    std::vector<Expected> events;
+};
+
+constexpr short kIdle = IDLE_MOVE_ID;
+constexpr short kAttack5A = 200;
+constexpr short kAttack5B = 201;
+constexpr short kAttackSpecial = 250;
+
+Expected NewAction(int f, int p) { return { f, EventKind::NewAction, p, 0, ConnectKind::Lockout }; }
+Expected Recoil(int f, int p) { return { f, EventKind::RecoilGuard, p, 0, ConnectKind::Lockout }; }
+Expected Connect(int f, int p, ConnectKind k) { return { f, EventKind::Connect, p, 0, k }; }
+Expected Gap(int f, int p, int v) { return { f, EventKind::Gap, p, v, ConnectKind::Lockout }; }
+Expected Advantage(int f, int p, int v) { return { f, EventKind::FrameAdvantage, p, v, ConnectKind::Lockout }; }
+
+std::vector<Scenario> BuildScenarios() {
+    std::vector<Scenario> s;
+
+    // 5A blocked: P1 recovers at 30, P2 leaves blockstun at 36 -> +6 (+2 visual)
+    s.push_back({ "block",
+        { { 10, kIdle, kIdle, false }, { 5, kAttack5A, kIdle, false }, { 15, kAttack5A, STANDING_BLOCK_LVL1, false },
+          { 6, kIdle, STANDING_BLOCK_LVL1, false }, { 20, kIdle, kIdle, false } },
+        { NewAction(10, 1), Connect(15, 1, ConnectKind::Block), Advantage(36, 1, 6) } });
+
+    // 5A hits, 5B blocked after a 7-frame gap (2.33 visual): +5, then +4
+    s.push_back({ "hit-gap-block",
+        { { 5, kIdle, kIdle, false }, { 3, kAttack5A, kIdle, false }, { 13, kAttack5A, STAND_HITSTUN_START, false },
+          { 5, kIdle, STAND_HITSTUN_START, false }, { 4, kIdle, kIdle, false }, { 3, kAttack5B, kIdle, false },
+          { 13, kAttack5B, STANDING_BLOCK_LVL1, false }, { 4, kIdle, STANDING_BLOCK_LVL1, false },
+          { 20, kIdle, kIdle, false } },
+        { NewAction(5, 1), Connect(8, 1, ConnectKind::Hit), Advantage(26, 1, 5),
+          NewAction(30, 1), Gap(33, 1, 7), Connect(33, 1, ConnectKind::Block), Advantage(50, 1, 4) } });
+
+    // P2 attacks, P1 recoil guards: the RG lockout counts as a connect, P1 is free 7 frames early
+    s.push_back({ "recoil-guard",
+        { { 10, kIdle, kIdle, false }, { 4, kIdle, kAttack5A, false }, { 20, RG_STAND_ID, kAttack5A, false },
+          { 7, kIdle, kAttack5A, false }, { 20, kIdle, kIdle, false } },
+        { NewAction(10, 2), Recoil(14, 1), Connect(14, 2, ConnectKind::Lockout), Advantage(41, 2, -7) } });
+
+    // Air block into landing: landing is not a defender-free edge, so the defender counts as free when
+    // the attacker recovers (0)
+    s.push_back({ "airblock-landing",
+        { { 6, kIdle, FALLING_ID, false }, { 4, kAttack5A, FALLING_ID, false }, { 17, kAttack5A, AIR_GUARD_ID, false },
+          { 5, kAttack5A, LANDING_ID, false }, { 4, kIdle, LANDING_ID, false }, { 20, kIdle, kIdle, false } },
+        { NewAction(6, 1), Connect(10, 1, ConnectKind::Block), Advantage(32, 1, 0) } });
+
+    // A 10-tick global freeze after P1 recovered is taken out of the advantage, and P1's attack
+    // starting inside it is not a connect; a 5-tick freeze inside the next gap is taken out of the gap
+    s.push_back({ "superflash",
+        { { 10, kIdle, kIdle, false }, { 4, kAttack5A, kIdle, false }, { 16, kAttack5A, STANDING_BLOCK_LVL1, false },
+          { 2, kIdle, STANDING_BLOCK_LVL1, false }, { 2, kIdle, STANDING_BLOCK_LVL1, true },
+          { 8, kAttackSpecial, STANDING_BLOCK_LVL1, true }, { 4, kAttackSpecial, STANDING_BLOCK_LVL1, false },
+          { 4, kAttackSpecial, kIdle, false }, { 5, kIdle, kIdle, false }, { 5, kIdle, kIdle, true },
+          { 4, kAttack5B, kIdle, false }, { 6, kAttack5B, STANDING_BLOCK_LVL1, false },
+          { 5, kIdle, STANDING_BLOCK_LVL1, false }, { 20, kIdle, kIdle, false } },
+        { NewAction(10, 1), Connect(14, 1, ConnectKind::Block), NewAction(34, 1), Advantage(46, 1, 6),
+          NewAction(60, 1), Gap(64, 1, 13), Connect(64, 1, ConnectKind::Block), Advantage(75, 1, 5) } });
+
+    return s;
+}
+
+// The 192 Hz inputs of a scenario (or of the bench stream), one per tick
+std::vector<FrameAdvantageEngine::Input> Expand(const std::vector<Segment>& segments, int firstFrame = 0) {
+    std::vector<FrameAdvantageEngine::Input> ticks;
+    short prev[2] = { segments.empty() ? kIdle : segments[0].p1, segments.empty() ? kIdle : segments[0].p2 };
+    int frame = firstFrame;
+    for (const Segment& seg : segments) {
+        for (int i = 0; i < seg.ticks; ++i) {
+            FrameAdvantageEngine::Input in{};
+            in.frame = frame++;
+            in.moveID[0] = seg.p1;
+            in.moveID[1] = seg.p2;
+            for (int p = 0; p < 2; ++p) {
+                in.prevMoveID[p] = prev[p];
+                in.actionable[p] = MoveProps::Has(in.moveID[p], MoveProps::Actionable);
+                in.prevActionable[p] = MoveProps::Has(prev[p], MoveProps::Actionable);
+                prev[p] = in.moveID[p];
+            }
+            in.gameSpeedFrozen = seg.frozen;
+            ticks.push_back(in);
+        }
+    }
+    return ticks;
+}
+
+const char* KindName(EventKind k) {
+    switch (k) {
+    case EventKind::NewAction:      return "new-action";
+    case EventKind::RecoilGuard:    return "recoil-guard";
+    case EventKind::Connect:        return "connect";
+    case EventKind::Gap:            return "gap";
+    case EventKind::FrameAdvantage: return "frame-advantage";
+    case EventKind::StaleReset:     return "stale-reset";
+    }
+    return "?";
+}
+
+const char* ConnectName(ConnectKind k) {
+    switch (k) {
+    case ConnectKind::Block:   return "block";
+    case ConnectKind::Hit:     return "hit";
+    case ConnectKind::Thrown:  return "thrown";
+    case ConnectKind::Lockout: return "lockout";
+    }
+    return "?";
+}
+
+std::string Describe(int frame, EventKind kind, int player, int value, ConnectKind connect) {
+    char buf[96];
+    if (kind == EventKind::Connect)
+        snprintf(buf, sizeof(buf), "@%d %s P%d %s", frame, KindName(kind), player, ConnectName(connect));
+    else if (kind == EventKind::Gap || kind == EventKind::FrameAdvantage)
+        snprintf(buf, sizeof(buf), "@%d %s P%d %+d", frame, KindName(kind), player, value);
+    else
+        snprintf(buf, sizeof(buf), "@%d %s P%d", frame, KindName(kind), player);
+    return buf;
+}
+
+bool Matches(const Event& e, const Expected& x) {
+    if (e.frame != x.frame || e.kind != x.kind || e.player != x.player) return false;
+    if (e.kind == EventKind::Connect) return e.connect == x.connect;
+    if (e.kind == EventKind::Gap || e.kind == EventKind::FrameAdvantage) return e.value == x.value;
+    return true;
+}
+
+bool RunScenario(const Scenario& sc, bool verbose) {
+    FrameAdvantageEngine::State state{};
+    FrameAdvantageEngine::Reset(state);
+    std::vector<Event> got;
+    Event buf[FrameAdvantageEngine::kMaxEvents];
+    for (const FrameAdvantageEngine::Input& in : Expand(sc.segments)) {
+        const int n = FrameAdvantageEngine::Step(state, in, buf, FrameAdvantageEngine::kMaxEvents);
+        got.insert(got.end(), buf, buf + n);
+    }
+
+    bool ok = got.size() == sc.events.size();
+    for (size_t i = 0; ok && i < got.size(); ++i) ok = Matches(got[i], sc.events[i]);
+    printf("%s %s (%zu events)\n", ok ? "PASS" : "FAIL", sc.name, got.size());
+    if (!ok || verbose) {
+        const size_t rows = got.size() > sc.events.size() ? got.size() : sc.events.size();
+        for (size_t i = 0; i < rows; ++i) {
+            const std::string g = i < got.size()
+                ? Describe(got[i].frame, got[i].kind, got[i].player, got[i].value, got[i].connect) : "-";
+            const std::string x = i < sc.events.size()
+                ? Describe(sc.events[i].frame, sc.events[i].kind, sc.events[i].player, sc.events[i].value,
+                           sc.events[i].connect) : "-";
+            printf("  %c got %-32s expected %s\n", g == x ? ' ' : '!', g.c_str(), x.c_str());
+        }
+    }
+    return ok;
+}
+
+void Bench(const std::vector<Scenario>& scenarios, uint32_t ticks, int repeat) {
+    std::vector<Segment> stream;
+    uint32_t total = 0, seed = 0x5eed1234u;
+    auto next = [&]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    while (total < ticks) {
+        const Scenario& sc = scenarios[next() % scenarios.size()];
+        for (const Segment& seg : sc.segments) { stream.push_back(seg); total += seg.ticks; }
+        const int idle = (int)(next() % 90);
+        stream.push_back({ idle, kIdle, kIdle, false });
+        total += idle;
+    }
+    const std::vector<FrameAdvantageEngine::Input> inputs = Expand(stream);
+
+    FrameAdvantageEngine::State state{};
+    FrameAdvantageEngine::Reset(state);
+    Event buf[FrameAdvantageEngine::kMaxEvents];
+    uint64_t events = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < repeat; ++rep) {
+        for (const FrameAdvantageEngine::Input& in : inputs)
+            events += (uint64_t)FrameAdvantageEngine::Step(state, in, buf, FrameAdvantageEngine::kMaxEvents);
+    }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    const double stepped = (double)inputs.size() * repeat;
+    printf("bench: %zu ticks x %d, %llu events\n", inputs.size(), repeat, (unsigned long long)events);
+    fprintf(stderr, "  %.1f Mticks/s, %.1f ns/tick (%.0fx realtime at 192 Hz)\n",
+            secs > 0 ? stepped / secs / 1e6 : 0.0, stepped > 0 ? secs * 1e9 / stepped : 0.0,
+            secs > 0 ? stepped / secs / 192.0 : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool verbose = false, list = false;
+    uint32_t benchTicks = 0;
+    int repeat = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--verbose")) verbose = true;
+        else if (!strcmp(argv[i], "--list")) list = true;
+        else if (!strcmp(argv[i], "--bench") && i + 1 < argc) benchTicks = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: efz_fa_replay [--list] [--verbose] [--bench TICKS] [--repeat N]\n");
+            return 2;
+        }
+    }
+    if (repeat < 1) repeat = 1;
+
+    const std::vector<Scenario> scenarios = BuildScenarios();
+    if (list) {
+        for (const Scenario& sc : scenarios) printf("%s\n", sc.name);
+        return 0;
+    }
+
+    size_t failed = 0;
+    for (const Scenario& sc : scenarios) failed += RunScenario(sc, verbose) ? 0 : 1;
+    printf("%zu scenarios: %zu passed, %zu failed\n", scenarios.size(), scenarios.size() - failed, failed);
+
+    if (benchTicks > 0) Bench(scenarios, benchTicks, repeat);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+// efz_fake_memory_check: drives the shared memory layer against FakeGameMemory.
+//
+//   efz_fake_memory_check
+//
+// Installs a FakeGameMemory with SetGameMemory and checks what the feature code relies on through
+// the real entry points (memory.cpp, memory_txn.cpp, runtime_state.cpp):
+//  - GetEFZBase / GetGameStatePtr / GetPlayerBase / ResolvePointer follow the 4-byte pointer slots
+//  - SafeReadMemory / SafeWriteMemory land in the fake, and unmapped or straddling ranges fail
+//  - the player-base cache drops on character select, non-battle screens and zero HP
+//  - MemoryWriteTxn overlays pending writes and applies them on Commit
+//  - JournaledWrite records the original game-state bytes and RevertAllWrites puts them back
+//  - RegionValidityCache requeries forgotten pages and never revives slots across a generation wrap
+//  - SetGameMemory(nullptr) restores the Win32 backend
+// Prints each failed check and exits 1 if any failed. Outside Windows it links the memory layer
+// against the shim in tools/host, so it builds on any host.
+#include "../../include/core/constants.h"
+#include "../../include/core/fake_game_memory.h"
+#include "../../include/core/memory.h"
+#include "../../include/core/memory_txn.h"
+#include "../../include/core/region_cache.h"
+#include "../../include/game/frame_monitor.h"
+#include "../../include/game/practice_offsets.h"
+#include "../../include/utils/utilities.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+int g_checks = 0;
+int g_failed = 0;
+
+void Check(bool ok, const char* what) {
+    ++g_checks;
+    if (!ok) {
+        ++g_failed;
+        printf("FAIL: %s\n", what);
+    }
+}
+
+void CheckPointers(FakeGameMemory& fake) {
+    Check(strcmp(GetGameMemory().Name(), "fake") == 0, "SetGameMemory installs the fake backend");
+    Check(GetEFZBase() == FakeGameMemory::kModuleBase, "GetEFZBase returns the fake module base");
+    Check(GetGameStatePtr() == fake.GameStateBase(), "GetGameStatePtr follows the game-state slot");
+    Check(GetPlayerBase(1) == fake.PlayerBase(1), "GetPlayerBase(1) follows the P1 slot");
+    Check(GetPlayerBase(2) == fake.PlayerBase(2), "GetPlayerBase(2) follows the P2 slot");
+    Check(GetPlayerBase(3) == 0, "GetPlayerBase rejects player 3");
+    Check(AreCharactersInitialized(), "characters initialized in battle with HP");
+    Check(ResolvePointer(GetEFZBase(), EFZ_BASE_OFFSET_P2, HP_OFFSET) == fake.PlayerBase(2) + HP_OFFSET,
+          "ResolvePointer adds the field offset to the P2 slot");
+}
+
+void CheckAccess(FakeGameMemory& fake) {
+    const uintptr_t p1 = fake.PlayerBase(1);
+    fake.ResetCounters();
+
+    const double x = 123.5;
+    Check(SafeWriteMemory(p1 + XPOS_OFFSET, &x, sizeof(x)), "SafeWriteMemory into the P1 struct");
+    double back = 0;
+    Check(SafeReadMemory(p1 + XPOS_OFFSET, &back, sizeof(back)) && back == x, "SafeReadMemory reads it back");
+    Check(fake.writes == 1 && fake.reads == 1, "one backend read and one write counted");
+    Check(fake.GetPlayerField<double>(1, XPOS_OFFSET) == x, "write is visible in the fake");
+
+    int dummy = 0;
+    Check(!SafeReadMemory(0x20000000, &dummy, sizeof(dummy)), "read of an unmapped address fails");
+    Check(!SafeReadMemory(p1 + FakeGameMemory::kPlayerBytes - 2, &dummy, sizeof(dummy)),
+          "read straddling the end of a region fails");
+    Check(!SafeWriteMemory(0x20000000, &dummy, sizeof(dummy)), "write to an unmapped address fails");
+    Check(fake.faults == 3, "three faults counted");
+
+    const uintptr_t extra = 0x30000000;
+    Check(fake.MapRegion(extra, 0x200), "MapRegion maps an extra block");
+    Check(!fake.MapRegion(extra + 0x80, 0x100), "MapRegion refuses an overlapping block");
+    const uint32_t v = 0xC0FFEE;
+    uint32_t vb = 0;
+    Check(SafeWriteMemory(extra + 0x10, &v, sizeof(v)) && SafeReadMemory(extra + 0x10, &vb, sizeof(vb)) && vb == v,
+          "round trip through an extra block");
+}
+
+void CheckPlayerCache(FakeGameMemory& fake) {
+    Check(GetPlayerBase(2) == fake.PlayerBase(2), "player base cached in battle");
+
+    fake.SetPlayerPresent(2, false);
+    Check(!AreCharactersInitialized(), "character select: characters not initialized");
+    Check(GetPlayerBase(1) == 0 && GetPlayerBase(2) == 0, "character select: player bases dropped");
+    fake.SetPlayerPresent(2, true);
+    Check(GetPlayerBase(2) == fake.PlayerBase(2), "player base back after character select");
+
+    fake.SetScreenState(1);
+    Check(GetPlayerBase(1) == 0, "non-battle screen: player bases dropped");
+    fake.SetScreenState(5);
+    Check(GetPlayerBase(1) == fake.PlayerBase(1), "win screen keeps player bases");
+    fake.SetScreenState(3);
+
+    const int zero = 0;
+    fake.SetPlayerField(1, HP_OFFSET, zero);
+    fake.SetPlayerField(2, HP_OFFSET, zero);
+    Check(!AreCharactersInitialized(), "zero HP on both sides: characters not initialized");
+    const int hp = MAX_HP;
+    fake.SetPlayerField(1, HP_OFFSET, hp);
+    fake.SetPlayerField(2, HP_OFFSET, hp);
+    Check(AreCharactersInitialized(), "characters initialized again with HP");
+}
+
+void CheckWriteTxn(FakeGameMemory& fake) {
+    const uintptr_t p1 = fake.PlayerBase(1);
+    const double x0 = 10.0, y0 = 20.0;
+    fake.SetPlayerField(1, XPOS_OFFSET, x0);
+    fake.SetPlayerField(1, YPOS_OFFSET, y0);
+    {
+        MemoryWriteTxn txn;
+        const double x1 = 300.0, y1 = 0.0;
+        txn.Add(p1 + XPOS_OFFSET, x1);
+        txn.Add(p1 + YPOS_OFFSET, y1);
+        double seen = 0;
+        Check(SafeReadMemory(p1 + XPOS_OFFSET, &seen, sizeof(seen)) && seen == x1, "txn: read-after-write sees pending X");
+        Check(fake.GetPlayerField<double>(1, XPOS_OFFSET) == x0, "txn: memory untouched before Commit");
+        Check(txn.Commit(), "txn: Commit succeeds");
+        Check(txn.LastRunCount() == 1, "txn: adjacent X/Y writes merge into one run");
+        Check(fake.GetPlayerField<double>(1, XPOS_OFFSET) == x1 && fake.GetPlayerField<double>(1, YPOS_OFFSET) == y1,
+              "txn: memory updated after Commit");
+    }
+    Check(GetWriteJournalBytes(WriteOwner::PracticePatch) == 0, "unowned txn journals nothing");
+
+    // Practice flags: the journal keeps the value from before the FIRST write
+    const uintptr_t flag = fake.GameStateBase() + GAMESTATE_OFF_P2_CPU_FLAG;
+    const uint8_t cpu = 1, human = 0, other = 2;
+    SafeWriteMemory(flag, &cpu, sizeof(cpu));
+    Check(JournaledWrite(WriteOwner::PracticePatch, flag, human), "JournaledWrite(PracticePatch) succeeds");
+    JournaledWrite(WriteOwner::PracticePatch, flag, other);
+    Check(GetWriteJournalBytes(WriteOwner::PracticePatch) == 1, "repeated writes journal the byte once");
+    Check(RevertAllWrites(), "RevertAllWrites succeeds");
+    uint8_t back = 0xFF;
+    Check(SafeReadMemory(flag, &back, sizeof(back)) && back == cpu, "RevertAllWrites restores the original flag");
+    Check(GetWriteJournalBytes(WriteOwner::PracticePatch) == 0, "revert clears the journal");
+
+    // More writes than the inline storage holds: the overflow flushes and nothing is lost
+    const uintptr_t block = 0x30000100;
+    const size_t n = MemoryWriteTxn::kMaxSpans + 8;
+    {
+        MemoryWriteTxn txn(WriteOwner::None);
+        for (size_t i = 0; i < n; ++i) txn.Add(block + i * 2, (uint8_t)(i + 1));
+        Check(txn.PendingWrites() < MemoryWriteTxn::kMaxSpans, "txn: span overflow flushes the pending batch");
+    }
+    bool all = true;
+    for (size_t i = 0; i < n; ++i) {
+        uint8_t b = 0;
+        all = all && SafeReadMemory(block + i * 2, &b, 1) && b == (uint8_t)(i + 1);
+    }
+    Check(all, "txn: every write lands across an overflow flush");
+}
+
+// Reports each page as its own region carrying `flags`, and counts the queries
+struct RegionQuery {
+    int queries = 0;
+    uint32_t flags = RegionValidityCache::kReadable | RegionValidityCache::kWritable;
+
+    static bool Fn(uintptr_t address, uintptr_t& regionBase, size_t& regionSize, uint32_t& flags, void* ctx) {
+        RegionQuery* q = static_cast<RegionQuery*>(ctx);
+        ++q->queries;
+        regionBase = address & ~(RegionValidityCache::kPageSize - 1);
+        regionSize = RegionValidityCache::kPageSize;
+        flags = q->flags;
+        return true;
+    }
+};
+
+void CheckRegionCache() {
+    RegionQuery q;
+    RegionValidityCache cache(&RegionQuery::Fn, &q);
+    const uintptr_t a = 0x10000000, b = 0x10001000;
+    Check(cache.CanWrite(a, 8) && cache.CanWrite(a, 8) && q.queries == 1, "region cache: second check is a hit");
+
+    cache.CanWrite(b, 8);
+    q.flags = RegionValidityCache::kReadable;       // protection changed behind the cache
+    cache.Forget(a, 8);
+    Check(!cache.CanWrite(a, 8) && q.queries == 3, "region cache: Forget requeries that page");
+    Check(cache.CanRead(b, 8) && q.queries == 3, "region cache: Forget keeps other pages");
+
+    // Cache a page, then walk the generation through a full 16-bit cycle back to the same low bits
+    q.flags = RegionValidityCache::kReadable | RegionValidityCache::kWritable;
+    cache.Invalidate();
+    cache.CanWrite(a, 8);
+    const int before = q.queries;
+    for (int i = 0; i < 0x10000; ++i) cache.Invalidate();
+    q.flags = RegionValidityCache::kReadable;
+    Check(!cache.CanWrite(a, 8) && q.queries == before + 1, "region cache: no stale hit after the generation wraps");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        fprintf(stderr, "usage: %s\n", argv[0]);
+        return 2;
+    }
+    {
+        FakeGameMemory fake;
+        SetGameMemory(&fake);
+        CheckPointers(fake);
+        CheckAccess(fake);
+        CheckPlayerCache(fake);
+        CheckWriteTxn(fake);
+        SetGameMemory(nullptr);
+    }
+    CheckRegionCache();
+    Check(strcmp(GetGameMemory().Name(), "fake") != 0, "SetGameMemory(nullptr) restores the default backend");
+    printf("%d checks, %d failed\n", g_checks, g_failed);
+    return g_failed ? 1 : 0;
+}
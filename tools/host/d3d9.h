@@ -0,0 +1,6 @@
+// Direct3D 9 types named by overlay.h; see windows.h in this directory
+#pragma once
+#include "windows.h"
+
+typedef void* LPDIRECT3D9;
+typedef void* LPDIRECT3DDEVICE9;
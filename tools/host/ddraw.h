@@ -0,0 +1,14 @@
+// DirectDraw types named by overlay.h; see windows.h in this directory
+#pragma once
+#include "windows.h"
+
+struct IDirectDrawSurface7;
+struct IDirectDraw7;
+typedef void* LPDIRECTDRAW;
+typedef void* LPDIRECTDRAW7;
+typedef void* LPDIRECTDRAWSURFACE7;
+typedef void* LPDDBLTFX;
+typedef void* LPDDENUMCALLBACKA;
+typedef struct _GUID { uint32_t Data1; uint16_t Data2, Data3; uint8_t Data4[8]; } GUID;
+typedef GUID* LPGUID;
+struct IUnknown;
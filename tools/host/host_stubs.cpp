@@ -0,0 +1,72 @@
+// Stand-ins for the DLL modules the replayed logic calls into but that only exist inside the game
+// process: hooks (input poll, collision, DirectDraw overlay), the EfzRevival pause/side-swap bridges,
+// config/ini handling, network detection and the console logger. Linked only by non-Windows
+// host tools (efz_trace_replay); their Win32 builds link the real modules.
+//
+// Each stand-in reports "not available" the way its real counterpart does before the game is hooked:
+// no overlay, no practice controller, offline, no window title to read a Revival version from,
+// zeroed settings (the Win32 replay never loads the ini either).
+#include "../../include/core/logger.h"
+#include "../../include/game/collision_hook.h"
+#include "../../include/gui/overlay.h"
+#include "../../include/input/injection_control.h"
+#include "../../include/utils/config.h"
+#include "../../include/utils/network.h"
+#include "../../include/utils/pause_integration.h"
+#include "../../include/utils/switch_players.h"
+#include <atomic>
+#include <string>
+
+// dllmain.cpp
+std::atomic<bool> g_featuresEnabled(false);
+
+// input_hook.cpp: the replay reads these back as the poll override the logic requested
+std::atomic<bool> g_forceBypass[3] = { false, false, false };
+std::atomic<bool> g_pollOverrideActive[3] = { false, false, false };
+std::atomic<uint8_t> g_pollOverrideMask[3] = { 0, 0, 0 };
+
+// imgui_impl.cpp
+namespace CharacterSettings { std::atomic<bool> g_guiVisible{false}; }
+
+// overlay.cpp
+int g_FrameAdvantageId = -1;
+int g_FrameAdvantage2Id = -1;
+int g_FrameGapId = -1;
+
+void DirectDrawHook::AddMessage(const std::string&, const std::string&, COLORREF, int, int, int) {}
+int DirectDrawHook::AddPermanentMessage(const std::string&, COLORREF, int, int) { return -1; }
+void DirectDrawHook::UpdatePermanentMessage(int, const std::string&, COLORREF) {}
+void DirectDrawHook::RemovePermanentMessage(int) {}
+
+// logger.cpp / debug_log.cpp: the replay's output is its CSV; DLL log lines are dropped
+void LogOut(const std::string&, bool) {}
+namespace DebugLog { bool g_EnableDebugLog = false; }
+
+// config.cpp
+const Config::Settings& Config::GetSettings() {
+    static Settings settings{};
+    return settings;
+}
+std::string Config::GetConfigFilePath() { return std::string(); }
+
+// network.cpp
+bool DetectOnlineMatch() { return false; }
+EfzRevivalVersion GetEfzRevivalVersion() { return EfzRevivalVersion::Unknown; }
+
+// collision_hook.cpp: no hook, so attack_reader falls back to its memory walk
+uintptr_t GetCachedAttackDataForPlayer(int) { return 0; }
+int GetAttackDataOffsetForPlayer(int) { return -1; }
+
+// pause_integration.cpp
+void PauseIntegration::EnsurePracticePointerCapture() {}
+void* PauseIntegration::GetPracticeControllerPtr() { return nullptr; }
+bool PauseIntegration::IsPracticePaused() { return false; }
+bool PauseIntegration::IsGameSpeedFrozen() { return false; }
+bool PauseIntegration::ReadStepCounter(uint32_t&) { return false; }
+bool PauseIntegration::ConsumeStepAdvance() { return false; }
+
+// switch_players.cpp
+bool SwitchPlayers::SetLocalSide(int) { return false; }
+bool SwitchPlayers::ResetControlMappingForMenusToP1() { return false; }
+void SwitchPlayers::ClearSwapFlag() {}
+void SwitchPlayers::MarkSwapped() {}
@@ -0,0 +1,134 @@
+// Minimal Win32 surface for building DLL logic sources into host tools (tools/trace_replay) on
+// non-Windows hosts.
+// Only what the feature logic touches is declared. Memory goes through FakeGameMemory, so the
+// page-query / protection APIs report failure. Files, windows and modules don't exist here.
+// Never on the include path of the DLL.
+#pragma once
+#include <chrono>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <strings.h>
+
+typedef unsigned long DWORD;
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef unsigned short WORD;
+typedef long LONG;
+typedef long long LONGLONG;
+typedef unsigned int UINT;
+typedef unsigned long long ULONGLONG;
+typedef size_t SIZE_T;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef const char* LPCSTR;
+typedef long HRESULT;
+typedef DWORD COLORREF;
+typedef uintptr_t WPARAM;
+typedef intptr_t LPARAM;
+typedef intptr_t LRESULT;
+typedef void* HANDLE;
+typedef void* HWND;
+typedef void* HMODULE;
+typedef void* HINSTANCE;
+typedef void* HDC;
+typedef void* HFONT;
+typedef void* LPVOID;
+typedef const void* LPCVOID;
+
+typedef struct { LONG left, top, right, bottom; } RECT;
+typedef RECT* LPRECT;
+typedef struct { LONG x, y; } POINT;
+typedef union { struct { unsigned LowPart; long HighPart; }; long long QuadPart; } LARGE_INTEGER;
+typedef struct {
+    void* BaseAddress; void* AllocationBase; DWORD AllocationProtect; SIZE_T RegionSize;
+    DWORD State; DWORD Protect; DWORD Type;
+} MEMORY_BASIC_INFORMATION;
+
+#define WINAPI
+#define CALLBACK
+#define STDMETHODCALLTYPE
+#define __stdcall
+#define __thiscall
+#define __fastcall
+#define __cdecl
+#define TRUE 1
+#define FALSE 0
+#define MAX_PATH 260
+#define RGB(r,g,b) ((COLORREF)(((BYTE)(r)|((WORD)((BYTE)(g))<<8))|(((DWORD)(BYTE)(b))<<16)))
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+
+#define GENERIC_READ 0x80000000u
+#define GENERIC_WRITE 0x40000000u
+#define FILE_SHARE_READ 1
+#define FILE_SHARE_WRITE 2
+#define CREATE_ALWAYS 2
+#define OPEN_EXISTING 3
+#define OPEN_ALWAYS 4
+#define FILE_ATTRIBUTE_NORMAL 0x80
+#define FILE_BEGIN 0
+#define FILE_MAP_WRITE 2
+#define FILE_MAP_READ 4
+#define ERROR_FILE_NOT_FOUND 2
+#define ERROR_PATH_NOT_FOUND 3
+
+#define PAGE_NOACCESS 0x01
+#define PAGE_READONLY 0x02
+#define PAGE_READWRITE 0x04
+#define PAGE_WRITECOPY 0x08
+#define PAGE_EXECUTE_READ 0x20
+#define PAGE_EXECUTE_READWRITE 0x40
+#define PAGE_EXECUTE_WRITECOPY 0x80
+#define PAGE_GUARD 0x100
+#define MEM_COMMIT 0x1000
+
+#define _stricmp strcasecmp
+#define _strnicmp strncasecmp
+
+inline ULONGLONG GetTickCount64() {
+    return (ULONGLONG)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline DWORD GetTickCount() { return (DWORD)GetTickCount64(); }
+inline void Sleep(DWORD) {}
+
+template <size_t N>
+inline int sprintf_s(char (&buf)[N], const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    const int n = vsnprintf(buf, N, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+#define _TRUNCATE ((size_t)-1)
+inline int _snprintf_s(char* buf, size_t size, size_t, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    const int n = vsnprintf(buf, size, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+inline HMODULE GetModuleHandleA(const char*) { return nullptr; }
+inline BOOL VirtualProtect(void*, SIZE_T, DWORD, DWORD*) { return FALSE; }
+inline SIZE_T VirtualQuery(const void*, MEMORY_BASIC_INFORMATION*, SIZE_T) { return 0; }
+inline BOOL IsBadReadPtr(const void*, uintptr_t) { return TRUE; }
+inline BOOL IsBadWritePtr(void*, uintptr_t) { return TRUE; }
+
+inline HANDLE CreateFileA(const char*, DWORD, DWORD, void*, DWORD, DWORD, HANDLE) { return INVALID_HANDLE_VALUE; }
+inline HANDLE CreateFileMappingA(HANDLE, void*, DWORD, DWORD, DWORD, const char*) { return nullptr; }
+inline void* MapViewOfFile(HANDLE, DWORD, DWORD, DWORD, size_t) { return nullptr; }
+inline BOOL UnmapViewOfFile(const void*) { return TRUE; }
+inline BOOL FlushViewOfFile(const void*, SIZE_T) { return TRUE; }
+inline BOOL CloseHandle(HANDLE) { return TRUE; }
+inline BOOL GetFileSizeEx(HANDLE, LARGE_INTEGER*) { return FALSE; }
+inline BOOL SetFilePointerEx(HANDLE, LARGE_INTEGER, LARGE_INTEGER*, DWORD) { return FALSE; }
+inline BOOL WriteFile(HANDLE, const void*, DWORD, DWORD*, void*) { return FALSE; }
+inline BOOL FlushFileBuffers(HANDLE) { return FALSE; }
+inline DWORD GetLastError() { return ERROR_FILE_NOT_FOUND; }
+
+inline HANDLE CreateEventA(void*, BOOL, BOOL, const char*) { return (HANDLE)1; }
+inline BOOL SetEvent(HANDLE) { return TRUE; }
+inline DWORD WaitForSingleObject(HANDLE, DWORD) { return 0; }
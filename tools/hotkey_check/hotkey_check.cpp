@@ -0,0 +1,238 @@
+// efz_hotkey_check: drives HotkeyDispatch::Table::Evaluate over scripted key snapshots.
+//
+//   efz_hotkey_check [--verbose]
+//
+// A ScriptedKeySource plays back one line per frame ("F12 DOWN" = keys held that frame, "pad0:A+LT"
+// = buttons held on a pad) and the checks walk it the way PollHotkeysOncePerFrame does: Evaluate the
+// previous and current snapshot, one hit at most per frame. Covered:
+//  - a press fires once on its edge; holding it does not repeat; release and press fires again
+//  - chord modifiers (Watch) never fire on their own and stay visible in the current snapshot
+//  - two edges in one frame resolve to the first binding in table order
+//  - pad bindings, trigger pseudo-bits, padFilter and the pad index in the hit
+// The table mirrors the default layout CompileHotkeyTable builds. Prints each failed check and exits
+// 1 if any failed. Only hotkey_dispatch.cpp is linked, so it builds on any host.
+#include "../../include/input/hotkey_dispatch.h"
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using HotkeyDispatch::Action;
+using HotkeyDispatch::Hit;
+using HotkeyDispatch::Snapshot;
+
+// Win32 virtual-key and XInput button values, spelled out so the tool needs no Windows headers
+constexpr int kVkSpace = 0x20, kVkLeft = 0x25, kVkDown = 0x28, kVkRight = 0x27, kVkF9 = 0x78, kVkF12 = 0x7B;
+constexpr uint32_t kPadDpadDown = 0x0002, kPadStart = 0x0010, kPadBack = 0x0020;
+constexpr uint32_t kPadA = 0x1000, kPadB = 0x2000, kPadX = 0x4000, kPadY = 0x8000;
+
+int g_checks = 0;
+int g_failed = 0;
+bool g_verbose = false;
+
+void Check(bool ok, const std::string& what) {
+    ++g_checks;
+    if (!ok) {
+        ++g_failed;
+        printf("FAIL: %s\n", what.c_str());
+    } else if (g_verbose) {
+        printf("ok:   %s\n", what.c_str());
+    }
+}
+
+int KeyByName(const std::string& name) {
+    if (name.size() == 1) return static_cast<unsigned char>(name[0]);
+    if (name == "SPACE") return kVkSpace;
+    if (name == "LEFT") return kVkLeft;
+    if (name == "RIGHT") return kVkRight;
+    if (name == "DOWN") return kVkDown;
+    if (name == "F9") return kVkF9;
+    if (name == "F12") return kVkF12;
+    return 0;
+}
+
+uint32_t ButtonByName(const std::string& name) {
+    if (name == "A") return kPadA;
+    if (name == "B") return kPadB;
+    if (name == "X") return kPadX;
+    if (name == "Y") return kPadY;
+    if (name == "START") return kPadStart;
+    if (name == "BACK") return kPadBack;
+    if (name == "DDOWN") return kPadDpadDown;
+    if (name == "LT") return HotkeyDispatch::PadBits(0, 255, 0);
+    if (name == "RT") return HotkeyDispatch::PadBits(0, 0, 255);
+    if (name == "LT-") return HotkeyDispatch::PadBits(0, HotkeyDispatch::kTriggerThreshold - 1, 0);
+    return 0;
+}
+
+// Stands in for GetAsyncKeyState/XInputShim: each script line is the held state for one frame
+class ScriptedKeySource {
+public:
+    explicit ScriptedKeySource(std::vector<std::string> frames) : m_frames(std::move(frames)) {}
+
+    bool Next(Snapshot& snap) {
+        if (m_pos >= m_frames.size()) return false;
+        snap = Snapshot{};
+        std::istringstream in(m_frames[m_pos++]);
+        std::string tok;
+        while (in >> tok) {
+            if (tok.compare(0, 3, "pad") == 0 && tok.size() > 5 && tok[4] == ':') {
+                const int pad = tok[3] - '0';
+                if (pad < 0 || pad >= HotkeyDispatch::kMaxPads) continue;
+                std::string rest = tok.substr(5);
+                size_t start = 0;
+                while (start <= rest.size()) {
+                    const size_t plus = rest.find('+', start);
+                    const std::string b = rest.substr(start, plus == std::string::npos ? std::string::npos : plus - start);
+                    snap.pads[pad] |= ButtonByName(b);
+                    if (plus == std::string::npos) break;
+                    start = plus + 1;
+                }
+            } else {
+                snap.keys.Set(KeyByName(tok));
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<std::string> m_frames;
+    size_t m_pos = 0;
+};
+
+HotkeyDispatch::Table BuildDefaultTable() {
+    HotkeyDispatch::Table t;
+    t.Bind(Action::ToggleMenu, '3', 0);
+    t.Bind(Action::ToggleImGui, kVkF12, 0);
+    t.Bind(Action::ToggleMenu, 0, kPadStart);
+    t.Bind(Action::ToggleImGui, 0, kPadBack);
+    t.Bind(Action::Teleport, 0, kPadY);
+    t.Bind(Action::SavePosition, 0, kPadX);
+    t.Bind(Action::MacroRecord, 0, HotkeyDispatch::kPadLeftTrigger);
+    t.Bind(Action::MacroPlay, 0, HotkeyDispatch::kPadRightTrigger);
+    t.Bind(Action::SwitchPlayers, 'L', 0);
+    t.Bind(Action::Teleport, '1', 0);
+    t.Bind(Action::SavePosition, '2', 0);
+    t.Bind(Action::ToggleStats, '4', 0);
+    t.Bind(Action::FramestepPause, kVkSpace, 0);
+    t.Bind(Action::FramestepStep, 'P', 0);
+    t.Bind(Action::AutoJump, kVkF9, 0);
+    t.Bind(Action::MacroRecord, 'I', 0);
+    t.Bind(Action::MacroPlay, 'O', 0);
+    t.Bind(Action::MacroSlot, 'K', 0);
+    t.Watch(kVkDown);
+    t.Watch(kVkLeft);
+    t.Watch(kVkRight);
+    t.Watch('A');
+    t.Watch('D');
+    return t;
+}
+
+// Expected hit per frame; the first frame only primes prev, as after a hotkey restart
+struct Expect {
+    Action action;
+    int pad;
+};
+
+void RunScript(const char* name, const HotkeyDispatch::Table& table, unsigned padFilter,
+               const std::vector<std::string>& frames, const std::vector<Expect>& expect) {
+    ScriptedKeySource src(frames);
+    Snapshot prev, cur;
+    if (!src.Next(prev)) return;
+    for (size_t i = 0; i < expect.size(); ++i) {
+        if (!src.Next(cur)) {
+            Check(false, std::string(name) + ": script shorter than expectations");
+            return;
+        }
+        const Hit hit = table.Evaluate(prev, cur, padFilter);
+        const bool ok = hit.action == expect[i].action && (hit.action == Action::None || hit.pad == expect[i].pad);
+        char what[160];
+        snprintf(what, sizeof(what), "%s frame %zu: got %s/%d, want %s/%d", name, i + 1,
+                 HotkeyDispatch::ActionName(hit.action), hit.pad,
+                 HotkeyDispatch::ActionName(expect[i].action), expect[i].pad);
+        Check(ok, what);
+        prev = cur;
+    }
+}
+
+void CheckTable(const HotkeyDispatch::Table& t) {
+    Check(t.Size() == 18, "default table binds 18 entries");
+    HotkeyDispatch::Table u;
+    Check(!u.Bind(Action::None, 'Z', 0), "Bind rejects Action::None");
+    Check(!u.Bind(Action::Help, 0, 0), "Bind drops a binding with neither key nor pad");
+    Check(u.Size() == 0, "dropped binding leaves the table empty");
+    Check(t.WatchedKeys().Test(kVkDown) && t.WatchedKeys().Test('D'), "chord modifiers are watched");
+    Check(t.WatchedKeys().Test('1') && !t.WatchedKeys().Test('Z'), "watched keys cover bound keys only");
+}
+
+void CheckKeyboard(const HotkeyDispatch::Table& t) {
+    const Expect none{ Action::None, -1 };
+    RunScript("edge and hold", t, 0xF,
+              { "", "1", "1", "1", "", "1" },
+              { { Action::Teleport, -1 }, none, none, none, { Action::Teleport, -1 } });
+    RunScript("held before start", t, 0xF,
+              { "F12", "F12", "", "F12" },
+              { none, none, { Action::ToggleImGui, -1 } });
+    RunScript("chord", t, 0xF,
+              { "", "DOWN", "DOWN 1", "DOWN 1", "DOWN", "A DOWN 1" },
+              { none, { Action::Teleport, -1 }, none, none, { Action::Teleport, -1 } });
+    RunScript("two edges one frame", t, 0xF,
+              { "", "1 3", "1 3 K" },
+              { { Action::ToggleMenu, -1 }, { Action::MacroSlot, -1 } });
+    RunScript("release order", t, 0xF,
+              { "I O", "O", "I O", "I", "I O" },
+              { none, { Action::MacroRecord, -1 }, none, { Action::MacroPlay, -1 } });
+    RunScript("unbound keys", t, 0xF,
+              { "", "Z", "Z Q", "" },
+              { none, none, none });
+
+    // The live loop checks the chord modifiers in the current snapshot after the hit
+    ScriptedKeySource src({ "DOWN", "DOWN A 1" });
+    Snapshot prev, cur;
+    src.Next(prev);
+    src.Next(cur);
+    const Hit hit = t.Evaluate(prev, cur, 0xF);
+    Check(hit.action == Action::Teleport && cur.keys.Test(kVkDown) && cur.keys.Test('A'),
+          "teleport hit sees DOWN+A held for the round-start chord");
+}
+
+void CheckPads(const HotkeyDispatch::Table& t) {
+    const Expect none{ Action::None, -1 };
+    RunScript("pad edge", t, 0xF,
+              { "", "pad0:Y", "pad0:Y", "pad0:Y+DDOWN", "", "pad2:Y" },
+              { { Action::Teleport, 0 }, none, none, none, { Action::Teleport, 2 } });
+    RunScript("pad filter", t, 0x1,
+              { "", "pad1:START", "pad1:START pad0:START" },
+              { none, { Action::ToggleMenu, 0 } });
+    RunScript("triggers", t, 0xF,
+              { "", "pad0:LT-", "pad0:LT", "pad0:LT+RT", "pad0:RT" },
+              { none, { Action::MacroRecord, 0 }, { Action::MacroPlay, 0 }, none });
+    RunScript("keyboard before pad in table order", t, 0xF,
+              { "", "F12 pad0:START" },
+              { { Action::ToggleImGui, -1 } });
+    RunScript("pad before later keyboard binding", t, 0xF,
+              { "", "1 pad3:X" },
+              { { Action::SavePosition, 3 } });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--verbose") == 0) {
+            g_verbose = true;
+        } else {
+            fprintf(stderr, "usage: %s [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+    HotkeyDispatch::Table t = BuildDefaultTable();
+    CheckTable(t);
+    CheckKeyboard(t);
+    CheckPads(t);
+    printf("%d checks, %d failed\n", g_checks, g_failed);
+    return g_failed ? 1 : 0;
+}
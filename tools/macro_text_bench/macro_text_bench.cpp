@@ -0,0 +1,164 @@
+// efz_macro_text_bench: throughput of the EFZMACRO text codec (MacroText::Parse / MacroText::Writer).
+//
+//   efz_macro_text_bench [macro.txt ...] [--ticks N] [--repeat N]
+//
+// Each input file is one macro in EFZMACRO 1 text (as shown by the Macros tab editor). Without
+// files a synthetic pack is generated: N ticks (default 200000) of held directions, button presses
+// with explicit {k: ...} buffer groups and xN runs, the shape of recorded macros. Every input is
+// parsed and re-serialized `--repeat` times; the canonical output must parse back to the same ticks.
+// Builds on any host (the codec has no Win32 dependencies).
+#include "../../include/game/macro_text.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<std::string> files;
+    uint32_t ticks = 200000;
+    int repeat = 20;
+};
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--ticks") && i + 1 < argc) opt.ticks = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) opt.repeat = atoi(argv[++i]);
+        else if (argv[i][0] == '-') return false;
+        else opt.files.push_back(argv[i]);
+    }
+    return opt.repeat > 0 && opt.ticks > 0;
+}
+
+// Flattened ticks: one mask and one write count per tick, writes concatenated
+struct Ticks : MacroText::TickSink {
+    std::vector<uint8_t> masks;
+    std::vector<uint16_t> counts;
+    std::vector<uint8_t> writes;
+    void OnTicks(uint8_t mask, const uint8_t* w, uint16_t k, uint32_t repeat) override {
+        for (uint32_t r = 0; r < repeat; ++r) {
+            masks.push_back(mask);
+            counts.push_back(k);
+            writes.insert(writes.end(), w, w + k);
+        }
+    }
+    void clear() { masks.clear(); counts.clear(); writes.clear(); }
+    bool operator==(const Ticks& o) const { return masks == o.masks && counts == o.counts && writes == o.writes; }
+};
+
+struct CountingSink : MacroText::TickSink {
+    uint64_t ticks = 0;
+    void OnTicks(uint8_t, const uint8_t*, uint16_t, uint32_t repeat) override { ticks += repeat; }
+};
+
+std::string Synthesize(uint32_t ticks) {
+    using namespace MacroText;
+    static const uint8_t kDirs[] = { 0, kDown, kDown | kRight, kRight, kDown | kLeft, kLeft, kUp, kUp | kRight };
+    static const uint8_t kButtons[] = { kA, kB, kC, kD, kA | kB, kB | kC };
+    uint32_t seed = 0x1234567u;
+    auto next = [&]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    std::string out;
+    Writer w(out, true);
+    uint32_t t = 0;
+    while (t < ticks) {
+        const uint8_t dir = kDirs[next() % 8];
+        const uint32_t hold = 1 + next() % 24;
+        for (uint32_t i = 0; i < hold && t < ticks; ++i, ++t) w.Tick(dir, &dir, 1);
+        if (next() % 3 == 0 && t < ticks) {
+            // Button press with the engine's typical 2-3 raw writes for that tick
+            const uint8_t m = (uint8_t)(dir | kButtons[next() % 6]);
+            const uint8_t writes[3] = { dir, m, m };
+            w.Tick(m, writes, (uint16_t)(2 + next() % 2));
+            ++t;
+        }
+    }
+    w.Finish();
+    return out;
+}
+
+bool ReadFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { fprintf(stderr, "cannot open %s\n", path.c_str()); return false; }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+bool Bench(const std::string& label, const std::string& text, int repeat) {
+    MacroText::ParseError err;
+    Ticks parsed;
+    if (!MacroText::Parse(text, parsed, err)) {
+        fprintf(stderr, "%s: %s (at offset %zu)\n", label.c_str(), err.message.c_str(), err.offset);
+        return false;
+    }
+
+    // Round trip: canonical text must reproduce the same ticks
+    std::string canon;
+    {
+        MacroText::Writer w(canon, true);
+        size_t pos = 0;
+        for (size_t i = 0; i < parsed.masks.size(); ++i) {
+            w.Tick(parsed.masks[i], parsed.writes.data() + pos, parsed.counts[i]);
+            pos += parsed.counts[i];
+        }
+        w.Finish();
+    }
+    Ticks again;
+    if (!MacroText::Parse(canon, again, err) || !(again == parsed)) {
+        fprintf(stderr, "%s: round trip mismatch\n", label.c_str());
+        return false;
+    }
+
+    CountingSink counter;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) MacroText::Parse(text, counter, err);
+    const double parseSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::string out;
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+        out.clear();
+        MacroText::Writer w(out, true);
+        size_t pos = 0;
+        for (size_t k = 0; k < parsed.masks.size(); ++k) {
+            w.Tick(parsed.masks[k], parsed.writes.data() + pos, parsed.counts[k]);
+            pos += parsed.counts[k];
+        }
+        w.Finish();
+    }
+    const double writeSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const double mb = text.size() * (double)repeat / (1024.0 * 1024.0);
+    fprintf(stderr, "%s: %zu bytes, %zu ticks, %zu buffer writes\n", label.c_str(), text.size(),
+            parsed.masks.size(), parsed.writes.size());
+    fprintf(stderr, "  parse: %.1f us/macro, %.0f MB/s, %.1f Mticks/s\n", parseSecs * 1e6 / repeat,
+            parseSecs > 0 ? mb / parseSecs : 0.0, parseSecs > 0 ? counter.ticks / parseSecs / 1e6 : 0.0);
+    fprintf(stderr, "  write: %.1f us/macro, %.1f Mticks/s\n", writeSecs * 1e6 / repeat,
+            writeSecs > 0 ? parsed.masks.size() * (double)repeat / writeSecs / 1e6 : 0.0);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s [macro.txt ...] [--ticks N] [--repeat N]\n", argv[0]);
+        return 2;
+    }
+    bool ok = true;
+    if (opt.files.empty()) {
+        ok = Bench("synthetic", Synthesize(opt.ticks), opt.repeat);
+    }
+    for (const std::string& path : opt.files) {
+        std::string text;
+        ok = ReadFile(path, text) && Bench(path, text, opt.repeat) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// efz_macro_text_fuzz: round-trip and mutation checks for the EFZMACRO text codec.
+//
+//   efz_macro_text_fuzz [--iterations N] [--seed S]
+//
+// Round trip: random tick sequences (held directions, button presses, arbitrary raw buffer bytes
+// including impossible U+D / L+R combinations, and runs longer than kMaxRepeat) are written with
+// MacroText::Writer, with and without buffer groups, and must parse back to the same ticks.
+// Mutation: each written macro is also mangled (bytes replaced, inserted, deleted from the grammar's
+// alphabet) and parsed. Parse must not crash, must report an error offset inside the text, and
+// anything it accepts must survive Writer -> Parse unchanged.
+// Exits 1 on the first failure and prints the offending text. Builds on any host.
+#include "../../include/game/macro_text.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace MacroText;
+
+struct Options {
+    uint32_t iterations = 20000;
+    uint32_t seed = 0x5eed1234u;
+};
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--iterations") && i + 1 < argc) opt.iterations = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) opt.seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else return false;
+    }
+    return opt.iterations > 0;
+}
+
+struct Rng {
+    uint32_t s;
+    uint32_t Next() { s = s * 1664525u + 1013904223u; return s >> 8; }
+    uint32_t Below(uint32_t n) { return Next() % n; }
+};
+
+// One pack per distinct tick content; adjacent identical packs are merged so two parses of the
+// same ticks compare equal however the text grouped them
+struct Pack {
+    uint8_t mask;
+    std::vector<uint8_t> writes;
+    uint64_t repeat;
+};
+
+struct Packs : TickSink {
+    std::vector<Pack> packs;
+    uint64_t ticks = 0;
+    void Add(uint8_t mask, const uint8_t* w, uint16_t k, uint64_t repeat) {
+        ticks += repeat;
+        if (!packs.empty()) {
+            Pack& last = packs.back();
+            if (last.mask == mask && last.writes.size() == k &&
+                (k == 0 || memcmp(last.writes.data(), w, k) == 0)) {
+                last.repeat += repeat;
+                return;
+            }
+        }
+        packs.push_back({ mask, std::vector<uint8_t>(w, w + k), repeat });
+    }
+    void OnTicks(uint8_t mask, const uint8_t* w, uint16_t k, uint32_t repeat) override { Add(mask, w, k, repeat); }
+    bool operator==(const Packs& o) const {
+        if (packs.size() != o.packs.size()) return false;
+        for (size_t i = 0; i < packs.size(); ++i) {
+            if (packs[i].mask != o.packs[i].mask || packs[i].writes != o.packs[i].writes ||
+                packs[i].repeat != o.packs[i].repeat) return false;
+        }
+        return true;
+    }
+};
+
+std::string Write(const Packs& in, bool includeBuffers) {
+    std::string out;
+    Writer w(out, includeBuffers);
+    for (const Pack& p : in.packs) {
+        for (uint64_t r = 0; r < p.repeat; ++r) w.Tick(p.mask, p.writes.data(), (uint16_t)p.writes.size());
+    }
+    w.Finish();
+    return out;
+}
+
+// What Parse should return for `in` written without buffer groups: one write equal to the mask
+Packs WithoutBuffers(const Packs& in) {
+    Packs out;
+    for (const Pack& p : in.packs) out.Add(p.mask, &p.mask, 1, p.repeat);
+    return out;
+}
+
+Packs RandomTicks(Rng& rng, bool longRun) {
+    static const uint8_t kDirs[] = { 0, kDown, kDown | kRight, kRight, kDown | kLeft, kLeft, kUp, kUp | kRight, kUp | kLeft };
+    static const uint8_t kButtons[] = { 0, kA, kB, kC, kD, kA | kB, kB | kC, kA | kB | kC | kD };
+    Packs out;
+    const uint32_t packs = 1 + rng.Below(40);
+    for (uint32_t i = 0; i < packs; ++i) {
+        const uint8_t mask = (uint8_t)(kDirs[rng.Below(9)] | kButtons[rng.Below(8)]);
+        uint8_t writes[8];
+        const uint16_t k = (uint16_t)rng.Below(5);
+        for (uint16_t j = 0; j < k; ++j) {
+            // Mostly the tick mask or a neighbour; sometimes any byte (hex form in the writer)
+            writes[j] = rng.Below(4) == 0 ? (uint8_t)rng.Below(256) : (uint8_t)(j == 0 ? mask & 0x0F : mask);
+        }
+        out.Add(mask, writes, k, 1 + rng.Below(rng.Below(4) == 0 ? 200 : 6));
+    }
+    if (longRun) {
+        // Longer than one xN suffix may express; the writer has to split it
+        const uint8_t mask = kDown;
+        out.Add(mask, &mask, 1, (uint64_t)kMaxRepeat * 2 + 1 + rng.Below(1000));
+    }
+    return out;
+}
+
+std::string Mutate(Rng& rng, std::string text) {
+    static const char kAlphabet[] = "0123456789NnABCDabcdxX{}: \n\t0xFF";
+    const uint32_t edits = 1 + rng.Below(6);
+    for (uint32_t e = 0; e < edits; ++e) {
+        const size_t at = text.empty() ? 0 : rng.Below((uint32_t)text.size() + 1);
+        const char c = kAlphabet[rng.Below(sizeof(kAlphabet) - 1)];
+        switch (rng.Below(3)) {
+            case 0: if (at < text.size()) text[at] = c; else text.push_back(c); break;
+            case 1: text.insert(text.begin() + at, c); break;
+            default: if (at < text.size()) text.erase(at, 1 + rng.Below(4)); break;
+        }
+    }
+    return text;
+}
+
+void PrintFailure(const char* what, const std::string& text) {
+    fprintf(stderr, "FAIL: %s\n", what);
+    if (text.size() > 400) fprintf(stderr, "  text (first 400 of %zu bytes): %.400s\n", text.size(), text.c_str());
+    else fprintf(stderr, "  text: %s\n", text.c_str());
+}
+
+bool CheckRoundTrip(const Packs& ticks, bool includeBuffers) {
+    const std::string text = Write(ticks, includeBuffers);
+    Packs back;
+    ParseError err;
+    if (!Parse(text, back, err)) {
+        PrintFailure(("writer output rejected at " + std::to_string(err.offset) + ": " + err.message).c_str(), text);
+        return false;
+    }
+    if (!(back == (includeBuffers ? ticks : WithoutBuffers(ticks)))) {
+        PrintFailure(includeBuffers ? "round trip changed ticks" : "round trip (no buffers) changed ticks", text);
+        return false;
+    }
+    return true;
+}
+
+// Accepted input must be a fixed point of Writer -> Parse
+bool CheckMutation(const std::string& text, bool& accepted) {
+    Packs first;
+    ParseError err;
+    accepted = Parse(text, first, err);
+    if (!accepted) {
+        if (err.offset > text.size() || err.message.empty()) {
+            PrintFailure("error offset outside the text or empty message", text);
+            return false;
+        }
+        return true;
+    }
+    // Mutated repeat digits can ask for ~1M ticks per pack; skip re-writing absurd sizes
+    if (first.ticks > 16u * kMaxRepeat) return true;
+    const std::string canon = Write(first, true);
+    Packs second;
+    if (!Parse(canon, second, err)) {
+        PrintFailure(("canonical form rejected at " + std::to_string(err.offset) + ": " + err.message).c_str(), text);
+        return false;
+    }
+    if (!(first == second)) {
+        PrintFailure("canonical form parsed to different ticks", text);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: efz_macro_text_fuzz [--iterations N] [--seed S]\n");
+        return 2;
+    }
+    Rng rng{ opt.seed };
+    uint32_t accepted = 0, rejected = 0;
+    for (uint32_t i = 0; i < opt.iterations; ++i) {
+        // Long runs are slow to write tick by tick; exercise them on a small fraction of iterations
+        const Packs ticks = RandomTicks(rng, i % 500 == 0);
+        if (!CheckRoundTrip(ticks, true) || !CheckRoundTrip(ticks, false)) return 1;
+
+        const bool small = ticks.ticks <= 4096;
+        const std::string text = Write(ticks, rng.Below(2) == 0 || !small);
+        if (!small) continue;
+        bool ok = false;
+        if (!CheckMutation(Mutate(rng, text), ok)) return 1;
+        if (ok) ++accepted; else ++rejected;
+    }
+    printf("%u round trips ok; mutations: %u accepted, %u rejected, 0 failures\n",
+           opt.iterations, accepted, rejected);
+    return 0;
+}
@@ -0,0 +1,245 @@
+// efz_macro_verify: batch replay-fidelity check for recorded macros.
+//
+//   efz_macro_verify [macro.txt | library.efzlib ...] [--phase 0|1|2|all] [--max-mismatch N]
+//                    [--synthetic N] [--repeat N] [--quiet]
+//
+// Every macro (an EFZMACRO 1 text file, or each entry of an efz_macros.efzlib library) is replayed
+// through MacroReplay's per-tick step into the portable input-buffer model and the history it
+// produces is diffed against the recorded buffer writes (MacroReplay::VerifyStream). --phase picks
+// the controller subframe on which each tick starts (default 0; live playback advances whenever the
+// engine index moves, so "all" also checks ticks that start late). A macro fails when a checked
+// phase has more than --max-mismatch differing entries (default 0) or a different entry count; the
+// exit code is 1 if any macro failed. Without inputs, --synthetic N macros of recorder-shaped ticks are
+// generated; every fourth one is a mismatch control (mid-tick direction changes, more writes than
+// subframes) that replay cannot reproduce, and it passes only if the check flags it.
+// --repeat re-runs the whole batch for throughput numbers. Builds on any host.
+#include "../../include/game/macro_library.h"
+#include "../../include/game/macro_replay.h"
+#include "../../include/game/macro_text.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<std::string> files;
+    int phaseFirst = 0;
+    int phaseLast = 0;
+    uint32_t maxMismatch = 0;
+    uint32_t synthetic = 2000;
+    int repeat = 1;
+    bool quiet = false;
+};
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--phase") && i + 1 < argc) {
+            const char* v = argv[++i];
+            if (!strcmp(v, "all")) { opt.phaseFirst = 0; opt.phaseLast = MacroReplay::kSubframesPerTick - 1; continue; }
+            opt.phaseFirst = opt.phaseLast = atoi(v);
+            if (opt.phaseFirst < 0 || opt.phaseFirst >= MacroReplay::kSubframesPerTick) return false;
+        }
+        else if (!strcmp(argv[i], "--max-mismatch") && i + 1 < argc) opt.maxMismatch = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--synthetic") && i + 1 < argc) opt.synthetic = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) opt.repeat = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--quiet")) opt.quiet = true;
+        else if (argv[i][0] == '-') return false;
+        else opt.files.push_back(argv[i]);
+    }
+    return opt.repeat > 0;
+}
+
+// One macro's streams, flattened: one mask and one write count per tick, writes concatenated
+struct Macro : MacroText::TickSink {
+    std::string label;
+    std::vector<uint8_t> masks;
+    std::vector<uint16_t> counts;
+    std::vector<uint8_t> writes;
+    bool expectMismatch = false; // synthetic control the replay model must fail to reproduce
+    void OnTicks(uint8_t mask, const uint8_t* w, uint16_t k, uint32_t repeat) override {
+        for (uint32_t r = 0; r < repeat; ++r) {
+            masks.push_back(mask);
+            counts.push_back(k);
+            writes.insert(writes.end(), w, w + k);
+        }
+    }
+};
+
+bool ReadFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { fprintf(stderr, "cannot open %s\n", path.c_str()); return false; }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+bool EndsWith(const std::string& s, const char* suffix) {
+    const size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+bool InBounds(const std::string& data, uint64_t offset, uint64_t bytes) {
+    return offset <= data.size() && bytes <= data.size() - offset;
+}
+
+// Reads the library file directly (MacroLibrary maps it through Win32); layout in macro_library.h
+bool LoadMacroLibrary(const std::string& path, std::vector<Macro>& out) {
+    std::string data;
+    if (!ReadFile(path, data)) return false;
+    MacroLibFileHeader hdr{};
+    if (data.size() < sizeof(hdr)) { fprintf(stderr, "%s: truncated header\n", path.c_str()); return false; }
+    memcpy(&hdr, data.data(), sizeof(hdr));
+    if (hdr.magic != MACROLIB_MAGIC || hdr.version != MACROLIB_VERSION ||
+        hdr.headerSize != sizeof(MacroLibFileHeader) || hdr.entrySize != sizeof(MacroLibEntry)) {
+        fprintf(stderr, "%s: not a version %u macro library\n", path.c_str(), MACROLIB_VERSION);
+        return false;
+    }
+    if (!InBounds(data, hdr.indexOffset, (uint64_t)hdr.entryCount * sizeof(MacroLibEntry))) {
+        fprintf(stderr, "%s: index out of bounds\n", path.c_str());
+        return false;
+    }
+    for (uint32_t i = 0; i < hdr.entryCount; ++i) {
+        MacroLibEntry e{};
+        memcpy(&e, data.data() + hdr.indexOffset + (size_t)i * sizeof(MacroLibEntry), sizeof(e));
+        if (!InBounds(data, e.nameOffset, e.nameLength) || !InBounds(data, e.macroOffset, e.ticks) ||
+            !InBounds(data, e.countsOffset, (uint64_t)e.ticks * sizeof(uint16_t)) ||
+            !InBounds(data, e.bufOffset, e.bufLength)) {
+            fprintf(stderr, "%s: entry %u out of bounds, skipped\n", path.c_str(), i);
+            continue;
+        }
+        Macro m;
+        m.label = path + ":" + data.substr(e.nameOffset, e.nameLength);
+        m.masks.assign(data.begin() + e.macroOffset, data.begin() + e.macroOffset + e.ticks);
+        m.counts.resize(e.ticks);
+        if (e.ticks) memcpy(m.counts.data(), data.data() + e.countsOffset, (size_t)e.ticks * sizeof(uint16_t));
+        m.writes.assign(data.begin() + e.bufOffset, data.begin() + e.bufOffset + e.bufLength);
+        out.push_back(std::move(m));
+    }
+    return true;
+}
+
+bool LoadText(const std::string& path, std::vector<Macro>& out) {
+    std::string text;
+    if (!ReadFile(path, text)) return false;
+    Macro m;
+    m.label = path;
+    MacroText::ParseError err;
+    if (!MacroText::Parse(text, m, err)) {
+        fprintf(stderr, "%s: %s (at offset %zu)\n", path.c_str(), err.message.c_str(), err.offset);
+        return false;
+    }
+    out.push_back(std::move(m));
+    return true;
+}
+
+// Recorder-shaped macros: held directions (one write per tick) and button presses whose writes
+// carry the press on every subframe, 60..600 ticks each. Controls add ticks the replay step cannot
+// reproduce: writes whose direction differs from the tick mask (directions come from the mask) or
+// more writes than subframes (one history entry per subframe).
+void Synthesize(uint32_t count, std::vector<Macro>& out) {
+    using namespace MacroText;
+    static const uint8_t kDirs[] = { 0, kDown, kDown | kRight, kRight, kDown | kLeft, kLeft, kUp, kUp | kRight };
+    static const uint8_t kButtons[] = { kA, kB, kC, kD, kA | kB, kB | kC };
+    uint32_t seed = 0x5eed1234u;
+    auto next = [&]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    for (uint32_t n = 0; n < count; ++n) {
+        Macro m;
+        m.label = "synthetic#" + std::to_string(n);
+        m.expectMismatch = (n % 4 == 3);
+        const uint32_t ticks = 60 + next() % 541;
+        if (m.expectMismatch) {
+            // Motion input inside one tick: 2 -> 3 -> 6C written while the tick mask holds 6C
+            const uint8_t press = (uint8_t)(kRight | kC);
+            const uint8_t motion[3] = { kDown, kDown | kRight, press };
+            m.OnTicks(press, motion, 3, 1);
+        }
+        while (m.masks.size() < ticks) {
+            const uint8_t dir = kDirs[next() % 8];
+            const uint32_t hold = 1 + next() % 24;
+            for (uint32_t i = 0; i < hold && m.masks.size() < ticks; ++i) m.OnTicks(dir, &dir, 1, 1);
+            if (next() % 3 == 0 && m.masks.size() < ticks) {
+                const uint8_t press = (uint8_t)(dir | kButtons[next() % 6]);
+                const uint8_t writes[3] = { press, press, press };
+                m.OnTicks(press, writes, (uint16_t)(2 + next() % 2), 1);
+            }
+            if (m.expectMismatch && next() % 4 == 0 && m.masks.size() < ticks) {
+                // Five writes in one tick
+                const uint8_t press = (uint8_t)(dir | kButtons[next() % 6]);
+                const uint8_t writes[5] = { dir, press, press, dir, press };
+                m.OnTicks(press, writes, 5, 1);
+            }
+        }
+        out.push_back(std::move(m));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: efz_macro_verify [macro.txt | library.efzlib ...] [--phase 0|1|2|all] "
+                        "[--max-mismatch N] [--synthetic N] [--repeat N] [--quiet]\n");
+        return 2;
+    }
+
+    std::vector<Macro> macros;
+    bool loadOk = true;
+    for (const std::string& f : opt.files) {
+        loadOk &= EndsWith(f, ".efzlib") ? LoadMacroLibrary(f, macros) : LoadText(f, macros);
+    }
+    if (opt.files.empty()) Synthesize(opt.synthetic, macros);
+    if (macros.empty()) {
+        fprintf(stderr, "no macros to verify\n");
+        return loadOk ? 0 : 2;
+    }
+
+    uint64_t totalTicks = 0;
+    size_t controls = 0;
+    for (const Macro& m : macros) {
+        totalTicks += m.masks.size();
+        if (m.expectMismatch) ++controls;
+    }
+
+    size_t failed = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < opt.repeat; ++rep) {
+        const bool report = (rep == 0);
+        for (const Macro& m : macros) {
+            bool ok = true;
+            for (int phase = opt.phaseFirst; phase <= opt.phaseLast; ++phase) {
+                const MacroReplay::FidelityReport r = MacroReplay::VerifyStream(
+                    m.masks.data(), m.counts.data(), (uint32_t)m.masks.size(),
+                    m.writes.data(), (uint32_t)m.writes.size(), phase);
+                const bool flagged = r.mismatches > opt.maxMismatch || r.producedEntries != r.expectedEntries;
+                const bool phaseOk = flagged == m.expectMismatch;
+                if (!phaseOk && report && !opt.quiet && m.expectMismatch) {
+                    printf("FAIL %s phase=%d: mismatch control replayed cleanly\n", m.label.c_str(), phase);
+                } else if (!phaseOk && report && !opt.quiet) {
+                    printf("FAIL %s phase=%d ticks=%u entries=%u/%u mismatches=%u (dir=%u btn=%u) first@%lld exp=0x%02X got=0x%02X\n",
+                           m.label.c_str(), phase, r.ticks, r.producedEntries, r.expectedEntries, r.mismatches,
+                           r.directionMismatches, r.buttonMismatches, (long long)r.firstMismatch,
+                           r.firstExpected, r.firstProduced);
+                }
+                ok &= phaseOk;
+            }
+            if (report && !ok) ++failed;
+        }
+    }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const double runs = (double)macros.size() * opt.repeat;
+    printf("%zu macros (%zu mismatch controls), %llu ticks, phases %d..%d: %zu passed, %zu failed\n",
+           macros.size(), controls, (unsigned long long)totalTicks, opt.phaseFirst, opt.phaseLast,
+           macros.size() - failed, failed);
+    fprintf(stderr, "  %.0f macros/s, %.1f Mticks/s\n", secs > 0 ? runs / secs : 0.0,
+            secs > 0 ? (double)totalTicks * opt.repeat * (opt.phaseLast - opt.phaseFirst + 1) / secs / 1e6 : 0.0);
+    return (failed == 0 && loadOk) ? 0 : 1;
+}
@@ -0,0 +1,283 @@
+// efz_move_props_check: exhaustive equivalence check and microbenchmark for the MoveProps table.
+//
+//   efz_move_props_check [--bench LOOKUPS] [--repeat N]
+//
+// The Legacy namespace below keeps the comparison chains MoveProps replaced (IsActionable,
+// IsBlockstun, IsRecoilGuard, IsDashState, IsHitstun, IsLaunched, IsAirtech, IsGroundtech, IsFrozen,
+// IsSpecialStun, IsThrown, IsBlockstunState, IsAttackMove, the airtechable moveID test of
+// IsPlayerAirtechable and the Continuous Recovery / RF freeze neutral whitelist), minus the
+// std::locale::global calls. Every flag is compared against its predicate for all 65536 short
+// values; any mismatch is printed and the exit code is 1.
+// --bench runs LOOKUPS pseudo-random moveIDs (mostly engine-range, some character-specific and
+// negative) through the old chains and through MoveProps::Get, --repeat times, and reports lookups
+// per second for both.
+// Builds on any host.
+#include "../../include/core/constants.h"
+#include "../../include/game/move_props.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace Legacy {
+
+bool IsHitstun(short moveID) {
+    return (moveID >= STAND_HITSTUN_START && moveID <= STAND_HITSTUN_END) ||
+           (moveID >= CROUCH_HITSTUN_START && moveID <= CROUCH_HITSTUN_END) ||
+           moveID == SWEEP_HITSTUN ||
+           moveID == 69; // Ikumi 623 hit state
+}
+
+bool IsLaunched(short moveID) {
+    return moveID >= LAUNCHED_HITSTUN_START && moveID <= LAUNCHED_HITSTUN_END;
+}
+
+bool IsAirtech(short moveID) {
+    return moveID == FORWARD_AIRTECH || moveID == BACKWARD_AIRTECH;
+}
+
+bool IsGroundtech(short moveID) {
+    return moveID == GROUNDTECH_PRE ||
+           moveID == GROUNDTECH_START ||
+           moveID == GROUNDTECH_END ||
+           moveID == GROUNDTECH_RECOVERY;
+}
+
+bool IsFrozen(short moveID) {
+    return moveID >= FROZEN_STATE_START && moveID <= FROZEN_STATE_END;
+}
+
+bool IsSpecialStun(short moveID) {
+    return moveID == FIRE_STATE || moveID == ELECTRIC_STATE ||
+           (moveID >= FROZEN_STATE_START && moveID <= FROZEN_STATE_END);
+}
+
+bool IsThrown(short moveID) {
+    if (moveID >= THROWN_STATE_START && moveID <= THROWN_STATE_END) return true;
+    if (moveID >= THROWN2_STATE_START && moveID <= THROWN2_STATE_END) return true;
+    if (moveID >= THROWN3_STATE_START && moveID <= THROWN3_STATE_END) return true;
+    if (moveID >= THROWN4_STATE_START && moveID <= THROWN4_STATE_END) return true;
+    if (moveID >= THROWN5_STATE_START && moveID <= THROWN5_STATE_END) return true;
+    return false;
+}
+
+bool IsBlockstunState(short moveID) {
+    return moveID == STANDING_BLOCK_LVL1 ||
+           moveID == STANDING_BLOCK_LVL2 ||
+           moveID == STANDING_BLOCK_LVL3 ||
+           moveID == CROUCHING_BLOCK_LVL1 ||
+           moveID == CROUCHING_BLOCK_LVL2_A ||
+           moveID == CROUCHING_BLOCK_LVL2_B ||
+           moveID == AIR_GUARD_ID;
+}
+
+bool IsAttackMove(short moveID) {
+    return (moveID >= 200 && moveID <= 350) ||
+           (moveID >= 400 && moveID <= 500);
+}
+
+bool IsRecoilGuard(short moveID) {
+    return moveID == RG_STAND_ID || moveID == RG_CROUCH_ID || moveID == RG_AIR_ID;
+}
+
+bool IsDashState(short moveID) {
+    return moveID == FORWARD_DASH_START_ID ||
+           moveID == FORWARD_DASH_RECOVERY_ID ||
+           moveID == BACKWARD_DASH_START_ID ||
+           moveID == BACKWARD_DASH_RECOVERY_ID;
+}
+
+bool IsBlockstun(short moveID) {
+    if (moveID == STAND_GUARD_ID ||
+        moveID == CROUCH_GUARD_ID ||
+        moveID == CROUCH_GUARD_STUN1 ||
+        moveID == CROUCH_GUARD_STUN2 ||
+        moveID == AIR_GUARD_ID) {
+        return true;
+    }
+    if (moveID == 150 || moveID == 152 ||
+        (moveID >= 140 && moveID <= 149) ||
+        (moveID >= 153 && moveID <= 165)) {
+        if (moveID == FORWARD_DASH_START_ID ||
+            moveID == FORWARD_DASH_RECOVERY_ID ||
+            moveID == FORWARD_DASH_RECOVERY_SENTINEL_ID ||
+            moveID == BACKWARD_DASH_START_ID ||
+            moveID == BACKWARD_DASH_RECOVERY_ID) {
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool IsNeutral(short moveID) {
+    return moveID == IDLE_MOVE_ID ||
+           moveID == WALK_FWD_ID ||
+           moveID == WALK_BACK_ID ||
+           moveID == CROUCH_ID ||
+           moveID == CROUCH_TO_STAND_ID ||
+           moveID == FALLING_ID ||
+           moveID == LANDING_ID || moveID == LANDING_1_ID || moveID == LANDING_2_ID || moveID == LANDING_3_ID;
+}
+
+// IsActionable's explicit inactionable groups
+bool IsProhibited(short moveID) {
+    bool isDash = (moveID == FORWARD_DASH_START_ID || moveID == FORWARD_DASH_RECOVERY_ID ||
+                   moveID == BACKWARD_DASH_START_ID || moveID == BACKWARD_DASH_RECOVERY_ID ||
+                   moveID == FORWARD_DASH_RECOVERY_SENTINEL_ID);
+    bool isGroundTechSeq = (moveID == GROUNDTECH_RECOVERY || moveID == GROUNDTECH_PRE || moveID == GROUNDTECH_START || moveID == GROUNDTECH_END);
+    bool isSuperflash = (moveID == GROUND_IC_ID || moveID == AIR_IC_ID);
+    return IsAttackMove(moveID) ||
+           IsBlockstunState(moveID) ||
+           IsHitstun(moveID) ||
+           IsLaunched(moveID) ||
+           IsThrown(moveID) ||
+           IsAirtech(moveID) ||
+           IsGroundtech(moveID) ||
+           IsFrozen(moveID) ||
+           IsRecoilGuard(moveID) ||
+           isDash || isGroundTechSeq || isSuperflash ||
+           moveID == STAND_GUARD_ID ||
+           moveID == CROUCH_GUARD_ID ||
+           moveID == AIR_GUARD_ID;
+}
+
+// Unknown states are not actionable
+bool IsActionable(short moveID) {
+    if (IsNeutral(moveID)) return true;
+    return false;
+}
+
+bool IsRecoveryNeutral(short m) {
+    return (m == 0 || m == 1 || m == 2 || m == 3 || m == 4 || m == 7 || m == 8 || m == 9 || m == 13);
+}
+
+bool IsAirtechableMove(short moveID) {
+    return (moveID >= LAUNCHED_HITSTUN_START && moveID <= LAUNCHED_HITSTUN_END) ||
+           (moveID == FIRE_STATE || moveID == ELECTRIC_STATE);
+}
+
+} // namespace Legacy
+
+namespace {
+
+struct Check {
+    const char* name;
+    uint16_t    flag;
+    bool (*legacy)(short);
+};
+
+bool LegacyProhibitedFlag(short m) { return !Legacy::IsNeutral(m) && Legacy::IsProhibited(m); }
+
+const Check kChecks[] = {
+    { "Actionable",      MoveProps::Actionable,      &Legacy::IsActionable },
+    { "RecoveryNeutral", MoveProps::RecoveryNeutral, &Legacy::IsRecoveryNeutral },
+    { "Blockstun",       MoveProps::Blockstun,       &Legacy::IsBlockstun },
+    { "BlockstunState",  MoveProps::BlockstunState,  &Legacy::IsBlockstunState },
+    { "RecoilGuard",     MoveProps::RecoilGuard,     &Legacy::IsRecoilGuard },
+    { "Dash",            MoveProps::Dash,            &Legacy::IsDashState },
+    { "Hitstun",         MoveProps::Hitstun,         &Legacy::IsHitstun },
+    { "Launched",        MoveProps::Launched,        &Legacy::IsLaunched },
+    { "Airtech",         MoveProps::Airtech,         &Legacy::IsAirtech },
+    { "Groundtech",      MoveProps::Groundtech,      &Legacy::IsGroundtech },
+    { "Frozen",          MoveProps::Frozen,          &Legacy::IsFrozen },
+    { "SpecialStun",     MoveProps::SpecialStun,     &Legacy::IsSpecialStun },
+    { "Thrown",          MoveProps::Thrown,          &Legacy::IsThrown },
+    { "Attack",          MoveProps::Attack,          &Legacy::IsAttackMove },
+    { "AirtechableMove", MoveProps::AirtechableMove, &Legacy::IsAirtechableMove },
+    { "Prohibited",      MoveProps::Prohibited,      &LegacyProhibitedFlag },
+};
+
+// Every flag against its predicate for every short value; returns the mismatch count
+int RunEquivalence() {
+    int mismatches = 0;
+    for (const Check& c : kChecks) {
+        int bad = 0;
+        for (int v = -32768; v <= 32767; ++v) {
+            const short id = static_cast<short>(v);
+            const bool table = MoveProps::Has(id, c.flag);
+            const bool legacy = c.legacy(id);
+            if (table != legacy) {
+                if (bad < 8) printf("MISMATCH %-15s moveID=%d table=%d legacy=%d\n", c.name, v, table, legacy);
+                ++bad;
+            }
+        }
+        printf("%-15s %s (%d mismatches over 65536 IDs)\n", c.name, bad ? "FAIL" : "ok", bad);
+        mismatches += bad;
+    }
+    return mismatches;
+}
+
+// Mostly engine-range IDs with some character-specific and negative values, like a real trace
+std::vector<short> BuildStream(size_t n) {
+    std::vector<short> ids(n);
+    uint32_t x = 0x9E3779B9u;
+    for (size_t i = 0; i < n; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        const uint32_t r = x % 100;
+        if (r < 85) ids[i] = static_cast<short>(x % 512);
+        else if (r < 97) ids[i] = static_cast<short>(512 + x % 2048);
+        else ids[i] = static_cast<short>(-1 - static_cast<int>(x % 16));
+    }
+    return ids;
+}
+
+// Every predicate once per ID, folded into a word so neither loop can be optimised away
+uint32_t LegacyPass(const std::vector<short>& ids) {
+    uint32_t acc = 0;
+    for (short id : ids) {
+        uint32_t w = 0;
+        for (size_t c = 0; c < sizeof(kChecks) / sizeof(kChecks[0]); ++c) {
+            if (kChecks[c].legacy(id)) w |= kChecks[c].flag;
+        }
+        acc = acc * 31 + w;
+    }
+    return acc;
+}
+
+uint32_t TablePass(const std::vector<short>& ids) {
+    uint32_t acc = 0;
+    for (short id : ids) acc = acc * 31 + MoveProps::Get(id);
+    return acc;
+}
+
+template <typename Fn>
+double TimePasses(Fn&& fn, const std::vector<short>& ids, int repeat, uint32_t& digest) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) digest ^= fn(ids);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t lookups = 0;
+    int repeat = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--bench" && i + 1 < argc) lookups = strtoul(argv[++i], nullptr, 10);
+        else if (a == "--repeat" && i + 1 < argc) repeat = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--bench LOOKUPS] [--repeat N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (repeat < 1) repeat = 1;
+
+    const int mismatches = RunEquivalence();
+
+    if (lookups) {
+        const std::vector<short> ids = BuildStream(lookups);
+        uint32_t legacyDigest = 0, tableDigest = 0;
+        const double legacySecs = TimePasses(LegacyPass, ids, repeat, legacyDigest);
+        const double tableSecs = TimePasses(TablePass, ids, repeat, tableDigest);
+        const double total = static_cast<double>(lookups) * repeat;
+        printf("legacy chains: %.0f lookups/s (all %zu predicates per ID)\n",
+               legacySecs > 0 ? total / legacySecs : 0.0, sizeof(kChecks) / sizeof(kChecks[0]));
+        printf("MoveProps::Get: %.0f lookups/s\n", tableSecs > 0 ? total / tableSecs : 0.0);
+        if (legacyDigest != tableDigest) printf("digest mismatch: %08X vs %08X\n", legacyDigest, tableDigest);
+        if (tableSecs > 0) printf("speedup: %.1fx\n", legacySecs / tableSecs);
+    }
+    return mismatches ? 1 : 0;
+}
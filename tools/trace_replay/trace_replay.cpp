@@ -0,0 +1,348 @@
+// efz_trace_replay: offline replay of a TraceRecorder ring file (efz_trace.bin).
+//
+//   efz_trace_replay <trace.bin> [--csv out.csv] [--repeat N] [--triggers] [--quiet]
+//
+// Walks the recorded ticks oldest-first and prints the decisions of each tick as CSV
+// (seq,frame,event,p1,p2,detail) plus a throughput summary in ticks/second.
+//
+// Built with EFZ_TRACE_REPLAY_DRIVE_LOGIC (both CMake targets) the replayer installs a FakeGameMemory,
+// loads each record's player/game-state windows into it and runs MonitorFrameAdvantage,
+// MonitorDummyAutoBlock, MonitorAutoActions and MonitorAutoAirtech in the same order as
+// FrameDataMonitor. It reports frame-advantage results and the input injections those state machines
+// make, and counts ticks whose injection state differs from what the DLL recorded. On Windows the
+// target links the DLL sources; elsewhere it links the same logic sources against the Win32 shim and
+// module stand-ins in tools/host (EFZ_TRACE_REPLAY_HOST).
+// Every --repeat pass starts from reset feature state, so later passes time the same work as the
+// first; events are reported for the first pass only and later passes must reproduce its divergence
+// count. Without EFZ_TRACE_REPLAY_DRIVE_LOGIC only the recorded decisions are decoded.
+#include "../../include/game/trace_recorder.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(EFZ_TRACE_REPLAY_DRIVE_LOGIC)
+#include "../../include/core/fake_game_memory.h"
+#include "../../include/core/constants.h"
+#include "../../include/game/per_frame_sample.h"
+#include "../../include/game/frame_advantage.h"
+#include "../../include/game/practice_patch.h"
+#include "../../include/game/auto_action.h"
+#include "../../include/game/frame_monitor.h"
+#include "../../include/core/memory.h"
+#include "../../include/input/injection_control.h"
+#include "../../include/input/immediate_input.h"
+#include "../../include/utils/utilities.h"
+#endif
+
+namespace {
+
+struct Options {
+    std::string tracePath;
+    std::string csvPath;
+    int repeat = 1;
+    bool triggers = false;   // enable auto-action + all four triggers before replaying
+    bool quiet = false;      // summary only
+};
+
+struct TraceFile {
+    TraceFileHeader header{};
+    std::vector<TraceRecord> records;   // oldest first
+};
+
+bool LoadTrace(const std::string& path, TraceFile& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { fprintf(stderr, "cannot open %s\n", path.c_str()); return false; }
+    if (!in.read(reinterpret_cast<char*>(&out.header), sizeof(out.header))) {
+        fprintf(stderr, "%s: truncated header\n", path.c_str()); return false;
+    }
+    const TraceFileHeader& h = out.header;
+    if (h.magic != TRACE_MAGIC || h.version != TRACE_VERSION ||
+        h.headerSize != sizeof(TraceFileHeader) || h.recordSize != sizeof(TraceRecord) || h.capacity == 0) {
+        fprintf(stderr, "%s: not a v%u trace (magic=%08X version=%u record=%u)\n", path.c_str(),
+                TRACE_VERSION, h.magic, h.version, h.recordSize);
+        return false;
+    }
+    std::vector<TraceRecord> ring(h.capacity);
+    in.read(reinterpret_cast<char*>(ring.data()), (std::streamsize)(ring.size() * sizeof(TraceRecord)));
+    const size_t slotsRead = (size_t)in.gcount() / sizeof(TraceRecord);
+
+    const uint64_t count = h.written < h.capacity ? h.written : h.capacity;
+    const uint64_t first = h.written - count;
+    out.records.reserve((size_t)count);
+    for (uint64_t seq = first; seq < h.written; ++seq) {
+        size_t slot = (size_t)(seq % h.capacity);
+        // Slot never written (recording stopped early) or torn by a concurrent overwrite: skip it
+        if (slot >= slotsRead || ring[slot].seq != seq) continue;
+        out.records.push_back(ring[slot]);
+    }
+    return true;
+}
+
+bool SameInput(const TraceInputState& a, const TraceInputState& b) {
+    return a.manualOverride == b.manualOverride && a.manualMask == b.manualMask &&
+           a.pollOverride == b.pollOverride && a.pollMask == b.pollMask &&
+           a.immediateMask == b.immediateMask && a.immediateOnly == b.immediateOnly;
+}
+
+// Effective mask a side was being driven with (0 = not injected)
+int EffectiveMask(const TraceInputState& s) {
+    if (s.pollOverride) return s.pollMask;
+    if (s.manualOverride) return s.manualMask;
+    return s.immediateMask;
+}
+
+class Reporter {
+public:
+    explicit Reporter(const Options& opt) : m_quiet(opt.quiet) {
+        if (!opt.csvPath.empty()) {
+            m_file = fopen(opt.csvPath.c_str(), "w");
+            if (!m_file) fprintf(stderr, "cannot write %s, using stdout\n", opt.csvPath.c_str());
+        }
+        Line("seq,frame,event,p1,p2,detail");
+    }
+    ~Reporter() { if (m_file) fclose(m_file); }
+
+    void Event(const TraceRecord& r, const char* event, long long p1, long long p2, const std::string& detail = std::string()) {
+        ++events;
+        char buf[256];
+        snprintf(buf, sizeof(buf), "%llu,%u,%s,%lld,%lld,%s", (unsigned long long)r.seq, r.frame, event, p1, p2, detail.c_str());
+        Line(buf);
+    }
+
+    uint64_t events = 0;
+
+private:
+    void Line(const char* s) {
+        if (m_file) { fputs(s, m_file); fputc('\n', m_file); }
+        else if (!m_quiet) puts(s);
+    }
+    FILE* m_file = nullptr;
+    bool m_quiet;
+};
+
+// Decisions the DLL recorded for this tick
+void ReportRecorded(const TraceRecord& r, const TraceRecord* prev, Reporter& rep) {
+    if (r.flags & TRACE_F_P2_BLOCK_EDGE)   rep.Event(r, "block_edge", r.moveID1, r.moveID2);
+    if (r.flags & TRACE_F_P2_HITSTUN_EDGE) rep.Event(r, "hitstun_edge", r.moveID1, r.moveID2);
+    if (!prev || !SameInput(prev->input[0], r.input[0]) || !SameInput(prev->input[1], r.input[1])) {
+        if (prev || EffectiveMask(r.input[0]) || EffectiveMask(r.input[1]))
+            rep.Event(r, "recorded_inject", EffectiveMask(r.input[0]), EffectiveMask(r.input[1]));
+    }
+    for (int i = 0; i < r.overlayCount && i < TRACE_OVERLAY_EVENTS; ++i) {
+        std::string text(r.overlay[i].text);
+        for (char& c : text) if (c == ',' || c == '\n') c = ' ';
+        rep.Event(r, "overlay", r.overlay[i].categoryHash, 0, text);
+    }
+}
+
+#if defined(EFZ_TRACE_REPLAY_DRIVE_LOGIC)
+// Sample of the tick being replayed; what GetCurrentPerFrameSample serves on hosts without frame_monitor.cpp
+const PerFrameSample* s_sample = nullptr;
+
+struct LogicReplay {
+    FakeGameMemory fake;
+    PerFrameSample sample{};
+    bool prevFaCalc[2] = {false, false};
+    TraceInputState prevInput[2] = {};
+    uint64_t divergentTicks = 0;
+
+    // Starts from the state DisableFeatures leaves behind, so nothing carries over from a previous pass:
+    // cached pointers, frame advantage, auto-block, auto-action delays/cooldowns and injected input
+    LogicReplay() {
+        SetGameMemory(&fake);
+        InvalidateEFZBaseCache();
+        InvalidateGameStatePtrCache();
+        InvalidatePlayerBaseCache();
+        frameCounter.store(0);
+        ResetFrameAdvantageState();
+        ResetDummyAutoBlockState();
+        g_suppressAutoActionClearLogging.store(true);
+        ClearAllAutoActionTriggers();
+        g_suppressAutoActionClearLogging.store(false);
+        ResetActionFlags();
+        for (int p = 1; p <= 2; ++p) {
+            ImmediateInput::Clear(p);
+            g_manualInputOverride[p].store(false);
+            g_manualInputMask[p].store(0);
+            g_pollOverrideActive[p].store(false);
+            g_pollOverrideMask[p].store(0);
+            g_forceBypass[p].store(false);
+            g_injectImmediateOnly[p].store(false);
+        }
+        s_sample = &sample;
+    }
+    ~LogicReplay() {
+        s_sample = nullptr;
+        SetGameMemory(nullptr);
+    }
+
+    static void CaptureInput(TraceInputState& in, int player) {
+        memset(&in, 0, sizeof(in));
+        in.manualOverride = g_manualInputOverride[player].load() ? 1 : 0;
+        in.manualMask = g_manualInputMask[player].load();
+        in.pollOverride = g_pollOverrideActive[player].load() ? 1 : 0;
+        in.pollMask = g_pollOverrideMask[player].load();
+        in.immediateMask = ImmediateInput::GetCurrentDesired(player);
+        in.immediateOnly = g_injectImmediateOnly[player].load() ? 1 : 0;
+    }
+
+    void LoadRecord(const TraceRecord& r) {
+        fake.SetPlayerPresent(1, (r.flags & TRACE_F_P1_VALID) != 0);
+        fake.SetPlayerPresent(2, (r.flags & TRACE_F_P2_VALID) != 0);
+        if (r.flags & TRACE_F_P1_VALID) fake.Write(fake.PlayerBase(1), r.p1Raw, sizeof(r.p1Raw));
+        if (r.flags & TRACE_F_P2_VALID) fake.Write(fake.PlayerBase(2), r.p2Raw, sizeof(r.p2Raw));
+        if (r.flags & TRACE_F_GS_VALID) fake.Write(fake.GameStateBase() + GAMESTATE_SNAPSHOT_BEGIN, r.gsRaw, sizeof(r.gsRaw));
+        frameCounter.store((int)r.frame);
+
+        sample.frame = r.frame;
+        sample.tickMs = r.tickMs;
+        sample.phase = (GamePhase)r.phase;
+        sample.mode = (GameMode)r.mode;
+        sample.charsInitialized = (r.flags & TRACE_F_CHARS_INIT) != 0;
+        sample.moveID1 = r.moveID1; sample.moveID2 = r.moveID2;
+        sample.prevMoveID1 = r.prevMoveID1; sample.prevMoveID2 = r.prevMoveID2;
+        sample.actionable1 = IsActionable(r.moveID1);
+        sample.actionable2 = IsActionable(r.moveID2);
+        sample.neutral1 = (r.flags & TRACE_F_NEUTRAL1) != 0;
+        sample.neutral2 = (r.flags & TRACE_F_NEUTRAL2) != 0;
+        sample.basePtr = fake.ModuleBase();
+        sample.gameStatePtr = fake.GameStateBase();
+        sample.p1Ptr = (r.flags & TRACE_F_P1_VALID) ? fake.PlayerBase(1) : 0;
+        sample.p2Ptr = (r.flags & TRACE_F_P2_VALID) ? fake.PlayerBase(2) : 0;
+        sample.online = (r.flags & TRACE_F_ONLINE) != 0;
+        sample.p1.valid = (r.flags & TRACE_F_P1_VALID) != 0; sample.p1.base = sample.p1Ptr;
+        sample.p2.valid = (r.flags & TRACE_F_P2_VALID) != 0; sample.p2.base = sample.p2Ptr;
+        sample.gs.valid = (r.flags & TRACE_F_GS_VALID) != 0; sample.gs.base = sample.gameStatePtr;
+        memcpy(sample.p1.raw, r.p1Raw, sizeof(r.p1Raw));
+        memcpy(sample.p2.raw, r.p2Raw, sizeof(r.p2Raw));
+        memcpy(sample.gs.raw, r.gsRaw, sizeof(r.gsRaw));
+    }
+
+    // rep == nullptr: replay without reporting events (timing passes)
+    void Tick(const TraceRecord& r, Reporter* rep) {
+        LoadRecord(r);
+        // Same order as FrameDataMonitor
+        MonitorFrameAdvantage(sample);
+        MonitorDummyAutoBlock(sample);
+        MonitorAutoActions(r.moveID1, r.moveID2, r.prevMoveID1, r.prevMoveID2);
+        MonitorAutoAirtech(r.moveID1, r.moveID2);
+
+        FrameAdvantageState fa = GetFrameAdvantageState();
+        const bool calc[2] = { fa.p1AdvantageCalculated, fa.p2AdvantageCalculated };
+        const double adv[2] = { fa.p1FrameAdvantage, fa.p2FrameAdvantage };
+        for (int i = 0; i < 2; ++i) {
+            if (rep && calc[i] && !prevFaCalc[i]) {
+                rep->Event(r, i == 0 ? "fa_p1" : "fa_p2", (long long)adv[i], i == 0 ? fa.p1GapFrames : fa.p2GapFrames,
+                          FormatFrameAdvantage((int)adv[i]));
+            }
+            prevFaCalc[i] = calc[i];
+        }
+
+        TraceInputState now[2];
+        CaptureInput(now[0], 1);
+        CaptureInput(now[1], 2);
+        if (rep && (!SameInput(now[0], prevInput[0]) || !SameInput(now[1], prevInput[1]))) {
+            rep->Event(r, "inject", EffectiveMask(now[0]), EffectiveMask(now[1]));
+        }
+        if (!SameInput(now[0], r.input[0]) || !SameInput(now[1], r.input[1])) ++divergentTicks;
+        prevInput[0] = now[0];
+        prevInput[1] = now[1];
+    }
+};
+#endif
+
+bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--csv" && i + 1 < argc) opt.csvPath = argv[++i];
+        else if (a == "--repeat" && i + 1 < argc) opt.repeat = atoi(argv[++i]);
+        else if (a == "--triggers") opt.triggers = true;
+        else if (a == "--quiet") opt.quiet = true;
+        else if (!a.empty() && a[0] != '-' && opt.tracePath.empty()) opt.tracePath = a;
+        else return false;
+    }
+    if (opt.repeat < 1) opt.repeat = 1;
+    return !opt.tracePath.empty();
+}
+
+} // namespace
+
+#if defined(EFZ_TRACE_REPLAY_HOST)
+// frame_monitor.cpp is not linked here; serve the sample the replay built for this tick
+const PerFrameSample& GetCurrentPerFrameSample() {
+    static const PerFrameSample kEmpty{};
+    return s_sample ? *s_sample : kEmpty;
+}
+
+// The fake memory holds the same bytes as the snapshot, so a guarded read is equivalent
+bool ReadSampledPlayerField(uintptr_t playerBase, uintptr_t offset, void* out, size_t size) {
+    if (!playerBase || !out || size == 0) return false;
+    return SafeReadMemory(playerBase + offset, out, size);
+}
+#endif
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s <trace.bin> [--csv out.csv] [--repeat N] [--triggers] [--quiet]\n", argv[0]);
+        return 2;
+    }
+    TraceFile trace;
+    if (!LoadTrace(opt.tracePath, trace)) return 1;
+    if (trace.records.empty()) { fprintf(stderr, "%s: no records\n", opt.tracePath.c_str()); return 1; }
+
+#if defined(EFZ_TRACE_REPLAY_DRIVE_LOGIC)
+    if (opt.triggers) {
+        autoActionEnabled.store(true);
+        triggerAfterBlockEnabled.store(true);
+        triggerOnWakeupEnabled.store(true);
+        triggerAfterHitstunEnabled.store(true);
+        triggerAfterAirtechEnabled.store(true);
+    }
+    uint64_t divergentTicks = 0;
+    bool reproducible = true;
+#else
+    if (opt.triggers) fprintf(stderr, "--triggers ignored: built without EFZ_TRACE_REPLAY_DRIVE_LOGIC\n");
+#endif
+
+    Reporter rep(opt);
+    uint64_t ticks = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < opt.repeat; ++pass) {
+#if defined(EFZ_TRACE_REPLAY_DRIVE_LOGIC)
+        LogicReplay logic;
+#endif
+        const TraceRecord* prev = nullptr;
+        for (const TraceRecord& r : trace.records) {
+            if (pass == 0) ReportRecorded(r, prev, rep);
+#if defined(EFZ_TRACE_REPLAY_DRIVE_LOGIC)
+            logic.Tick(r, pass == 0 ? &rep : nullptr);
+#endif
+            prev = &r;
+            ++ticks;
+        }
+#if defined(EFZ_TRACE_REPLAY_DRIVE_LOGIC)
+        if (pass == 0) divergentTicks = logic.divergentTicks;
+        else if (logic.divergentTicks != divergentTicks) reproducible = false;
+#endif
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const TraceRecord& first = trace.records.front();
+    const TraceRecord& last = trace.records.back();
+    fprintf(stderr, "%s: %zu ticks (frames %u..%u, %.1fs of game time), %llu events\n",
+            opt.tracePath.c_str(), trace.records.size(), first.frame, last.frame,
+            (last.frame - first.frame) / (double)(trace.header.tickHz ? trace.header.tickHz : 192),
+            (unsigned long long)rep.events);
+#if defined(EFZ_TRACE_REPLAY_DRIVE_LOGIC)
+    fprintf(stderr, "injection state differs from recording on %llu ticks\n", (unsigned long long)divergentTicks);
+    if (!reproducible) fprintf(stderr, "warning: later --repeat passes diverged differently; state leaked between passes\n");
+#endif
+    fprintf(stderr, "replayed %llu ticks in %.3fs: %.0f ticks/s\n", (unsigned long long)ticks, secs,
+            secs > 0 ? ticks / secs : 0.0);
+    return 0;
+}